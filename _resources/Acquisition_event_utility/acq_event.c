@@ -0,0 +1,347 @@
+/*
+ ******************************************************************************
+ * @file    acq_event.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Pollable readiness and non blocking drain of the FIFO
+ *          acquisition of a sensor (Linux event loop integration).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "acq_event.h"
+
+/** @defgroup  Acquisition_event
+  * @brief     The readiness sources (signal eventfd, optional interrupt
+  *            line descriptor, optional timerfd) are registered in an
+  *            epoll instance private to the object: its descriptor is the
+  *            one returned by st_acq_fd() and is itself pollable, readable
+  *            as long as one of the sources is.
+  * @{
+  *
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+struct st_acq_s {
+  st_acq_cfg cfg;
+  int ep_fd;
+  int ev_fd;
+  int timer_fd;
+  uint8_t *buf;                   /* burst_max * word_len bytes */
+  st_acq_stats stats;
+};
+
+/* Private functions ---------------------------------------------------------*/
+static st_acq_status source_add(st_acq *acq, int fd, uint32_t events);
+static uint64_t counter_read(int fd);
+static void timer_arm(st_acq *acq);
+
+/**
+  * @defgroup  Acquisition_event_pubblic_functions
+  * @brief     This section provide a set of functions used to wait for and
+  *            drain the FIFO of a sensor from an event loop.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Create an acquisition object.
+  *
+  * @param  acq               acquisition object.(ptr to ptr)
+  * @param  cfg               sensor, FIFO and readiness sources.(ptr)
+  *
+  * @retval st_acq_status     ST_ACQ_OK / ST_ACQ_ERR
+  *
+  */
+st_acq_status st_acq_init(st_acq **acq, const st_acq_cfg *cfg)
+{
+  st_acq *a;
+
+  *acq = NULL;
+
+  if ((cfg->level_get == NULL) || (cfg->burst_read == NULL) ||
+      (cfg->word_len == 0U) || (cfg->burst_max == 0U)) {
+    return ST_ACQ_ERR;
+  }
+
+  a = (st_acq *)calloc(1, sizeof(st_acq));
+  if (a == NULL) {
+    return ST_ACQ_ERR;
+  }
+
+  a->cfg = *cfg;
+  a->ep_fd = -1;
+  a->ev_fd = -1;
+  a->timer_fd = -1;
+
+  a->buf = (uint8_t *)malloc((size_t)cfg->burst_max * cfg->word_len);
+  a->ep_fd = epoll_create1(EPOLL_CLOEXEC);
+  a->ev_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  if ((a->buf == NULL) || (a->ep_fd < 0) || (a->ev_fd < 0) ||
+      (source_add(a, a->ev_fd, EPOLLIN) != ST_ACQ_OK)) {
+    st_acq_deinit(a);
+    return ST_ACQ_ERR;
+  }
+
+  /* GPIO line events are readable, sysfs GPIO values signal POLLPRI */
+  if ((cfg->irq_fd >= 0) &&
+      (source_add(a, cfg->irq_fd, EPOLLIN | EPOLLPRI) != ST_ACQ_OK)) {
+    st_acq_deinit(a);
+    return ST_ACQ_ERR;
+  }
+
+  if (cfg->timer_ms != 0U) {
+    a->timer_fd = timerfd_create(CLOCK_MONOTONIC,
+                                 TFD_NONBLOCK | TFD_CLOEXEC);
+    if ((a->timer_fd < 0) ||
+        (source_add(a, a->timer_fd, EPOLLIN) != ST_ACQ_OK)) {
+      st_acq_deinit(a);
+      return ST_ACQ_ERR;
+    }
+    timer_arm(a);
+  }
+
+  *acq = a;
+
+  return ST_ACQ_OK;
+}
+
+/**
+  * @brief  Release an acquisition object (irq_fd is not closed).
+  *
+  * @param  acq               acquisition object.(ptr)
+  *
+  */
+void st_acq_deinit(st_acq *acq)
+{
+  if (acq == NULL) {
+    return;
+  }
+
+  if (acq->timer_fd >= 0) {
+    (void)close(acq->timer_fd);
+  }
+  if (acq->ev_fd >= 0) {
+    (void)close(acq->ev_fd);
+  }
+  if (acq->ep_fd >= 0) {
+    (void)close(acq->ep_fd);
+  }
+
+  free(acq->buf);
+  free(acq);
+}
+
+/**
+  * @brief  Pollable descriptor, readable when st_acq_drain() has work:
+  *         add it to the epoll / poll set of the event loop (EPOLLIN).
+  *
+  * @param  acq               acquisition object.(ptr)
+  *
+  * @retval int               file descriptor
+  *
+  */
+int st_acq_fd(const st_acq *acq)
+{
+  return acq->ep_fd;
+}
+
+/**
+  * @brief  Signal the readiness, from the interrupt source. Only an
+  *         eventfd write: async signal safe, callable from any thread.
+  *
+  * @param  acq               acquisition object.(ptr)
+  *
+  * @retval st_acq_status     ST_ACQ_OK / ST_ACQ_ERR
+  *
+  */
+st_acq_status st_acq_signal(st_acq *acq)
+{
+  uint64_t one = 1;
+
+  if ((write(acq->ev_fd, &one, sizeof(one)) != (ssize_t)sizeof(one)) &&
+      (errno != EAGAIN)) {
+    return ST_ACQ_ERR;
+  }
+
+  return ST_ACQ_OK;
+}
+
+/**
+  * @brief  Clear the readiness and read the FIFO content, never blocks.
+  *         The words are read in bursts of burst_max and passed to the
+  *         data callback; the FIFO level is read again at the end and, if
+  *         still at the watermark (the interrupt edge is consumed), the
+  *         object signals itself to be drained again on the next loop
+  *         iteration.
+  *
+  * @param  acq               acquisition object.(ptr)
+  * @param  words             words read, can be NULL.(ptr)
+  *
+  * @retval st_acq_status     ST_ACQ_OK / ST_ACQ_ERR (bus error)
+  *
+  */
+st_acq_status st_acq_drain(st_acq *acq, uint32_t *words)
+{
+  st_acq_cfg *cfg = &acq->cfg;
+  struct pollfd pfd;
+  uint64_t n;
+  uint32_t total = 0;
+  uint16_t level = 0;
+  uint16_t num;
+  uint8_t ready = 0;
+  int32_t ret;
+
+  n = counter_read(acq->ev_fd);
+  if (n != 0U) {
+    acq->stats.signals += (uint32_t)n;
+    ready = 1;
+  }
+
+  if (cfg->irq_fd >= 0) {
+    pfd.fd = cfg->irq_fd;
+    pfd.events = POLLIN | POLLPRI;
+    pfd.revents = 0;
+    if ((poll(&pfd, 1, 0) > 0) && (pfd.revents != 0)) {
+      if (cfg->irq_ack != NULL) {
+        cfg->irq_ack(cfg->irq_fd, cfg->arg);
+      }
+      acq->stats.irqs++;
+      ready = 1;
+    }
+  }
+
+  if (acq->timer_fd >= 0) {
+    if (counter_read(acq->timer_fd) != 0U) {
+      acq->stats.timeouts++;
+      ready = 1;
+    }
+    /* fallback only: the period restarts at every drain */
+    timer_arm(acq);
+  }
+
+  acq->stats.wakeups += ready;
+
+  ret = cfg->level_get(&cfg->ctx, &level);
+
+  while ((ret == 0) && (level > 0U)) {
+    num = (level < cfg->burst_max) ? level : cfg->burst_max;
+    ret = cfg->burst_read(&cfg->ctx, acq->buf, num);
+    if (ret == 0) {
+      if (cfg->data != NULL) {
+        cfg->data(acq->buf, num, cfg->arg);
+      }
+      acq->stats.bursts++;
+      total += num;
+      level -= num;
+    }
+  }
+
+  if ((ret == 0) && (cfg->wtm != 0U) && (total != 0U)) {
+    ret = cfg->level_get(&cfg->ctx, &level);
+    if ((ret == 0) && (level >= cfg->wtm)) {
+      (void)st_acq_signal(acq);
+    }
+  }
+
+  acq->stats.words += total;
+  if (words != NULL) {
+    *words = total;
+  }
+
+  if (ret != 0) {
+    acq->stats.errors++;
+    return ST_ACQ_ERR;
+  }
+
+  return ST_ACQ_OK;
+}
+
+/**
+  * @brief  Acquisition statistics.
+  *
+  * @param  acq               acquisition object.(ptr)
+  * @param  stats             statistics.(ptr)
+  *
+  */
+void st_acq_stats_get(const st_acq *acq, st_acq_stats *stats)
+{
+  *stats = acq->stats;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @brief  Register a readiness source in the private epoll instance.
+  *
+  */
+static st_acq_status source_add(st_acq *acq, int fd, uint32_t events)
+{
+  struct epoll_event ev;
+
+  ev.events = events;
+  ev.data.fd = fd;
+
+  if (epoll_ctl(acq->ep_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    return ST_ACQ_ERR;
+  }
+
+  return ST_ACQ_OK;
+}
+
+/**
+  * @brief  Read and clear an eventfd / timerfd counter, 0 if not set.
+  *
+  */
+static uint64_t counter_read(int fd)
+{
+  uint64_t n = 0;
+
+  if (read(fd, &n, sizeof(n)) != (ssize_t)sizeof(n)) {
+    n = 0;
+  }
+
+  return n;
+}
+
+/**
+  * @brief  Restart the fallback timer.
+  *
+  */
+static void timer_arm(st_acq *acq)
+{
+  struct itimerspec its;
+
+  its.it_value.tv_sec = (time_t)(acq->cfg.timer_ms / 1000U);
+  its.it_value.tv_nsec = (long)(acq->cfg.timer_ms % 1000U) * 1000000L;
+  its.it_interval = its.it_value;
+
+  (void)timerfd_settime(acq->timer_fd, 0, &its, NULL);
+}
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,188 @@
+/*
+ ******************************************************************************
+ * @file    acq_event.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          acq_event.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_ACQ_EVENT_H
+#define ST_ACQ_EVENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/** @addtogroup Acquisition event
+  * @brief    Linux event loop integration of the FIFO acquisition of a
+  *           sensor: every acquisition object exposes one pollable file
+  *           descriptor (st_acq_fd()), readable when the FIFO needs to be
+  *           drained, so a single epoll / poll loop services many sensors
+  *           without threads polling the watermark flags.
+  *
+  *           The descriptor becomes readable on:
+  *           - st_acq_signal(), called by the interrupt source (GPIO
+  *             edge handler, simulated interrupt...), async signal safe;
+  *           - the interrupt line descriptor given in the configuration
+  *             (e.g. GPIO character device line event, UIO);
+  *           - the timer fallback, for sensors without interrupt line or
+  *             to recover a missed edge.
+  *
+  *           st_acq_drain() clears the readiness and does all the pending
+  *           burst reads without waiting: the FIFO level is read once,
+  *           the words are read in bursts and passed to the data
+  *           callback; if the level is still at the watermark after the
+  *           drain the object signals itself, so the next loop iteration
+  *           continues without starving the other sensors.
+  * @{
+  *
+  */
+
+#ifndef MEMS_SHARED_TYPES
+#define MEMS_SHARED_TYPES
+
+typedef struct{
+  uint8_t bit0       : 1;
+  uint8_t bit1       : 1;
+  uint8_t bit2       : 1;
+  uint8_t bit3       : 1;
+  uint8_t bit4       : 1;
+  uint8_t bit5       : 1;
+  uint8_t bit6       : 1;
+  uint8_t bit7       : 1;
+} bitwise_t;
+
+#define PROPERTY_DISABLE                (0U)
+#define PROPERTY_ENABLE                 (1U)
+
+/** @addtogroup  Interfaces_Functions
+  * @brief       This section provide a set of functions used to read and
+  *              write a generic register of the device.
+  *              MANDATORY: return 0 -> no Error.
+  * @{
+  *
+  */
+
+typedef int32_t (*stmdev_write_ptr)(void *, uint8_t, uint8_t*, uint16_t);
+typedef int32_t (*stmdev_read_ptr) (void *, uint8_t, uint8_t*, uint16_t);
+
+typedef struct {
+  /** Component mandatory fields **/
+  stmdev_write_ptr  write_reg;
+  stmdev_read_ptr   read_reg;
+  /** Customizable optional pointer **/
+  void *handle;
+} stmdev_ctx_t;
+
+/**
+  * @}
+  *
+  */
+
+#endif /* MEMS_SHARED_TYPES */
+
+/** @defgroup Acquisition_event_pubblic_definitions
+  * @{
+  *
+  */
+
+typedef enum {
+  ST_ACQ_OK = 0,
+  ST_ACQ_ERR
+} st_acq_status;
+
+typedef struct st_acq_s st_acq;
+
+/**
+  * @brief  FIFO level in words, e.g. xxx_fifo_data_level_get().
+  *         MANDATORY: return 0 -> no Error.
+  */
+typedef int32_t (*st_acq_level_ptr)(stmdev_ctx_t *ctx, uint16_t *words);
+
+/**
+  * @brief  Read words FIFO words in one burst (words * word_len bytes).
+  *         MANDATORY: return 0 -> no Error.
+  */
+typedef int32_t (*st_acq_burst_ptr)(stmdev_ctx_t *ctx, uint8_t *data,
+                                    uint16_t words);
+
+/**
+  * @brief  Data of a burst, e.g. to st_fifo_stream_feed().
+  */
+typedef void (*st_acq_data_ptr)(const uint8_t *data, uint16_t words,
+                                void *arg);
+
+/**
+  * @brief  Interrupt line descriptor acknowledge (read of the pending
+  *         event), called by st_acq_drain() when irq_fd is readable.
+  */
+typedef void (*st_acq_irq_ack_ptr)(int fd, void *arg);
+
+typedef struct {
+  stmdev_ctx_t ctx;               /* driver context of the sensor */
+  st_acq_level_ptr level_get;
+  st_acq_burst_ptr burst_read;
+  uint16_t word_len;              /* bytes per FIFO word */
+  uint16_t burst_max;             /* words per burst */
+  uint16_t wtm;                   /* FIFO watermark, 0: no self signal */
+  st_acq_data_ptr data;
+  void *arg;                      /* data / irq_ack argument */
+  int irq_fd;                     /* interrupt line descriptor, -1: none */
+  st_acq_irq_ack_ptr irq_ack;
+  uint32_t timer_ms;              /* timer fallback period, 0: none */
+} st_acq_cfg;
+
+typedef struct {
+  uint32_t wakeups;               /* drains with readiness set */
+  uint32_t signals;               /* from st_acq_signal() */
+  uint32_t irqs;                  /* from irq_fd */
+  uint32_t timeouts;              /* from the timer fallback */
+  uint32_t bursts;
+  uint32_t words;
+  uint32_t errors;                /* bus errors */
+} st_acq_stats;
+
+/**
+  * @}
+  *
+  */
+
+st_acq_status st_acq_init(st_acq **acq, const st_acq_cfg *cfg);
+
+void st_acq_deinit(st_acq *acq);
+
+int st_acq_fd(const st_acq *acq);
+
+st_acq_status st_acq_signal(st_acq *acq);
+
+st_acq_status st_acq_drain(st_acq *acq, uint32_t *words);
+
+void st_acq_stats_get(const st_acq *acq, st_acq_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_ACQ_EVENT_H */
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,354 @@
+/*
+ ******************************************************************************
+ * @file    acq_event_demo.c
+ * @author  Sensor Solutions Software Team
+ * @brief   One epoll loop servicing the FIFO of several simulated sensors.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Build (Linux):
+ *
+ *   gcc -O2 -pthread -I../Bus_simulator_utility acq_event.c \
+ *       acq_event_demo.c ../Bus_simulator_utility/bus_simulator.c \
+ *       -o acq_event_demo
+ *
+ * Usage:
+ *
+ *   acq_event_demo [seconds] [ODR Hz] [burst words] [drop 1 in N]
+ *
+ * Defaults: 2 s, 1666 Hz, bursts of 64 words, no interrupt dropped. With
+ * drop N every N-th watermark event of each sensor is not signalled (a
+ * missed edge), to be recovered by the fallback timer.
+ *
+ * Accelerometers with the LSM6DSOX register map (tagged FIFO) on the
+ * simulated SPI bus, run in real time: a thread moves the simulated time
+ * with the wall clock and turns the FIFO watermark interrupt events into
+ * st_acq_signal() calls (the GPIO interrupt of a real board). The main
+ * thread is a single epoll loop on the descriptors of the acquisition
+ * objects and drains the ready ones. The last sensor has no interrupt
+ * line and is serviced by the timer fallback only.
+ *
+ * For each sensor: wakeups and their source, bursts, words received
+ * versus produced, FIFO overrun and gaps found in the sample sequence;
+ * then the CPU time of the process versus the elapsed time.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include "bus_simulator.h"
+#include "acq_event.h"
+
+/* Private constants  --------------------------------------------------------*/
+#define LSM6DSOX_WHO_AM_I        (0x0FU)
+#define LSM6DSOX_ID              (0x6CU)
+#define LSM6DSOX_STATUS_REG      (0x1EU)
+#define LSM6DSOX_OUTX_L_A        (0x28U)
+#define LSM6DSOX_FIFO_STATUS1    (0x3AU)
+#define LSM6DSOX_FIFO_DATA_OUT_TAG (0x78U)
+#define TAG_XL                   (0x02U)
+
+#define DEV_NUM                  (4U)
+#define ODR_HZ                   (1666.0)
+#define FIFO_DEPTH               (512U)
+#define FIFO_WTM                 (32U)
+#define FIFO_WORD                (7U)
+#define BURST_MAX                (64U)
+#define TIMER_MS                 (50U)     /* missed interrupt recovery */
+#define TIMER_NO_IRQ_MS          (10U)     /* sensor without interrupt */
+#define TICK_NS                  (1000000U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  stmdev_ctx_t bus;               /* simulated bus context */
+  uint16_t expected;
+  uint32_t gaps;
+  uint32_t events;                /* watermark events raised */
+} sensor;
+
+/* Private variables ---------------------------------------------------------*/
+static pthread_mutex_t bus_lock = PTHREAD_MUTEX_INITIALIZER;
+static st_bus_sim *sim;
+static st_acq *acq[DEV_NUM];
+static sensor sensors[DEV_NUM];
+static volatile int running = 1;
+static uint32_t drop;             /* every drop-th event not signalled */
+
+/* Private functions ---------------------------------------------------------*/
+static void *irq_thread(void *arg);
+static int32_t level_get(stmdev_ctx_t *ctx, uint16_t *words);
+static int32_t burst_read(stmdev_ctx_t *ctx, uint8_t *data, uint16_t words);
+static void data_cb(const uint8_t *data, uint16_t words, void *arg);
+static uint64_t now_ns(clockid_t clock);
+
+int main(int argc, char *argv[])
+{
+  double seconds = (argc > 1) ? atof(argv[1]) : 2.0;
+  double odr = (argc > 2) ? atof(argv[2]) : ODR_HZ;
+  int burst = (argc > 3) ? atoi(argv[3]) : (int)BURST_MAX;
+  st_bus_sim_dev_cfg dev_cfg[DEV_NUM];
+  struct epoll_event ev[DEV_NUM];
+  st_bus_sim_dev_stats dev_stats;
+  st_bus_sim_stats stats;
+  st_acq_stats acq_stats;
+  st_bus_sim_cfg cfg;
+  st_acq_cfg acq_cfg;
+  pthread_t thread;
+  uint64_t start;
+  uint64_t cpu;
+  uint64_t end;
+  uint32_t i;
+  int ep_fd;
+  int n;
+
+  drop = (argc > 4) ? (uint32_t)atoi(argv[4]) : 0U;
+
+  if ((seconds <= 0.0) || (odr <= 0.0) || (burst <= 0) ||
+      (burst > (int)FIFO_DEPTH) || (drop == 1U)) {
+    printf("usage: %s [seconds] [ODR Hz] [burst words] [drop 1 in N]\n",
+           argv[0]);
+    return 1;
+  }
+
+  cfg.type = ST_BUS_SIM_SPI;
+  cfg.clock_hz = 10000000U;
+  cfg.host_ns = 2000;
+  cfg.cs_ns = 200;
+
+  for (i = 0; i < DEV_NUM; i++) {
+    dev_cfg[i].add = (uint8_t)i;
+    dev_cfg[i].who_am_i_reg = LSM6DSOX_WHO_AM_I;
+    dev_cfg[i].who_am_i = LSM6DSOX_ID;
+    dev_cfg[i].stretch_ns = 0;
+    dev_cfg[i].odr_hz = (float)odr;
+    dev_cfg[i].status_reg = LSM6DSOX_STATUS_REG;
+    dev_cfg[i].drdy_mask = 0x01U;
+    dev_cfg[i].out_reg = LSM6DSOX_OUTX_L_A;
+    dev_cfg[i].fifo_type = ST_BUS_SIM_FIFO_TAGGED;
+    dev_cfg[i].fifo_depth = FIFO_DEPTH;
+    dev_cfg[i].fifo_wtm = FIFO_WTM;
+    dev_cfg[i].fifo_out_reg = LSM6DSOX_FIFO_DATA_OUT_TAG;
+    dev_cfg[i].fifo_status_reg = LSM6DSOX_FIFO_STATUS1;
+    dev_cfg[i].fifo_tag = TAG_XL;
+    dev_cfg[i].int_drdy = 0;
+    dev_cfg[i].int_fifo = (i == (DEV_NUM - 1U)) ? 0U : 1U;
+    dev_cfg[i].gen = NULL;
+    dev_cfg[i].write_hook = NULL;
+    dev_cfg[i].arg = NULL;
+  }
+
+  if (st_bus_sim_init(&sim, &cfg, dev_cfg, DEV_NUM) != ST_BUS_SIM_OK) {
+    printf("bus simulator init error\n");
+    return 1;
+  }
+
+  ep_fd = epoll_create1(0);
+  if (ep_fd < 0) {
+    printf("epoll error\n");
+    return 1;
+  }
+
+  for (i = 0; i < DEV_NUM; i++) {
+    st_bus_sim_ctx_get(sim, (uint16_t)i, &sensors[i].bus);
+
+    acq_cfg.ctx.write_reg = NULL;
+    acq_cfg.ctx.read_reg = NULL;
+    acq_cfg.ctx.handle = &sensors[i];
+    acq_cfg.level_get = level_get;
+    acq_cfg.burst_read = burst_read;
+    acq_cfg.word_len = FIFO_WORD;
+    acq_cfg.burst_max = (uint16_t)burst;
+    acq_cfg.wtm = FIFO_WTM;
+    acq_cfg.data = data_cb;
+    acq_cfg.arg = &sensors[i];
+    acq_cfg.irq_fd = -1;
+    acq_cfg.irq_ack = NULL;
+    acq_cfg.timer_ms = (dev_cfg[i].int_fifo == 0U) ? TIMER_NO_IRQ_MS :
+                       TIMER_MS;
+
+    if (st_acq_init(&acq[i], &acq_cfg) != ST_ACQ_OK) {
+      printf("acquisition %u init error\n", (unsigned)i);
+      return 1;
+    }
+
+    ev[0].events = EPOLLIN;
+    ev[0].data.u32 = i;
+    if (epoll_ctl(ep_fd, EPOLL_CTL_ADD, st_acq_fd(acq[i]), &ev[0]) != 0) {
+      printf("epoll error\n");
+      return 1;
+    }
+  }
+
+  start = now_ns(CLOCK_MONOTONIC);
+  end = start + (uint64_t)(seconds * 1e9);
+  cpu = now_ns(CLOCK_PROCESS_CPUTIME_ID);
+
+  if (pthread_create(&thread, NULL, irq_thread, (void *)&start) != 0) {
+    printf("thread error\n");
+    return 1;
+  }
+
+  /* the event loop: sleeps until one of the sensors has work */
+  while (now_ns(CLOCK_MONOTONIC) < end) {
+    n = epoll_wait(ep_fd, ev, DEV_NUM, 100);
+    while (n > 0) {
+      n--;
+      (void)st_acq_drain(acq[ev[n].data.u32], NULL);
+    }
+  }
+
+  running = 0;
+  (void)pthread_join(thread, NULL);
+
+  cpu = now_ns(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+  end = now_ns(CLOCK_MONOTONIC) - start;
+
+  printf("%.0f Hz, bursts of %d words, ", odr, burst);
+  if (drop != 0U) {
+    printf("1 watermark interrupt in %u dropped\n", (unsigned)drop);
+  }
+  else {
+    printf("no interrupt dropped\n");
+  }
+  printf("dev  irq  wakeups  signal  timer  bursts  words in/out"
+         "     overrun  gaps\n");
+
+  for (i = 0; i < DEV_NUM; i++) {
+    st_acq_stats_get(acq[i], &acq_stats);
+    st_bus_sim_dev_stats_get(sim, (uint16_t)i, &dev_stats);
+    printf("%3u  %-3s  %7u  %6u  %5u  %6u  %6u/%-6u  %7u  %4u\n",
+           (unsigned)i, (dev_cfg[i].int_fifo != 0U) ? "yes" : "no",
+           (unsigned)acq_stats.wakeups, (unsigned)acq_stats.signals,
+           (unsigned)acq_stats.timeouts, (unsigned)acq_stats.bursts,
+           (unsigned)acq_stats.words, (unsigned)dev_stats.samples,
+           (unsigned)dev_stats.fifo_overrun, (unsigned)sensors[i].gaps);
+    st_acq_deinit(acq[i]);
+  }
+
+  st_bus_sim_stats_get(sim, &stats);
+  printf("bus utilization %.1f %%, CPU time %.1f ms in %.1f ms (%.2f %%)\n",
+         (double)stats.utilization * 100.0, (double)cpu / 1e6,
+         (double)end / 1e6, (double)cpu * 100.0 / (double)end);
+
+  st_bus_sim_deinit(sim);
+
+  return 0;
+}
+
+/*
+ * @brief  Simulated interrupt source: every TICK_NS the simulated time
+ *         catches up with the wall clock and the FIFO watermark events
+ *         raised meanwhile signal the acquisition objects (but every
+ *         drop-th one of each sensor).
+ *
+ */
+static void *irq_thread(void *arg)
+{
+  uint64_t start = *(const uint64_t *)arg;
+  struct timespec tick = { 0, TICK_NS };
+  st_bus_sim_event ev;
+  uint64_t elapsed;
+
+  while (running != 0) {
+    (void)nanosleep(&tick, NULL);
+
+    (void)pthread_mutex_lock(&bus_lock);
+    elapsed = now_ns(CLOCK_MONOTONIC) - start;
+    if (elapsed > st_bus_sim_now(sim)) {
+      st_bus_sim_delay(sim, elapsed - st_bus_sim_now(sim));
+    }
+
+    (void)st_bus_sim_wait(sim, 0, &ev);
+    while (ev.type != ST_BUS_SIM_EV_TIMEOUT) {
+      if (ev.type == ST_BUS_SIM_EV_FIFO_WTM) {
+        sensors[ev.dev].events++;
+        if ((drop == 0U) || ((sensors[ev.dev].events % drop) != 0U)) {
+          (void)st_acq_signal(acq[ev.dev]);
+        }
+      }
+      (void)st_bus_sim_wait(sim, 0, &ev);
+    }
+    (void)pthread_mutex_unlock(&bus_lock);
+  }
+
+  return NULL;
+}
+
+/*
+ * @brief  FIFO level (FIFO_STATUS1 / FIFO_STATUS2).
+ *
+ */
+static int32_t level_get(stmdev_ctx_t *ctx, uint16_t *words)
+{
+  sensor *s = (sensor *)ctx->handle;
+  uint8_t buff[2];
+  int32_t ret;
+
+  (void)pthread_mutex_lock(&bus_lock);
+  ret = s->bus.read_reg(s->bus.handle, LSM6DSOX_FIFO_STATUS1, buff, 2);
+  (void)pthread_mutex_unlock(&bus_lock);
+
+  *words = (uint16_t)buff[0] | ((uint16_t)(buff[1] & 0x03U) << 8);
+
+  return ret;
+}
+
+/*
+ * @brief  FIFO words, tag and data, in one transaction.
+ *
+ */
+static int32_t burst_read(stmdev_ctx_t *ctx, uint8_t *data, uint16_t words)
+{
+  sensor *s = (sensor *)ctx->handle;
+  int32_t ret;
+
+  (void)pthread_mutex_lock(&bus_lock);
+  ret = s->bus.read_reg(s->bus.handle, LSM6DSOX_FIFO_DATA_OUT_TAG, data,
+                        (uint16_t)(words * FIFO_WORD));
+  (void)pthread_mutex_unlock(&bus_lock);
+
+  return ret;
+}
+
+/*
+ * @brief  Check the sample sequence (x = sample index).
+ *
+ */
+static void data_cb(const uint8_t *data, uint16_t words, void *arg)
+{
+  sensor *s = (sensor *)arg;
+  uint16_t x;
+  uint16_t w;
+
+  for (w = 0; w < words; w++) {
+    x = (uint16_t)data[(w * FIFO_WORD) + 1U] |
+        ((uint16_t)data[(w * FIFO_WORD) + 2U] << 8);
+    s->gaps += (x != s->expected) ? 1U : 0U;
+    s->expected = x + 1U;
+  }
+}
+
+static uint64_t now_ns(clockid_t clock)
+{
+  struct timespec ts;
+
+  (void)clock_gettime(clock, &ts);
+
+  return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
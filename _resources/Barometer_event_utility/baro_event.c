@@ -0,0 +1,371 @@
+/*
+ ******************************************************************************
+ * @file    baro_event.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Event-driven barometer on the pressure threshold interrupt.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "baro_event.h"
+#include "lps22hb_reg.h"
+#include "lps22hh_reg.h"
+#include "lps27hhw_reg.h"
+#include "lps33hw_reg.h"
+
+/**
+  * @defgroup  Barometer event
+  * @brief     This file provides a set of functions needed to program the
+  *            pressure threshold interrupt around the current level and
+  *            to read and re-arm it when a change is detected.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+/*
+ * INTERRUPT_CFG (0x0B) and PRESS_OUT (0x28) have the same addresses on
+ * all the parts, INTERRUPT_CFG the same layout:
+ * PHE, PLE, LIR, DIFF_EN, RESET_AZ, AUTOZERO, RESET_ARP, AUTOREFP
+ * (AUTORIFP on LPS22HB / LPS33HW).
+ */
+#define CFG_DIFF_EN              (0x08U)
+#define CFG_RESET_ARP            (0x40U)
+#define CFG_AUTOREFP             (0x80U)
+
+/* INT_SOURCE */
+#define SRC_PH                   (0x01U)
+#define SRC_PL                   (0x02U)
+#define SRC_IA                   (0x04U)
+
+#define OUT_MAX                  (7U)   /* INT_SOURCE to PRESS_OUT_H */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint8_t src_reg;              /* INT_SOURCE, first register of the burst */
+  uint8_t out_len;              /* INT_SOURCE to PRESS_OUT_H */
+} part_desc;
+
+/* Private variables ---------------------------------------------------------*/
+static const part_desc part_table[ST_BARO_PART_NUM] = {
+  /* LPS22HB: INT_SOURCE, FIFO_STATUS, STATUS, PRESS_OUT */
+  { LPS22HB_INT_SOURCE, 6U },
+  /* LPS22HH: INT_SOURCE, FIFO_STATUS1/2, STATUS, PRESS_OUT */
+  { LPS22HH_INT_SOURCE, 7U },
+  /* LPS27HHW: INT_SOURCE, FIFO_STATUS1/2, STATUS, PRESS_OUT */
+  { LPS27HHW_INT_SOURCE, 7U },
+  /* LPS33HW: INT_SOURCE, FIFO_STATUS, STATUS, PRESS_OUT */
+  { LPS33HW_INT_SOURCE, 6U },
+};
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t part_init(st_baro_dev *dev, uint16_t ths);
+static int32_t reference_rearm(st_baro_dev *dev);
+static float_t pressure_decode(const st_baro_dev *dev, const uint8_t *buf);
+
+/**
+  * @defgroup    Barometer_event_pubblic_functions
+  * @brief       This section provide a set of APIs for pressure change
+  *              detection on interrupt.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Configure the threshold interrupt: latched, both directions,
+  *         routed to the INT pin, threshold_hPa of the device.
+  *         The interrupt stays disabled until st_baro_arm().
+  *         The data rate is left to the application.
+  *
+  * @param  dev               barometer, part, ctx and threshold_hPa
+  *                           set.(ptr)
+  * @retval st_baro_status    ST_BARO_OK / ST_BARO_ERR (bad parameters or
+  *                           bus error)
+  *
+  */
+st_baro_status st_baro_init(st_baro_dev *dev)
+{
+  uint16_t ths;
+  int32_t ret;
+
+  if ((dev == NULL) || (dev->part >= ST_BARO_PART_NUM) ||
+      (dev->threshold_hPa < ST_BARO_THS_MIN_HPA) ||
+      (dev->threshold_hPa > ST_BARO_THS_MAX_HPA)) {
+    return ST_BARO_ERR;
+  }
+
+  ths = (uint16_t)((dev->threshold_hPa * 16.0f) + 0.5f);
+  ret = part_init(dev, ths);
+
+  if (ret == 0) {
+    ret = dev->ctx.read_reg(dev->ctx.handle, LPS22HH_INTERRUPT_CFG,
+                            &dev->int_cfg, 1);
+  }
+  if (ret == 0) {
+    /* no comparison (and no interrupt) until the reference is armed */
+    dev->int_cfg &= (uint8_t)~(CFG_DIFF_EN | CFG_RESET_ARP | CFG_AUTOREFP);
+    ret = dev->ctx.write_reg(dev->ctx.handle, LPS22HH_INTERRUPT_CFG,
+                             &dev->int_cfg, 1);
+    dev->int_cfg |= (uint8_t)(CFG_DIFF_EN | CFG_AUTOREFP);
+  }
+
+  return (ret == 0) ? ST_BARO_OK : ST_BARO_ERR;
+}
+
+/**
+  * @brief  Arm the interrupt around the current pressure: read the
+  *         level and take the reference from the next conversion.
+  *         To be called with the device running (data rate set), after
+  *         st_baro_init() and after any data rate change.
+  *
+  * @param  dev               barometer, initialized with
+  *                           st_baro_init().(ptr)
+  * @retval st_baro_status    ST_BARO_OK / ST_BARO_ERR (bad parameters or
+  *                           bus error)
+  *
+  */
+st_baro_status st_baro_arm(st_baro_dev *dev)
+{
+  uint8_t buf[3];
+  int32_t ret;
+
+  if (dev == NULL) {
+    return ST_BARO_ERR;
+  }
+
+  ret = dev->ctx.read_reg(dev->ctx.handle, LPS22HH_PRESS_OUT_XL, buf, 3);
+  if (ret == 0) {
+    dev->ref_hPa = pressure_decode(dev, buf);
+    ret = reference_rearm(dev);
+  }
+
+  return (ret == 0) ? ST_BARO_OK : ST_BARO_ERR;
+}
+
+/**
+  * @brief  Service of the INT pin: read interrupt source and pressure
+  *         with one burst (clears the latched interrupt) and, on a
+  *         threshold crossing, re-arm the reference around the new
+  *         level and report the change.
+  *
+  *         A crossing latched by a conversion just before the previous
+  *         re-arm finds the pressure still close to the reference: it
+  *         is not reported (valid 0) and needs no re-arm.
+  *
+  * @param  dev               barometer, armed with st_baro_arm().(ptr)
+  * @param  ev                event.(ptr)
+  * @retval st_baro_status    ST_BARO_OK / ST_BARO_ERR (bad parameters or
+  *                           bus error)
+  *
+  */
+st_baro_status st_baro_event_get(st_baro_dev *dev, st_baro_event *ev)
+{
+  const part_desc *desc;
+  uint8_t buf[OUT_MAX];
+  float_t change;
+  int32_t ret;
+
+  if ((dev == NULL) || (ev == NULL)) {
+    return ST_BARO_ERR;
+  }
+
+  desc = &part_table[dev->part];
+  ret = dev->ctx.read_reg(dev->ctx.handle, desc->src_reg, buf,
+                          desc->out_len);
+  if (ret != 0) {
+    return ST_BARO_ERR;
+  }
+
+  ev->pressure_hPa = pressure_decode(dev, &buf[desc->out_len - 3U]);
+  change = ev->pressure_hPa - dev->ref_hPa;
+  ev->change_hPa = change;
+  ev->high = ((buf[0] & SRC_PH) != 0U) ? 1U : 0U;
+  ev->low = ((buf[0] & SRC_PL) != 0U) ? 1U : 0U;
+  ev->valid = 0;
+
+  if (((buf[0] & SRC_IA) != 0U) &&
+      ((change * 2.0f >= dev->threshold_hPa) ||
+       (change * 2.0f <= -dev->threshold_hPa))) {
+    ev->valid = 1;
+    dev->ref_hPa = ev->pressure_hPa;
+    ret = reference_rearm(dev);
+  }
+
+  return (ret == 0) ? ST_BARO_OK : ST_BARO_ERR;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @brief  Interrupt configuration of a device, threshold in 1/16 hPa.
+  *
+  */
+static int32_t part_init(st_baro_dev *dev, uint16_t ths)
+{
+  stmdev_ctx_t *ctx = &dev->ctx;
+  uint8_t buff[2];
+  int32_t ret = 0;
+
+  buff[0] = (uint8_t)(ths & 0x00FFU);
+  buff[1] = (uint8_t)(ths >> 8);
+
+  switch (dev->part) {
+    case ST_BARO_LPS22HB:
+      ret = lps22hb_block_data_update_set(ctx, PROPERTY_ENABLE);
+      if (ret == 0) {
+        ret = lps22hb_auto_add_inc_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        ret = lps22hb_int_threshold_set(ctx, buff);
+      }
+      if (ret == 0) {
+        ret = lps22hb_sign_of_int_threshold_set(ctx, LPS22HB_BOTH);
+      }
+      if (ret == 0) {
+        ret = lps22hb_int_notification_mode_set(ctx, LPS22HB_INT_LATCHED);
+      }
+      if (ret == 0) {
+        ret = lps22hb_int_pin_mode_set(ctx, LPS22HB_EVERY_PRES_INT);
+      }
+      break;
+
+    case ST_BARO_LPS22HH:
+      ret = lps22hh_block_data_update_set(ctx, PROPERTY_ENABLE);
+      if (ret == 0) {
+        ret = lps22hh_auto_increment_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        ret = lps22hh_int_treshold_set(ctx, ths);
+      }
+      if (ret == 0) {
+        ret = lps22hh_int_on_threshold_set(ctx, LPS22HH_BOTH);
+      }
+      if (ret == 0) {
+        ret = lps22hh_int_notification_set(ctx, LPS22HH_INT_LATCHED);
+      }
+      if (ret == 0) {
+        lps22hh_ctrl_reg3_t ctrl_reg3;
+        ret = lps22hh_pin_int_route_get(ctx, &ctrl_reg3);
+        if (ret == 0) {
+          /* pressure high or low */
+          ctrl_reg3.int_s = 3;
+          ret = lps22hh_pin_int_route_set(ctx, &ctrl_reg3);
+        }
+      }
+      break;
+
+    case ST_BARO_LPS27HHW:
+      ret = lps27hhw_block_data_update_set(ctx, PROPERTY_ENABLE);
+      if (ret == 0) {
+        ret = lps27hhw_auto_increment_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        ret = lps27hhw_int_treshold_set(ctx, ths);
+      }
+      if (ret == 0) {
+        ret = lps27hhw_int_on_threshold_set(ctx, LPS27HHW_BOTH);
+      }
+      if (ret == 0) {
+        ret = lps27hhw_int_notification_set(ctx, LPS27HHW_INT_LATCHED);
+      }
+      if (ret == 0) {
+        lps27hhw_ctrl_reg3_t ctrl_reg3;
+        ret = lps27hhw_pin_int_route_get(ctx, &ctrl_reg3);
+        if (ret == 0) {
+          /* pressure high or low */
+          ctrl_reg3.int_s = 3;
+          ret = lps27hhw_pin_int_route_set(ctx, &ctrl_reg3);
+        }
+      }
+      break;
+
+    case ST_BARO_LPS33HW:
+      ret = lps33hw_block_data_update_set(ctx, PROPERTY_ENABLE);
+      if (ret == 0) {
+        ret = lps33hw_auto_add_inc_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        ret = lps33hw_int_threshold_set(ctx, buff);
+      }
+      if (ret == 0) {
+        ret = lps33hw_sign_of_int_threshold_set(ctx, LPS33HW_BOTH);
+      }
+      if (ret == 0) {
+        ret = lps33hw_int_notification_mode_set(ctx, LPS33HW_INT_LATCHED);
+      }
+      if (ret == 0) {
+        ret = lps33hw_int_pin_mode_set(ctx, LPS33HW_EVERY_PRES_INT);
+      }
+      break;
+
+    default:
+      ret = -1;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  New reference from the next conversion: reset of the
+  *         AUTOREFP function with the comparison off, then AUTOREFP and
+  *         comparison on. Two writes of the cached INTERRUPT_CFG.
+  *
+  */
+static int32_t reference_rearm(st_baro_dev *dev)
+{
+  uint8_t cfg;
+  int32_t ret;
+
+  cfg = (uint8_t)(dev->int_cfg & ~(CFG_DIFF_EN | CFG_AUTOREFP));
+  cfg |= CFG_RESET_ARP;
+  ret = dev->ctx.write_reg(dev->ctx.handle, LPS22HH_INTERRUPT_CFG, &cfg, 1);
+  if (ret == 0) {
+    ret = dev->ctx.write_reg(dev->ctx.handle, LPS22HH_INTERRUPT_CFG,
+                             &dev->int_cfg, 1);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Pressure from PRESS_OUT_XL, PRESS_OUT_L, PRESS_OUT_H.
+  *
+  */
+static float_t pressure_decode(const st_baro_dev *dev, const uint8_t *buf)
+{
+  int32_t press;
+
+  press = (int32_t)((uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+                    ((uint32_t)buf[2] << 16));
+
+  switch (dev->part) {
+    case ST_BARO_LPS22HB:
+      return lps22hb_from_lsb_to_hpa(press);
+    case ST_BARO_LPS22HH:
+      return lps22hh_from_lsb_to_hpa((uint32_t)press << 8);
+    case ST_BARO_LPS27HHW:
+      return lps27hhw_from_lsb_to_hpa(press);
+    default:
+      return lps33hw_from_lsb_to_hpa(press);
+  }
+}
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,160 @@
+/*
+ ******************************************************************************
+ * @file    baro_event.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          baro_event.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_BARO_EVENT_H
+#define ST_BARO_EVENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+/** @addtogroup Barometer event
+  * @brief    Pressure change detection on the threshold interrupt of the
+  *           pressure sensors (LPS22HB, LPS22HH, LPS27HHW, LPS33HW).
+  *
+  *           The device runs at the data rate set by the application
+  *           and compares every conversion with its reference pressure:
+  *           the interrupt pin rises only when the difference exceeds
+  *           the threshold, in either direction. The host sleeps until
+  *           then, reads interrupt source and pressure with one burst
+  *           and re-arms the reference around the new level, so its
+  *           wakeups follow the pressure (altitude) changes and not the
+  *           data rate.
+  *
+  *           The reference is taken by the device from the conversion
+  *           following the re-arm (AUTOREFP / AUTORIFP), the output
+  *           registers keep the absolute pressure.
+  * @{
+  *
+  */
+
+#ifndef MEMS_SHARED_TYPES
+#define MEMS_SHARED_TYPES
+
+typedef struct{
+  uint8_t bit0       : 1;
+  uint8_t bit1       : 1;
+  uint8_t bit2       : 1;
+  uint8_t bit3       : 1;
+  uint8_t bit4       : 1;
+  uint8_t bit5       : 1;
+  uint8_t bit6       : 1;
+  uint8_t bit7       : 1;
+} bitwise_t;
+
+#define PROPERTY_DISABLE                (0U)
+#define PROPERTY_ENABLE                 (1U)
+
+/** @addtogroup  Interfaces_Functions
+  * @brief       This section provide a set of functions used to read and
+  *              write a generic register of the device.
+  *              MANDATORY: return 0 -> no Error.
+  * @{
+  *
+  */
+
+typedef int32_t (*stmdev_write_ptr)(void *, uint8_t, uint8_t*, uint16_t);
+typedef int32_t (*stmdev_read_ptr) (void *, uint8_t, uint8_t*, uint16_t);
+
+typedef struct {
+  /** Component mandatory fields **/
+  stmdev_write_ptr  write_reg;
+  stmdev_read_ptr   read_reg;
+  /** Customizable optional pointer **/
+  void *handle;
+} stmdev_ctx_t;
+
+/**
+  * @}
+  *
+  */
+
+#endif /* MEMS_SHARED_TYPES */
+
+/** @defgroup Barometer_event_pubblic_definitions
+  * @{
+  *
+  */
+
+/* threshold limits, THS_P is 15 bit in 1/16 hPa */
+#define ST_BARO_THS_MIN_HPA      (0.0625f)
+#define ST_BARO_THS_MAX_HPA      (2047.9375f)
+
+typedef enum {
+  ST_BARO_OK = 0,
+  ST_BARO_ERR
+} st_baro_status;
+
+typedef enum {
+  ST_BARO_LPS22HB = 0,
+  ST_BARO_LPS22HH,
+  ST_BARO_LPS27HHW,
+  ST_BARO_LPS33HW,
+  ST_BARO_PART_NUM
+} st_baro_part;
+
+/**
+  * @brief  Barometer. part, ctx and threshold_hPa are set by the
+  *         application, the other fields by st_baro_init() and
+  *         st_baro_arm().
+  */
+typedef struct {
+  st_baro_part part;
+  stmdev_ctx_t ctx;
+  float_t threshold_hPa;      /* change reported, e.g. 0.12 hPa ~ 1 m */
+  float_t ref_hPa;            /* level of the last re-arm */
+  uint8_t int_cfg;            /* INTERRUPT_CFG, reference armed */
+} st_baro_dev;
+
+typedef struct {
+  uint8_t valid;              /* 1: threshold crossed, fields updated */
+  uint8_t high;               /* pressure over the reference */
+  uint8_t low;                /* pressure under the reference */
+  float_t pressure_hPa;       /* new level */
+  float_t change_hPa;         /* new level - previous level */
+} st_baro_event;
+
+/**
+  * @}
+  *
+  */
+
+st_baro_status st_baro_init(st_baro_dev *dev);
+
+st_baro_status st_baro_arm(st_baro_dev *dev);
+
+st_baro_status st_baro_event_get(st_baro_dev *dev, st_baro_event *ev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_BARO_EVENT_H */
+
+/**
+  * @}
+  *
+  */
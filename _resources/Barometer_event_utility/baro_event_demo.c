@@ -0,0 +1,354 @@
+/*
+ ******************************************************************************
+ * @file    baro_event_demo.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Event-driven barometer on a register model of the LPS22HH and
+ *          LPS22HB threshold interrupt.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Build (Linux):
+ *
+ *   gcc -O2 -I../../lps22hb_STdC/driver -I../../lps22hh_STdC/driver \
+ *       -I../../lps27hhw_STdC/driver -I../../lps33hw_STdC/driver \
+ *       baro_event.c baro_event_demo.c \
+ *       ../../lps22hb_STdC/driver/lps22hb_reg.c \
+ *       ../../lps22hh_STdC/driver/lps22hh_reg.c \
+ *       ../../lps27hhw_STdC/driver/lps27hhw_reg.c \
+ *       ../../lps33hw_STdC/driver/lps33hw_reg.c -lm -o baro_event_demo
+ *
+ * Usage:
+ *
+ *   baro_event_demo [minutes] [threshold hPa]
+ *
+ * The bus simulator utility has no pressure threshold interrupt, so the
+ * demo carries a minimal register model of the part: plain registers,
+ * plus the behaviour used by baro_event.c:
+ *
+ * - every conversion updates PRESS_OUT; with DIFF_EN set, PRESS_OUT -
+ *   REF_P over +THS_P / under -THS_P sets PH / PL and IA in INT_SOURCE
+ *   and raises the (latched) INT pin;
+ * - AUTOREFP written after RESET_ARP copies the next conversion to REF_P;
+ * - reading INT_SOURCE clears it and the pin.
+ *
+ * The pressure is generated for a person moving between the floors of a
+ * building: 25 Hz, 0.01 hPa RMS noise, weather drift of -0.5 hPa/h and,
+ * every 1 to 5 minutes, a move of 1 to 5 floors (3 m each, 0.36 hPa) at
+ * 0.3 m/s. The host services the INT pin with st_baro_event_get() at the
+ * conversion that raised it.
+ *
+ * For each part: wakeups, transactions and data bytes on the bus after
+ * st_baro_arm(), versus reading STATUS and PRESS_OUT at every conversion
+ * (streaming); crossings not reported (valid 0) and the largest distance
+ * between the reported level and the noise free pressure.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "baro_event.h"
+
+/* Private constants  --------------------------------------------------------*/
+#define REG_INTERRUPT_CFG        (0x0BU)
+#define REG_THS_P_L              (0x0CU)
+#define REG_THS_P_H              (0x0DU)
+#define REG_PRESS_OUT_XL         (0x28U)
+#define CFG_PHE                  (0x01U)
+#define CFG_PLE                  (0x02U)
+#define CFG_LIR                  (0x04U)
+#define CFG_DIFF_EN              (0x08U)
+#define CFG_RESET_ARP            (0x40U)
+#define CFG_AUTOREFP             (0x80U)
+#define SRC_PH                   (0x01U)
+#define SRC_PL                   (0x02U)
+#define SRC_IA                   (0x04U)
+
+#define ODR_HZ                   (25.0)
+#define NOISE_HPA                (0.01)
+#define DRIFT_HPA_H              (-0.5)
+#define FLOOR_M                  (3.0)
+#define SPEED_MS                 (0.3)
+#define HPA_M                    (0.12)    /* near sea level */
+#define STREAM_BYTES             (4U)      /* STATUS + PRESS_OUT */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  const char *name;
+  st_baro_part part;
+  uint8_t int_source;             /* INT_SOURCE address */
+  uint8_t reg[128];
+  int32_t ref_p;                  /* REF_P */
+  uint8_t ref_pending;            /* AUTOREFP armed, REF_P not taken */
+  uint8_t pin;                    /* INT pin level */
+  uint32_t transactions;
+  uint32_t bytes;
+} baro_model;
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t seed;
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t model_write(void *handle, uint8_t reg, uint8_t *bufp,
+                           uint16_t len);
+static int32_t model_read(void *handle, uint8_t reg, uint8_t *bufp,
+                          uint16_t len);
+static void model_convert(baro_model *model, double hpa);
+static double noise(void);
+static int run(baro_model *model, double minutes, float threshold);
+
+int main(int argc, char *argv[])
+{
+  static baro_model model[2] = {
+    { .name = "LPS22HH", .part = ST_BARO_LPS22HH, .int_source = 0x24U },
+    { .name = "LPS22HB", .part = ST_BARO_LPS22HB, .int_source = 0x25U },
+  };
+  double minutes = (argc > 1) ? atof(argv[1]) : 60.0;
+  float threshold = (argc > 2) ? (float)atof(argv[2]) : 0.25f;
+  int err = 0;
+  uint8_t i;
+
+  if ((minutes <= 0.0) || (threshold < ST_BARO_THS_MIN_HPA) ||
+      (threshold > ST_BARO_THS_MAX_HPA)) {
+    printf("usage: %s [minutes] [threshold hPa]\n", argv[0]);
+    return 1;
+  }
+
+  for (i = 0; i < 2U; i++) {
+    err |= run(&model[i], minutes, threshold);
+  }
+
+  return err;
+}
+
+/*
+ * @brief  Trace of one part: arm, then service the INT pin.
+ *
+ */
+static int run(baro_model *model, double minutes, float threshold)
+{
+  st_baro_dev dev;
+  st_baro_event ev;
+  uint32_t samples = (uint32_t)(minutes * 60.0 * ODR_HZ);
+  uint32_t wakeups = 0;
+  uint32_t stale = 0;
+  uint32_t moves = 0;
+  uint32_t k;
+  double next_move = 60.0;
+  double target = 0.0;
+  double alt = 0.0;
+  double level;
+  double err;
+  double err_max = 0.0;
+  double t;
+  int floors;
+
+  seed = 1;
+  memset(&dev, 0, sizeof(dev));
+  dev.part = model->part;
+  dev.ctx.write_reg = model_write;
+  dev.ctx.read_reg = model_read;
+  dev.ctx.handle = model;
+  dev.threshold_hPa = threshold;
+
+  if (st_baro_init(&dev) != ST_BARO_OK) {
+    return 1;
+  }
+  model_convert(model, 1013.25);
+  if (st_baro_arm(&dev) != ST_BARO_OK) {
+    return 1;
+  }
+  model->transactions = 0;
+  model->bytes = 0;
+
+  for (k = 0; k < samples; k++) {
+    t = (double)k / ODR_HZ;
+
+    if (t >= next_move) {
+      /* 1 to 5 floors, up or down (never under the ground floor) */
+      floors = 1 + (int)((seed >> 16) % 5U);
+      if ((((seed >> 20) & 0x01U) != 0U) &&
+          (target >= (FLOOR_M * (double)floors))) {
+        target -= FLOOR_M * (double)floors;
+      }
+      else {
+        target += FLOOR_M * (double)floors;
+      }
+      moves++;
+      next_move = t + 60.0 + (double)((seed >> 12) % 240U);
+    }
+    if (alt < target) {
+      alt = fmin(target, alt + (SPEED_MS / ODR_HZ));
+    }
+    else if (alt > target) {
+      alt = fmax(target, alt - (SPEED_MS / ODR_HZ));
+    }
+
+    level = 1013.25 + (DRIFT_HPA_H * t / 3600.0) - (alt * HPA_M);
+    model_convert(model, level + (NOISE_HPA * noise()));
+
+    if (model->pin != 0U) {
+      wakeups++;
+      if (st_baro_event_get(&dev, &ev) != ST_BARO_OK) {
+        return 1;
+      }
+      if (ev.valid == 0U) {
+        stale++;
+      }
+    }
+
+    err = fabs((double)dev.ref_hPa - level);
+    err_max = (err > err_max) ? err : err_max;
+  }
+
+  printf("%s %.0f Hz, %.0f min, threshold %.2f hPa, %u floor moves\n",
+         model->name, ODR_HZ, minutes, threshold, moves);
+  printf("              wakeups  transactions     bytes\n");
+  printf("  streaming  %8u  %12u  %8u\n", samples, samples,
+         samples * STREAM_BYTES);
+  printf("  baro_event %8u  %12u  %8u\n", wakeups, model->transactions,
+         model->bytes);
+  printf("  not reported %u, level error max %.3f hPa\n\n", stale,
+         err_max);
+
+  return 0;
+}
+
+/*
+ * @brief  Register write: RESET_ARP stops the reference capture,
+ *         AUTOREFP arms it for the next conversion.
+ *
+ */
+static int32_t model_write(void *handle, uint8_t reg, uint8_t *bufp,
+                           uint16_t len)
+{
+  baro_model *model = handle;
+  uint16_t i;
+  uint8_t add;
+
+  model->transactions++;
+  model->bytes += len;
+
+  for (i = 0; i < len; i++) {
+    add = (uint8_t)((reg + i) & 0x7FU);
+    model->reg[add] = bufp[i];
+
+    if (add == REG_INTERRUPT_CFG) {
+      if ((bufp[i] & CFG_RESET_ARP) != 0U) {
+        model->ref_pending = 0;
+        model->reg[add] &= (uint8_t)~(CFG_RESET_ARP | CFG_AUTOREFP);
+      }
+      else if ((bufp[i] & CFG_AUTOREFP) != 0U) {
+        model->ref_pending = 1;
+      }
+      else {
+        /* AUTOREFP off */
+      }
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * @brief  Register read: reading INT_SOURCE clears the latched interrupt.
+ *
+ */
+static int32_t model_read(void *handle, uint8_t reg, uint8_t *bufp,
+                          uint16_t len)
+{
+  baro_model *model = handle;
+  uint16_t i;
+  uint8_t add;
+
+  model->transactions++;
+  model->bytes += len;
+
+  for (i = 0; i < len; i++) {
+    add = (uint8_t)((reg + i) & 0x7FU);
+    bufp[i] = model->reg[add];
+
+    if (add == model->int_source) {
+      model->reg[add] = 0;
+      model->pin = 0;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * @brief  End of a conversion: output registers, reference capture and
+ *         threshold comparison.
+ *
+ */
+static void model_convert(baro_model *model, double hpa)
+{
+  int32_t p = (int32_t)lround(hpa * 4096.0);
+  uint8_t cfg = model->reg[REG_INTERRUPT_CFG];
+  int32_t ths;
+  uint8_t src = 0;
+
+  model->reg[REG_PRESS_OUT_XL] = (uint8_t)p;
+  model->reg[REG_PRESS_OUT_XL + 1U] = (uint8_t)(p >> 8);
+  model->reg[REG_PRESS_OUT_XL + 2U] = (uint8_t)(p >> 16);
+
+  if (model->ref_pending != 0U) {
+    model->ref_p = p;
+    model->ref_pending = 0;
+  }
+
+  if ((cfg & CFG_DIFF_EN) != 0U) {
+    ths = (int32_t)((uint32_t)model->reg[REG_THS_P_L] |
+                    ((uint32_t)model->reg[REG_THS_P_H] << 8)) * 256;
+    if (((cfg & CFG_PHE) != 0U) && ((p - model->ref_p) > ths)) {
+      src |= SRC_PH;
+    }
+    if (((cfg & CFG_PLE) != 0U) && ((p - model->ref_p) < -ths)) {
+      src |= SRC_PL;
+    }
+  }
+
+  if (src != 0U) {
+    model->reg[model->int_source] |= (uint8_t)(src | SRC_IA);
+    model->pin = 1;
+  }
+  else if ((cfg & CFG_LIR) == 0U) {
+    /* pulsed: the pin follows the comparison */
+    model->pin = 0;
+  }
+  else {
+    /* latched until INT_SOURCE is read */
+  }
+}
+
+/*
+ * @brief  Gaussian noise, unit variance (Box-Muller on a LCG), also
+ *         advancing the seed used by the floor moves.
+ *
+ */
+static double noise(void)
+{
+  double u;
+  double v;
+
+  seed = (seed * 1103515245U) + 12345U;
+  u = ((double)(seed >> 8) + 1.0) / 16777217.0;
+  seed = (seed * 1103515245U) + 12345U;
+  v = ((double)(seed >> 8) + 1.0) / 16777217.0;
+
+  return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
@@ -0,0 +1,693 @@
+/*
+ ******************************************************************************
+ * @file    bus_simulator.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Simulated I2C / SPI bus with sensor device models.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "bus_simulator.h"
+
+/**
+  * @defgroup  Bus simulator
+  * @brief     This file provides a simulated sensor bus with time, data
+  *            rate and interrupt models.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+#define EVENT_QUEUE_LEN          (256U)
+#define FIFO_DEPTH_MAX           (1023U)
+#define FIFO_TAGGED_WORD         (7U)
+#define FIFO_RAW_WORD            (6U)
+#define FIFO_OVR_FLAG            (0x40U)
+#define FIFO_WTM_FLAG            (0x80U)
+
+/* I2C frame bits: start, address + ACK, register + ACK, stop */
+#define I2C_WRITE_BITS           (20U)
+/* I2C frame bits: as write, plus repeated start and address + ACK */
+#define I2C_READ_BITS            (30U)
+/* SPI frame bits: register (R/W bit included) */
+#define SPI_BITS                 (8U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  st_bus_sim_dev_cfg cfg;
+  st_bus_sim *sim;
+  uint16_t idx;
+  uint8_t reg[256];
+  uint8_t word_len;               /* FIFO word length, 0: no FIFO */
+  uint8_t *fifo;                  /* fifo_depth words */
+  uint16_t fifo_head;
+  uint16_t fifo_level;
+  uint8_t fifo_ovr;               /* overrun since last word read */
+  uint8_t drdy;                   /* output registers not read */
+  float_t odr_hz;
+  uint64_t odr_start_ns;          /* data rate set */
+  uint64_t odr_tick;              /* samples since odr_start_ns */
+  uint64_t next_ns;               /* next sample */
+  uint32_t sample_index;
+  st_bus_sim_dev_stats stats;
+} sim_dev;
+
+struct st_bus_sim_s {
+  st_bus_sim_cfg cfg;
+  uint16_t dev_num;
+  sim_dev *dev;
+  uint64_t now_ns;
+  uint64_t busy_ns;
+  uint32_t transactions;
+  uint32_t events_lost;
+  st_bus_sim_event event[EVENT_QUEUE_LEN];
+  uint16_t event_head;
+  uint16_t event_num;
+};
+
+/* Private functions ---------------------------------------------------------*/
+/*  Functions declare in this section are defined at the end of this file.    */
+static void odr_apply(sim_dev *d, float_t odr_hz, uint64_t now_ns);
+static void advance(st_bus_sim *sim, uint64_t t_ns);
+static void sample_produce(sim_dev *d);
+static void event_push(st_bus_sim *sim, sim_dev *d, uint8_t line,
+                       st_bus_sim_ev_type type);
+static uint8_t reg_read(sim_dev *d, uint8_t add, uint8_t *next);
+static uint64_t transaction(sim_dev *d, uint8_t read, uint16_t len);
+static int32_t sim_write(void *handle, uint8_t reg, uint8_t *data,
+                         uint16_t len);
+static int32_t sim_read(void *handle, uint8_t reg, uint8_t *data,
+                        uint16_t len);
+
+/**
+  * @defgroup  Bus_simulator_pubblic_functions
+  * @brief     This section provide the APIs of the bus simulator.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Create a simulated bus with its devices, time starts at 0 ns.
+  *
+  * @param  sim               simulator handle.(ptr)
+  * @param  cfg               bus configuration.(ptr)
+  * @param  dev_cfg           device models, dev_num entries (devices
+  *                           are identified by their index).(ptr)
+  * @param  dev_num           number of devices.
+  *
+  * @retval st_bus_sim_status ST_BUS_SIM_OK / ST_BUS_SIM_ERR
+  *
+  */
+st_bus_sim_status st_bus_sim_init(st_bus_sim **sim,
+                                  const st_bus_sim_cfg *cfg,
+                                  const st_bus_sim_dev_cfg *dev_cfg,
+                                  uint16_t dev_num)
+{
+  st_bus_sim *s;
+  sim_dev *d;
+  uint16_t i;
+  uint16_t j;
+
+  if ((cfg->clock_hz == 0U) || (dev_num == 0U)) {
+    return ST_BUS_SIM_ERR;
+  }
+
+  for (i = 0; i < dev_num; i++) {
+    if ((dev_cfg[i].odr_hz < 0.0f) ||
+        ((dev_cfg[i].fifo_type != ST_BUS_SIM_FIFO_NONE) &&
+         ((dev_cfg[i].fifo_depth == 0U) ||
+          (dev_cfg[i].fifo_depth > FIFO_DEPTH_MAX)))) {
+      return ST_BUS_SIM_ERR;
+    }
+
+    for (j = 0; j < i; j++) {
+      if (dev_cfg[j].add == dev_cfg[i].add) {
+        return ST_BUS_SIM_ERR;
+      }
+    }
+  }
+
+  s = calloc(1, sizeof(st_bus_sim));
+  if (s == NULL) {
+    return ST_BUS_SIM_ERR;
+  }
+
+  s->dev = calloc(dev_num, sizeof(sim_dev));
+  if (s->dev == NULL) {
+    free(s);
+    return ST_BUS_SIM_ERR;
+  }
+
+  s->cfg = *cfg;
+  s->dev_num = dev_num;
+
+  for (i = 0; i < dev_num; i++) {
+    d = &s->dev[i];
+    d->cfg = dev_cfg[i];
+    d->sim = s;
+    d->idx = i;
+    d->reg[d->cfg.who_am_i_reg] = d->cfg.who_am_i;
+
+    if (d->cfg.fifo_type == ST_BUS_SIM_FIFO_TAGGED) {
+      d->word_len = FIFO_TAGGED_WORD;
+    }
+    else if (d->cfg.fifo_type == ST_BUS_SIM_FIFO_RAW) {
+      d->word_len = FIFO_RAW_WORD;
+    }
+    else {
+      d->word_len = 0;
+    }
+
+    if (d->word_len != 0U) {
+      d->fifo = malloc((size_t)d->cfg.fifo_depth * d->word_len);
+      if (d->fifo == NULL) {
+        st_bus_sim_deinit(s);
+        return ST_BUS_SIM_ERR;
+      }
+    }
+
+    odr_apply(d, d->cfg.odr_hz, 0);
+  }
+
+  *sim = s;
+
+  return ST_BUS_SIM_OK;
+}
+
+/**
+  * @brief  Free a simulated bus.
+  *
+  * @param  sim               simulator handle.(ptr)
+  *
+  */
+void st_bus_sim_deinit(st_bus_sim *sim)
+{
+  uint16_t i;
+
+  for (i = 0; i < sim->dev_num; i++) {
+    free(sim->dev[i].fifo);
+  }
+
+  free(sim->dev);
+  free(sim);
+}
+
+/**
+  * @brief  Driver context of a device: every read_reg / write_reg is a
+  *         bus transaction that advances the simulated time.
+  *
+  * @param  sim               simulator handle.(ptr)
+  * @param  dev               device index.
+  * @param  ctx               driver context.(ptr)
+  *
+  * @retval st_bus_sim_status ST_BUS_SIM_OK / ST_BUS_SIM_ERR
+  *
+  */
+st_bus_sim_status st_bus_sim_ctx_get(st_bus_sim *sim, uint16_t dev,
+                                     stmdev_ctx_t *ctx)
+{
+  if (dev >= sim->dev_num) {
+    return ST_BUS_SIM_ERR;
+  }
+
+  ctx->write_reg = sim_write;
+  ctx->read_reg = sim_read;
+  ctx->handle = &sim->dev[dev];
+
+  return ST_BUS_SIM_OK;
+}
+
+/**
+  * @brief  Change the data rate of a device, the first sample comes one
+  *         period after the change (e.g. from a register write hook).
+  *
+  * @param  sim               simulator handle.(ptr)
+  * @param  dev               device index.
+  * @param  odr_hz            data rate, 0: power down.
+  *
+  * @retval st_bus_sim_status ST_BUS_SIM_OK / ST_BUS_SIM_ERR
+  *
+  */
+st_bus_sim_status st_bus_sim_odr_set(st_bus_sim *sim, uint16_t dev,
+                                     float_t odr_hz)
+{
+  if ((dev >= sim->dev_num) || (odr_hz < 0.0f)) {
+    return ST_BUS_SIM_ERR;
+  }
+
+  if (sim->dev[dev].odr_hz != odr_hz) {
+    advance(sim, sim->now_ns);
+    odr_apply(&sim->dev[dev], odr_hz, sim->now_ns);
+  }
+
+  return ST_BUS_SIM_OK;
+}
+
+/**
+  * @brief  Simulated time.
+  *
+  * @param  sim               simulator handle.(ptr)
+  *
+  * @retval uint64_t          time in ns.
+  *
+  */
+uint64_t st_bus_sim_now(st_bus_sim *sim)
+{
+  return sim->now_ns;
+}
+
+/**
+  * @brief  Let the simulated time run (host busy or sleeping), the
+  *         events raised meanwhile are returned by st_bus_sim_wait().
+  *
+  * @param  sim               simulator handle.(ptr)
+  * @param  ns                delay in ns.
+  *
+  */
+void st_bus_sim_delay(st_bus_sim *sim, uint64_t ns)
+{
+  sim->now_ns += ns;
+  advance(sim, sim->now_ns);
+}
+
+/**
+  * @brief  Wait for an interrupt event: the oldest event already raised
+  *         is returned at once, otherwise the time moves to the next
+  *         event, or by timeout_ns (event type ST_BUS_SIM_EV_TIMEOUT).
+  *
+  * @param  sim               simulator handle.(ptr)
+  * @param  timeout_ns        max wait in ns.
+  * @param  event             interrupt event.(ptr)
+  *
+  * @retval st_bus_sim_status ST_BUS_SIM_OK / ST_BUS_SIM_ERR (no device
+  *                           can raise events before the timeout)
+  *
+  */
+st_bus_sim_status st_bus_sim_wait(st_bus_sim *sim, uint64_t timeout_ns,
+                                  st_bus_sim_event *event)
+{
+  uint64_t deadline = sim->now_ns + timeout_ns;
+  uint64_t next;
+  uint16_t i;
+  uint8_t irq;
+
+  advance(sim, sim->now_ns);
+
+  while ((sim->event_num == 0U) && (sim->now_ns < deadline)) {
+
+    /* next sample of a device with interrupts */
+    next = deadline;
+    irq = 0;
+    for (i = 0; i < sim->dev_num; i++) {
+      if ((sim->dev[i].odr_hz > 0.0f) &&
+          ((sim->dev[i].cfg.int_drdy != 0U) ||
+           (sim->dev[i].cfg.int_fifo != 0U))) {
+        irq = 1;
+        next = (sim->dev[i].next_ns < next) ? sim->dev[i].next_ns : next;
+      }
+    }
+
+    sim->now_ns = (next > sim->now_ns) ? next : sim->now_ns;
+    advance(sim, sim->now_ns);
+
+    if ((irq == 0U) && (sim->event_num == 0U)) {
+      sim->now_ns = deadline;
+      advance(sim, sim->now_ns);
+      event->time_ns = sim->now_ns;
+      event->type = ST_BUS_SIM_EV_TIMEOUT;
+      return ST_BUS_SIM_ERR;
+    }
+  }
+
+  if (sim->event_num == 0U) {
+    event->time_ns = sim->now_ns;
+    event->dev = 0;
+    event->line = 0;
+    event->type = ST_BUS_SIM_EV_TIMEOUT;
+  }
+  else {
+    *event = sim->event[sim->event_head];
+    sim->event_head = (sim->event_head + 1U) % EVENT_QUEUE_LEN;
+    sim->event_num--;
+  }
+
+  return ST_BUS_SIM_OK;
+}
+
+/**
+  * @brief  Bus statistics.
+  *
+  * @param  sim               simulator handle.(ptr)
+  * @param  stats             bus statistics.(ptr)
+  *
+  */
+void st_bus_sim_stats_get(st_bus_sim *sim, st_bus_sim_stats *stats)
+{
+  stats->now_ns = sim->now_ns;
+  stats->busy_ns = sim->busy_ns;
+  stats->utilization = (sim->now_ns == 0U) ? 0.0f :
+                       (float_t)((double)sim->busy_ns / (double)sim->now_ns);
+  stats->transactions = sim->transactions;
+  stats->events_lost = sim->events_lost;
+}
+
+/**
+  * @brief  Device statistics.
+  *
+  * @param  sim               simulator handle.(ptr)
+  * @param  dev               device index.
+  * @param  stats             device statistics.(ptr)
+  *
+  * @retval st_bus_sim_status ST_BUS_SIM_OK / ST_BUS_SIM_ERR
+  *
+  */
+st_bus_sim_status st_bus_sim_dev_stats_get(st_bus_sim *sim, uint16_t dev,
+                                           st_bus_sim_dev_stats *stats)
+{
+  if (dev >= sim->dev_num) {
+    return ST_BUS_SIM_ERR;
+  }
+
+  advance(sim, sim->now_ns);
+  *stats = sim->dev[dev].stats;
+
+  return ST_BUS_SIM_OK;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  Bus simulator private functions
+  * @brief     This section provide a set of private low-level functions
+  *            used by pubblic APIs.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Set the data rate of a device from now_ns.
+  *
+  */
+static void odr_apply(sim_dev *d, float_t odr_hz, uint64_t now_ns)
+{
+  d->odr_hz = odr_hz;
+  d->odr_start_ns = now_ns;
+  d->odr_tick = 1;
+  d->next_ns = (odr_hz > 0.0f) ?
+               (now_ns + (uint64_t)(1e9 / (double)odr_hz)) : UINT64_MAX;
+}
+
+/**
+  * @brief  Produce the samples of all devices up to t_ns, in time order
+  *         (events are queued in time order).
+  *
+  */
+static void advance(st_bus_sim *sim, uint64_t t_ns)
+{
+  sim_dev *next;
+  uint16_t i;
+
+  do {
+    next = NULL;
+    for (i = 0; i < sim->dev_num; i++) {
+      if ((sim->dev[i].next_ns <= t_ns) &&
+          ((next == NULL) || (sim->dev[i].next_ns < next->next_ns))) {
+        next = &sim->dev[i];
+      }
+    }
+
+    if (next != NULL) {
+      sample_produce(next);
+      next->odr_tick++;
+      next->next_ns = next->odr_start_ns +
+                      (uint64_t)(((double)next->odr_tick * 1e9) /
+                                 (double)next->odr_hz);
+    }
+  } while (next != NULL);
+}
+
+/**
+  * @brief  New sample: output registers, data ready and FIFO.
+  *
+  */
+static void sample_produce(sim_dev *d)
+{
+  uint8_t data[6];
+  uint8_t *word;
+  uint8_t tag;
+  uint8_t ones;
+  uint8_t i;
+  int16_t val;
+
+  if (d->cfg.gen != NULL) {
+    d->cfg.gen(d->idx, d->sample_index, data, d->cfg.arg);
+  }
+  else {
+    val = (int16_t)d->sample_index;
+    data[0] = (uint8_t)val;
+    data[1] = (uint8_t)((uint16_t)val >> 8);
+    val = (int16_t)(-val);
+    data[2] = (uint8_t)val;
+    data[3] = (uint8_t)((uint16_t)val >> 8);
+    data[4] = (uint8_t)d->idx;
+    data[5] = (uint8_t)(d->idx >> 8);
+  }
+
+  d->stats.samples++;
+
+  /* output registers */
+  if (d->drdy != 0U) {
+    d->stats.samples_lost++;
+  }
+  for (i = 0; i < 6U; i++) {
+    d->reg[(uint8_t)(d->cfg.out_reg + i)] = data[i];
+  }
+  d->reg[d->cfg.status_reg] |= d->cfg.drdy_mask;
+  d->drdy = 1;
+
+  if (d->cfg.int_drdy != 0U) {
+    event_push(d->sim, d, d->cfg.int_drdy, ST_BUS_SIM_EV_DRDY);
+  }
+
+  /* FIFO, stream mode: the oldest word is lost when full */
+  if (d->word_len != 0U) {
+
+    if (d->fifo_level == d->cfg.fifo_depth) {
+      d->fifo_head = (d->fifo_head + 1U) % d->cfg.fifo_depth;
+      d->fifo_level--;
+      d->stats.fifo_overrun++;
+      if ((d->fifo_ovr == 0U) && (d->cfg.int_fifo != 0U)) {
+        event_push(d->sim, d, d->cfg.int_fifo, ST_BUS_SIM_EV_FIFO_OVR);
+      }
+      d->fifo_ovr = 1;
+    }
+
+    word = &d->fifo[((d->fifo_head + d->fifo_level) % d->cfg.fifo_depth) *
+                    d->word_len];
+
+    if (d->word_len == FIFO_TAGGED_WORD) {
+      /* sensor tag, tag counter, parity (even number of bits set) */
+      tag = (uint8_t)((d->cfg.fifo_tag << 3) |
+                      ((d->sample_index & 0x03U) << 1));
+      ones = 0;
+      for (i = 0; i < 8U; i++) {
+        ones += (tag >> i) & 0x01U;
+      }
+      word[0] = (uint8_t)(tag | (ones & 0x01U));
+      memcpy(&word[1], data, 6);
+    }
+    else {
+      memcpy(word, data, 6);
+    }
+
+    d->fifo_level++;
+    if (d->fifo_level > d->stats.fifo_level_max) {
+      d->stats.fifo_level_max = d->fifo_level;
+    }
+
+    if ((d->cfg.fifo_wtm != 0U) && (d->fifo_level == d->cfg.fifo_wtm) &&
+        (d->cfg.int_fifo != 0U)) {
+      event_push(d->sim, d, d->cfg.int_fifo, ST_BUS_SIM_EV_FIFO_WTM);
+    }
+  }
+
+  d->sample_index++;
+}
+
+/**
+  * @brief  Queue an interrupt event at the time of the sample.
+  *
+  */
+static void event_push(st_bus_sim *sim, sim_dev *d, uint8_t line,
+                       st_bus_sim_ev_type type)
+{
+  st_bus_sim_event *ev;
+
+  if (sim->event_num == EVENT_QUEUE_LEN) {
+    sim->events_lost++;
+  }
+  else {
+    ev = &sim->event[(sim->event_head + sim->event_num) % EVENT_QUEUE_LEN];
+    ev->time_ns = d->next_ns;
+    ev->dev = d->idx;
+    ev->line = line;
+    ev->type = type;
+    sim->event_num++;
+  }
+}
+
+/**
+  * @brief  Read one register, next is the register read after it.
+  *
+  */
+static uint8_t reg_read(sim_dev *d, uint8_t add, uint8_t *next)
+{
+  uint8_t off = (uint8_t)(add - d->cfg.fifo_out_reg);
+  uint8_t val;
+
+  *next = (uint8_t)(add + 1U);
+
+  if ((d->word_len != 0U) && (off < d->word_len)) {
+    /* FIFO word, the address rolls back at the end of the word */
+    val = 0;
+    if (d->fifo_level > 0U) {
+      val = d->fifo[(d->fifo_head * d->word_len) + off];
+      if (off == (d->word_len - 1U)) {
+        d->fifo_head = (d->fifo_head + 1U) % d->cfg.fifo_depth;
+        d->fifo_level--;
+        d->fifo_ovr = 0;
+        d->stats.fifo_words_read++;
+      }
+    }
+    if (off == (d->word_len - 1U)) {
+      *next = d->cfg.fifo_out_reg;
+    }
+  }
+  else if ((d->word_len != 0U) && (add == d->cfg.fifo_status_reg)) {
+    val = (uint8_t)d->fifo_level;
+  }
+  else if ((d->word_len != 0U) &&
+           (add == (uint8_t)(d->cfg.fifo_status_reg + 1U))) {
+    val = (uint8_t)((d->fifo_level >> 8) & 0x03U);
+    val |= (d->fifo_ovr != 0U) ? FIFO_OVR_FLAG : 0U;
+    val |= ((d->cfg.fifo_wtm != 0U) &&
+            (d->fifo_level >= d->cfg.fifo_wtm)) ? FIFO_WTM_FLAG : 0U;
+  }
+  else {
+    val = d->reg[add];
+    if ((uint8_t)(add - d->cfg.out_reg) < 6U) {
+      d->reg[d->cfg.status_reg] &= (uint8_t)~d->cfg.drdy_mask;
+      d->drdy = 0;
+    }
+  }
+
+  return val;
+}
+
+/**
+  * @brief  Account a transaction of len data bytes, return its duration.
+  *
+  */
+static uint64_t transaction(sim_dev *d, uint8_t read, uint16_t len)
+{
+  st_bus_sim *sim = d->sim;
+  uint64_t bits;
+  uint64_t busy;
+
+  if (sim->cfg.type == ST_BUS_SIM_I2C) {
+    bits = ((read != 0U) ? I2C_READ_BITS : I2C_WRITE_BITS) + (9U * len);
+    busy = ((bits * 1000000000U) / sim->cfg.clock_hz) + d->cfg.stretch_ns;
+  }
+  else {
+    bits = SPI_BITS + (8U * len);
+    busy = ((bits * 1000000000U) / sim->cfg.clock_hz) + sim->cfg.cs_ns;
+  }
+
+  sim->busy_ns += busy;
+  sim->transactions++;
+  d->stats.transactions++;
+  d->stats.bytes += len;
+  d->stats.busy_ns += busy;
+
+  return busy + sim->cfg.host_ns;
+}
+
+/**
+  * @brief  Driver write: registers are written at the transaction start.
+  *
+  */
+static int32_t sim_write(void *handle, uint8_t reg, uint8_t *data,
+                         uint16_t len)
+{
+  sim_dev *d = handle;
+  st_bus_sim *sim = d->sim;
+  uint64_t duration;
+  uint16_t i;
+  uint8_t add = reg;
+
+  advance(sim, sim->now_ns);
+  duration = transaction(d, 0, len);
+
+  for (i = 0; i < len; i++) {
+    d->reg[add] = data[i];
+    if (d->cfg.write_hook != NULL) {
+      d->cfg.write_hook(sim, d->idx, add, data[i], d->cfg.arg);
+    }
+    add++;
+  }
+
+  sim->now_ns += duration;
+
+  return 0;
+}
+
+/**
+  * @brief  Driver read: registers are read at the transaction start.
+  *
+  */
+static int32_t sim_read(void *handle, uint8_t reg, uint8_t *data,
+                        uint16_t len)
+{
+  sim_dev *d = handle;
+  st_bus_sim *sim = d->sim;
+  uint64_t duration;
+  uint16_t i;
+  uint8_t add = reg;
+
+  advance(sim, sim->now_ns);
+  duration = transaction(d, 1, len);
+
+  for (i = 0; i < len; i++) {
+    data[i] = reg_read(d, add, &add);
+  }
+
+  sim->now_ns += duration;
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
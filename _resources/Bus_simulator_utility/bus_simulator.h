@@ -0,0 +1,250 @@
+/*
+ ******************************************************************************
+ * @file    bus_simulator.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          bus_simulator.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_BUS_SIM_H
+#define ST_BUS_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <math.h>
+
+/** @addtogroup Bus simulator
+  * @brief    Host side (Linux) simulation of an I2C or SPI bus with
+  *           several sensors, to compare bus scheduling, batching and
+  *           FIFO drain strategies without hardware.
+  *
+  *           Time is simulated (ns): every transaction takes the time
+  *           of its bits at the bus clock, plus the clock stretching of
+  *           the device (I2C), the chip select setup / hold (SPI) and a
+  *           host overhead (driver, DMA setup). Devices produce samples
+  *           at their data rate: output registers and data ready flag
+  *           are updated and, with a FIFO, a word is stored (the oldest
+  *           word is lost when the FIFO is full). Data ready, FIFO
+  *           watermark and FIFO overrun are signalled as interrupt
+  *           events, st_bus_sim_wait() moves the time to the next one.
+  *           Events are the rising edges of the lines: the watermark
+  *           event comes when the FIFO level reaches the watermark, so
+  *           the FIFO must be drained below it to get the next one.
+  *
+  *           Every device has its own driver context (stmdev_ctx_t), so
+  *           the xxx_reg.c APIs run on the simulated devices.
+  * @{
+  *
+  */
+
+#ifndef MEMS_SHARED_TYPES
+#define MEMS_SHARED_TYPES
+
+typedef struct{
+  uint8_t bit0       : 1;
+  uint8_t bit1       : 1;
+  uint8_t bit2       : 1;
+  uint8_t bit3       : 1;
+  uint8_t bit4       : 1;
+  uint8_t bit5       : 1;
+  uint8_t bit6       : 1;
+  uint8_t bit7       : 1;
+} bitwise_t;
+
+#define PROPERTY_DISABLE                (0U)
+#define PROPERTY_ENABLE                 (1U)
+
+/** @addtogroup  Interfaces_Functions
+  * @brief       This section provide a set of functions used to read and
+  *              write a generic register of the device.
+  *              MANDATORY: return 0 -> no Error.
+  * @{
+  *
+  */
+
+typedef int32_t (*stmdev_write_ptr)(void *, uint8_t, uint8_t*, uint16_t);
+typedef int32_t (*stmdev_read_ptr) (void *, uint8_t, uint8_t*, uint16_t);
+
+typedef struct {
+  /** Component mandatory fields **/
+  stmdev_write_ptr  write_reg;
+  stmdev_read_ptr   read_reg;
+  /** Customizable optional pointer **/
+  void *handle;
+} stmdev_ctx_t;
+
+/**
+  * @}
+  *
+  */
+
+#endif /* MEMS_SHARED_TYPES */
+
+/** @defgroup Bus_simulator_pubblic_definitions
+  * @{
+  *
+  */
+
+typedef enum {
+  ST_BUS_SIM_OK = 0,
+  ST_BUS_SIM_ERR
+} st_bus_sim_status;
+
+typedef enum {
+  ST_BUS_SIM_I2C = 0,
+  ST_BUS_SIM_SPI
+} st_bus_sim_type;
+
+typedef enum {
+  ST_BUS_SIM_FIFO_NONE = 0,
+  ST_BUS_SIM_FIFO_TAGGED,         /* tag + 6 bytes (LSM6DSOX family) */
+  ST_BUS_SIM_FIFO_RAW             /* output registers only */
+} st_bus_sim_fifo_type;
+
+typedef enum {
+  ST_BUS_SIM_EV_DRDY = 0,
+  ST_BUS_SIM_EV_FIFO_WTM,
+  ST_BUS_SIM_EV_FIFO_OVR,
+  ST_BUS_SIM_EV_TIMEOUT           /* st_bus_sim_wait() only */
+} st_bus_sim_ev_type;
+
+typedef struct st_bus_sim_s st_bus_sim;
+
+typedef struct {
+  st_bus_sim_type type;
+  uint32_t clock_hz;              /* SCL / SCK frequency */
+  uint32_t host_ns;               /* host overhead per transaction */
+  uint32_t cs_ns;                 /* SPI chip select setup + hold */
+} st_bus_sim_cfg;
+
+/**
+  * @brief  Sample generator: 6 bytes for sample index of device dev.
+  *         NULL: x = index, y = -index, z = dev (little endian).
+  */
+typedef void (*st_bus_sim_gen_ptr)(uint16_t dev, uint32_t index,
+                                   uint8_t data[6], void *arg);
+
+/**
+  * @brief  Register write hook, called after the register is stored,
+  *         e.g. to decode the data rate with st_bus_sim_odr_set().
+  */
+typedef void (*st_bus_sim_write_ptr)(st_bus_sim *sim, uint16_t dev,
+                                     uint8_t reg, uint8_t val, void *arg);
+
+/**
+  * @brief  Device model. Registers not listed here are plain read /
+  *         write registers (initial value 0, who_am_i_reg excepted);
+  *         multi byte accesses always increment the register address.
+  *
+  *         FIFO status registers (2 bytes, as LSM6DSOX FIFO_STATUS1/2):
+  *         level[7:0]; level[9:8], overrun 0x40, watermark 0x80.
+  *         Reading the FIFO word registers from fifo_out_reg returns
+  *         the oldest word, the address rolls back to fifo_out_reg at
+  *         the end of every word so a whole batch is read in one burst.
+  */
+typedef struct {
+  uint8_t add;                    /* I2C 7 bit address / SPI chip select */
+  uint8_t who_am_i_reg;
+  uint8_t who_am_i;
+  uint32_t stretch_ns;            /* I2C clock stretching / transaction */
+  float_t odr_hz;                 /* data rate, 0: power down */
+  uint8_t status_reg;             /* data ready flag register */
+  uint8_t drdy_mask;              /* cleared reading the output registers */
+  uint8_t out_reg;                /* output registers (6 bytes) */
+  st_bus_sim_fifo_type fifo_type;
+  uint16_t fifo_depth;            /* FIFO words (max 1023) */
+  uint16_t fifo_wtm;              /* watermark, 0: no watermark */
+  uint8_t fifo_out_reg;           /* first FIFO word register */
+  uint8_t fifo_status_reg;        /* FIFO status registers */
+  uint8_t fifo_tag;               /* sensor tag of the tagged FIFO */
+  uint8_t int_drdy;               /* data ready line: 0 none, 1, 2 */
+  uint8_t int_fifo;               /* FIFO wtm / overrun line: 0 none, 1, 2 */
+  st_bus_sim_gen_ptr gen;
+  st_bus_sim_write_ptr write_hook;
+  void *arg;                      /* gen / write_hook argument */
+} st_bus_sim_dev_cfg;
+
+typedef struct {
+  uint64_t time_ns;
+  uint16_t dev;
+  uint8_t line;                   /* interrupt line, 1 or 2 */
+  st_bus_sim_ev_type type;
+} st_bus_sim_event;
+
+typedef struct {
+  uint64_t now_ns;                /* simulated time */
+  uint64_t busy_ns;               /* bus busy time */
+  float_t utilization;            /* busy / now */
+  uint32_t transactions;
+  uint32_t events_lost;           /* event queue full */
+} st_bus_sim_stats;
+
+typedef struct {
+  uint32_t transactions;
+  uint32_t bytes;                 /* data bytes read / written */
+  uint64_t busy_ns;
+  uint32_t samples;               /* produced by the device */
+  uint32_t samples_lost;          /* output registers overwritten before
+                                   * being read */
+  uint32_t fifo_words_read;
+  uint32_t fifo_overrun;          /* FIFO words lost */
+  uint16_t fifo_level_max;
+} st_bus_sim_dev_stats;
+
+/**
+  * @}
+  *
+  */
+
+st_bus_sim_status st_bus_sim_init(st_bus_sim **sim,
+                                  const st_bus_sim_cfg *cfg,
+                                  const st_bus_sim_dev_cfg *dev_cfg,
+                                  uint16_t dev_num);
+
+void st_bus_sim_deinit(st_bus_sim *sim);
+
+st_bus_sim_status st_bus_sim_ctx_get(st_bus_sim *sim, uint16_t dev,
+                                     stmdev_ctx_t *ctx);
+
+st_bus_sim_status st_bus_sim_odr_set(st_bus_sim *sim, uint16_t dev,
+                                     float_t odr_hz);
+
+uint64_t st_bus_sim_now(st_bus_sim *sim);
+
+void st_bus_sim_delay(st_bus_sim *sim, uint64_t ns);
+
+st_bus_sim_status st_bus_sim_wait(st_bus_sim *sim, uint64_t timeout_ns,
+                                  st_bus_sim_event *event);
+
+void st_bus_sim_stats_get(st_bus_sim *sim, st_bus_sim_stats *stats);
+
+st_bus_sim_status st_bus_sim_dev_stats_get(st_bus_sim *sim, uint16_t dev,
+                                           st_bus_sim_dev_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_BUS_SIM_H */
+
+/**
+  * @}
+  *
+  */
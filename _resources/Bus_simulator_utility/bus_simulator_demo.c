@@ -0,0 +1,250 @@
+/*
+ ******************************************************************************
+ * @file    bus_simulator_demo.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Comparison of sample read strategies on the simulated bus.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Build (Linux):
+ *
+ *   gcc -O2 bus_simulator.c bus_simulator_demo.c -o bus_simulator_demo
+ *
+ * Usage:
+ *
+ *   bus_simulator_demo [simulated seconds]
+ *
+ * Accelerometers with the LSM6DSOX register map (tagged FIFO) are read
+ * for every bus / data rate configuration with three strategies, all
+ * driven by the interrupt events:
+ *
+ * - drdy:  data ready interrupt, output registers read (1 transaction
+ *          per sample);
+ * - word:  FIFO watermark interrupt, FIFO status read, then tag and
+ *          data of every word (2 transactions per sample);
+ * - burst: FIFO watermark interrupt, FIFO status read, then all the
+ *          words in one transaction.
+ *
+ * For each run: bus utilization, samples received versus produced,
+ * samples lost (output registers overwritten or FIFO overrun) and gaps
+ * found in the received sample sequence.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "bus_simulator.h"
+
+/* Private constants  --------------------------------------------------------*/
+#define LSM6DSOX_WHO_AM_I        (0x0FU)
+#define LSM6DSOX_ID              (0x6CU)
+#define LSM6DSOX_STATUS_REG      (0x1EU)
+#define LSM6DSOX_OUTX_L_A        (0x28U)
+#define LSM6DSOX_FIFO_STATUS1    (0x3AU)
+#define LSM6DSOX_FIFO_DATA_OUT_TAG (0x78U)
+#define TAG_XL                   (0x02U)
+
+#define DEV_MAX                  (8U)
+#define FIFO_DEPTH               (512U)
+#define FIFO_WTM                 (32U)
+#define FIFO_WORD                (7U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+  READ_DRDY = 0,
+  READ_FIFO_WORD,
+  READ_FIFO_BURST
+} read_mode;
+
+typedef struct {
+  const char *name;
+  st_bus_sim_type type;
+  uint32_t clock_hz;
+  uint16_t dev_num;
+  float_t odr_hz;
+} scenario;
+
+/* Private variables ---------------------------------------------------------*/
+static const scenario scenarios[] = {
+  { "I2C  400 kHz", ST_BUS_SIM_I2C,   400000U, 2,  416.0f },
+  { "I2C  400 kHz", ST_BUS_SIM_I2C,   400000U, 2, 1666.0f },
+  { "I2C  400 kHz", ST_BUS_SIM_I2C,   400000U, 2, 6667.0f },
+  { "I2C 1000 kHz", ST_BUS_SIM_I2C,  1000000U, 2, 6667.0f },
+  { "SPI   10 MHz", ST_BUS_SIM_SPI, 10000000U, 8, 1666.0f },
+  { "SPI   10 MHz", ST_BUS_SIM_SPI, 10000000U, 8, 6667.0f },
+};
+
+static const char *mode_name[] = { "drdy", "word", "burst" };
+
+static uint8_t buff[FIFO_DEPTH * FIFO_WORD];
+
+/* Private functions ---------------------------------------------------------*/
+static void run(const scenario *sc, read_mode mode, uint64_t duration_ns);
+static uint32_t check(uint16_t *expected, const uint8_t *data);
+
+int main(int argc, char *argv[])
+{
+  double seconds = (argc > 1) ? atof(argv[1]) : 1.0;
+  uint32_t i;
+  uint32_t m;
+
+  if (seconds <= 0.0) {
+    printf("usage: %s [simulated seconds]\n", argv[0]);
+    return 1;
+  }
+
+  printf("bus           dev  ODR Hz  mode    util %%   samples in/out"
+         "    lost   gaps\n");
+
+  for (i = 0; i < (sizeof(scenarios) / sizeof(scenarios[0])); i++) {
+    for (m = READ_DRDY; m <= READ_FIFO_BURST; m++) {
+      run(&scenarios[i], (read_mode)m, (uint64_t)(seconds * 1e9));
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * @brief  Read the devices of a scenario with a strategy.
+ *
+ */
+static void run(const scenario *sc, read_mode mode, uint64_t duration_ns)
+{
+  st_bus_sim_dev_cfg dev_cfg[DEV_MAX];
+  stmdev_ctx_t ctx[DEV_MAX];
+  uint16_t expected[DEV_MAX];
+  st_bus_sim_cfg cfg;
+  st_bus_sim_stats stats;
+  st_bus_sim_dev_stats dev_stats;
+  st_bus_sim_event ev;
+  st_bus_sim *sim;
+  uint64_t samples = 0;
+  uint64_t received = 0;
+  uint64_t lost = 0;
+  uint64_t gaps = 0;
+  uint16_t level;
+  uint16_t i;
+  uint16_t w;
+
+  cfg.type = sc->type;
+  cfg.clock_hz = sc->clock_hz;
+  cfg.host_ns = 2000;
+  cfg.cs_ns = 200;
+
+  for (i = 0; i < sc->dev_num; i++) {
+    dev_cfg[i].add = (sc->type == ST_BUS_SIM_I2C) ? (0x6AU + i) : i;
+    dev_cfg[i].who_am_i_reg = LSM6DSOX_WHO_AM_I;
+    dev_cfg[i].who_am_i = LSM6DSOX_ID;
+    dev_cfg[i].stretch_ns = 0;
+    dev_cfg[i].odr_hz = sc->odr_hz;
+    dev_cfg[i].status_reg = LSM6DSOX_STATUS_REG;
+    dev_cfg[i].drdy_mask = 0x01U;
+    dev_cfg[i].out_reg = LSM6DSOX_OUTX_L_A;
+    dev_cfg[i].fifo_type = ST_BUS_SIM_FIFO_TAGGED;
+    dev_cfg[i].fifo_depth = FIFO_DEPTH;
+    dev_cfg[i].fifo_wtm = FIFO_WTM;
+    dev_cfg[i].fifo_out_reg = LSM6DSOX_FIFO_DATA_OUT_TAG;
+    dev_cfg[i].fifo_status_reg = LSM6DSOX_FIFO_STATUS1;
+    dev_cfg[i].fifo_tag = TAG_XL;
+    dev_cfg[i].int_drdy = (mode == READ_DRDY) ? 1U : 0U;
+    dev_cfg[i].int_fifo = (mode == READ_DRDY) ? 0U : 1U;
+    dev_cfg[i].gen = NULL;
+    dev_cfg[i].write_hook = NULL;
+    dev_cfg[i].arg = NULL;
+    expected[i] = 0;
+  }
+
+  if (st_bus_sim_init(&sim, &cfg, dev_cfg, sc->dev_num) != ST_BUS_SIM_OK) {
+    printf("%s: init error\n", sc->name);
+    return;
+  }
+
+  for (i = 0; i < sc->dev_num; i++) {
+    st_bus_sim_ctx_get(sim, i, &ctx[i]);
+  }
+
+  while (st_bus_sim_now(sim) < duration_ns) {
+
+    st_bus_sim_wait(sim, duration_ns - st_bus_sim_now(sim), &ev);
+    if (ev.type == ST_BUS_SIM_EV_TIMEOUT) {
+      break;
+    }
+
+    i = ev.dev;
+
+    if (mode == READ_DRDY) {
+      ctx[i].read_reg(ctx[i].handle, LSM6DSOX_OUTX_L_A, buff, 6);
+      gaps += check(&expected[i], buff);
+      received++;
+    }
+    else if (ev.type == ST_BUS_SIM_EV_FIFO_WTM) {
+      /* drain below the watermark, the next event is its next crossing */
+      do {
+        ctx[i].read_reg(ctx[i].handle, LSM6DSOX_FIFO_STATUS1, buff, 2);
+        level = (uint16_t)buff[0] | ((uint16_t)(buff[1] & 0x03U) << 8);
+
+        if (mode == READ_FIFO_WORD) {
+          for (w = 0; w < level; w++) {
+            ctx[i].read_reg(ctx[i].handle, LSM6DSOX_FIFO_DATA_OUT_TAG,
+                            buff, 1);
+            ctx[i].read_reg(ctx[i].handle, LSM6DSOX_FIFO_DATA_OUT_TAG + 1U,
+                            &buff[1], 6);
+            gaps += check(&expected[i], &buff[1]);
+          }
+        }
+        else {
+          ctx[i].read_reg(ctx[i].handle, LSM6DSOX_FIFO_DATA_OUT_TAG, buff,
+                          (uint16_t)(level * FIFO_WORD));
+          for (w = 0; w < level; w++) {
+            gaps += check(&expected[i], &buff[(w * FIFO_WORD) + 1U]);
+          }
+        }
+        received += level;
+      } while ((level >= FIFO_WTM) && (st_bus_sim_now(sim) < duration_ns));
+    }
+  }
+
+  st_bus_sim_stats_get(sim, &stats);
+  for (i = 0; i < sc->dev_num; i++) {
+    st_bus_sim_dev_stats_get(sim, i, &dev_stats);
+    samples += dev_stats.samples;
+    lost += (mode == READ_DRDY) ? dev_stats.samples_lost :
+            dev_stats.fifo_overrun;
+  }
+
+  printf("%s  %3u  %6.0f  %-5s  %6.1f  %7llu/%-7llu  %6llu  %5llu\n",
+         sc->name, sc->dev_num, (double)sc->odr_hz, mode_name[mode],
+         (double)stats.utilization * 100.0,
+         (unsigned long long)received, (unsigned long long)samples,
+         (unsigned long long)lost, (unsigned long long)gaps);
+
+  st_bus_sim_deinit(sim);
+}
+
+/*
+ * @brief  Check the sample sequence (x = sample index), return 1 when
+ *         samples are missing before this one.
+ *
+ */
+static uint32_t check(uint16_t *expected, const uint8_t *data)
+{
+  uint16_t x = (uint16_t)data[0] | ((uint16_t)data[1] << 8);
+  uint32_t gap = (x != *expected) ? 1U : 0U;
+
+  *expected = x + 1U;
+
+  return gap;
+}
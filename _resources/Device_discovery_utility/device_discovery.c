@@ -0,0 +1,605 @@
+/*
+ ******************************************************************************
+ * @file    device_discovery.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Discovery and binding of the sensors connected to an I2C bus.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "device_discovery.h"
+
+/**
+  * @defgroup  Device discovery
+  * @brief     This file provides a set of functions needed to find the
+  *            sensors on a bus and bind the driver contexts.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+#define ADD_MAX                  (4U)
+#define PROBE_MAX                (48U)
+#define NONE                     ((uint8_t)ST_DISCOVERY_PART_NUM)
+#define NO_RANK                  (0xFFU)
+
+/* Part flags */
+#define REG_INC                  (0x01U)  /* register MSB for auto increment */
+#define CHECK2                   (0x02U)  /* second register check */
+
+#define REG_INC_BIT              (0x80U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint8_t part;                 /* st_discovery_part */
+  uint8_t add[ADD_MAX];         /* XXX_I2C_ADD_x, 0 = unused */
+  uint8_t reg;                  /* XXX_WHO_AM_I */
+  uint8_t id;                   /* XXX_ID */
+  uint8_t reg2;                 /* second check (CHECK2) */
+  uint8_t id2;
+  uint8_t companion;            /* other die of combo parts */
+  uint8_t flags;
+} part_desc;
+
+typedef struct {
+  uint8_t add;
+  uint8_t reg;
+  uint8_t val;
+  uint8_t ack;
+} probe;
+
+/* Private variables ---------------------------------------------------------*/
+/*
+ * Values of the XXX_I2C_ADD_x, XXX_WHO_AM_I and XXX_ID definitions of the
+ * drivers, in the st_discovery_part order.
+ */
+static const part_desc part_table[] = {
+  { ST_DISCOVERY_LSM6DSOX,     { 0xD5U, 0xD7U }, 0x0FU, 0x6CU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LSM6DSO,      { 0xD5U, 0xD7U }, 0x0FU, 0x6CU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LSM6DSO32,    { 0xD5U, 0xD7U }, 0x0FU, 0x6CU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LSM6DSR,      { 0xD5U, 0xD7U }, 0x0FU, 0x6BU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LSM6DSRX,     { 0xD5U, 0xD7U }, 0x0FU, 0x6BU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_ISM330DHCX,   { 0xD5U, 0xD7U }, 0x0FU, 0x6BU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_ASM330LHH,    { 0xD5U, 0xD7U }, 0x0FU, 0x6BU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_IIS2ICLX,     { 0xD5U, 0xD7U }, 0x0FU, 0x6BU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LSM6DSL,      { 0xD5U, 0xD7U }, 0x0FU, 0x6AU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LSM6DSM,      { 0xD5U, 0xD7U }, 0x0FU, 0x6AU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LSM6DS3TR_C,  { 0xD5U, 0xD7U }, 0x0FU, 0x6AU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_ISM330DLC,    { 0xD5U, 0xD7U }, 0x0FU, 0x6AU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LSM6DS3,      { 0xD5U, 0xD7U }, 0x0FU, 0x69U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_IIS3DWB,      { 0xD5U, 0xD7U }, 0x0FU, 0x7BU, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LSM9DS1_IMU,  { 0xD5U, 0xD7U }, 0x0FU, 0x68U, 0, 0,
+    ST_DISCOVERY_LSM9DS1_MAG, 0 },
+  { ST_DISCOVERY_LSM9DS1_MAG,  { 0x3DU, 0x39U }, 0x0FU, 0x3DU, 0, 0,
+    ST_DISCOVERY_LSM9DS1_IMU, 0 },
+  { ST_DISCOVERY_L3GD20H,      { 0xD5U, 0xD7U }, 0x0FU, 0xD7U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_I3G4250D,     { 0xD1U, 0xD3U }, 0x0FU, 0xD3U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_A3G4250D,     { 0xD1U, 0xD3U }, 0x0FU, 0xD3U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LIS2DW12,     { 0x31U, 0x33U }, 0x0FU, 0x44U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LIS2DTW12,    { 0x31U, 0x33U }, 0x0FU, 0x44U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_IIS2DLPC,     { 0x31U, 0x33U }, 0x0FU, 0x44U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_AIS2DW12,     { 0x31U, 0x33U }, 0x0FU, 0x44U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LIS3DH,       { 0x31U, 0x33U }, 0x0FU, 0x33U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LIS2DH12,     { 0x31U, 0x33U }, 0x0FU, 0x33U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_IIS2DH,       { 0x31U, 0x33U }, 0x0FU, 0x33U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LIS2DE12,     { 0x31U, 0x33U }, 0x0FU, 0x33U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LIS3DE,       { 0x31U, 0x33U }, 0x0FU, 0x33U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LSM303AGR_XL, { 0x33U },        0x0FU, 0x33U, 0, 0,
+    ST_DISCOVERY_LSM303AGR_MG, REG_INC },
+  { ST_DISCOVERY_LSM303AGR_MG, { 0x3DU },        0x4FU, 0x40U, 0, 0,
+    ST_DISCOVERY_LSM303AGR_XL, REG_INC },
+  { ST_DISCOVERY_LIS331DLH,    { 0x31U, 0x33U }, 0x0FU, 0x32U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_H3LIS331DL,   { 0x31U, 0x33U }, 0x0FU, 0x32U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_H3LIS100DL,   { 0x31U, 0x33U }, 0x0FU, 0x32U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_IIS328DQ,     { 0x31U, 0x33U }, 0x0FU, 0x32U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_AIS328DQ,     { 0x31U, 0x33U }, 0x0FU, 0x32U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_AIS3624DQ,    { 0x31U, 0x33U }, 0x0FU, 0x32U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LIS25BA,      { 0x33U, 0x31U }, 0x0FU, 0x20U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LIS2DS12,     { 0x3DU, 0x3BU }, 0x0FU, 0x43U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LSM303AH_XL,  { 0x3BU },        0x0FU, 0x43U, 0, 0,
+    ST_DISCOVERY_LSM303AH_MG, REG_INC },
+  { ST_DISCOVERY_LSM303AH_MG,  { 0x3DU },        0x4FU, 0x40U, 0, 0,
+    ST_DISCOVERY_LSM303AH_XL, REG_INC },
+  { ST_DISCOVERY_ISM303DAC_XL, { 0x3BU },        0x0FU, 0x43U, 0, 0,
+    ST_DISCOVERY_ISM303DAC_MG, REG_INC },
+  { ST_DISCOVERY_ISM303DAC_MG, { 0x3DU },        0x4FU, 0x40U, 0, 0,
+    ST_DISCOVERY_ISM303DAC_XL, REG_INC },
+  { ST_DISCOVERY_LIS2HH12,     { 0x3DU, 0x3BU }, 0x0FU, 0x41U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LIS3DSH,      { 0x3DU, 0x3BU }, 0x0FU, 0x3FU, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LIS2MDL,      { 0x3DU },        0x4FU, 0x40U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_IIS2MDC,      { 0x3DU },        0x4FU, 0x40U, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LIS3MDL,      { 0x39U, 0x3DU }, 0x0FU, 0x3DU, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_LPS22HH,      { 0xB9U, 0xBBU }, 0x0FU, 0xB3U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LPS27HHW,     { 0xB9U, 0xBBU }, 0x0FU, 0xB3U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LPS22HB,      { 0xB9U, 0xBBU }, 0x0FU, 0xB1U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LPS33HW,      { 0xB9U, 0xBBU }, 0x0FU, 0xB1U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LPS33W,       { 0xB9U, 0xBBU }, 0x0FU, 0xB1U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LPS33K,       { 0xBBU },        0x0FU, 0xB1U, 0, 0, NONE, 0 },
+  { ST_DISCOVERY_LPS25HB,      { 0xB9U, 0xBBU }, 0x0FU, 0xBDU, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_HTS221,       { 0xBFU },        0x0FU, 0xBCU, 0, 0, NONE,
+    REG_INC },
+  { ST_DISCOVERY_STTS22H,      { 0x71U, 0x7FU }, 0x01U, 0xA0U, 0, 0, NONE, 0 },
+  /* STTS751 product ID (0xxxx / 1xxxx) and manufacturer ID */
+  { ST_DISCOVERY_STTS751,  { 0x91U, 0x93U, 0x71U, 0x73U }, 0xFDU, 0x00U,
+    0xFEU, 0x53U, NONE, CHECK2 },
+  { ST_DISCOVERY_STTS751,  { 0x95U, 0x97U, 0x75U, 0x77U }, 0xFDU, 0x01U,
+    0xFEU, 0x53U, NONE, CHECK2 },
+};
+
+#define PART_TABLE_LEN   (sizeof(part_table) / sizeof(part_table[0]))
+
+static const char *const part_name[ST_DISCOVERY_PART_NUM] = {
+  "LSM6DSOX", "LSM6DSO", "LSM6DSO32", "LSM6DSR", "LSM6DSRX", "ISM330DHCX",
+  "ASM330LHH", "IIS2ICLX", "LSM6DSL", "LSM6DSM", "LSM6DS3TR-C", "ISM330DLC",
+  "LSM6DS3", "IIS3DWB", "LSM9DS1 IMU", "LSM9DS1 MAG", "L3GD20H",
+  "I3G4250D", "A3G4250D", "LIS2DW12", "LIS2DTW12", "IIS2DLPC", "AIS2DW12",
+  "LIS3DH", "LIS2DH12", "IIS2DH", "LIS2DE12", "LIS3DE", "LSM303AGR XL",
+  "LSM303AGR MAG", "LIS331DLH", "H3LIS331DL", "H3LIS100DL", "IIS328DQ",
+  "AIS328DQ", "AIS3624DQ", "LIS25BA", "LIS2DS12", "LSM303AH XL",
+  "LSM303AH MAG", "ISM303DAC XL", "ISM303DAC MAG", "LIS2HH12", "LIS3DSH",
+  "LIS2MDL", "IIS2MDC", "LIS3MDL", "LPS22HH", "LPS27HHW", "LPS22HB",
+  "LPS33HW", "LPS33W", "LPS33K", "LPS25HB", "HTS221", "STTS22H", "STTS751",
+};
+
+/* Private functions ---------------------------------------------------------*/
+/*  Functions declare in this section are defined at the end of this file.    */
+static uint8_t add_match(const part_desc *d, uint8_t add);
+static uint16_t probe_build(const uint8_t *rank, probe *p);
+static void probe_run(const st_discovery_bus *bus, probe *p, uint16_t num);
+static uint8_t probe_match(const probe *p, uint16_t num, uint8_t add,
+                           const part_desc *d);
+static uint8_t companion_seen(const probe *p, uint16_t num,
+                              const uint8_t *rank, uint8_t companion);
+static uint8_t check2(const st_discovery_bus *bus, uint8_t add,
+                      const part_desc *d);
+static int32_t dev_write(void *handle, uint8_t reg, uint8_t *data,
+                         uint16_t len);
+static int32_t dev_read(void *handle, uint8_t reg, uint8_t *data,
+                        uint16_t len);
+
+/**
+  * @defgroup  Device_discovery_pubblic_functions
+  * @brief     This section provide a set of APIs for discovering the
+  *            devices on a bus.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Scan the bus for the listed parts and bind a driver context to
+  *         every device found (at most one device per address).
+  *
+  * @param  bus               bus access functions.(ptr)
+  * @param  part              parts supported by the firmware, in order of
+  *                           preference for parts sharing address and ID;
+  *                           NULL for all the parts in st_discovery_part
+  *                           order.(ptr)
+  * @param  part_num          number of parts in the list.
+  * @param  dev               discovered devices.(ptr)
+  * @param  dev_max           size of the dev array.
+  * @param  dev_num           number of discovered devices.(ptr)
+  *
+  * @retval st_discovery_status  ST_DISCOVERY_OK / ST_DISCOVERY_ERR (bad
+  *                              parameters or more than dev_max devices)
+  *
+  */
+st_discovery_status st_discovery_scan(const st_discovery_bus *bus,
+                                      const st_discovery_part *part,
+                                      uint8_t part_num,
+                                      st_discovery_dev *dev,
+                                      uint8_t dev_max, uint8_t *dev_num)
+{
+  uint8_t rank[ST_DISCOVERY_PART_NUM];
+  probe p[PROBE_MAX];
+  const part_desc *cand[ST_DISCOVERY_CANDIDATE_MAX];
+  uint8_t cand_comp[ST_DISCOVERY_CANDIDATE_MAX];
+  const part_desc *d;
+  st_discovery_status ret = ST_DISCOVERY_OK;
+  uint8_t candidates;
+  uint8_t stored;
+  uint8_t comp;
+  uint16_t probe_num;
+  uint16_t i;
+  uint16_t j;
+  uint8_t k;
+
+  if (bus == NULL || bus->read_reg == NULL || dev == NULL ||
+      dev_num == NULL || (part == NULL && part_num != 0U)) {
+    return ST_DISCOVERY_ERR;
+  }
+
+  /* rank of every part in the list, NO_RANK when not supported */
+  for (i = 0; i < (uint16_t)ST_DISCOVERY_PART_NUM; i++) {
+    rank[i] = (part == NULL) ? (uint8_t)i : NO_RANK;
+  }
+
+  for (i = 0; i < part_num; i++) {
+    if ((uint32_t)part[i] >= (uint32_t)ST_DISCOVERY_PART_NUM) {
+      return ST_DISCOVERY_ERR;
+    }
+
+    if (rank[part[i]] == NO_RANK) {
+      rank[part[i]] = (uint8_t)i;
+    }
+  }
+
+  /* one read per (address, WHO_AM_I register) */
+  probe_num = probe_build(rank, p);
+  probe_run(bus, p, probe_num);
+
+  *dev_num = 0;
+
+  for (i = 0; i < probe_num; i++) {
+    /* resolve every address once, on its first acknowledged probe */
+    if (p[i].ack == 0U || (i > 0U && p[i - 1U].add == p[i].add &&
+                           p[i - 1U].ack != 0U)) {
+      continue;
+    }
+
+    candidates = 0;
+    stored = 0;
+
+    for (j = 0; j < PART_TABLE_LEN; j++) {
+      d = &part_table[j];
+
+      if (rank[d->part] == NO_RANK || probe_match(p, probe_num, p[i].add,
+                                               d) == 0U) {
+        continue;
+      }
+
+      if ((d->flags & CHECK2) != 0U && check2(bus, p[i].add, d) == 0U) {
+        continue;
+      }
+
+      candidates++;
+      comp = companion_seen(p, probe_num, rank, d->companion);
+
+      /*
+       * keep the candidates in order of preference: companion die
+       * found, then rank in the list
+       */
+      for (k = stored; k > 0U; k--) {
+        if (comp < cand_comp[k - 1U] || (comp == cand_comp[k - 1U] &&
+            rank[d->part] >= rank[cand[k - 1U]->part])) {
+          break;
+        }
+        if (k < ST_DISCOVERY_CANDIDATE_MAX) {
+          cand[k] = cand[k - 1U];
+          cand_comp[k] = cand_comp[k - 1U];
+        }
+      }
+      if (k < ST_DISCOVERY_CANDIDATE_MAX) {
+        cand[k] = d;
+        cand_comp[k] = comp;
+        if (stored < ST_DISCOVERY_CANDIDATE_MAX) {
+          stored++;
+        }
+      }
+    }
+
+    if (stored == 0U) {
+      continue;
+    }
+
+    if (*dev_num >= dev_max) {
+      ret = ST_DISCOVERY_ERR;
+      break;
+    }
+
+    dev[*dev_num].part = (st_discovery_part)cand[0]->part;
+    dev[*dev_num].i2c_add = p[i].add;
+    dev[*dev_num].id = cand[0]->id;
+    dev[*dev_num].candidates = candidates;
+    for (k = 0; k < ST_DISCOVERY_CANDIDATE_MAX; k++) {
+      dev[*dev_num].candidate[k] = (k < stored) ?
+                                   (st_discovery_part)cand[k]->part :
+                                   ST_DISCOVERY_PART_NUM;
+    }
+    dev[*dev_num].reg_inc = ((cand[0]->flags & REG_INC) != 0U) ? 1U : 0U;
+    dev[*dev_num].bus = bus;
+    dev[*dev_num].ctx.write_reg = dev_write;
+    dev[*dev_num].ctx.read_reg = dev_read;
+    dev[*dev_num].ctx.handle = &dev[*dev_num];
+    (*dev_num)++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Name of a part.
+  *
+  * @param  part              part.
+  *
+  * @retval                   part name, "" if unknown
+  *
+  */
+const char *st_discovery_part_name(st_discovery_part part)
+{
+  if ((uint32_t)part >= (uint32_t)ST_DISCOVERY_PART_NUM) {
+    return "";
+  }
+
+  return part_name[part];
+}
+
+/**
+  * @brief  Name of a discovered device: the names of all the matching
+  *         parts, preferred first, separated by '/' (e.g.
+  *         "LIS2MDL/IIS2MDC"), truncated to the buffer.
+  *
+  * @param  dev               discovered device.(ptr)
+  * @param  buf               name buffer.(ptr)
+  * @param  len               buffer size, terminator included.
+  *
+  * @retval                   buf, "" if bad parameters
+  *
+  */
+const char *st_discovery_dev_name(const st_discovery_dev *dev, char *buf,
+                                  uint16_t len)
+{
+  const char *name;
+  uint16_t n = 0;
+  uint8_t k;
+
+  if (buf == NULL || len == 0U) {
+    return "";
+  }
+
+  buf[0] = '\0';
+  if (dev == NULL) {
+    return buf;
+  }
+
+  for (k = 0; k < ST_DISCOVERY_CANDIDATE_MAX; k++) {
+    if ((uint32_t)dev->candidate[k] >= (uint32_t)ST_DISCOVERY_PART_NUM) {
+      break;
+    }
+
+    if (k > 0U && n + 1U < len) {
+      buf[n] = '/';
+      n++;
+    }
+
+    for (name = part_name[dev->candidate[k]];
+         *name != '\0' && n + 1U < len; name++) {
+      buf[n] = *name;
+      n++;
+    }
+  }
+
+  buf[n] = '\0';
+
+  return buf;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  Device discovery private functions
+  * @brief     This section provide a set of private low-level functions
+  *            used by pubblic APIs.
+  * @{
+  *
+  */
+
+static uint8_t add_match(const part_desc *d, uint8_t add)
+{
+  uint8_t i;
+
+  for (i = 0; i < ADD_MAX; i++) {
+    /* R/W bit is not part of the address */
+    if (d->add[i] != 0U && (d->add[i] | 0x01U) == add) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  List the (address, WHO_AM_I register) pairs of the supported
+  *         parts, sorted by address. Addresses are stored with the R/W
+  *         bit set as in the drivers definitions.
+  *
+  * @param  rank              rank of the parts, NO_RANK if not supported.(ptr)
+  * @param  p                 probes.(ptr)
+  *
+  * @retval                   number of probes
+  *
+  */
+static uint16_t probe_build(const uint8_t *rank, probe *p)
+{
+  const part_desc *d;
+  uint16_t num = 0;
+  uint16_t add;
+  uint16_t i;
+  uint16_t k;
+
+  /* by address first: a missing device costs one read */
+  for (add = 0x01U; add <= 0xFFU; add += 2U) {
+    for (i = 0; i < PART_TABLE_LEN; i++) {
+      d = &part_table[i];
+
+      if (rank[d->part] == NO_RANK || add_match(d, (uint8_t)add) == 0U) {
+        continue;
+      }
+
+      for (k = num; k > 0U; k--) {
+        if (p[k - 1U].add != add || p[k - 1U].reg == d->reg) {
+          break;
+        }
+      }
+
+      if ((k > 0U && p[k - 1U].add == add) || num >= PROBE_MAX) {
+        continue;
+      }
+
+      p[num].add = (uint8_t)add;
+      p[num].reg = d->reg;
+      p[num].val = 0;
+      p[num].ack = 0;
+      num++;
+    }
+  }
+
+  return num;
+}
+
+static void probe_run(const st_discovery_bus *bus, probe *p, uint16_t num)
+{
+  uint8_t absent = 0;
+  uint16_t i;
+
+  for (i = 0; i < num; i++) {
+    if (i == 0U || p[i].add != p[i - 1U].add) {
+      absent = 0;
+    }
+
+    if (absent == 0U) {
+      if (bus->read_reg(bus->handle, p[i].add, p[i].reg, &p[i].val,
+                        1) == 0) {
+        p[i].ack = 1;
+      } else {
+        absent = 1;
+      }
+    }
+  }
+}
+
+static uint8_t probe_match(const probe *p, uint16_t num, uint8_t add,
+                           const part_desc *d)
+{
+  uint16_t i;
+
+  if (add_match(d, add) == 0U) {
+    return 0;
+  }
+
+  for (i = 0; i < num; i++) {
+    if (p[i].add == add && p[i].reg == d->reg) {
+      return (p[i].ack != 0U && p[i].val == d->id) ? 1U : 0U;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Check if the other die of a combo part answered.
+  *
+  * @retval                   1 if found, 0 if not (or not a combo part)
+  *
+  */
+static uint8_t companion_seen(const probe *p, uint16_t num,
+                              const uint8_t *rank, uint8_t companion)
+{
+  const part_desc *d;
+  uint16_t i;
+  uint16_t j;
+
+  if (companion == NONE || rank[companion] == NO_RANK) {
+    return 0;
+  }
+
+  for (i = 0; i < PART_TABLE_LEN; i++) {
+    d = &part_table[i];
+
+    if (d->part != companion) {
+      continue;
+    }
+
+    for (j = 0; j < num; j++) {
+      if (probe_match(p, num, p[j].add, d) != 0U) {
+        return 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
+static uint8_t check2(const st_discovery_bus *bus, uint8_t add,
+                      const part_desc *d)
+{
+  uint8_t val;
+
+  if (bus->read_reg(bus->handle, add, d->reg2, &val, 1) != 0) {
+    return 0;
+  }
+
+  return (val == d->id2) ? 1U : 0U;
+}
+
+static int32_t dev_write(void *handle, uint8_t reg, uint8_t *data,
+                         uint16_t len)
+{
+  st_discovery_dev *dev = (st_discovery_dev *)handle;
+
+  if (dev->bus->write_reg == NULL) {
+    return -1;
+  }
+
+  if (dev->reg_inc != 0U) {
+    reg |= REG_INC_BIT;
+  }
+
+  return dev->bus->write_reg(dev->bus->handle, dev->i2c_add, reg, data,
+                             len);
+}
+
+static int32_t dev_read(void *handle, uint8_t reg, uint8_t *data,
+                        uint16_t len)
+{
+  st_discovery_dev *dev = (st_discovery_dev *)handle;
+
+  if (dev->reg_inc != 0U) {
+    reg |= REG_INC_BIT;
+  }
+
+  return dev->bus->read_reg(dev->bus->handle, dev->i2c_add, reg, data,
+                            len);
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,242 @@
+/*
+ ******************************************************************************
+ * @file    device_discovery.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          device_discovery.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_DISCOVERY_H
+#define ST_DISCOVERY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/** @addtogroup Device discovery
+  * @brief    Discovery of the sensors connected to an I2C bus.
+  *           A table holds I2C addresses and WHO_AM_I register / value of
+  *           every part supported by the drivers (values of the
+  *           XXX_I2C_ADD_x, XXX_WHO_AM_I and XXX_ID definitions of the
+  *           xxx_reg.h files; SPI only parts are not listed).
+  *           The scan reads every WHO_AM_I register once per address
+  *           (an address that does not acknowledge is skipped after the
+  *           first read), so the number of bus transactions depends on
+  *           the addresses in use, not on the number of supported parts.
+  *
+  *           Parts sharing address and ID are resolved:
+  *           - by a second register check when the part has one;
+  *           - by the companion die of combo parts (e.g. LSM303AGR
+  *             accelerometer and magnetometer, LSM9DS1 IMU and
+  *             magnetometer);
+  *           - by the order of the parts list given to the scan (the
+  *             parts the firmware supports, most likely first).
+  *           All the matching parts are returned with the device, in
+  *           order of preference, so the application knows when the
+  *           choice was made only by the list order and can show them
+  *           (st_discovery_dev_name(), e.g. "LIS2MDL/IIS2MDC").
+  *
+  *           Every discovered device comes with a driver context
+  *           (stmdev_ctx_t) bound to its address, ready for the
+  *           xxx_reg.c APIs.
+  * @{
+  *
+  */
+
+#ifndef MEMS_SHARED_TYPES
+#define MEMS_SHARED_TYPES
+
+typedef struct{
+  uint8_t bit0       : 1;
+  uint8_t bit1       : 1;
+  uint8_t bit2       : 1;
+  uint8_t bit3       : 1;
+  uint8_t bit4       : 1;
+  uint8_t bit5       : 1;
+  uint8_t bit6       : 1;
+  uint8_t bit7       : 1;
+} bitwise_t;
+
+#define PROPERTY_DISABLE                (0U)
+#define PROPERTY_ENABLE                 (1U)
+
+/** @addtogroup  Interfaces_Functions
+  * @brief       This section provide a set of functions used to read and
+  *              write a generic register of the device.
+  *              MANDATORY: return 0 -> no Error.
+  * @{
+  *
+  */
+
+typedef int32_t (*stmdev_write_ptr)(void *, uint8_t, uint8_t*, uint16_t);
+typedef int32_t (*stmdev_read_ptr) (void *, uint8_t, uint8_t*, uint16_t);
+
+typedef struct {
+  /** Component mandatory fields **/
+  stmdev_write_ptr  write_reg;
+  stmdev_read_ptr   read_reg;
+  /** Customizable optional pointer **/
+  void *handle;
+} stmdev_ctx_t;
+
+/**
+  * @}
+  *
+  */
+
+#endif /* MEMS_SHARED_TYPES */
+
+/** @defgroup Device_discovery_pubblic_definitions
+  * @{
+  *
+  */
+
+#define ST_DISCOVERY_CANDIDATE_MAX   (8U)
+
+typedef enum {
+  ST_DISCOVERY_OK = 0,
+  ST_DISCOVERY_ERR
+} st_discovery_status;
+
+/* Parts sharing the same ID are listed together, most common first */
+typedef enum {
+  ST_DISCOVERY_LSM6DSOX = 0,
+  ST_DISCOVERY_LSM6DSO,
+  ST_DISCOVERY_LSM6DSO32,
+  ST_DISCOVERY_LSM6DSR,
+  ST_DISCOVERY_LSM6DSRX,
+  ST_DISCOVERY_ISM330DHCX,
+  ST_DISCOVERY_ASM330LHH,
+  ST_DISCOVERY_IIS2ICLX,
+  ST_DISCOVERY_LSM6DSL,
+  ST_DISCOVERY_LSM6DSM,
+  ST_DISCOVERY_LSM6DS3TR_C,
+  ST_DISCOVERY_ISM330DLC,
+  ST_DISCOVERY_LSM6DS3,
+  ST_DISCOVERY_IIS3DWB,
+  ST_DISCOVERY_LSM9DS1_IMU,
+  ST_DISCOVERY_LSM9DS1_MAG,
+  ST_DISCOVERY_L3GD20H,
+  ST_DISCOVERY_I3G4250D,
+  ST_DISCOVERY_A3G4250D,
+  ST_DISCOVERY_LIS2DW12,
+  ST_DISCOVERY_LIS2DTW12,
+  ST_DISCOVERY_IIS2DLPC,
+  ST_DISCOVERY_AIS2DW12,
+  ST_DISCOVERY_LIS3DH,
+  ST_DISCOVERY_LIS2DH12,
+  ST_DISCOVERY_IIS2DH,
+  ST_DISCOVERY_LIS2DE12,
+  ST_DISCOVERY_LIS3DE,
+  ST_DISCOVERY_LSM303AGR_XL,
+  ST_DISCOVERY_LSM303AGR_MG,
+  ST_DISCOVERY_LIS331DLH,
+  ST_DISCOVERY_H3LIS331DL,
+  ST_DISCOVERY_H3LIS100DL,
+  ST_DISCOVERY_IIS328DQ,
+  ST_DISCOVERY_AIS328DQ,
+  ST_DISCOVERY_AIS3624DQ,
+  ST_DISCOVERY_LIS25BA,
+  ST_DISCOVERY_LIS2DS12,
+  ST_DISCOVERY_LSM303AH_XL,
+  ST_DISCOVERY_LSM303AH_MG,
+  ST_DISCOVERY_ISM303DAC_XL,
+  ST_DISCOVERY_ISM303DAC_MG,
+  ST_DISCOVERY_LIS2HH12,
+  ST_DISCOVERY_LIS3DSH,
+  ST_DISCOVERY_LIS2MDL,
+  ST_DISCOVERY_IIS2MDC,
+  ST_DISCOVERY_LIS3MDL,
+  ST_DISCOVERY_LPS22HH,
+  ST_DISCOVERY_LPS27HHW,
+  ST_DISCOVERY_LPS22HB,
+  ST_DISCOVERY_LPS33HW,
+  ST_DISCOVERY_LPS33W,
+  ST_DISCOVERY_LPS33K,
+  ST_DISCOVERY_LPS25HB,
+  ST_DISCOVERY_HTS221,
+  ST_DISCOVERY_STTS22H,
+  ST_DISCOVERY_STTS751,
+  ST_DISCOVERY_PART_NUM
+} st_discovery_part;
+
+/**
+  * @brief  I2C bus access, i2c_add is the 8 bit address as in the
+  *         XXX_I2C_ADD_x definitions (R/W bit to be ignored).
+  *         MANDATORY: return 0 -> no Error, the read must fail when
+  *         the address is not acknowledged.
+  */
+typedef int32_t (*st_discovery_write_ptr)(void *handle, uint8_t i2c_add,
+                                          uint8_t reg, uint8_t *data,
+                                          uint16_t len);
+typedef int32_t (*st_discovery_read_ptr)(void *handle, uint8_t i2c_add,
+                                         uint8_t reg, uint8_t *data,
+                                         uint16_t len);
+
+typedef struct {
+  st_discovery_write_ptr write_reg;
+  st_discovery_read_ptr read_reg;
+  void *handle;
+} st_discovery_bus;
+
+/**
+  * @brief  Discovered device. ctx.handle points to the structure itself,
+  *         so the array must not be moved while the contexts are in use.
+  */
+typedef struct {
+  st_discovery_part part;
+  uint8_t i2c_add;            /* 8 bit address (XXX_I2C_ADD_x) */
+  uint8_t id;                 /* WHO_AM_I value */
+  uint8_t candidates;         /* listed parts matching, > 1: resolved
+                               * only by the list order */
+  st_discovery_part candidate[ST_DISCOVERY_CANDIDATE_MAX]; /* matching
+                               * parts, preferred first (= part) */
+  uint8_t reg_inc;            /* register MSB set on every access (auto
+                               * increment of the older parts) */
+  const st_discovery_bus *bus;
+  stmdev_ctx_t ctx;           /* driver context bound to the device */
+} st_discovery_dev;
+
+/**
+  * @}
+  *
+  */
+
+st_discovery_status st_discovery_scan(const st_discovery_bus *bus,
+                                      const st_discovery_part *part,
+                                      uint8_t part_num,
+                                      st_discovery_dev *dev,
+                                      uint8_t dev_max, uint8_t *dev_num);
+
+const char *st_discovery_part_name(st_discovery_part part);
+
+const char *st_discovery_dev_name(const st_discovery_dev *dev, char *buf,
+                                  uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_DISCOVERY_H */
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,142 @@
+/*
+ ******************************************************************************
+ * @file    bench_fifo.c
+ * @author  Sensor Solutions Software Team
+ * @brief   FIFO decompression utility microbenchmark cases.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "driver_bench.h"
+#include "fifo_utility.h"
+
+/* Private constants  --------------------------------------------------------*/
+#define TAG_GY                   (0x01U)
+#define TAG_XL                   (0x02U)
+#define TAG_XL_COMPRESSED_3X     (0x09U)
+#define BDR_HZ                   (416.0f)
+#define WORDS                    (256U)
+
+/* Private variables ---------------------------------------------------------*/
+static st_fifo_raw_slot raw[WORDS];
+static st_fifo_out_slot out[WORDS * 3U];
+static st_fifo_state state;
+static st_fifo_stream stream;
+
+/* Private functions ---------------------------------------------------------*/
+static uint8_t tag_byte(uint8_t tag, uint32_t tick);
+
+/*
+ * Every BDR tick a gyroscope word, every 3 ticks an accelerometer 3x
+ * compressed word (the first accelerometer word is not compressed), as
+ * in the FIFO decode pool benchmark.
+ */
+static void init(void)
+{
+  uint32_t seed = 0x5AU;
+  uint32_t tick = 0;
+  uint32_t i = 0;
+  uint16_t word;
+  uint8_t k;
+
+  while (i < WORDS) {
+    raw[i].fifo_data_out[0] = tag_byte(TAG_GY, tick);
+    for (k = 1; k < 7U; k++) {
+      seed = (seed * 1103515245U) + 12345U;
+      raw[i].fifo_data_out[k] = (uint8_t)(seed >> 16);
+    }
+    i++;
+
+    if ((i < WORDS) && (tick == 0U)) {
+      raw[i].fifo_data_out[0] = tag_byte(TAG_XL, tick);
+      for (k = 1; k < 7U; k++) {
+        raw[i].fifo_data_out[k] = 0;
+      }
+      i++;
+    }
+    else if ((i < WORDS) && ((tick % 3U) == 2U)) {
+      raw[i].fifo_data_out[0] = tag_byte(TAG_XL_COMPRESSED_3X, tick);
+      for (k = 0; k < 3U; k++) {
+        seed = (seed * 1103515245U) + 12345U;
+        word = (uint16_t)((seed >> 8) & 0x7FFFU);
+        raw[i].fifo_data_out[1U + (2U * k)] = (uint8_t)word;
+        raw[i].fifo_data_out[2U + (2U * k)] = (uint8_t)(word >> 8);
+      }
+      i++;
+    }
+
+    tick++;
+  }
+}
+
+static uint8_t tag_byte(uint8_t tag, uint32_t tick)
+{
+  uint8_t val = (uint8_t)((tag << 3) | ((tick & 0x03U) << 1));
+  uint8_t ones = 0;
+  uint8_t i;
+
+  for (i = 0; i < 8U; i++) {
+    ones += (val >> i) & 0x01U;
+  }
+
+  return (uint8_t)(val | (ones & 0x01U));
+}
+
+static void view_cb(const st_fifo_view *view, void *arg)
+{
+  (void)arg;
+  st_bench_sink += view->raw_data[0];
+}
+
+static void slot_cb(const st_fifo_out_slot *slot, void *arg)
+{
+  (void)arg;
+  st_bench_sink += slot->raw_data[0];
+}
+
+/* the decoder state restarts on every call, the stream is the same */
+static void state_decompress(void)
+{
+  uint16_t num;
+
+  (void)st_fifo_state_init(&state, BDR_HZ, BDR_HZ, 0.0f);
+  (void)st_fifo_state_decompress(&state, out, raw, &num, WORDS);
+}
+
+static void state_decode_view(void)
+{
+  (void)st_fifo_state_init(&state, BDR_HZ, BDR_HZ, 0.0f);
+  (void)st_fifo_state_decode_view(&state, raw, WORDS, view_cb, NULL);
+}
+
+static void stream_feed(void)
+{
+  uint32_t used;
+
+  (void)st_fifo_stream_init(&stream, BDR_HZ, BDR_HZ, 0.0f, slot_cb, NULL,
+                            NULL);
+  (void)st_fifo_stream_feed(&stream, (const uint8_t *)raw, sizeof(raw),
+                            &used);
+}
+
+static const st_bench_case cases[] = {
+  { "st_fifo_state_decompress, per word", state_decompress, WORDS },
+  { "st_fifo_state_decode_view, per word", state_decode_view, WORDS },
+  { "st_fifo_stream_feed (callback), per word", stream_feed, WORDS },
+};
+
+/* Public variables ----------------------------------------------------------*/
+const st_bench_table st_bench_fifo = {
+  "fifo", init, cases, (uint16_t)(sizeof(cases) / sizeof(cases[0]))
+};
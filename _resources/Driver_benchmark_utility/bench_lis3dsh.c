@@ -0,0 +1,89 @@
+/*
+ ******************************************************************************
+ * @file    bench_lis3dsh.c
+ * @author  Sensor Solutions Software Team
+ * @brief   LIS3DSH driver microbenchmark cases.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "driver_bench.h"
+#include "lis3dsh_reg.h"
+
+/* Private constants  --------------------------------------------------------*/
+#define FIFO_LEVEL               (31U)
+
+/* Private variables ---------------------------------------------------------*/
+static st_bench_mock mock;
+static stmdev_ctx_t ctx;
+static lis3dsh_md_t md;
+static lis3dsh_data_t data;
+static lis3dsh_all_sources_t all_sources;
+static int16_t fifo_raw[FIFO_LEVEL * 3U];
+
+/* Private functions ---------------------------------------------------------*/
+static void init(void)
+{
+  st_bench_mock_init(&mock, &ctx, 0x3FU);
+
+  /* FIFO not empty, 31 samples */
+  mock.reg[LIS3DSH_FIFO_SRC] = FIFO_LEVEL;
+
+  md.odr = LIS3DSH_1kHz6;
+  md.fs = LIS3DSH_4g;
+}
+
+static void data_get(void)
+{
+  (void)lis3dsh_data_get(&ctx, &md, &data);
+}
+
+static void data_burst_get(void)
+{
+  (void)lis3dsh_data_burst_get(&ctx, &md, &data);
+}
+
+static void all_sources_get(void)
+{
+  (void)lis3dsh_all_sources_get(&ctx, &all_sources);
+}
+
+static void fifo_data_get(void)
+{
+  uint8_t num;
+
+  (void)lis3dsh_fifo_data_get(&ctx, fifo_raw, FIFO_LEVEL, &num);
+}
+
+static void from_fs4_to_mg(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < 3U; i++) {
+    data.xl.mg[i] = lis3dsh_from_fs4_to_mg(data.xl.raw[i]);
+  }
+}
+
+static const st_bench_case cases[] = {
+  { "lis3dsh_data_get", data_get, 1 },
+  { "lis3dsh_data_burst_get", data_burst_get, 1 },
+  { "lis3dsh_all_sources_get", all_sources_get, 1 },
+  { "lis3dsh_fifo_data_get, per sample", fifo_data_get, FIFO_LEVEL },
+  { "lis3dsh_from_fs4_to_mg, per axis", from_fs4_to_mg, 3 },
+};
+
+/* Public variables ----------------------------------------------------------*/
+const st_bench_table st_bench_lis3dsh = {
+  "lis3dsh", init, cases, (uint16_t)(sizeof(cases) / sizeof(cases[0]))
+};
@@ -0,0 +1,104 @@
+/*
+ ******************************************************************************
+ * @file    bench_lsm6dsox.c
+ * @author  Sensor Solutions Software Team
+ * @brief   LSM6DSOX driver microbenchmark cases.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "driver_bench.h"
+#include "lsm6dsox_reg.h"
+
+/* Private variables ---------------------------------------------------------*/
+static st_bench_mock mock;
+static stmdev_ctx_t ctx;
+static lsm6dsox_md_t md;
+static lsm6dsox_data_t data;
+static lsm6dsox_all_sources_t all_sources;
+static lsm6dsox_status_reg_t status;
+static uint8_t buff[14];
+
+/* Private functions ---------------------------------------------------------*/
+static void init(void)
+{
+  st_bench_mock_init(&mock, &ctx, 0x6CU);
+
+  md.ui.xl.fs = LSM6DSOX_XL_UI_4g;
+  md.ui.gy.fs = LSM6DSOX_GY_UI_2000dps;
+}
+
+static void read_reg_6(void)
+{
+  (void)lsm6dsox_read_reg(&ctx, LSM6DSOX_OUTX_L_A, buff, 6);
+}
+
+static void acceleration_raw_get(void)
+{
+  (void)lsm6dsox_acceleration_raw_get(&ctx, buff);
+}
+
+static void xl_flag_data_ready_get(void)
+{
+  (void)lsm6dsox_xl_flag_data_ready_get(&ctx, buff);
+}
+
+static void data_drdy_raw_get(void)
+{
+  (void)lsm6dsox_data_drdy_raw_get(&ctx, &status, buff, &buff[2], &buff[8]);
+}
+
+static void data_get(void)
+{
+  (void)lsm6dsox_data_get(&ctx, NULL, &md, &data);
+}
+
+static void all_sources_get(void)
+{
+  (void)lsm6dsox_all_sources_get(&ctx, &all_sources);
+}
+
+static void from_fs4_to_mg(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < 3U; i++) {
+    data.ui.xl.mg[i] = lsm6dsox_from_fs4_to_mg(data.ui.xl.raw[i]);
+  }
+}
+
+static void from_fs2000_to_mdps(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < 3U; i++) {
+    data.ui.gy.mdps[i] = lsm6dsox_from_fs2000_to_mdps(data.ui.gy.raw[i]);
+  }
+}
+
+static const st_bench_case cases[] = {
+  { "lsm6dsox_read_reg, 6 bytes (mock bus)", read_reg_6, 1 },
+  { "lsm6dsox_acceleration_raw_get", acceleration_raw_get, 1 },
+  { "lsm6dsox_xl_flag_data_ready_get", xl_flag_data_ready_get, 1 },
+  { "lsm6dsox_data_drdy_raw_get", data_drdy_raw_get, 1 },
+  { "lsm6dsox_data_get (temp, gy, xl)", data_get, 1 },
+  { "lsm6dsox_all_sources_get", all_sources_get, 1 },
+  { "lsm6dsox_from_fs4_to_mg, per axis", from_fs4_to_mg, 3 },
+  { "lsm6dsox_from_fs2000_to_mdps, per axis", from_fs2000_to_mdps, 3 },
+};
+
+/* Public variables ----------------------------------------------------------*/
+const st_bench_table st_bench_lsm6dsox = {
+  "lsm6dsox", init, cases, (uint16_t)(sizeof(cases) / sizeof(cases[0]))
+};
@@ -0,0 +1,265 @@
+/*
+ ******************************************************************************
+ * @file    driver_bench.c
+ * @author  Sensor Solutions Software Team
+ * @brief   CPU microbenchmarks of the drivers on a zero latency mock bus.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Build (Linux):
+ *
+ *   gcc -O2 -I../../lsm6dsox_STdC/driver -I../../lis3dsh_STdC/driver \
+ *       -I../FIFO_decompression_utility driver_bench.c bench_lsm6dsox.c \
+ *       bench_lis3dsh.c bench_fifo.c \
+ *       ../../lsm6dsox_STdC/driver/lsm6dsox_reg.c \
+ *       ../../lis3dsh_STdC/driver/lis3dsh_reg.c \
+ *       ../FIFO_decompression_utility/fifo_utility.c -o driver_bench
+ *
+ * Usage:
+ *
+ *   driver_bench [driver]
+ *
+ * Cortex-M (M3 / M4 / M7): build the same files with ST_BENCH_CYCCNT
+ * defined and call st_bench_run(NULL) from the firmware, the time is read
+ * from the DWT cycle counter and printf() must be retargeted; results are
+ * in CPU cycles.
+ *
+ * Every case runs until ST_BENCH_MIN_TIME (ns or cycles) has elapsed, the
+ * best of ST_BENCH_REPEAT runs is reported, per operation.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#if !defined(ST_BENCH_CYCCNT)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <stdio.h>
+#include <string.h>
+#if !defined(ST_BENCH_CYCCNT)
+#include <time.h>
+#endif
+#include "driver_bench.h"
+
+/* Private constants  --------------------------------------------------------*/
+#if defined(ST_BENCH_CYCCNT)
+#define DEMCR                    (*(volatile uint32_t *)0xE000EDFCU)
+#define DWT_CTRL                 (*(volatile uint32_t *)0xE0001000U)
+#define DWT_CYCCNT               (*(volatile uint32_t *)0xE0001004U)
+#define DEMCR_TRCENA             (0x01000000U)
+#define DWT_CYCCNTENA            (0x00000001U)
+#define TIME_UNIT                "cycles"
+#ifndef ST_BENCH_MIN_TIME
+#define ST_BENCH_MIN_TIME        (2000000U)
+#endif
+#else
+#define TIME_UNIT                "ns"
+#ifndef ST_BENCH_MIN_TIME
+#define ST_BENCH_MIN_TIME        (20000000U)
+#endif
+#endif
+
+#ifndef ST_BENCH_REPEAT
+#define ST_BENCH_REPEAT          (5U)
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+volatile uint32_t st_bench_sink;
+
+static const st_bench_table *const tables[] = {
+  &st_bench_lsm6dsox,
+  &st_bench_lis3dsh,
+  &st_bench_fifo,
+};
+
+/* Private functions ---------------------------------------------------------*/
+static void timer_init(void);
+static uint32_t timer_get(void);
+static double case_run(void (*run)(void));
+static void empty(void);
+static int32_t mock_write(void *handle, uint8_t reg, uint8_t *data,
+                          uint16_t len);
+static int32_t mock_read(void *handle, uint8_t reg, uint8_t *data,
+                         uint16_t len);
+
+#if !defined(ST_BENCH_CYCCNT)
+int main(int argc, char *argv[])
+{
+  st_bench_run((argc > 1) ? argv[1] : NULL);
+
+  return 0;
+}
+#endif
+
+/**
+  * @brief  Run the cases of one driver (NULL: all the drivers) and print
+  *         the time per operation.
+  *
+  * @param  driver            driver name, as printed.(ptr)
+  *
+  */
+void st_bench_run(const char *driver)
+{
+  const st_bench_table *t;
+  double overhead;
+  double val;
+  uint16_t i;
+  uint16_t c;
+
+  timer_init();
+
+  overhead = case_run(empty);
+  printf("call overhead: %.1f %s (subtracted)\n\n", overhead, TIME_UNIT);
+  printf("%-44s %12s/op\n", "case", TIME_UNIT);
+
+  for (i = 0; i < (sizeof(tables) / sizeof(tables[0])); i++) {
+    t = tables[i];
+    if ((driver != NULL) && (strcmp(driver, t->driver) != 0)) {
+      continue;
+    }
+
+    t->init();
+    for (c = 0; c < t->case_num; c++) {
+      val = case_run(t->cases[c].run) - overhead;
+      if (val < 0.0) {
+        val = 0.0;
+      }
+      if (t->cases[c].ops > 1U) {
+        val /= (double)t->cases[c].ops;
+      }
+      printf("%-44s %15.1f\n", t->cases[c].name, val);
+    }
+  }
+}
+
+/**
+  * @brief  Driver context on a register image: reads and writes are
+  *         copies, the register address wraps at 0xFF.
+  *
+  * @param  mock              register image.(ptr)
+  * @param  ctx               driver context bound to the image.(ptr)
+  * @param  seed              register image content (pseudo random).
+  *
+  */
+void st_bench_mock_init(st_bench_mock *mock, stmdev_ctx_t *ctx,
+                        uint32_t seed)
+{
+  uint16_t i;
+
+  for (i = 0; i < sizeof(mock->reg); i++) {
+    seed = (seed * 1103515245U) + 12345U;
+    mock->reg[i] = (uint8_t)(seed >> 16);
+  }
+
+  ctx->write_reg = mock_write;
+  ctx->read_reg = mock_read;
+  ctx->handle = mock;
+}
+
+/*
+ * @brief  Time per call of run (best of ST_BENCH_REPEAT), the number of
+ *         calls is doubled until ST_BENCH_MIN_TIME has elapsed.
+ *
+ */
+static double case_run(void (*run)(void))
+{
+  double best = 0.0;
+  uint32_t calls = 1;
+  uint32_t start;
+  uint32_t time;
+  uint32_t n;
+  uint32_t r;
+
+  do {
+    calls *= 2U;
+    start = timer_get();
+    for (n = 0; n < calls; n++) {
+      run();
+    }
+    time = timer_get() - start;
+  } while ((time < ST_BENCH_MIN_TIME) && (calls < 0x40000000U));
+
+  for (r = 0; r < ST_BENCH_REPEAT; r++) {
+    start = timer_get();
+    for (n = 0; n < calls; n++) {
+      run();
+    }
+    time = timer_get() - start;
+    if ((r == 0U) || (((double)time / (double)calls) < best)) {
+      best = (double)time / (double)calls;
+    }
+  }
+
+  return best;
+}
+
+static void empty(void)
+{
+  st_bench_sink++;
+}
+
+#if defined(ST_BENCH_CYCCNT)
+static void timer_init(void)
+{
+  DEMCR |= DEMCR_TRCENA;
+  DWT_CYCCNT = 0;
+  DWT_CTRL |= DWT_CYCCNTENA;
+}
+
+/* wraps every 2^32 cycles, differences are taken modulo 2^32 */
+static uint32_t timer_get(void)
+{
+  return DWT_CYCCNT;
+}
+#else
+static void timer_init(void)
+{
+}
+
+/* ns, wraps every 4.29 s, differences are taken modulo 2^32 */
+static uint32_t timer_get(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000U) +
+                    (uint64_t)ts.tv_nsec);
+}
+#endif
+
+static int32_t mock_write(void *handle, uint8_t reg, uint8_t *data,
+                          uint16_t len)
+{
+  st_bench_mock *mock = (st_bench_mock *)handle;
+  uint16_t i;
+
+  for (i = 0; i < len; i++) {
+    mock->reg[(uint8_t)(reg + i)] = data[i];
+  }
+
+  return 0;
+}
+
+static int32_t mock_read(void *handle, uint8_t reg, uint8_t *data,
+                         uint16_t len)
+{
+  st_bench_mock *mock = (st_bench_mock *)handle;
+  uint16_t i;
+
+  for (i = 0; i < len; i++) {
+    data[i] = mock->reg[(uint8_t)(reg + i)];
+  }
+
+  return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ ******************************************************************************
+ * @file    driver_bench.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains the definitions shared by the driver
+ *          microbenchmarks.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_BENCH_H
+#define ST_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/** @addtogroup Driver benchmark
+  * @brief    CPU cost of the driver side code (register unpacking, unit
+  *           conversions, FIFO decoding) measured on a zero latency mock
+  *           bus: register reads and writes are copies from / to a
+  *           register image in RAM, so the figures isolate the compute.
+  *
+  *           Every driver has its own case table (bench_xxx.c); a case
+  *           is a function running the code under test once, ops is the
+  *           number of operations per call the result is divided by
+  *           (e.g. FIFO words decoded per call).
+  * @{
+  *
+  */
+
+#ifndef MEMS_SHARED_TYPES
+#define MEMS_SHARED_TYPES
+
+typedef struct{
+  uint8_t bit0       : 1;
+  uint8_t bit1       : 1;
+  uint8_t bit2       : 1;
+  uint8_t bit3       : 1;
+  uint8_t bit4       : 1;
+  uint8_t bit5       : 1;
+  uint8_t bit6       : 1;
+  uint8_t bit7       : 1;
+} bitwise_t;
+
+#define PROPERTY_DISABLE                (0U)
+#define PROPERTY_ENABLE                 (1U)
+
+/** @addtogroup  Interfaces_Functions
+  * @brief       This section provide a set of functions used to read and
+  *              write a generic register of the device.
+  *              MANDATORY: return 0 -> no Error.
+  * @{
+  *
+  */
+
+typedef int32_t (*stmdev_write_ptr)(void *, uint8_t, uint8_t*, uint16_t);
+typedef int32_t (*stmdev_read_ptr) (void *, uint8_t, uint8_t*, uint16_t);
+
+typedef struct {
+  /** Component mandatory fields **/
+  stmdev_write_ptr  write_reg;
+  stmdev_read_ptr   read_reg;
+  /** Customizable optional pointer **/
+  void *handle;
+} stmdev_ctx_t;
+
+/**
+  * @}
+  *
+  */
+
+#endif /* MEMS_SHARED_TYPES */
+
+/** @defgroup Driver_benchmark_pubblic_definitions
+  * @{
+  *
+  */
+
+typedef struct {
+  const char *name;
+  void (*run)(void);
+  uint32_t ops;                   /* operations per call, 0 = 1 */
+} st_bench_case;
+
+typedef struct {
+  const char *driver;
+  void (*init)(void);             /* mock registers, configuration */
+  const st_bench_case *cases;
+  uint16_t case_num;
+} st_bench_table;
+
+/* Register image of the mock bus, one per device */
+typedef struct {
+  uint8_t reg[256];
+} st_bench_mock;
+
+/**
+  * @}
+  *
+  */
+
+void st_bench_run(const char *driver);
+
+void st_bench_mock_init(st_bench_mock *mock, stmdev_ctx_t *ctx,
+                        uint32_t seed);
+
+extern volatile uint32_t st_bench_sink;
+
+extern const st_bench_table st_bench_lsm6dsox;
+extern const st_bench_table st_bench_lis3dsh;
+extern const st_bench_table st_bench_fifo;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_BENCH_H */
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,416 @@
+/*
+ ******************************************************************************
+ * @file    env_one_shot.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Synchronized one-shot sampling of the environmental sensors.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "env_one_shot.h"
+#include "hts221_reg.h"
+#include "lps22hb_reg.h"
+#include "lps22hh_reg.h"
+#include "lps33hw_reg.h"
+#include "stts22h_reg.h"
+
+/**
+  * @defgroup  Environmental one-shot
+  * @brief     This file provides a set of functions needed to trigger,
+  *            wait and read single conversions of several environmental
+  *            sensors in one measurement cycle.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+#define OUT_MAX                  (6U)   /* status + output registers */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint32_t conv_us;             /* default conversion time (upper bound) */
+  uint8_t out_reg;              /* first register of the burst */
+  uint8_t out_len;
+} part_desc;
+
+/* Private variables ---------------------------------------------------------*/
+/*
+ * Conversion times: period of the fastest data rate of the part, that is
+ * an upper bound of a single conversion with the default averaging.
+ */
+static const part_desc part_table[ST_ENV_PART_NUM] = {
+  /* HTS221:  12.5 Hz, STATUS_REG + HUMIDITY_OUT + TEMP_OUT */
+  { 80000U, HTS221_STATUS_REG, 5U },
+  /* LPS22HB: 75 Hz, STATUS + PRESS_OUT + TEMP_OUT */
+  { 13400U, LPS22HB_STATUS, 6U },
+  /* LPS22HH: 200 Hz (low current), STATUS + PRESS_OUT + TEMP_OUT */
+  { 5000U, LPS22HH_STATUS, 6U },
+  /* LPS33HW: 75 Hz, STATUS + PRESS_OUT + TEMP_OUT */
+  { 13400U, LPS33HW_STATUS, 6U },
+  /* STTS22H: 200 Hz, STATUS + TEMP_OUT */
+  { 5000U, STTS22H_STATUS, 3U },
+};
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t part_init(st_env_dev *dev);
+static void part_decode(const st_env_dev *dev, const uint8_t *buf,
+                        st_env_data *data);
+static float_t linear_interpolation(const float_t *cal, int16_t x);
+static uint32_t conv_time(const st_env_dev *dev);
+
+/**
+  * @defgroup    Environmental_one_shot_pubblic_functions
+  * @brief       This section provide a set of APIs for synchronized
+  *              single conversions.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Put the devices in one-shot mode (power down between the
+  *         conversions) and read the HTS221 calibration.
+  *         To be called again after any change of the one-shot control
+  *         registers made outside this utility.
+  *
+  * @param  dev               devices, part and ctx set.(ptr)
+  * @param  dev_num           number of devices (max ST_ENV_DEV_MAX).
+  * @retval st_env_status     ST_ENV_OK / ST_ENV_ERR (bad parameters or
+  *                           bus error)
+  *
+  */
+st_env_status st_env_init(st_env_dev *dev, uint16_t dev_num)
+{
+  uint16_t i;
+
+  if ((dev == NULL) || (dev_num > ST_ENV_DEV_MAX)) {
+    return ST_ENV_ERR;
+  }
+
+  for (i = 0; i < dev_num; i++) {
+    if ((dev[i].part >= ST_ENV_PART_NUM) || (part_init(&dev[i]) != 0)) {
+      return ST_ENV_ERR;
+    }
+  }
+
+  return ST_ENV_OK;
+}
+
+/**
+  * @brief  Measurement cycle: trigger all the devices, wait their
+  *         conversion times and read each of them with one burst.
+  *
+  *         Triggers are issued longest conversion first, reads in order
+  *         of conversion time; the waits count only the delays, so the
+  *         bus time of triggers and reads adds margin to every device.
+  *         The cycle lasts the longest conversion time plus one write
+  *         and one read per device.
+  *
+  * @param  dev               devices, initialized with st_env_init().(ptr)
+  * @param  dev_num           number of devices (max ST_ENV_DEV_MAX).
+  * @param  delay             platform delay.(ptr)
+  * @param  handle            delay argument.(ptr)
+  * @param  data              measurements, one per device.(ptr)
+  * @retval st_env_status     ST_ENV_OK / ST_ENV_ERR (bad parameters or
+  *                           bus error)
+  *
+  */
+st_env_status st_env_one_shot(st_env_dev *dev, uint16_t dev_num,
+                              st_env_delay_ptr delay, void *handle,
+                              st_env_data *data)
+{
+  uint8_t order[ST_ENV_DEV_MAX];
+  uint8_t buf[OUT_MAX];
+  const part_desc *desc;
+  uint32_t elapsed_us = 0;
+  uint32_t conv_us;
+  int32_t ret = 0;
+  uint16_t i;
+  uint16_t j;
+  uint8_t k;
+
+  if ((dev == NULL) || (delay == NULL) || (data == NULL) ||
+      (dev_num > ST_ENV_DEV_MAX)) {
+    return ST_ENV_ERR;
+  }
+
+  /* order by conversion time, shortest first (insertion sort) */
+  for (i = 0; i < dev_num; i++) {
+    k = (uint8_t)i;
+    for (j = i; (j > 0U) &&
+                (conv_time(&dev[order[j - 1U]]) > conv_time(&dev[k])); j--) {
+      order[j] = order[j - 1U];
+    }
+    order[j] = k;
+  }
+
+  /* trigger, longest conversion first */
+  for (i = dev_num; (i > 0U) && (ret == 0); i--) {
+    k = order[i - 1U];
+    ret = dev[k].ctx.write_reg(dev[k].ctx.handle, dev[k].trig_reg,
+                               &dev[k].trig_val, 1);
+  }
+
+  /* wait the end of every conversion and read status + outputs */
+  for (i = 0; (i < dev_num) && (ret == 0); i++) {
+    k = order[i];
+    conv_us = conv_time(&dev[k]);
+    if (conv_us > elapsed_us) {
+      delay(handle, conv_us - elapsed_us);
+      elapsed_us = conv_us;
+    }
+
+    desc = &part_table[dev[k].part];
+    ret = dev[k].ctx.read_reg(dev[k].ctx.handle, desc->out_reg, buf,
+                              desc->out_len);
+    if (ret == 0) {
+      part_decode(&dev[k], buf, &data[k]);
+    }
+  }
+
+  return (ret == 0) ? ST_ENV_OK : ST_ENV_ERR;
+}
+
+/**
+  * @brief  Default conversion time of a part (upper bound).
+  *
+  * @param  part              part.
+  * @retval                   conversion time [us], 0 if unknown part
+  *
+  */
+uint32_t st_env_conv_time_get(st_env_part part)
+{
+  if (part >= ST_ENV_PART_NUM) {
+    return 0;
+  }
+
+  return part_table[part].conv_us;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @brief  One-shot configuration of a device, the value of the one-shot
+  *         control register is kept so that every trigger is one write.
+  *
+  */
+static int32_t part_init(st_env_dev *dev)
+{
+  stmdev_ctx_t *ctx = &dev->ctx;
+  int32_t ret = 0;
+
+  switch (dev->part) {
+    case ST_ENV_HTS221:
+      ret = hts221_hum_adc_point_0_get(ctx, &dev->hum_cal[0]);
+      if (ret == 0) {
+        ret = hts221_hum_rh_point_0_get(ctx, &dev->hum_cal[1]);
+      }
+      if (ret == 0) {
+        ret = hts221_hum_adc_point_1_get(ctx, &dev->hum_cal[2]);
+      }
+      if (ret == 0) {
+        ret = hts221_hum_rh_point_1_get(ctx, &dev->hum_cal[3]);
+      }
+      if (ret == 0) {
+        ret = hts221_temp_adc_point_0_get(ctx, &dev->temp_cal[0]);
+      }
+      if (ret == 0) {
+        ret = hts221_temp_deg_point_0_get(ctx, &dev->temp_cal[1]);
+      }
+      if (ret == 0) {
+        ret = hts221_temp_adc_point_1_get(ctx, &dev->temp_cal[2]);
+      }
+      if (ret == 0) {
+        ret = hts221_temp_deg_point_1_get(ctx, &dev->temp_cal[3]);
+      }
+      if (ret == 0) {
+        ret = hts221_block_data_update_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        ret = hts221_data_rate_set(ctx, HTS221_ONE_SHOT);
+      }
+      if (ret == 0) {
+        ret = hts221_power_on_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        hts221_ctrl_reg2_t ctrl_reg2;
+        ret = hts221_read_reg(ctx, HTS221_CTRL_REG2,
+                              (uint8_t*)&ctrl_reg2, 1);
+        ctrl_reg2.one_shot = PROPERTY_ENABLE;
+        dev->trig_reg = HTS221_CTRL_REG2;
+        dev->trig_val = *(uint8_t*)&ctrl_reg2;
+      }
+      break;
+
+    case ST_ENV_LPS22HB:
+      ret = lps22hb_data_rate_set(ctx, LPS22HB_POWER_DOWN);
+      if (ret == 0) {
+        ret = lps22hb_block_data_update_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        ret = lps22hb_auto_add_inc_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        lps22hb_ctrl_reg2_t ctrl_reg2;
+        ret = lps22hb_read_reg(ctx, LPS22HB_CTRL_REG2,
+                               (uint8_t*)&ctrl_reg2, 1);
+        ctrl_reg2.one_shot = PROPERTY_ENABLE;
+        dev->trig_reg = LPS22HB_CTRL_REG2;
+        dev->trig_val = *(uint8_t*)&ctrl_reg2;
+      }
+      break;
+
+    case ST_ENV_LPS22HH:
+      ret = lps22hh_data_rate_set(ctx, LPS22HH_POWER_DOWN);
+      if (ret == 0) {
+        ret = lps22hh_block_data_update_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        ret = lps22hh_auto_increment_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        lps22hh_ctrl_reg2_t ctrl_reg2;
+        ret = lps22hh_read_reg(ctx, LPS22HH_CTRL_REG2,
+                               (uint8_t*)&ctrl_reg2, 1);
+        ctrl_reg2.one_shot = PROPERTY_ENABLE;
+        dev->trig_reg = LPS22HH_CTRL_REG2;
+        dev->trig_val = *(uint8_t*)&ctrl_reg2;
+      }
+      break;
+
+    case ST_ENV_LPS33HW:
+      ret = lps33hw_data_rate_set(ctx, LPS33HW_POWER_DOWN);
+      if (ret == 0) {
+        ret = lps33hw_block_data_update_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        ret = lps33hw_auto_add_inc_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        lps33hw_ctrl_reg2_t ctrl_reg2;
+        ret = lps33hw_read_reg(ctx, LPS33HW_CTRL_REG2,
+                               (uint8_t*)&ctrl_reg2, 1);
+        ctrl_reg2.one_shot = PROPERTY_ENABLE;
+        dev->trig_reg = LPS33HW_CTRL_REG2;
+        dev->trig_val = *(uint8_t*)&ctrl_reg2;
+      }
+      break;
+
+    case ST_ENV_STTS22H:
+      ret = stts22h_block_data_update_set(ctx, PROPERTY_ENABLE);
+      if (ret == 0) {
+        ret = stts22h_auto_increment_set(ctx, PROPERTY_ENABLE);
+      }
+      if (ret == 0) {
+        /* leaves free-run mode (software reset sequence) */
+        ret = stts22h_temp_data_rate_set(ctx, STTS22H_ONE_SHOT);
+      }
+      if (ret == 0) {
+        stts22h_ctrl_t ctrl;
+        ret = stts22h_read_reg(ctx, STTS22H_CTRL, (uint8_t*)&ctrl, 1);
+        ctrl.one_shot = PROPERTY_ENABLE;
+        dev->trig_reg = STTS22H_CTRL;
+        dev->trig_val = *(uint8_t*)&ctrl;
+      }
+      break;
+
+    default:
+      ret = -1;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Measurements from the burst of status and output registers.
+  *
+  */
+static void part_decode(const st_env_dev *dev, const uint8_t *buf,
+                        st_env_data *data)
+{
+  int32_t press;
+  int16_t temp;
+  int16_t hum;
+
+  data->pressure_hPa = 0.0f;
+  data->humidity_perc = 0.0f;
+
+  switch (dev->part) {
+    case ST_ENV_HTS221:
+      /* t_da, h_da */
+      data->valid = ((buf[0] & 0x03U) == 0x03U) ? 1U : 0U;
+      hum = (int16_t)((uint16_t)buf[1] | ((uint16_t)buf[2] << 8));
+      temp = (int16_t)((uint16_t)buf[3] | ((uint16_t)buf[4] << 8));
+      data->humidity_perc = linear_interpolation(dev->hum_cal, hum);
+      data->temperature_degC = linear_interpolation(dev->temp_cal, temp);
+      break;
+
+    case ST_ENV_LPS22HB:
+    case ST_ENV_LPS22HH:
+    case ST_ENV_LPS33HW:
+      /* p_da, t_da */
+      data->valid = ((buf[0] & 0x03U) == 0x03U) ? 1U : 0U;
+      press = (int32_t)((uint32_t)buf[1] | ((uint32_t)buf[2] << 8) |
+                        ((uint32_t)buf[3] << 16));
+      temp = (int16_t)((uint16_t)buf[4] | ((uint16_t)buf[5] << 8));
+      if (dev->part == ST_ENV_LPS22HB) {
+        data->pressure_hPa = lps22hb_from_lsb_to_hpa(press);
+        data->temperature_degC = lps22hb_from_lsb_to_degc(temp);
+      }
+      else if (dev->part == ST_ENV_LPS33HW) {
+        data->pressure_hPa = lps33hw_from_lsb_to_hpa(press);
+        data->temperature_degC = lps33hw_from_lsb_to_degc(temp);
+      }
+      else {
+        data->pressure_hPa = lps22hh_from_lsb_to_hpa((uint32_t)press << 8);
+        data->temperature_degC = lps22hh_from_lsb_to_celsius(temp);
+      }
+      break;
+
+    default:
+      /* STTS22H: not busy */
+      data->valid = ((buf[0] & 0x01U) == 0x00U) ? 1U : 0U;
+      temp = (int16_t)((uint16_t)buf[1] | ((uint16_t)buf[2] << 8));
+      data->temperature_degC = stts22h_from_lsb_to_celsius(temp);
+      break;
+  }
+}
+
+/**
+  * @brief  HTS221 calibration: linear interpolation of the two points.
+  *
+  */
+static float_t linear_interpolation(const float_t *cal, int16_t x)
+{
+  return (((cal[3] - cal[1]) * (float_t)x) +
+          ((cal[2] * cal[1]) - (cal[0] * cal[3]))) / (cal[2] - cal[0]);
+}
+
+/**
+  * @brief  Conversion time of a device: its own or the part default.
+  *
+  */
+static uint32_t conv_time(const st_env_dev *dev)
+{
+  return (dev->conv_us != 0U) ? dev->conv_us :
+         part_table[dev->part].conv_us;
+}
+
+/**
+  * @}
+  *
+  */
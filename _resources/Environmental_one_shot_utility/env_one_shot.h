@@ -0,0 +1,170 @@
+/*
+ ******************************************************************************
+ * @file    env_one_shot.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          env_one_shot.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_ENV_ONE_SHOT_H
+#define ST_ENV_ONE_SHOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+/** @addtogroup Environmental one-shot
+  * @brief    Synchronized single conversions of the environmental sensors
+  *           (HTS221, LPS22HB, LPS22HH, LPS33HW, STTS22H) kept in power
+  *           down between the measurement cycles.
+  *
+  *           A cycle triggers all the devices in one pass (one register
+  *           write each, longest conversion first), waits the known
+  *           conversion times with the platform delay (no status
+  *           polling) and reads every device with one burst of status
+  *           and output registers, in order of end of conversion.
+  *           The bus is idle between the cycles and during the waits.
+  *
+  *           Conversion times default to upper bounds (period of the
+  *           fastest data rate of the part) and can be set per device;
+  *           the status read with the data tells if the time was enough.
+  *
+  *           Multi byte reads need the register address auto increment:
+  *           the utility enables it on the parts that have a control bit,
+  *           on the HTS221 the platform read must set the register MSB
+  *           (0x80), as in the driver examples.
+  * @{
+  *
+  */
+
+#ifndef MEMS_SHARED_TYPES
+#define MEMS_SHARED_TYPES
+
+typedef struct{
+  uint8_t bit0       : 1;
+  uint8_t bit1       : 1;
+  uint8_t bit2       : 1;
+  uint8_t bit3       : 1;
+  uint8_t bit4       : 1;
+  uint8_t bit5       : 1;
+  uint8_t bit6       : 1;
+  uint8_t bit7       : 1;
+} bitwise_t;
+
+#define PROPERTY_DISABLE                (0U)
+#define PROPERTY_ENABLE                 (1U)
+
+/** @addtogroup  Interfaces_Functions
+  * @brief       This section provide a set of functions used to read and
+  *              write a generic register of the device.
+  *              MANDATORY: return 0 -> no Error.
+  * @{
+  *
+  */
+
+typedef int32_t (*stmdev_write_ptr)(void *, uint8_t, uint8_t*, uint16_t);
+typedef int32_t (*stmdev_read_ptr) (void *, uint8_t, uint8_t*, uint16_t);
+
+typedef struct {
+  /** Component mandatory fields **/
+  stmdev_write_ptr  write_reg;
+  stmdev_read_ptr   read_reg;
+  /** Customizable optional pointer **/
+  void *handle;
+} stmdev_ctx_t;
+
+/**
+  * @}
+  *
+  */
+
+#endif /* MEMS_SHARED_TYPES */
+
+/** @defgroup Environmental_one_shot_pubblic_definitions
+  * @{
+  *
+  */
+
+#define ST_ENV_DEV_MAX           (16U)
+
+typedef enum {
+  ST_ENV_OK = 0,
+  ST_ENV_ERR
+} st_env_status;
+
+typedef enum {
+  ST_ENV_HTS221 = 0,
+  ST_ENV_LPS22HB,
+  ST_ENV_LPS22HH,
+  ST_ENV_LPS33HW,
+  ST_ENV_STTS22H,
+  ST_ENV_PART_NUM
+} st_env_part;
+
+/**
+  * @brief  Platform delay, at least us microseconds.
+  */
+typedef void (*st_env_delay_ptr)(void *handle, uint32_t us);
+
+/**
+  * @brief  Device of the measurement cycle. part, ctx and conv_us are
+  *         set by the application, the other fields by st_env_init().
+  */
+typedef struct {
+  st_env_part part;
+  stmdev_ctx_t ctx;
+  uint32_t conv_us;           /* conversion time, 0: part default */
+  uint8_t trig_reg;           /* one-shot control register */
+  uint8_t trig_val;           /* its value with the one-shot bit set */
+  float_t hum_cal[4];         /* HTS221: adc 0, rh 0, adc 1, rh 1 */
+  float_t temp_cal[4];        /* HTS221: adc 0, deg 0, adc 1, deg 1 */
+} st_env_dev;
+
+typedef struct {
+  uint8_t valid;              /* 1: all the outputs of the part updated */
+  float_t temperature_degC;
+  float_t pressure_hPa;       /* LPS22HB, LPS22HH, LPS33HW */
+  float_t humidity_perc;      /* HTS221 */
+} st_env_data;
+
+/**
+  * @}
+  *
+  */
+
+st_env_status st_env_init(st_env_dev *dev, uint16_t dev_num);
+
+st_env_status st_env_one_shot(st_env_dev *dev, uint16_t dev_num,
+                              st_env_delay_ptr delay, void *handle,
+                              st_env_data *data);
+
+uint32_t st_env_conv_time_get(st_env_part part);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_ENV_ONE_SHOT_H */
+
+/**
+  * @}
+  *
+  */
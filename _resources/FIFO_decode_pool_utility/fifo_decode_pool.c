@@ -0,0 +1,863 @@
+/*
+ ******************************************************************************
+ * @file    fifo_decode_pool.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Multi-device FIFO decoding on a pool of worker threads.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "fifo_decode_pool.h"
+
+/**
+  * @defgroup  FIFO decode pool
+  * @brief     This file provides a set of functions needed to decode the
+  *            FIFO streams of many devices on a pool of threads.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+#define SLOTS_PER_WORD           (3U)    /* max decoded slots per word */
+#define BUF_MIN                  (64U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct st_pool_job_s {
+  struct st_pool_job_s *next;
+  uint16_t len;
+  st_fifo_raw_slot raw[];
+} st_pool_job;
+
+typedef struct {
+  /* owned by the worker holding the device (scheduled = 1) */
+  st_fifo_state state;
+  /* protected by lock */
+  pthread_mutex_t lock;
+  st_pool_job *job_head;
+  st_pool_job *job_tail;
+  uint8_t scheduled;          /* queued on a worker or being decoded */
+  uint8_t seen;               /* at least one slot decoded */
+  uint32_t newest;            /* newest decoded timestamp */
+  uint32_t errors;            /* batches with decoding errors */
+  st_fifo_out_slot *out;      /* decoded slots, sorted by timestamp */
+  uint32_t out_num;
+  uint32_t out_size;
+  /* owned by the st_pool_merge() caller */
+  st_fifo_out_slot *stage;
+  uint32_t stage_head;
+  uint32_t stage_num;
+  uint32_t stage_size;
+} st_pool_dev;
+
+typedef struct {
+  uint32_t timestamp;         /* oldest staged slot of the device */
+  uint16_t dev;
+} st_pool_heap;
+
+typedef struct {
+  pthread_t thread;
+  pthread_mutex_t lock;
+  uint16_t *queue;            /* ring of device indexes, dev_num entries */
+  uint32_t head;
+  uint32_t num;
+  st_fifo_out_slot *scratch;
+  uint32_t scratch_size;
+  st_pool *pool;
+  uint16_t id;
+} st_pool_worker;
+
+struct st_pool_s {
+  st_pool_cfg cfg;
+  st_pool_dev *dev;
+  st_pool_worker *worker;
+  st_pool_heap *heap;         /* merge min-heap, dev_num entries */
+  pthread_mutex_t lock;
+  pthread_cond_t work_cv;     /* ready > 0 or stop */
+  pthread_cond_t idle_cv;     /* pending == 0 */
+  uint32_t ready;             /* devices queued and not claimed */
+  uint32_t pending;           /* batches submitted and not decoded */
+  uint16_t started;           /* worker threads running */
+  uint8_t stop;
+};
+
+/* Private functions ---------------------------------------------------------*/
+/*  Functions declare in this section are defined at the end of this file.    */
+static void *worker_main(void *arg);
+static void worker_push(st_pool_worker *worker, uint16_t dev);
+static uint8_t worker_pop(st_pool_worker *worker, uint16_t *dev);
+static uint8_t worker_steal(st_pool_worker *worker, uint16_t *dev);
+static void dev_schedule(st_pool *pool, uint16_t worker, uint16_t dev);
+static void dev_decode(st_pool_worker *worker, uint16_t dev);
+static void dev_store(st_pool_dev *dev, const st_fifo_out_slot *slot,
+                      uint32_t num);
+static uint32_t dev_ready(const st_pool_dev *dev, uint32_t limit);
+static void heap_down(st_pool_heap *heap, uint32_t num, uint32_t i);
+static uint8_t heap_less(const st_pool_heap *a, const st_pool_heap *b);
+static int32_t ts_diff(uint32_t a, uint32_t b);
+static uint8_t buf_reserve(st_fifo_out_slot **buf, uint32_t *size,
+                           uint32_t num);
+
+/**
+  * @defgroup  FIFO_pool_pubblic_functions
+  * @brief     This section provide a set of APIs for decoding the FIFO
+  *            streams of many devices in parallel.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Create the pool and start the worker threads.
+  *
+  * @param  pool              created pool.(ptr)
+  * @param  cfg               pool configuration.(ptr)
+  *
+  * @retval st_pool_status    ST_POOL_OK /  ST_POOL_ERR
+  *
+  */
+st_pool_status st_pool_init(st_pool **pool, const st_pool_cfg *cfg)
+{
+  st_pool *p;
+  uint16_t thread_num;
+  uint16_t i;
+  long cpu;
+
+  if ((pool == NULL) || (cfg == NULL) || (cfg->dev_num == 0U) ||
+      (cfg->dev_cfg == NULL)) {
+    return ST_POOL_ERR;
+  }
+
+  thread_num = cfg->thread_num;
+  if (thread_num == 0U) {
+    cpu = sysconf(_SC_NPROCESSORS_ONLN);
+    thread_num = (cpu > 0) ? (uint16_t)cpu : 1U;
+  }
+
+  p = calloc(1, sizeof(st_pool));
+  if (p == NULL) {
+    return ST_POOL_ERR;
+  }
+
+  p->cfg = *cfg;
+  p->cfg.thread_num = thread_num;
+  p->dev = calloc(cfg->dev_num, sizeof(st_pool_dev));
+  p->worker = calloc(thread_num, sizeof(st_pool_worker));
+  p->heap = calloc(cfg->dev_num, sizeof(st_pool_heap));
+  if ((p->dev == NULL) || (p->worker == NULL) || (p->heap == NULL)) {
+    free(p->dev);
+    free(p->worker);
+    free(p->heap);
+    free(p);
+    return ST_POOL_ERR;
+  }
+
+  pthread_mutex_init(&p->lock, NULL);
+  pthread_cond_init(&p->work_cv, NULL);
+  pthread_cond_init(&p->idle_cv, NULL);
+
+  for (i = 0; i < cfg->dev_num; i++) {
+    (void)st_fifo_state_init(&p->dev[i].state, cfg->dev_cfg[i].bdr_xl,
+                             cfg->dev_cfg[i].bdr_gy,
+                             cfg->dev_cfg[i].bdr_vsens);
+    pthread_mutex_init(&p->dev[i].lock, NULL);
+  }
+
+  for (i = 0; i < thread_num; i++) {
+    p->worker[i].pool = p;
+    p->worker[i].id = i;
+    pthread_mutex_init(&p->worker[i].lock, NULL);
+    p->worker[i].queue = calloc(cfg->dev_num, sizeof(uint16_t));
+  }
+
+  for (i = 0; i < thread_num; i++) {
+    if ((p->worker[i].queue == NULL) ||
+        (pthread_create(&p->worker[i].thread, NULL, worker_main,
+                        &p->worker[i]) != 0)) {
+      /* stop the threads already started */
+      st_pool_deinit(p);
+      return ST_POOL_ERR;
+    }
+    p->started++;
+  }
+
+  *pool = p;
+
+  return ST_POOL_OK;
+}
+
+/**
+  * @brief  Stop the worker threads and release the pool. Batches not yet
+  *         decoded are discarded.
+  *
+  * @param  pool              pool.(ptr)
+  *
+  */
+void st_pool_deinit(st_pool *pool)
+{
+  st_pool_job *job;
+  uint16_t i;
+
+  if (pool == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  pool->stop = 1;
+  pthread_cond_broadcast(&pool->work_cv);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (i = 0; i < pool->started; i++) {
+    pthread_join(pool->worker[i].thread, NULL);
+  }
+
+  for (i = 0; i < pool->cfg.thread_num; i++) {
+    free(pool->worker[i].queue);
+    free(pool->worker[i].scratch);
+    pthread_mutex_destroy(&pool->worker[i].lock);
+  }
+
+  for (i = 0; i < pool->cfg.dev_num; i++) {
+    while (pool->dev[i].job_head != NULL) {
+      job = pool->dev[i].job_head;
+      pool->dev[i].job_head = job->next;
+      free(job);
+    }
+    free(pool->dev[i].out);
+    free(pool->dev[i].stage);
+    pthread_mutex_destroy(&pool->dev[i].lock);
+  }
+
+  pthread_cond_destroy(&pool->work_cv);
+  pthread_cond_destroy(&pool->idle_cv);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool->heap);
+  free(pool->worker);
+  free(pool->dev);
+  free(pool);
+}
+
+/**
+  * @brief  Submit a raw FIFO batch of a device. The batch is copied, so
+  *         the buffer can be reused as soon as the function returns.
+  *         Batches of the same device are decoded in submission order.
+  *
+  * @param  pool              pool.(ptr)
+  * @param  dev               device index.
+  * @param  raw               raw FIFO words.(ptr)
+  * @param  len               number of raw FIFO words.
+  *
+  * @retval st_pool_status    ST_POOL_OK /  ST_POOL_ERR
+  *
+  */
+st_pool_status st_pool_submit(st_pool *pool, uint16_t dev,
+                              const st_fifo_raw_slot *raw, uint16_t len)
+{
+  st_pool_dev *d;
+  st_pool_job *job;
+  uint8_t schedule;
+
+  if ((pool == NULL) || (dev >= pool->cfg.dev_num) || (raw == NULL)) {
+    return ST_POOL_ERR;
+  }
+  if (len == 0U) {
+    return ST_POOL_OK;
+  }
+
+  job = malloc(sizeof(st_pool_job) + (len * sizeof(st_fifo_raw_slot)));
+  if (job == NULL) {
+    return ST_POOL_ERR;
+  }
+  job->next = NULL;
+  job->len = len;
+  memcpy(job->raw, raw, len * sizeof(st_fifo_raw_slot));
+
+  /* counted before it can be decoded */
+  pthread_mutex_lock(&pool->lock);
+  pool->pending++;
+  pthread_mutex_unlock(&pool->lock);
+
+  d = &pool->dev[dev];
+  pthread_mutex_lock(&d->lock);
+  if (d->job_tail != NULL) {
+    d->job_tail->next = job;
+  }
+  else {
+    d->job_head = job;
+  }
+  d->job_tail = job;
+  schedule = (d->scheduled == 0U) ? 1U : 0U;
+  d->scheduled = 1;
+  pthread_mutex_unlock(&d->lock);
+
+  if (schedule != 0U) {
+    dev_schedule(pool, dev % pool->cfg.thread_num, dev);
+  }
+
+  return ST_POOL_OK;
+}
+
+/**
+  * @brief  Wait until all the submitted batches are decoded.
+  *
+  * @param  pool              pool.(ptr)
+  *
+  */
+void st_pool_wait(st_pool *pool)
+{
+  pthread_mutex_lock(&pool->lock);
+  while (pool->pending > 0U) {
+    pthread_cond_wait(&pool->idle_cv, &pool->lock);
+  }
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+  * @brief  Get the decoded slots of all the devices in timestamp order
+  *         (equal timestamps in device index order).
+  *         Without flush only slots not newer than the newest timestamp
+  *         of every device minus reorder_window are returned: a slot
+  *         decoded later is expected to be newer than that. Devices
+  *         without submitted batches are not considered, while a device
+  *         has submitted batches and no decoded slot yet nothing is
+  *         returned (its timestamps are not known).
+  *         With flush the function waits all submitted batches and
+  *         returns all the remaining slots.
+  *         Slots exceeding max are kept for the next call.
+  *         The function must be called by one thread at a time.
+  *
+  * @param  pool              pool.(ptr)
+  * @param  out               merged slots.(ptr)
+  * @param  max               out size.
+  * @param  flush             0: only slots that can be ordered /
+  *                           1: all slots.
+  *
+  * @retval uint32_t          number of slots in out.
+  *
+  */
+uint32_t st_pool_merge(st_pool *pool, st_pool_out_slot *out, uint32_t max,
+                       uint8_t flush)
+{
+  st_pool_dev *d;
+  uint32_t limit = 0;
+  uint32_t heap_num = 0;
+  uint32_t num = 0;
+  uint32_t ready;
+  uint8_t seen = 0;
+  uint8_t hold = 0;
+  uint16_t i;
+
+  if (flush != 0U) {
+    st_pool_wait(pool);
+  }
+  else {
+    for (i = 0; i < pool->cfg.dev_num; i++) {
+      d = &pool->dev[i];
+      pthread_mutex_lock(&d->lock);
+      if (d->seen != 0U) {
+        if ((seen == 0U) || (ts_diff(d->newest, limit) < 0)) {
+          limit = d->newest;
+        }
+        seen = 1;
+      }
+      else if (d->scheduled != 0U) {
+        /* batches submitted, timestamps not known yet */
+        hold = 1;
+      }
+      else {
+        /* no batch submitted yet */
+      }
+      pthread_mutex_unlock(&d->lock);
+    }
+
+    /* without decoded slots out_num is 0 for every device */
+    limit -= pool->cfg.reorder_window;
+  }
+
+  /* move the slots that can be ordered from devices to merge stage */
+  for (i = 0; i < pool->cfg.dev_num; i++) {
+    d = &pool->dev[i];
+
+    if ((d->stage_head > 0U) && (d->stage_head < d->stage_num)) {
+      memmove(d->stage, &d->stage[d->stage_head],
+              (d->stage_num - d->stage_head) * sizeof(st_fifo_out_slot));
+    }
+    d->stage_num -= d->stage_head;
+    d->stage_head = 0;
+
+    pthread_mutex_lock(&d->lock);
+    if (flush != 0U) {
+      ready = d->out_num;
+    }
+    else {
+      ready = (hold == 0U) ? dev_ready(d, limit) : 0U;
+    }
+    if ((ready > 0U) &&
+        (buf_reserve(&d->stage, &d->stage_size,
+                     d->stage_num + ready) != 0U)) {
+      memcpy(&d->stage[d->stage_num], d->out,
+             ready * sizeof(st_fifo_out_slot));
+      d->stage_num += ready;
+      d->out_num -= ready;
+      memmove(d->out, &d->out[ready], d->out_num * sizeof(st_fifo_out_slot));
+    }
+    pthread_mutex_unlock(&d->lock);
+
+    if (d->stage_num > 0U) {
+      pool->heap[heap_num].timestamp = d->stage[0].timestamp;
+      pool->heap[heap_num].dev = i;
+      heap_num++;
+    }
+  }
+
+  /* k-way merge of the device stages */
+  for (i = (uint16_t)(heap_num / 2U); i > 0U; i--) {
+    heap_down(pool->heap, heap_num, i - 1U);
+  }
+
+  while ((num < max) && (heap_num > 0U)) {
+    d = &pool->dev[pool->heap[0].dev];
+    out[num].dev = pool->heap[0].dev;
+    out[num].slot = d->stage[d->stage_head];
+    num++;
+    d->stage_head++;
+
+    if (d->stage_head == d->stage_num) {
+      d->stage_head = 0;
+      d->stage_num = 0;
+      heap_num--;
+      pool->heap[0] = pool->heap[heap_num];
+    }
+    else {
+      pool->heap[0].timestamp = d->stage[d->stage_head].timestamp;
+    }
+    heap_down(pool->heap, heap_num, 0);
+  }
+
+  return num;
+}
+
+/**
+  * @brief  Number of batches of a device with decoding errors (wrong
+  *         tag parity or invalid tag: the rest of the batch is skipped).
+  *
+  * @param  pool              pool.(ptr)
+  * @param  dev               device index.
+  *
+  * @retval uint32_t          batches with errors.
+  *
+  */
+uint32_t st_pool_dev_errors(st_pool *pool, uint16_t dev)
+{
+  uint32_t errors;
+
+  if (dev >= pool->cfg.dev_num) {
+    return 0;
+  }
+
+  pthread_mutex_lock(&pool->dev[dev].lock);
+  errors = pool->dev[dev].errors;
+  pthread_mutex_unlock(&pool->dev[dev].lock);
+
+  return errors;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  FIFO pool private functions
+  * @brief     This section provide a set of private low-level functions
+  *            used by pubblic APIs.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Worker thread: claim a queued device, take it from the own
+  *         queue or steal it from another worker and decode one batch.
+  *
+  * @param  arg               worker.(ptr)
+  *
+  */
+static void *worker_main(void *arg)
+{
+  st_pool_worker *worker = (st_pool_worker *)arg;
+  st_pool *pool = worker->pool;
+  uint16_t dev;
+
+  for (;;) {
+    pthread_mutex_lock(&pool->lock);
+    while ((pool->ready == 0U) && (pool->stop == 0U)) {
+      pthread_cond_wait(&pool->work_cv, &pool->lock);
+    }
+    if (pool->stop != 0U) {
+      pthread_mutex_unlock(&pool->lock);
+      break;
+    }
+    pool->ready--;
+    pthread_mutex_unlock(&pool->lock);
+
+    /*
+     * The claimed device is in a queue, possibly just being pushed:
+     * look for it until found.
+     */
+    while ((worker_pop(worker, &dev) == 0U) &&
+           (worker_steal(worker, &dev) == 0U)) {
+      sched_yield();
+    }
+
+    dev_decode(worker, dev);
+  }
+
+  return NULL;
+}
+
+/**
+  * @brief  Decode the oldest batch of a device, then queue the device
+  *         again on the same worker if it has more batches.
+  *
+  * @param  worker            worker.(ptr)
+  * @param  dev               device index.
+  *
+  */
+static void dev_decode(st_pool_worker *worker, uint16_t dev)
+{
+  st_pool *pool = worker->pool;
+  st_pool_dev *d = &pool->dev[dev];
+  st_pool_job *job;
+  st_fifo_status ret = ST_FIFO_ERR;
+  uint16_t num = 0;
+  uint8_t more;
+
+  pthread_mutex_lock(&d->lock);
+  job = d->job_head;
+  d->job_head = job->next;
+  if (d->job_head == NULL) {
+    d->job_tail = NULL;
+  }
+  pthread_mutex_unlock(&d->lock);
+
+  /* decoder state is used only by the worker holding the device */
+  if (buf_reserve(&worker->scratch, &worker->scratch_size,
+                  (uint32_t)job->len * SLOTS_PER_WORD) != 0U) {
+    ret = st_fifo_state_decompress(&d->state, worker->scratch, job->raw,
+                                   &num, job->len);
+  }
+
+  pthread_mutex_lock(&d->lock);
+  if (ret != ST_FIFO_OK) {
+    d->errors++;
+  }
+  dev_store(d, worker->scratch, num);
+  more = (d->job_head != NULL) ? 1U : 0U;
+  if (more == 0U) {
+    d->scheduled = 0;
+  }
+  pthread_mutex_unlock(&d->lock);
+
+  free(job);
+
+  /* queued again at the end: other devices of this worker go first */
+  if (more != 0U) {
+    dev_schedule(pool, worker->id, dev);
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  pool->pending--;
+  if (pool->pending == 0U) {
+    pthread_cond_broadcast(&pool->idle_cv);
+  }
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+  * @brief  Queue a device on a worker and wake up one worker.
+  *
+  * @param  pool              pool.(ptr)
+  * @param  worker            worker index.
+  * @param  dev               device index.
+  *
+  */
+static void dev_schedule(st_pool *pool, uint16_t worker, uint16_t dev)
+{
+  worker_push(&pool->worker[worker], dev);
+
+  pthread_mutex_lock(&pool->lock);
+  pool->ready++;
+  pthread_cond_signal(&pool->work_cv);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+  * @brief  Add decoded slots to the device ones keeping them sorted by
+  *         timestamp (insertion from the newest: decoded slots are
+  *         almost sorted, so they are almost always appended).
+  *         Called with the device lock held.
+  *
+  * @param  dev               device.(ptr)
+  * @param  slot              decoded slots.(ptr)
+  * @param  num               number of slots.
+  *
+  */
+static void dev_store(st_pool_dev *dev, const st_fifo_out_slot *slot,
+                      uint32_t num)
+{
+  uint32_t i;
+  uint32_t j;
+
+  if ((num == 0U) ||
+      (buf_reserve(&dev->out, &dev->out_size, dev->out_num + num) == 0U)) {
+    return;
+  }
+
+  for (i = 0; i < num; i++) {
+    j = dev->out_num;
+    while ((j > 0U) &&
+           (ts_diff(dev->out[j - 1U].timestamp, slot[i].timestamp) > 0)) {
+      dev->out[j] = dev->out[j - 1U];
+      j--;
+    }
+    dev->out[j] = slot[i];
+    dev->out_num++;
+  }
+
+  if ((dev->seen == 0U) ||
+      (ts_diff(dev->out[dev->out_num - 1U].timestamp, dev->newest) > 0)) {
+    dev->newest = dev->out[dev->out_num - 1U].timestamp;
+  }
+  dev->seen = 1;
+}
+
+/**
+  * @brief  Number of device slots not newer than limit.
+  *         Called with the device lock held.
+  *
+  * @param  dev               device.(ptr)
+  * @param  limit             newest timestamp.
+  *
+  * @retval uint32_t          number of slots.
+  *
+  */
+static uint32_t dev_ready(const st_pool_dev *dev, uint32_t limit)
+{
+  uint32_t low = 0;
+  uint32_t high = dev->out_num;
+  uint32_t mid;
+
+  while (low < high) {
+    mid = low + ((high - low) / 2U);
+    if (ts_diff(dev->out[mid].timestamp, limit) <= 0) {
+      low = mid + 1U;
+    }
+    else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+/**
+  * @brief  Add a device at the end of a worker queue.
+  *
+  * @param  worker            worker.(ptr)
+  * @param  dev               device index.
+  *
+  */
+static void worker_push(st_pool_worker *worker, uint16_t dev)
+{
+  uint32_t size = worker->pool->cfg.dev_num;
+
+  /* a device is in one queue at most: the queue never overflows */
+  pthread_mutex_lock(&worker->lock);
+  worker->queue[(worker->head + worker->num) % size] = dev;
+  worker->num++;
+  pthread_mutex_unlock(&worker->lock);
+}
+
+/**
+  * @brief  Take the oldest device of the own queue.
+  *
+  * @param  worker            worker.(ptr)
+  * @param  dev               device index.(ptr)
+  *
+  * @retval uint8_t           1: device found / 0: queue empty.
+  *
+  */
+static uint8_t worker_pop(st_pool_worker *worker, uint16_t *dev)
+{
+  uint32_t size = worker->pool->cfg.dev_num;
+  uint8_t ret = 0;
+
+  pthread_mutex_lock(&worker->lock);
+  if (worker->num > 0U) {
+    *dev = worker->queue[worker->head];
+    worker->head = (worker->head + 1U) % size;
+    worker->num--;
+    ret = 1;
+  }
+  pthread_mutex_unlock(&worker->lock);
+
+  return ret;
+}
+
+/**
+  * @brief  Steal the newest device of another worker queue, looking at
+  *         the workers after the own one.
+  *
+  * @param  worker            worker.(ptr)
+  * @param  dev               device index.(ptr)
+  *
+  * @retval uint8_t           1: device found / 0: all queues empty.
+  *
+  */
+static uint8_t worker_steal(st_pool_worker *worker, uint16_t *dev)
+{
+  st_pool *pool = worker->pool;
+  st_pool_worker *victim;
+  uint32_t size = pool->cfg.dev_num;
+  uint16_t i;
+  uint8_t ret = 0;
+
+  for (i = 1; (i < pool->cfg.thread_num) && (ret == 0U); i++) {
+    victim = &pool->worker[(worker->id + i) % pool->cfg.thread_num];
+
+    pthread_mutex_lock(&victim->lock);
+    if (victim->num > 0U) {
+      victim->num--;
+      *dev = victim->queue[(victim->head + victim->num) % size];
+      ret = 1;
+    }
+    pthread_mutex_unlock(&victim->lock);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Restore the min-heap property (oldest stage head on top)
+  *         from node i down.
+  *
+  * @param  heap              heap entries.(ptr)
+  * @param  num               heap size.
+  * @param  i                 node.
+  *
+  */
+static void heap_down(st_pool_heap *heap, uint32_t num, uint32_t i)
+{
+  uint32_t child;
+  st_pool_heap tmp;
+
+  for (;;) {
+    child = (2U * i) + 1U;
+    if (child >= num) {
+      break;
+    }
+    if (((child + 1U) < num) &&
+        (heap_less(&heap[child + 1U], &heap[child]) != 0U)) {
+      child++;
+    }
+    if (heap_less(&heap[child], &heap[i]) == 0U) {
+      break;
+    }
+    tmp = heap[i];
+    heap[i] = heap[child];
+    heap[child] = tmp;
+    i = child;
+  }
+}
+
+/**
+  * @brief  Compare the oldest staged slots of two devices.
+  *
+  * @param  a                 heap entry.(ptr)
+  * @param  b                 heap entry.(ptr)
+  *
+  * @retval uint8_t           1: a before b / 0: otherwise.
+  *
+  */
+static uint8_t heap_less(const st_pool_heap *a, const st_pool_heap *b)
+{
+  int32_t diff = ts_diff(a->timestamp, b->timestamp);
+
+  return ((diff < 0) || ((diff == 0) && (a->dev < b->dev))) ? 1U : 0U;
+}
+
+/**
+  * @brief  Difference of two timestamps across the wrap of the 32 bit
+  *         counter (about 29.8 hours at 40 kHz): valid while the two
+  *         are less than half the range apart.
+  *
+  * @param  a                 timestamp.
+  * @param  b                 timestamp.
+  *
+  * @retval int32_t           a - b, < 0: a older than b.
+  *
+  */
+static int32_t ts_diff(uint32_t a, uint32_t b)
+{
+  return (int32_t)(a - b);
+}
+
+/**
+  * @brief  Grow a slot buffer (doubling) to hold at least num slots.
+  *
+  * @param  buf               buffer.(ptr)
+  * @param  size              buffer size in slots.(ptr)
+  * @param  num               slots needed.
+  *
+  * @retval uint8_t           1: done / 0: out of memory.
+  *
+  */
+static uint8_t buf_reserve(st_fifo_out_slot **buf, uint32_t *size,
+                           uint32_t num)
+{
+  st_fifo_out_slot *tmp;
+  uint32_t new_size;
+
+  if (num <= *size) {
+    return 1;
+  }
+
+  new_size = (*size < BUF_MIN) ? BUF_MIN : *size;
+  while (new_size < num) {
+    new_size *= 2U;
+  }
+
+  tmp = realloc(*buf, new_size * sizeof(st_fifo_out_slot));
+  if (tmp == NULL) {
+    return 0;
+  }
+  *buf = tmp;
+  *size = new_size;
+
+  return 1;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,123 @@
+/*
+ ******************************************************************************
+ * @file    fifo_decode_pool.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          fifo_decode_pool.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_FIFO_POOL_H
+#define ST_FIFO_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "fifo_utility.h"
+
+/** @addtogroup FIFO decode pool
+  * @brief    Host side (POSIX threads) decoding of the compressed FIFO
+  *           streams of many devices (see fifo_utility.c).
+  *
+  *           Raw FIFO batches are submitted per device and decoded by a
+  *           pool of worker threads:
+  *           - every device has its own decoder state (st_fifo_state),
+  *             its batches are decoded one at a time in submission order;
+  *           - a device with pending batches is queued on one worker
+  *             (device index modulo number of workers), idle workers
+  *             steal queued devices from the others, so the load is
+  *             balanced also with few very active devices;
+  *           - decoded slots are kept per device sorted by timestamp and
+  *             st_pool_merge() returns the slots of all devices merged
+  *             in timestamp order.
+  *
+  *           Timestamps of different devices are compared as they are,
+  *           so the devices must share the same time base (timestamps
+  *           reset together or batch data rate based timestamps
+  *           starting from the same instant). The comparison follows
+  *           the wrap of the 32 bit counter (about 29.8 hours at
+  *           40 kHz), as long as the slots being ordered are less than
+  *           half the counter range apart.
+  * @{
+  *
+  */
+
+/** @defgroup FIFO_pool_pubblic_definitions
+  * @{
+  *
+  */
+
+typedef enum {
+  ST_POOL_OK = 0,
+  ST_POOL_ERR
+} st_pool_status;
+
+/**
+  * @brief  Device batch data rates in Hz, see st_fifo_init().
+  */
+typedef struct {
+  float_t bdr_xl;
+  float_t bdr_gy;
+  float_t bdr_vsens;
+} st_pool_dev_cfg;
+
+typedef struct {
+  uint16_t thread_num;            /* worker threads, 0: online CPUs */
+  uint16_t dev_num;               /* number of devices */
+  const st_pool_dev_cfg *dev_cfg; /* dev_num entries */
+  uint32_t reorder_window;        /* max age (timestamp LSb) of a slot
+                                   * decoded after newer slots of the
+                                   * same device, see st_pool_merge() */
+} st_pool_cfg;
+
+typedef struct {
+  uint16_t dev;                   /* device index */
+  st_fifo_out_slot slot;
+} st_pool_out_slot;
+
+typedef struct st_pool_s st_pool;
+
+/**
+  * @}
+  *
+  */
+
+st_pool_status st_pool_init(st_pool **pool, const st_pool_cfg *cfg);
+
+void st_pool_deinit(st_pool *pool);
+
+st_pool_status st_pool_submit(st_pool *pool, uint16_t dev,
+                              const st_fifo_raw_slot *raw, uint16_t len);
+
+void st_pool_wait(st_pool *pool);
+
+uint32_t st_pool_merge(st_pool *pool, st_pool_out_slot *out, uint32_t max,
+                       uint8_t flush);
+
+uint32_t st_pool_dev_errors(st_pool *pool, uint16_t dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_FIFO_POOL_H */
+
+/**
+  * @}
+  *
+  */
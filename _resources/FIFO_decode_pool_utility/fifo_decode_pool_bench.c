@@ -0,0 +1,442 @@
+/*
+ ******************************************************************************
+ * @file    fifo_decode_pool_bench.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Throughput benchmark of the FIFO decode pool.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Build (Linux):
+ *
+ *   gcc -O2 -pthread -I../FIFO_decompression_utility fifo_decode_pool.c \
+ *       fifo_decode_pool_bench.c ../FIFO_decompression_utility/fifo_utility.c \
+ *       -o fifo_decode_pool_bench
+ *
+ * Usage:
+ *
+ *   fifo_decode_pool_bench [devices] [batches per device] [words per batch]
+ *
+ * Every device streams gyroscope not compressed and accelerometer 3x
+ * compressed at 416 Hz, after a timestamp word that puts the wrap of the
+ * 32 bit timestamp halfway through the stream. The same streams are
+ * decoded on one thread with st_fifo_state_decompress() (reference) and
+ * by the pool with 1, 2, 4 .. online CPUs threads; the pool output is
+ * checked against the reference slot by slot: timestamp order and, per
+ * device, the same slots (time, tag, data) of the reference sorted by
+ * timestamp.
+ *
+ * - decode: all the batches are submitted and decoded (st_pool_wait()),
+ *   speedup is versus the reference;
+ * - streaming: every round of batches (one per device) is followed by
+ *   st_pool_merge() without flush, as in a gateway forwarding the
+ *   merged stream; the merge runs on the calling thread.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "fifo_decode_pool.h"
+
+/* Private constants  --------------------------------------------------------*/
+#define TAG_GY                   (0x01U)
+#define TAG_XL                   (0x02U)
+#define TAG_TS                   (0x04U)
+#define TAG_XL_COMPRESSED_3X     (0x09U)
+#define BDR_HZ                   (416.0f)
+#define TS_TICK                  (96U)     /* 40 kHz / 416 Hz */
+#define MERGE_SLOTS              (65536U)
+
+/* Private variables ---------------------------------------------------------*/
+static st_fifo_raw_slot **stream;
+static st_fifo_out_slot *ref_out;
+static st_fifo_out_slot **ref_dev;
+static uint32_t *ref_num;
+static uint32_t *ref_pos;
+static st_pool_out_slot merge_out[MERGE_SLOTS];
+
+/* Private functions ---------------------------------------------------------*/
+static uint8_t tag_byte(uint8_t tag, uint32_t tick);
+static void stream_gen(st_fifo_raw_slot *raw, uint32_t len, uint32_t seed);
+static double now_s(void);
+static int ref_build(uint32_t dev_num, uint32_t batch_num,
+                     uint32_t batch_len);
+static void merge_reset(uint32_t dev_num, uint32_t *last);
+static int merge_check(uint32_t num, uint32_t *last);
+
+int main(int argc, char *argv[])
+{
+  st_pool_dev_cfg *dev_cfg;
+  st_pool_cfg cfg;
+  st_pool *pool;
+  st_fifo_state state;
+  uint32_t dev_num = (argc > 1) ? (uint32_t)atoi(argv[1]) : 32U;
+  uint32_t batch_num = (argc > 2) ? (uint32_t)atoi(argv[2]) : 200U;
+  uint32_t batch_len = (argc > 3) ? (uint32_t)atoi(argv[3]) : 512U;
+  uint32_t cpu = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+  uint64_t ref_slots = 0;
+  uint64_t slots;
+  uint32_t last;
+  uint32_t num;
+  uint32_t threads;
+  uint32_t d;
+  uint32_t b;
+  uint16_t out_num;
+  double ref_time;
+  double t0;
+  double t_dec;
+  double t_all;
+  int err = 0;
+
+  if ((dev_num == 0U) || (dev_num > 65535U) || (batch_num == 0U) ||
+      (batch_len == 0U) || (batch_len > 65535U)) {
+    printf("usage: %s [devices] [batches] [words per batch]\n", argv[0]);
+    return 1;
+  }
+
+  stream = calloc(dev_num, sizeof(st_fifo_raw_slot *));
+  dev_cfg = calloc(dev_num, sizeof(st_pool_dev_cfg));
+  ref_out = malloc(3U * batch_len * sizeof(st_fifo_out_slot));
+  if ((stream == NULL) || (dev_cfg == NULL) || (ref_out == NULL)) {
+    return 1;
+  }
+
+  for (d = 0; d < dev_num; d++) {
+    stream[d] = malloc(batch_num * batch_len * sizeof(st_fifo_raw_slot));
+    if (stream[d] == NULL) {
+      return 1;
+    }
+    stream_gen(stream[d], batch_num * batch_len, d + 1U);
+    dev_cfg[d].bdr_xl = BDR_HZ;
+    dev_cfg[d].bdr_gy = BDR_HZ;
+    dev_cfg[d].bdr_vsens = 0.0f;
+  }
+
+  /* reference: one thread, devices one after the other */
+  t0 = now_s();
+  for (d = 0; d < dev_num; d++) {
+    st_fifo_state_init(&state, BDR_HZ, BDR_HZ, 0.0f);
+    for (b = 0; b < batch_num; b++) {
+      out_num = 0;
+      if (st_fifo_state_decompress(&state, ref_out,
+                                   &stream[d][b * batch_len], &out_num,
+                                   (uint16_t)batch_len) != ST_FIFO_OK) {
+        err = 1;
+      }
+      ref_slots += out_num;
+    }
+  }
+  ref_time = now_s() - t0;
+
+  /* expected merged slots of every device, not timed */
+  if (ref_build(dev_num, batch_num, batch_len) != 0) {
+    return 1;
+  }
+
+  printf("%u devices, %u batches x %u words, %llu slots\n", dev_num,
+         batch_num, batch_len, (unsigned long long)ref_slots);
+  printf("reference (1 thread)      %8.2f Mslot/s\n",
+         (double)ref_slots / ref_time / 1e6);
+  printf("threads   decode Mslot/s  speedup   streaming Mslot/s\n");
+
+  threads = 1;
+  while (threads <= cpu) {
+    cfg.thread_num = (uint16_t)threads;
+    cfg.dev_num = (uint16_t)dev_num;
+    cfg.dev_cfg = dev_cfg;
+    cfg.reorder_window = (uint32_t)(3.0f * 40000.0f / BDR_HZ);
+
+    if (st_pool_init(&pool, &cfg) != ST_POOL_OK) {
+      return 1;
+    }
+
+    /* decode only: all batches submitted, then merged */
+    t0 = now_s();
+    for (b = 0; b < batch_num; b++) {
+      for (d = 0; d < dev_num; d++) {
+        st_pool_submit(pool, (uint16_t)d, &stream[d][b * batch_len],
+                       (uint16_t)batch_len);
+      }
+    }
+    st_pool_wait(pool);
+    t_dec = now_s() - t0;
+
+    slots = 0;
+    merge_reset(dev_num, &last);
+    do {
+      num = st_pool_merge(pool, merge_out, MERGE_SLOTS, 1);
+      err |= merge_check(num, &last);
+      slots += num;
+    } while (num > 0U);
+    if (slots != ref_slots) {
+      err = 1;
+    }
+    st_pool_deinit(pool);
+
+    /* streaming: merged output read after every round of batches */
+    if (st_pool_init(&pool, &cfg) != ST_POOL_OK) {
+      return 1;
+    }
+
+    merge_reset(dev_num, &last);
+    t0 = now_s();
+    slots = 0;
+    for (b = 0; b < batch_num; b++) {
+      for (d = 0; d < dev_num; d++) {
+        st_pool_submit(pool, (uint16_t)d, &stream[d][b * batch_len],
+                       (uint16_t)batch_len);
+      }
+      do {
+        num = st_pool_merge(pool, merge_out, MERGE_SLOTS, 0);
+        err |= merge_check(num, &last);
+        slots += num;
+      } while (num == MERGE_SLOTS);
+    }
+    do {
+      num = st_pool_merge(pool, merge_out, MERGE_SLOTS, 1);
+      err |= merge_check(num, &last);
+      slots += num;
+    } while (num > 0U);
+    t_all = now_s() - t0;
+
+    if (slots != ref_slots) {
+      err = 1;
+    }
+    for (d = 0; d < dev_num; d++) {
+      if (st_pool_dev_errors(pool, (uint16_t)d) != 0U) {
+        err = 1;
+      }
+    }
+
+    printf("%7u   %14.2f  %7.2f   %17.2f\n", threads,
+           (double)ref_slots / t_dec / 1e6, ref_time / t_dec,
+           (double)ref_slots / t_all / 1e6);
+
+    st_pool_deinit(pool);
+
+    /* 1, 2, 4 .. and the number of online CPUs */
+    threads = ((threads < cpu) && ((threads * 2U) > cpu)) ? cpu :
+              (threads * 2U);
+  }
+
+  printf("%s\n", (err == 0) ? "output check passed" : "OUTPUT CHECK FAILED");
+
+  for (d = 0; d < dev_num; d++) {
+    free(stream[d]);
+    free(ref_dev[d]);
+  }
+  free(stream);
+  free(ref_dev);
+  free(ref_num);
+  free(ref_pos);
+  free(dev_cfg);
+  free(ref_out);
+
+  return err;
+}
+
+/*
+ * @brief  FIFO tag byte: sensor tag, tag counter and parity bit (the
+ *         number of bits set must be even).
+ *
+ */
+static uint8_t tag_byte(uint8_t tag, uint32_t tick)
+{
+  uint8_t val = (uint8_t)((tag << 3) | ((tick & 0x03U) << 1));
+  uint8_t ones = 0;
+  uint8_t i;
+
+  for (i = 0; i < 8U; i++) {
+    ones += (val >> i) & 0x01U;
+  }
+
+  return (uint8_t)(val | (ones & 0x01U));
+}
+
+/*
+ * @brief  Generate a device stream: a timestamp word, then every BDR
+ *         tick a gyroscope word, every 3 ticks an accelerometer 3x
+ *         compressed word (the first accelerometer word is not
+ *         compressed). The first timestamp is chosen so that the 32 bit
+ *         counter wraps halfway through the stream (4 words every 3
+ *         ticks).
+ *
+ */
+static void stream_gen(st_fifo_raw_slot *raw, uint32_t len, uint32_t seed)
+{
+  uint32_t ts = 0U - ((len / 4U) * 3U * TS_TICK / 2U);
+  uint32_t tick = 0;
+  uint32_t i = 0;
+  uint16_t word;
+  uint8_t k;
+
+  raw[i].fifo_data_out[0] = tag_byte(TAG_TS, tick);
+  for (k = 0; k < 6U; k++) {
+    raw[i].fifo_data_out[1U + k] = (k < 4U) ? (uint8_t)(ts >> (8U * k)) : 0U;
+  }
+  i++;
+
+  while (i < len) {
+    raw[i].fifo_data_out[0] = tag_byte(TAG_GY, tick);
+    for (k = 1; k < 7U; k++) {
+      seed = (seed * 1103515245U) + 12345U;
+      raw[i].fifo_data_out[k] = (uint8_t)(seed >> 16);
+    }
+    i++;
+
+    if ((i < len) && (tick == 0U)) {
+      raw[i].fifo_data_out[0] = tag_byte(TAG_XL, tick);
+      memset(&raw[i].fifo_data_out[1], 0, 6);
+      i++;
+    }
+    else if ((i < len) && ((tick % 3U) == 2U)) {
+      raw[i].fifo_data_out[0] = tag_byte(TAG_XL_COMPRESSED_3X, tick);
+      for (k = 0; k < 3U; k++) {
+        seed = (seed * 1103515245U) + 12345U;
+        word = (uint16_t)((seed >> 8) & 0x7FFFU);
+        raw[i].fifo_data_out[1U + (2U * k)] = (uint8_t)word;
+        raw[i].fifo_data_out[2U + (2U * k)] = (uint8_t)(word >> 8);
+      }
+      i++;
+    }
+
+    tick++;
+  }
+}
+
+static double now_s(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/*
+ * @brief  Decode again the streams of every device on one thread and
+ *         keep the slots sorted by timestamp, ties in decode order: the
+ *         sequence of the device expected in the merged output.
+ *
+ */
+static int ref_build(uint32_t dev_num, uint32_t batch_num,
+                     uint32_t batch_len)
+{
+  st_fifo_state state;
+  st_fifo_out_slot slot;
+  st_fifo_out_slot *out;
+  uint32_t d;
+  uint32_t b;
+  uint32_t i;
+  uint32_t j;
+  uint16_t out_num;
+
+  ref_dev = calloc(dev_num, sizeof(st_fifo_out_slot *));
+  ref_num = calloc(dev_num, sizeof(uint32_t));
+  ref_pos = calloc(dev_num, sizeof(uint32_t));
+  if ((ref_dev == NULL) || (ref_num == NULL) || (ref_pos == NULL)) {
+    return 1;
+  }
+
+  for (d = 0; d < dev_num; d++) {
+    out = malloc(3U * batch_num * batch_len * sizeof(st_fifo_out_slot));
+    if (out == NULL) {
+      return 1;
+    }
+    ref_dev[d] = out;
+
+    st_fifo_state_init(&state, BDR_HZ, BDR_HZ, 0.0f);
+    for (b = 0; b < batch_num; b++) {
+      out_num = 0;
+      (void)st_fifo_state_decompress(&state, &out[ref_num[d]],
+                                     &stream[d][b * batch_len], &out_num,
+                                     (uint16_t)batch_len);
+      ref_num[d] += out_num;
+    }
+
+    /* stable insertion sort, as the pool stores the device slots */
+    for (i = 1; i < ref_num[d]; i++) {
+      slot = out[i];
+      j = i;
+      while ((j > 0U) &&
+             ((int32_t)(out[j - 1U].timestamp - slot.timestamp) > 0)) {
+        out[j] = out[j - 1U];
+        j--;
+      }
+      out[j] = slot;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * @brief  Restart the check of the merged output, from the oldest slot
+ *         of the devices.
+ *
+ */
+static void merge_reset(uint32_t dev_num, uint32_t *last)
+{
+  uint32_t d;
+
+  memset(ref_pos, 0, dev_num * sizeof(uint32_t));
+  *last = ref_dev[0][0].timestamp;
+  for (d = 1; d < dev_num; d++) {
+    if ((int32_t)(ref_dev[d][0].timestamp - *last) < 0) {
+      *last = ref_dev[d][0].timestamp;
+    }
+  }
+}
+
+/*
+ * @brief  Check the merged slots: timestamp order and, per device, same
+ *         content of the reference.
+ *
+ */
+static int merge_check(uint32_t num, uint32_t *last)
+{
+  const st_fifo_out_slot *slot;
+  const st_fifo_out_slot *ref;
+  uint32_t i;
+  uint16_t d;
+  int err = 0;
+
+  for (i = 0; i < num; i++) {
+    slot = &merge_out[i].slot;
+    d = merge_out[i].dev;
+
+    if ((int32_t)(slot->timestamp - *last) < 0) {
+      err = 1;
+    }
+    *last = slot->timestamp;
+
+    if (ref_pos[d] >= ref_num[d]) {
+      err = 1;
+      continue;
+    }
+    ref = &ref_dev[d][ref_pos[d]];
+    ref_pos[d]++;
+    if ((slot->timestamp != ref->timestamp) ||
+        (slot->sensor_tag != ref->sensor_tag) ||
+        (memcmp(slot->raw_data, ref->raw_data, 6) != 0)) {
+      err = 1;
+    }
+  }
+
+  return err;
+}
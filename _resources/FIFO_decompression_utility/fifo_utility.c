@@ -18,6 +18,7 @@
  */
 
 /* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
 #include "fifo_utility.h"
 
 /**
@@ -88,29 +89,35 @@ typedef enum {
 
 /* Private functions ---------------------------------------------------------*/
 /*  Functions declare in this section are defined at the end of this file.    */
+static st_fifo_status decode_word(st_fifo_state *state, const uint8_t raw[7],
+                                  st_fifo_view view[3], int16_t side[3][3],
+                                  uint16_t *out_num);
+static void view_to_slot(st_fifo_out_slot *fifo_out_slot,
+                         const st_fifo_view *view);
 static uint8_t has_even_parity(uint8_t x);
 static st_fifo_sensor_type get_sensor_type(uint8_t tag);
 static st_fifo_compression_type get_compression_type(uint8_t tag);
 static uint8_t is_tag_valid(uint8_t tag);
-static void get_diff_2x(int16_t diff[6], uint8_t input[6]);
-static void get_diff_3x(int16_t diff[9], uint8_t input[6]);
-static void byte_cpy(uint8_t *destination, uint8_t *source, uint32_t len);
+static void get_diff_2x(int16_t diff[6], const uint8_t input[6]);
+static void get_diff_3x(int16_t diff[9], const uint8_t input[6]);
+static void byte_cpy(uint8_t *destination, const uint8_t *source,
+                     uint32_t len);
 
 /* Private variables ---------------------------------------------------------*/
-static uint8_t tag_counter_old     = 0x00U;
-static float_t bdr_xl              = 0.0f;
-static float_t bdr_gy              = 0.0f;
-static float_t bdr_vsens           = 0.0f;
-static float_t bdr_xl_old          = 0.0f;
-static float_t bdr_gy_old          = 0.0f;
-static float_t bdr_max             = 0.0f;
-static uint32_t timestamp          = 0;
-static uint32_t last_timestamp_xl  = 0;
-static uint32_t last_timestamp_gy  = 0;
-static uint8_t bdr_chg_xl_flag     = 0;
-static uint8_t bdr_chg_gy_flag     = 0;
-static int16_t last_data_xl[3]     = {0};
-static int16_t last_data_gy[3]     = {0};
+static st_fifo_state fifo_state;
+
+static const float_t bdr_xl_vect[] = {    0,   13    ,  26,   52,  104,
+                                        208,  416    , 833, 1666, 3333,
+                                       6666,    1.625,   0,    0,    0,
+                                          0 };
+
+static const float_t bdr_gy_vect[] = {   0,   13,   26,   52, 104, 208, 416,
+                                       833, 1666, 3333, 6666,   0,   0,   0,
+                                         0,    0};
+
+static const float_t bdr_vsens_vect[] = { 0, 13, 26, 52, 104    , 208, 416,
+                                          0,  0,  0,  0,   1.625,   0,   0,
+                                          0,  0};
 
 /**
   * @defgroup  FIFO_pubblic_functions
@@ -139,6 +146,53 @@ static int16_t last_data_gy[3]     = {0};
 st_fifo_status st_fifo_init(float_t    bdr_xl_in,
                             float_t    bdr_gy_in,
                             float_t    bdr_vsens_in)
+{
+  return st_fifo_state_init(&fifo_state, bdr_xl_in, bdr_gy_in, bdr_vsens_in);
+}
+
+/**
+  * @brief  Decompress a compressed raw FIFO stream.
+  *
+  * @param  fifo_out_slot     decoded output stream.(ptr)
+  * @param  fifo_raw_slot     compressed raw input data stream.(ptr)
+  * @param  out_slot_size     decoded stream size.(ptr)
+  * @param  stream_size       raw input stream size.
+  *
+  * @retval st_fifo_status    ST_FIFO_OK /  ST_FIFO_ERR
+  *
+  */
+st_fifo_status st_fifo_decompress(st_fifo_out_slot *fifo_out_slot,
+                                  st_fifo_raw_slot *fifo_raw_slot,
+                                  uint16_t *out_slot_size,
+                                  uint16_t stream_size)
+{
+  return st_fifo_state_decompress(&fifo_state, fifo_out_slot, fifo_raw_slot,
+                                  out_slot_size, stream_size);
+}
+
+/**
+  * @brief  Initialize a FIFO decoder state. Every state decodes the
+  *         stream of one device, so states of different devices can be
+  *         used at the same time (e.g. by different threads).
+  *
+  * @param  state             decoder state.(ptr)
+  * @param  bdr_xl_in         batch data rate for accelerometer sensor in Hz,
+  *                           pass 0 Hz if odrchg_en is set to 1 or timestamp
+  *                           is stored in FIFO.
+  * @param  bdr_gy_in         batch data rate for gyro sensor in Hz,
+  *                           pass 0 Hz if odrchg_en is set to 1 or timestamp
+  *                           is stored in FIFO.
+  * @param  bdr_vsens_in      batch data rate for virtual sensor in Hz,
+  *                           pass 0 Hz if odrchg_en is set to 1 or timestamp
+  *                           is stored in FIFO.
+  *
+  * @retval st_fifo_status    ST_FIFO_OK /  ST_FIFO_ERR
+  *
+  */
+st_fifo_status st_fifo_state_init(st_fifo_state *state,
+                                  float_t bdr_xl_in,
+                                  float_t bdr_gy_in,
+                                  float_t bdr_vsens_in)
 {
   uint32_t i;
   st_fifo_status ret = ST_FIFO_ERR;
@@ -148,23 +202,25 @@ st_fifo_status st_fifo_init(float_t    bdr_xl_in,
   }
   else {
 
-    tag_counter_old = 0x00U;
-    bdr_xl = bdr_xl_in;
-    bdr_gy = bdr_gy_in;
-    bdr_vsens = bdr_vsens_in;
-    bdr_xl_old = bdr_xl_in;
-    bdr_gy_old = bdr_gy_in;
-    bdr_max = ( ( bdr_xl  > bdr_gy )    ? bdr_xl  : bdr_gy );
-    bdr_max = ( ( bdr_max > bdr_vsens ) ? bdr_max : bdr_vsens );
-    timestamp = 0;
-    bdr_chg_xl_flag = 0;
-    bdr_chg_gy_flag = 0;
-    last_timestamp_xl = 0;
-    last_timestamp_gy = 0;
+    state->tag_counter_old = 0x00U;
+    state->bdr_xl = bdr_xl_in;
+    state->bdr_gy = bdr_gy_in;
+    state->bdr_vsens = bdr_vsens_in;
+    state->bdr_xl_old = bdr_xl_in;
+    state->bdr_gy_old = bdr_gy_in;
+    state->bdr_max = ((state->bdr_xl > state->bdr_gy) ?
+                      state->bdr_xl : state->bdr_gy);
+    state->bdr_max = ((state->bdr_max > state->bdr_vsens) ?
+                      state->bdr_max : state->bdr_vsens);
+    state->timestamp = 0;
+    state->bdr_chg_xl_flag = 0;
+    state->bdr_chg_gy_flag = 0;
+    state->last_timestamp_xl = 0;
+    state->last_timestamp_gy = 0;
 
     for (i = 0; i < 3U; i++) {
-      last_data_xl[i] = 0;
-      last_data_gy[i] = 0;
+      state->last_data_xl[i] = 0;
+      state->last_data_gy[i] = 0;
 
       ret = ST_FIFO_OK;
     }
@@ -174,8 +230,10 @@ st_fifo_status st_fifo_init(float_t    bdr_xl_in,
 }
 
 /**
-  * @brief  Decompress a compressed raw FIFO stream.
+  * @brief  Decompress a compressed raw FIFO stream with the given
+  *         decoder state.
   *
+  * @param  state             decoder state.(ptr)
   * @param  fifo_out_slot     decoded output stream.(ptr)
   * @param  fifo_raw_slot     compressed raw input data stream.(ptr)
   * @param  out_slot_size     decoded stream size.(ptr)
@@ -184,340 +242,241 @@ st_fifo_status st_fifo_init(float_t    bdr_xl_in,
   * @retval st_fifo_status    ST_FIFO_OK /  ST_FIFO_ERR
   *
   */
-st_fifo_status st_fifo_decompress(st_fifo_out_slot *fifo_out_slot,
-                                  st_fifo_raw_slot *fifo_raw_slot,
-                                  uint16_t *out_slot_size,
-                                  uint16_t stream_size)
+st_fifo_status st_fifo_state_decompress(st_fifo_state *state,
+                                        st_fifo_out_slot *fifo_out_slot,
+                                        st_fifo_raw_slot *fifo_raw_slot,
+                                        uint16_t *out_slot_size,
+                                        uint16_t stream_size)
 {
+  st_fifo_view view[3];
+  int16_t side[3][3];
   uint16_t j = 0;
-  int16_t data[3];
-  uint8_t tag;
-  uint8_t tag_counter;
-  uint8_t diff_tag_counter;
-  uint8_t bdr_acc_cfg;
-  uint8_t bdr_gyr_cfg;
-  uint8_t bdr_vsens_cfg;
-  uint32_t last_timestamp;
-  int16_t diff[9];
-
-  float_t bdr_acc_vect[]  = {    0,   13    ,  26,   52,  104,
-                               208,  416    , 833, 1666, 3333,
-                              6666,    1.625,   0,    0,    0,
-                                 0 };
-
-  float_t bdr_gyr_vect[] = {   0,   13,   26,   52, 104, 208, 416,
-                             833, 1666, 3333, 6666,   0,   0,   0,
-                               0,    0};
-
-  float_t bdr_vsens_vect[] = { 0, 13, 26, 52, 104    , 208, 416,
-                               0,  0,  0,  0,   1.625,   0,   0,
-                               0,  0};
+  uint16_t num;
+  uint16_t k;
 
   for (uint16_t i = 0; i < stream_size; i++) {
 
-    tag = (fifo_raw_slot[i].fifo_data_out[0] & TAG_SENSOR_MASK);
-    tag = tag >> TAG_SENSOR_SHIFT;
-
-    tag_counter = (fifo_raw_slot[i].fifo_data_out[0] & TAG_COUNTER_MASK);
-    tag_counter = tag_counter >> TAG_COUNTER_SHIFT;
-
-    if ((has_even_parity(fifo_raw_slot[i].fifo_data_out[0]) == 0U) ||
-        (is_tag_valid(tag) == 0U)){
+    if (decode_word(state, fifo_raw_slot[i].fifo_data_out,
+                    view, side, &num) != ST_FIFO_OK) {
       return ST_FIFO_ERR;
     }
 
-    if ((tag_counter != (tag_counter_old)) && (bdr_max != 0.0f)) {
-
-      if (tag_counter < tag_counter_old){
-        diff_tag_counter = tag_counter + 4U - tag_counter_old;
-      }
-      else{
-        diff_tag_counter = tag_counter - tag_counter_old;
-      }
-
-      timestamp += (TIMESTAMP_FREQ / (uint32_t)bdr_max) * diff_tag_counter;
+    for (k = 0; k < num; k++) {
+      view_to_slot(&fifo_out_slot[j], &view[k]);
+      j++;
+      *out_slot_size = j;
     }
+  }
 
-    if (tag == TAG_ODRCHG) {
-
-      bdr_acc_cfg = (fifo_raw_slot[i].fifo_data_out[6] & BDR_XL_MASK);
-      bdr_acc_cfg = bdr_acc_cfg >> BDR_XL_SHIFT;
-
-      bdr_gyr_cfg = (fifo_raw_slot[i].fifo_data_out[6] & BDR_GY_MASK);
-      bdr_gyr_cfg = bdr_gyr_cfg >> BDR_GY_SHIFT;
-
-      bdr_vsens_cfg =(fifo_raw_slot[i].fifo_data_out[3] & BDR_VSENS_MASK);
-      bdr_vsens_cfg = bdr_vsens_cfg >> BDR_VSENS_SHIFT;
-
-      bdr_xl_old = bdr_xl;
-      bdr_gy_old = bdr_gy;
-
-      bdr_xl = bdr_acc_vect[bdr_acc_cfg];
-      bdr_gy = bdr_gyr_vect[bdr_gyr_cfg];
-      bdr_vsens = bdr_vsens_vect[bdr_vsens_cfg];
-      bdr_max = ((bdr_xl > bdr_gy) ? bdr_xl : bdr_gy);
-      bdr_max = ((bdr_max > bdr_vsens) ? bdr_max : bdr_vsens);
-
-      bdr_chg_xl_flag = 1;
-      bdr_chg_gy_flag = 1;
-
-      } else if (tag == TAG_TS) {
-
-        byte_cpy( (uint8_t*)&timestamp, &fifo_raw_slot[i].fifo_data_out[1], 4);
-
-      } else {
-
-      st_fifo_compression_type compression_type = get_compression_type(tag);
-      st_fifo_sensor_type sensor_type = get_sensor_type(tag);
-
-      switch (compression_type){
-        case ST_FIFO_COMPRESSION_NC:
-          if (tag == TAG_STEP_COUNTER){
-            byte_cpy((uint8_t*)&fifo_out_slot[j].timestamp,
-                     &fifo_raw_slot[i].fifo_data_out[3], 4);
-          }
-          else{
-            fifo_out_slot[j].timestamp = timestamp;
-          }
-
-          fifo_out_slot[j].sensor_tag = sensor_type;
-          byte_cpy(fifo_out_slot[j].raw_data,
-                   &fifo_raw_slot[i].fifo_data_out[1], 6);
-
-          if (sensor_type == ST_FIFO_ACCELEROMETER) {
-            byte_cpy((uint8_t*)last_data_xl, fifo_out_slot[j].raw_data, 6);
-            last_timestamp_xl = timestamp;
-            bdr_chg_xl_flag = 0;
-          }
-
-          if (sensor_type == ST_FIFO_GYROSCOPE) {
-            byte_cpy((uint8_t*)last_data_gy, fifo_out_slot[j].raw_data, 6);
-            last_timestamp_gy = timestamp;
-            bdr_chg_gy_flag = 0;
-          }
-
-          j++;
-          break;
-        case ST_FIFO_COMPRESSION_NC_T_1:
-          fifo_out_slot[j].sensor_tag = get_sensor_type(tag);
-          byte_cpy(fifo_out_slot[j].raw_data,
-                   &fifo_raw_slot[i].fifo_data_out[1], 6);
-
-          if (sensor_type == ST_FIFO_ACCELEROMETER) {
-
-
-            if (bdr_chg_xl_flag != 0U){
-              last_timestamp = (last_timestamp_xl +
-                                (TIMESTAMP_FREQ / (uint32_t)bdr_xl_old));
-            }
-            else{
-              last_timestamp = ((uint32_t)timestamp -
-                                ((uint32_t)TIMESTAMP_FREQ / (uint32_t)bdr_xl));
-            }
-
-            fifo_out_slot[j].timestamp = last_timestamp;
-            byte_cpy((uint8_t*)last_data_xl,
-                     (uint8_t*) fifo_out_slot[j].raw_data, 6);
-            last_timestamp_xl = last_timestamp;
-          }
-
-          if (sensor_type == ST_FIFO_GYROSCOPE) {
-
-
-            if (bdr_chg_gy_flag != 0U){
-              last_timestamp = (last_timestamp_gy +
-                                (TIMESTAMP_FREQ / (uint32_t)bdr_gy_old));
-            }
-            else{
-              last_timestamp = (timestamp -
-                                (TIMESTAMP_FREQ / (uint32_t)bdr_gy));
-            }
-
-            fifo_out_slot[j].timestamp = last_timestamp;
-            byte_cpy((uint8_t*)last_data_gy, fifo_out_slot[j].raw_data, 6);
-            last_timestamp_gy = last_timestamp;
-          }
-
-          j++;
-          break;
-        case ST_FIFO_COMPRESSION_NC_T_2:
-          fifo_out_slot[j].sensor_tag = get_sensor_type(tag);
-          byte_cpy(fifo_out_slot[j].raw_data,
-                   &fifo_raw_slot[i].fifo_data_out[1], 6);
-
-          if (sensor_type == ST_FIFO_ACCELEROMETER) {
-            if (bdr_chg_xl_flag != 0U){
-              last_timestamp = (last_timestamp_xl +
-                                (TIMESTAMP_FREQ / (uint32_t)bdr_xl_old));
-            }
-            else{
-              last_timestamp = (timestamp -
-                                ((2U * TIMESTAMP_FREQ) / (uint32_t) bdr_xl));
-            }
-
-            fifo_out_slot[j].timestamp = last_timestamp;
-            byte_cpy((uint8_t*)last_data_xl, fifo_out_slot[j].raw_data, 6);
-            last_timestamp_xl = last_timestamp;
-          }
-          if (sensor_type == ST_FIFO_GYROSCOPE) {
-
-            if (bdr_chg_gy_flag != 0U){
-              last_timestamp = (last_timestamp_gy +
-                                (TIMESTAMP_FREQ / (uint32_t)bdr_gy_old));
-            }
-            else{
-              last_timestamp = (timestamp -
-                                (2U * TIMESTAMP_FREQ / (uint32_t)bdr_gy));
-            }
-
-            fifo_out_slot[j].timestamp = last_timestamp;
-            byte_cpy((uint8_t*)last_data_gy,
-                     (uint8_t*)fifo_out_slot[j].raw_data, 6);
-            last_timestamp_gy = last_timestamp;
-          }
-
-          j++;
-          break;
-        case ST_FIFO_COMPRESSION_2X:
-          get_diff_2x(diff, &fifo_raw_slot[i].fifo_data_out[1]);
-
-          fifo_out_slot[j].sensor_tag = sensor_type;
-
-          if (sensor_type == ST_FIFO_ACCELEROMETER) {
-            data[0] = last_data_xl[0] + diff[0];
-            data[1] = last_data_xl[1] + diff[1];
-            data[2] = last_data_xl[2] + diff[2];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            fifo_out_slot[j].timestamp =
-                        (timestamp - (2U * TIMESTAMP_FREQ / (uint32_t)bdr_xl));
-
-            byte_cpy((uint8_t*)last_data_xl, fifo_out_slot[j].raw_data, 6);
-          }
-
-          if (sensor_type == ST_FIFO_GYROSCOPE) {
-            data[0] = last_data_gy[0] + diff[0];
-            data[1] = last_data_gy[1] + diff[1];
-            data[2] = last_data_gy[2] + diff[2];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            fifo_out_slot[j].timestamp =
-                        (timestamp - (2U * TIMESTAMP_FREQ / (uint32_t)bdr_gy));
-
-            byte_cpy((uint8_t*)last_data_gy, fifo_out_slot[j].raw_data, 6);
-          }
-
-          j++;
+  return ST_FIFO_OK;
+}
 
-          fifo_out_slot[j].sensor_tag = sensor_type;
+/**
+  * @brief  Decode a raw FIFO stream without copying the samples, e.g. a
+  *         FIFO burst read by DMA in an array of st_fifo_raw_slot.
+  *
+  *         Every decoded sample is passed to cb as a view: the data of
+  *         not compressed words point to the raw stream, only 2x / 3x
+  *         compressed samples are rebuilt in a side buffer of 3 samples.
+  *         The view is valid until cb returns.
+  *
+  * @param  state             decoder state.(ptr)
+  * @param  fifo_raw_slot     compressed raw input data stream.(ptr)
+  * @param  stream_size       raw input stream size.
+  * @param  cb                decoded sample handler.
+  * @param  cb_arg            handler argument.(ptr)
+  *
+  * @retval st_fifo_status    ST_FIFO_OK /  ST_FIFO_ERR
+  *
+  */
+st_fifo_status st_fifo_state_decode_view(st_fifo_state *state,
+                                         const st_fifo_raw_slot *fifo_raw_slot,
+                                         uint16_t stream_size,
+                                         st_fifo_view_cb cb, void *cb_arg)
+{
+  st_fifo_view view[3];
+  int16_t side[3][3];
+  uint16_t num;
+  uint16_t k;
 
-          if (sensor_type == ST_FIFO_ACCELEROMETER) {
-            last_timestamp = (timestamp - (TIMESTAMP_FREQ / (uint32_t)bdr_xl));
-            data[0] = last_data_xl[0] + diff[3];
-            data[1] = last_data_xl[1] + diff[4];
-            data[2] = last_data_xl[2] + diff[5];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            fifo_out_slot[j].timestamp = last_timestamp;
-            byte_cpy((uint8_t*)last_data_xl, fifo_out_slot[j].raw_data, 6);
-            last_timestamp_xl = last_timestamp;
-          }
+  for (uint16_t i = 0; i < stream_size; i++) {
 
-          if (sensor_type == ST_FIFO_GYROSCOPE) {
-            last_timestamp = (timestamp - (TIMESTAMP_FREQ / (uint32_t)bdr_gy));
-            data[0] = last_data_gy[0] + diff[3];
-            data[1] = last_data_gy[1] + diff[4];
-            data[2] = last_data_gy[2] + diff[5];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            fifo_out_slot[j].timestamp = last_timestamp;
-            byte_cpy((uint8_t*)last_data_gy, fifo_out_slot[j].raw_data, 6);
-            last_timestamp_gy = last_timestamp;
-          }
+    if (decode_word(state, fifo_raw_slot[i].fifo_data_out,
+                    view, side, &num) != ST_FIFO_OK) {
+      return ST_FIFO_ERR;
+    }
 
-          j++;
-          break;
-        default: //(compression_type == ST_FIFO_COMPRESSION_3X)
+    for (k = 0; k < num; k++) {
+      cb(&view[k], cb_arg);
+    }
+  }
 
-          get_diff_3x(diff, &fifo_raw_slot[i].fifo_data_out[1]);
+  return ST_FIFO_OK;
+}
 
-          fifo_out_slot[j].sensor_tag = sensor_type;
+/**
+  * @brief  Initialize a bounded ring of decoded slots.
+  *
+  * @param  ring              ring.(ptr)
+  * @param  slot              ring storage, size slots.(ptr)
+  * @param  size              ring capacity, at least 3 slots (the slots
+  *                           of one 3x compressed FIFO word).
+  *
+  * @retval st_fifo_status    ST_FIFO_OK /  ST_FIFO_ERR
+  *
+  */
+st_fifo_status st_fifo_ring_init(st_fifo_ring *ring, st_fifo_out_slot *slot,
+                                 uint16_t size)
+{
+  st_fifo_status ret = ST_FIFO_ERR;
 
-          if (sensor_type == ST_FIFO_ACCELEROMETER) {
-            data[0] = last_data_xl[0] + diff[0];
-            data[1] = last_data_xl[1] + diff[1];
-            data[2] = last_data_xl[2] + diff[2];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            fifo_out_slot[j].timestamp =
-                        (timestamp - (2U * TIMESTAMP_FREQ / (uint32_t)bdr_xl));
-            byte_cpy((uint8_t*)last_data_xl, fifo_out_slot[j].raw_data, 6);
-          }
+  if ((slot != NULL) && (size >= 3U)) {
+    ring->slot = slot;
+    ring->size = size;
+    ring->head = 0;
+    ring->num = 0;
+    ret = ST_FIFO_OK;
+  }
 
-          if (sensor_type == ST_FIFO_GYROSCOPE) {
-            data[0] = last_data_gy[0] + diff[0];
-            data[1] = last_data_gy[1] + diff[1];
-            data[2] = last_data_gy[2] + diff[2];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            fifo_out_slot[j].timestamp =
-                        (timestamp - (2U * TIMESTAMP_FREQ / (uint32_t)bdr_gy));
-            byte_cpy((uint8_t*)last_data_gy,
-                     (uint8_t*)fifo_out_slot[j].raw_data, 6);
-          }
+  return ret;
+}
 
-          j++;
+/**
+  * @brief  Move the oldest decoded slots out of the ring.
+  *
+  * @param  ring              ring.(ptr)
+  * @param  fifo_out_slot     output slots.(ptr)
+  * @param  max               output capacity.
+  *
+  * @retval uint16_t          number of slots moved.
+  *
+  */
+uint16_t st_fifo_ring_get(st_fifo_ring *ring, st_fifo_out_slot *fifo_out_slot,
+                          uint16_t max)
+{
+  uint16_t i = 0;
 
-          fifo_out_slot[j].sensor_tag = sensor_type;
+  while ((i < max) && (ring->num > 0U)) {
+    byte_cpy((uint8_t*)&fifo_out_slot[i], (uint8_t*)&ring->slot[ring->head],
+             sizeof(st_fifo_out_slot));
+    ring->head = (ring->head + 1U) % ring->size;
+    ring->num--;
+    i++;
+  }
 
-          if (sensor_type == ST_FIFO_ACCELEROMETER) {
-            data[0] = last_data_xl[0] + diff[3];
-            data[1] = last_data_xl[1] + diff[4];
-            data[2] = last_data_xl[2] + diff[5];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            fifo_out_slot[j].timestamp =
-                             (timestamp -(TIMESTAMP_FREQ / (uint32_t)bdr_xl));
-            byte_cpy((uint8_t*)last_data_xl, fifo_out_slot[j].raw_data, 6);
-          }
+  return i;
+}
 
-          if (sensor_type == ST_FIFO_GYROSCOPE) {
-            data[0] = last_data_gy[0] + diff[3];
-            data[1] = last_data_gy[1] + diff[4];
-            data[2] = last_data_gy[2] + diff[5];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            fifo_out_slot[j].timestamp =
-                             (timestamp - (TIMESTAMP_FREQ / (uint32_t)bdr_gy));
-            byte_cpy((uint8_t*)last_data_gy, fifo_out_slot[j].raw_data, 6);
-          }
+/**
+  * @brief  Initialize a streaming decoder.
+  *
+  *         The raw FIFO bytes are fed in chunks of any length (a single
+  *         tag or data byte, a partial drain, a whole burst) and every
+  *         decoded slot is passed to cb or stored in ring, in decoding
+  *         order (as st_fifo_state_decompress()): memory does not depend
+  *         on the FIFO depth.
+  *
+  * @param  stream            streaming decoder.(ptr)
+  * @param  bdr_xl_in         batch data rate for accelerometer sensor in Hz,
+  *                           see st_fifo_state_init().
+  * @param  bdr_gy_in         batch data rate for gyro sensor in Hz,
+  *                           see st_fifo_state_init().
+  * @param  bdr_vsens_in      batch data rate for virtual sensor in Hz,
+  *                           see st_fifo_state_init().
+  * @param  cb                decoded slot handler, NULL to use ring.
+  * @param  cb_arg            handler argument.(ptr)
+  * @param  ring              decoded slots ring (see st_fifo_ring_init()),
+  *                           used only if cb is NULL.(ptr)
+  *
+  * @retval st_fifo_status    ST_FIFO_OK /  ST_FIFO_ERR
+  *
+  */
+st_fifo_status st_fifo_stream_init(st_fifo_stream *stream,
+                                   float_t bdr_xl_in,
+                                   float_t bdr_gy_in,
+                                   float_t bdr_vsens_in,
+                                   st_fifo_out_cb cb, void *cb_arg,
+                                   st_fifo_ring *ring)
+{
+  st_fifo_status ret = ST_FIFO_ERR;
 
-          j++;
+  if ((cb != NULL) || (ring != NULL)) {
+    stream->cb = cb;
+    stream->cb_arg = cb_arg;
+    stream->ring = ring;
+    stream->word_len = 0;
+    ret = st_fifo_state_init(&stream->state, bdr_xl_in, bdr_gy_in,
+                             bdr_vsens_in);
+  }
 
-          fifo_out_slot[j].timestamp = timestamp;
-          fifo_out_slot[j].sensor_tag = sensor_type;
+  return ret;
+}
 
-          if (sensor_type == ST_FIFO_ACCELEROMETER) {
-            data[0] = last_data_xl[0] + diff[6];
-            data[1] = last_data_xl[1] + diff[7];
-            data[2] = last_data_xl[2] + diff[8];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            byte_cpy((uint8_t*)last_data_xl, fifo_out_slot[j].raw_data, 6);
-            last_timestamp_xl = timestamp;
-          }
+/**
+  * @brief  Feed raw FIFO bytes (tag + 6 data bytes per FIFO word) to a
+  *         streaming decoder.
+  *
+  *         With a ring, feeding stops before a FIFO word whose slots
+  *         could not fit in the ring: read the ring and feed again the
+  *         bytes not used. A word with bad parity or tag is dropped and
+  *         ST_FIFO_ERR returned, the following bytes can be fed again.
+  *
+  * @param  stream            streaming decoder.(ptr)
+  * @param  data              raw FIFO bytes.(ptr)
+  * @param  len               number of raw FIFO bytes.
+  * @param  used              number of bytes used.(ptr)
+  *
+  * @retval st_fifo_status    ST_FIFO_OK /  ST_FIFO_ERR
+  *
+  */
+st_fifo_status st_fifo_stream_feed(st_fifo_stream *stream,
+                                   const uint8_t *data, uint32_t len,
+                                   uint32_t *used)
+{
+  st_fifo_view view[3];
+  int16_t side[3][3];
+  st_fifo_out_slot out;
+  st_fifo_ring *ring = stream->ring;
+  st_fifo_status ret = ST_FIFO_OK;
+  uint32_t i = 0;
+  uint16_t num;
+  uint16_t k;
+
+  while ((i < len) && (ret == ST_FIFO_OK)) {
+
+    if ((stream->word_len == 6U) && (stream->cb == NULL) &&
+        ((uint16_t)(ring->size - ring->num) < 3U)) {
+      /* ring full: wait to be read */
+      len = i;
+    }
+    else {
+      stream->word[stream->word_len] = data[i];
+      stream->word_len++;
+      i++;
+    }
 
-          if (sensor_type == ST_FIFO_GYROSCOPE) {
-            data[0] = last_data_gy[0] + diff[6];
-            data[1] = last_data_gy[1] + diff[7];
-            data[2] = last_data_gy[2] + diff[8];
-            byte_cpy(fifo_out_slot[j].raw_data,(uint8_t*)data, 6);
-            byte_cpy((uint8_t*)last_data_gy, fifo_out_slot[j].raw_data, 6);
-            last_timestamp_gy = timestamp;
-          }
+    if (stream->word_len == 7U) {
+      stream->word_len = 0;
+      ret = decode_word(&stream->state, stream->word, view, side, &num);
+      num = (ret == ST_FIFO_OK) ? num : 0U;
 
-          j++;
-          break;
+      for (k = 0; k < num; k++) {
+        if (stream->cb != NULL) {
+          view_to_slot(&out, &view[k]);
+          stream->cb(&out, stream->cb_arg);
+        }
+        else {
+          view_to_slot(&ring->slot[(ring->head + ring->num) % ring->size],
+                       &view[k]);
+          ring->num++;
         }
-
-        *out_slot_size = j;
       }
-
-    tag_counter_old = tag_counter;
+    }
   }
 
-  return ST_FIFO_OK;
+  *used = i;
+
+  return ret;
 }
 
 /**
@@ -626,6 +585,213 @@ void st_fifo_extract_sensor(st_fifo_out_slot *sensor_out_slot,
   *
   */
 
+/**
+  * @brief  Decode one raw FIFO word (tag + 6 data bytes) and update the
+  *         decoder state.
+  *
+  *         Not compressed data are not copied: the view points to the
+  *         raw word. 2x / 3x compressed data are rebuilt in side.
+  *
+  * @param  state             decoder state.(ptr)
+  * @param  raw               raw FIFO word.(ptr)
+  * @param  view              decoded samples, up to 3 (3x compression).(ptr)
+  * @param  side              rebuilt compressed samples.(ptr)
+  * @param  out_num           number of decoded samples, 0 for timestamp and
+  *                           BDR change words.(ptr)
+  *
+  * @retval st_fifo_status    ST_FIFO_OK /  ST_FIFO_ERR (parity or tag)
+  *
+  */
+static st_fifo_status decode_word(st_fifo_state *state, const uint8_t raw[7],
+                                  st_fifo_view view[3], int16_t side[3][3],
+                                  uint16_t *out_num)
+{
+  st_fifo_compression_type compression_type;
+  st_fifo_sensor_type sensor_type;
+  uint16_t j = 0;
+  uint16_t num;
+  uint8_t tag;
+  uint8_t tag_counter;
+  uint8_t diff_tag_counter;
+  uint8_t bdr_acc_cfg;
+  uint8_t bdr_gyr_cfg;
+  uint8_t bdr_vsens_cfg;
+  uint8_t k;
+  uint32_t slot_timestamp = 0;
+  uint32_t bdr;
+  uint32_t bdr_old;
+  uint32_t *last_timestamp;
+  int16_t *last_data;
+  uint8_t *bdr_chg_flag;
+  int16_t diff[9];
+
+  tag = (raw[0] & TAG_SENSOR_MASK);
+  tag = tag >> TAG_SENSOR_SHIFT;
+
+  tag_counter = (raw[0] & TAG_COUNTER_MASK);
+  tag_counter = tag_counter >> TAG_COUNTER_SHIFT;
+
+  if ((has_even_parity(raw[0]) == 0U) ||
+      (is_tag_valid(tag) == 0U)){
+    return ST_FIFO_ERR;
+  }
+
+  if ((tag_counter != (state->tag_counter_old)) && (state->bdr_max != 0.0f)) {
+
+    if (tag_counter < state->tag_counter_old){
+      diff_tag_counter = tag_counter + 4U - state->tag_counter_old;
+    }
+    else{
+      diff_tag_counter = tag_counter - state->tag_counter_old;
+    }
+
+    state->timestamp +=
+      (TIMESTAMP_FREQ / (uint32_t)state->bdr_max) * diff_tag_counter;
+  }
+
+  if (tag == TAG_ODRCHG) {
+
+    bdr_acc_cfg = (raw[6] & BDR_XL_MASK);
+    bdr_acc_cfg = bdr_acc_cfg >> BDR_XL_SHIFT;
+
+    bdr_gyr_cfg = (raw[6] & BDR_GY_MASK);
+    bdr_gyr_cfg = bdr_gyr_cfg >> BDR_GY_SHIFT;
+
+    bdr_vsens_cfg =(raw[3] & BDR_VSENS_MASK);
+    bdr_vsens_cfg = bdr_vsens_cfg >> BDR_VSENS_SHIFT;
+
+    state->bdr_xl_old = state->bdr_xl;
+    state->bdr_gy_old = state->bdr_gy;
+
+    state->bdr_xl = bdr_xl_vect[bdr_acc_cfg];
+    state->bdr_gy = bdr_gy_vect[bdr_gyr_cfg];
+    state->bdr_vsens = bdr_vsens_vect[bdr_vsens_cfg];
+    state->bdr_max =
+      ((state->bdr_xl > state->bdr_gy) ? state->bdr_xl : state->bdr_gy);
+    state->bdr_max = ((state->bdr_max > state->bdr_vsens) ?
+                      state->bdr_max : state->bdr_vsens);
+
+    state->bdr_chg_xl_flag = 1;
+    state->bdr_chg_gy_flag = 1;
+
+  } else if (tag == TAG_TS) {
+
+    byte_cpy((uint8_t*)&state->timestamp, &raw[1], 4);
+
+  } else {
+
+    compression_type = get_compression_type(tag);
+    sensor_type = get_sensor_type(tag);
+
+    /* decoding history of the sensor, used for acc and gyro only */
+    if (sensor_type == ST_FIFO_ACCELEROMETER) {
+      last_data = state->last_data_xl;
+      last_timestamp = &state->last_timestamp_xl;
+      bdr_chg_flag = &state->bdr_chg_xl_flag;
+      bdr = (uint32_t)state->bdr_xl;
+      bdr_old = (uint32_t)state->bdr_xl_old;
+    }
+    else {
+      last_data = state->last_data_gy;
+      last_timestamp = &state->last_timestamp_gy;
+      bdr_chg_flag = &state->bdr_chg_gy_flag;
+      bdr = (uint32_t)state->bdr_gy;
+      bdr_old = (uint32_t)state->bdr_gy_old;
+    }
+
+    switch (compression_type){
+      case ST_FIFO_COMPRESSION_NC:
+        if (tag == TAG_STEP_COUNTER){
+          byte_cpy((uint8_t*)&slot_timestamp, &raw[3], 4);
+        }
+        else{
+          slot_timestamp = state->timestamp;
+        }
+
+        if ((sensor_type == ST_FIFO_ACCELEROMETER) ||
+            (sensor_type == ST_FIFO_GYROSCOPE)) {
+          byte_cpy((uint8_t*)last_data, &raw[1], 6);
+          *last_timestamp = state->timestamp;
+          *bdr_chg_flag = 0;
+        }
+
+        view[j].timestamp = slot_timestamp;
+        view[j].sensor_tag = sensor_type;
+        view[j].raw_data = &raw[1];
+        j++;
+        break;
+      case ST_FIFO_COMPRESSION_NC_T_1:
+      case ST_FIFO_COMPRESSION_NC_T_2:
+        if (*bdr_chg_flag != 0U){
+          slot_timestamp = *last_timestamp + (TIMESTAMP_FREQ / bdr_old);
+        }
+        else if (compression_type == ST_FIFO_COMPRESSION_NC_T_1){
+          slot_timestamp = state->timestamp - (TIMESTAMP_FREQ / bdr);
+        }
+        else{
+          slot_timestamp = state->timestamp - ((2U * TIMESTAMP_FREQ) / bdr);
+        }
+
+        byte_cpy((uint8_t*)last_data, &raw[1], 6);
+        *last_timestamp = slot_timestamp;
+
+        view[j].timestamp = slot_timestamp;
+        view[j].sensor_tag = sensor_type;
+        view[j].raw_data = &raw[1];
+        j++;
+        break;
+      default: // ST_FIFO_COMPRESSION_2X / ST_FIFO_COMPRESSION_3X
+        if (compression_type == ST_FIFO_COMPRESSION_2X) {
+          get_diff_2x(diff, &raw[1]);
+          num = 2;
+        }
+        else {
+          get_diff_3x(diff, &raw[1]);
+          num = 3;
+        }
+
+        /* samples at T-2, T-1 (and T for 3x) */
+        for (j = 0; j < num; j++) {
+          for (k = 0; k < 3U; k++) {
+            side[j][k] = (int16_t)(last_data[k] + diff[(3U * j) + k]);
+            last_data[k] = side[j][k];
+          }
+
+          slot_timestamp = state->timestamp -
+                           (((2U - j) * TIMESTAMP_FREQ) / bdr);
+
+          view[j].timestamp = slot_timestamp;
+          view[j].sensor_tag = sensor_type;
+          view[j].raw_data = (const uint8_t*)side[j];
+        }
+
+        *last_timestamp = slot_timestamp;
+        break;
+    }
+  }
+
+  state->tag_counter_old = tag_counter;
+
+  *out_num = j;
+
+  return ST_FIFO_OK;
+}
+
+/**
+  * @brief  Copy a decoded sample view in an output slot.
+  *
+  * @param  fifo_out_slot     output slot.(ptr)
+  * @param  view              decoded sample.(ptr)
+  *
+  */
+static void view_to_slot(st_fifo_out_slot *fifo_out_slot,
+                         const st_fifo_view *view)
+{
+  fifo_out_slot->timestamp = view->timestamp;
+  fifo_out_slot->sensor_tag = view->sensor_tag;
+  byte_cpy(fifo_out_slot->raw_data, view->raw_data, 6);
+}
+
 /**
   * @brief  This function indicate if a raw tag is valid or not.
   *
@@ -837,7 +1003,7 @@ static uint8_t has_even_parity(uint8_t x)
   * @param  input[6]          FIFO raw word without tag.
   *
   */
-static void get_diff_2x(int16_t diff[6], uint8_t input[6])
+static void get_diff_2x(int16_t diff[6], const uint8_t input[6])
 {
   uint8_t i;
   for (i = 0; i < 6U; i++){
@@ -857,17 +1023,19 @@ static void get_diff_2x(int16_t diff[6], uint8_t input[6])
   * @param  input[6]          fifo raw word without tag.
   *
   */
-static void get_diff_3x(int16_t diff[9], uint8_t input[6])
+static void get_diff_3x(int16_t diff[9], const uint8_t input[6])
 {
+  uint32_t decode_tmp;
   uint32_t decode_temp;
 
   for (uint8_t i = 0; i < 3U; i++) {
 
-    byte_cpy((uint8_t*)&decode_temp, &input[2U * i], 2);
+    decode_tmp = (uint32_t)input[(2U * i) + 1U];
+    decode_tmp = (decode_tmp * 256U) + (uint32_t)input[2U * i];
 
     for (uint8_t j = 0; j < 3U; j++) {
 
-      decode_temp &= ( (uint32_t)0x1FU << (5U * j) );
+      decode_temp = decode_tmp & ( (uint32_t)0x1FU << (5U * j) );
       decode_temp = decode_temp >> (5U * j);
 
       int16_t temp = (int16_t)decode_temp;
@@ -884,7 +1052,8 @@ static void get_diff_3x(int16_t diff[9], uint8_t input[6])
   * @param  source           Source buffer.(ptr)
   *
   */
-static void byte_cpy(uint8_t *destination, uint8_t *source, uint32_t len)
+static void byte_cpy(uint8_t *destination, const uint8_t *source,
+                     uint32_t len)
 {
   uint32_t i;
 
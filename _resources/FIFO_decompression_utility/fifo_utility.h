@@ -74,6 +74,65 @@ typedef struct {
   uint8_t raw_data[6];
 } st_fifo_out_slot;
 
+/**
+  * @brief  Decoder state of one device, see st_fifo_state_init().
+  */
+typedef struct {
+  float_t bdr_xl;
+  float_t bdr_gy;
+  float_t bdr_vsens;
+  float_t bdr_xl_old;
+  float_t bdr_gy_old;
+  float_t bdr_max;
+  uint32_t timestamp;
+  uint32_t last_timestamp_xl;
+  uint32_t last_timestamp_gy;
+  int16_t last_data_xl[3];
+  int16_t last_data_gy[3];
+  uint8_t tag_counter_old;
+  uint8_t bdr_chg_xl_flag;
+  uint8_t bdr_chg_gy_flag;
+} st_fifo_state;
+
+/**
+  * @brief  Decoded sample, see st_fifo_state_decode_view().
+  */
+typedef struct {
+  uint32_t timestamp;
+  st_fifo_sensor_type sensor_tag;
+  const uint8_t *raw_data;  /* 6 bytes, in the raw stream if not
+                             * compressed */
+} st_fifo_view;
+
+typedef void (*st_fifo_view_cb)(const st_fifo_view *view, void *arg);
+
+/**
+  * @brief  Decoded slot handler, see st_fifo_stream_init().
+  */
+typedef void (*st_fifo_out_cb)(const st_fifo_out_slot *slot, void *arg);
+
+/**
+  * @brief  Bounded ring of decoded slots, see st_fifo_ring_init().
+  */
+typedef struct {
+  st_fifo_out_slot *slot;   /* storage */
+  uint16_t size;            /* capacity in slots */
+  uint16_t head;            /* oldest slot */
+  uint16_t num;             /* stored slots */
+} st_fifo_ring;
+
+/**
+  * @brief  Streaming decoder, see st_fifo_stream_init().
+  */
+typedef struct {
+  st_fifo_state state;
+  st_fifo_out_cb cb;
+  void *cb_arg;
+  st_fifo_ring *ring;
+  uint8_t word[7];          /* FIFO word being received */
+  uint8_t word_len;
+} st_fifo_stream;
+
 /**
   * @defgroup axisXbitXX_t
   * @brief    This union is useful to represent different sensors data type.
@@ -111,6 +170,39 @@ st_fifo_status st_fifo_decompress(st_fifo_out_slot *fifo_out_slot,
                                   uint16_t *out_slot_size,
                                   uint16_t stream_size);
 
+st_fifo_status st_fifo_state_init(st_fifo_state *state,
+                                  float_t bdr_xl_in,
+                                  float_t bdr_gy_in,
+                                  float_t bdr_vsens_in);
+
+st_fifo_status st_fifo_state_decompress(st_fifo_state *state,
+                                        st_fifo_out_slot *fifo_out_slot,
+                                        st_fifo_raw_slot *fifo_raw_slot,
+                                        uint16_t *out_slot_size,
+                                        uint16_t stream_size);
+
+st_fifo_status st_fifo_state_decode_view(st_fifo_state *state,
+                                         const st_fifo_raw_slot *fifo_raw_slot,
+                                         uint16_t stream_size,
+                                         st_fifo_view_cb cb, void *cb_arg);
+
+st_fifo_status st_fifo_ring_init(st_fifo_ring *ring, st_fifo_out_slot *slot,
+                                 uint16_t size);
+
+uint16_t st_fifo_ring_get(st_fifo_ring *ring, st_fifo_out_slot *fifo_out_slot,
+                          uint16_t max);
+
+st_fifo_status st_fifo_stream_init(st_fifo_stream *stream,
+                                   float_t bdr_xl_in,
+                                   float_t bdr_gy_in,
+                                   float_t bdr_vsens_in,
+                                   st_fifo_out_cb cb, void *cb_arg,
+                                   st_fifo_ring *ring);
+
+st_fifo_status st_fifo_stream_feed(st_fifo_stream *stream,
+                                   const uint8_t *data, uint32_t len,
+                                   uint32_t *used);
+
 void st_fifo_sort(st_fifo_out_slot *fifo_out_slot, uint16_t out_slot_size);
 
 uint16_t st_fifo_get_sensor_occurrence(st_fifo_out_slot *fifo_out_slot,
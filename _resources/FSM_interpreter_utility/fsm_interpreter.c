@@ -0,0 +1,1058 @@
+/*
+ ******************************************************************************
+ * @file    fsm_interpreter.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Host side interpreter of the Finite State Machine programs.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fsm_interpreter.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/**
+  * @defgroup  FSM interpreter
+  * @brief     This file provides a set of functions needed to run
+  *            Finite State Machine programs on recorded data.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+/* Program fixed part: CONFIG_A, CONFIG_B, SIZE, SETTINGS, RP, PP */
+#define PRG_CONFIG_A             (0x00U)
+#define PRG_CONFIG_B             (0x01U)
+#define PRG_SIZE                 (0x02U)
+#define PRG_HEADER_LEN           (0x06U)
+
+#define CONFIG_A_NR_THRESH(a)    (((a) >> 6) & 0x03U)
+#define CONFIG_A_NR_MASK(a)      (((a) >> 4) & 0x03U)
+#define CONFIG_A_NR_LTIMER(a)    (((a) >> 2) & 0x03U)
+#define CONFIG_A_NR_TIMER(a)     ((a) & 0x03U)
+#define CONFIG_B_HYST            (0x40U)
+#define CONFIG_B_ZC              (0x10U)
+#define CONFIG_B_SUPPORTED       (CONFIG_B_HYST | CONFIG_B_ZC)
+
+/* Conditions (reset condition in the high nibble, next in the low one) */
+#define COND_NOP                 (0x0U)
+#define COND_TI1                 (0x1U)
+#define COND_TI2                 (0x2U)
+#define COND_TI3                 (0x3U)
+#define COND_TI4                 (0x4U)
+#define COND_GNTH1               (0x5U)
+#define COND_GNTH2               (0x6U)
+#define COND_LNTH1               (0x7U)
+#define COND_LNTH2               (0x8U)
+#define COND_GLTH1               (0x9U)
+#define COND_LLTH1               (0xAU)
+#define COND_GRTH1               (0xBU)
+#define COND_LRTH1               (0xCU)
+#define COND_GRTH2               (0xDU)
+#define COND_LRTH2               (0xEU)
+#define COND_ZC                  (0xFU)
+
+/* Commands */
+#define CMD_STOP                 (0x00U)
+#define CMD_CONT                 (0x11U)
+#define CMD_CONTREL              (0x22U)
+#define CMD_SRP                  (0x33U)
+#define CMD_CRP                  (0x44U)
+#define CMD_SETP                 (0x55U)
+#define CMD_SELMA                (0x66U)
+#define CMD_SELMB                (0x77U)
+#define CMD_SELMC                (0x88U)
+#define CMD_OUTC                 (0x99U)
+#define CMD_STHR1                (0xAAU)
+#define CMD_STHR2                (0xBBU)
+#define CMD_SELTHR1              (0xCCU)
+#define CMD_SELTHR3              (0xDDU)
+#define CMD_SISW                 (0xEEU)
+#define CMD_REL                  (0xFFU)
+
+#define AXIS_NUM                 (4U)
+#define ZC_VALID                 (0x80U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  const st_fsm_engine *engine;
+  st_fsm_recording *rec;
+  uint32_t rec_num;
+  uint32_t next;
+  pthread_mutex_t lock;
+} batch_queue;
+
+/* Private functions ---------------------------------------------------------*/
+/*  Functions declare in this section are defined at the end of this file.    */
+static st_fsm_status program_layout(st_fsm_program *p);
+static st_fsm_status program_check(st_fsm_program *p);
+static int16_t command_len(uint8_t code);
+static uint8_t condition_check(const st_fsm_program *p, uint8_t cond);
+static void program_reset(st_fsm_program *p);
+static uint8_t program_step(st_fsm_program *p, const float_t v[AXIS_NUM],
+                            uint8_t *outs);
+static uint8_t condition_eval(st_fsm_program *p, uint8_t cond,
+                              const float_t v[AXIS_NUM]);
+static uint8_t timer_of(uint8_t cond);
+static float_t thresh_get(const st_fsm_program *p, uint8_t n);
+static void *batch_worker(void *arg);
+
+/**
+  * @defgroup  FSM_interpreter_pubblic_functions
+  * @brief     This section provide a set of APIs for running
+  *            Finite State Machine programs.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize an empty engine.
+  *
+  * @param  engine            FSM engine.(ptr)
+  * @param  xl_sens           accelerometer sensitivity in g/LSB.
+  * @param  gy_sens           gyroscope sensitivity in dps/LSB.
+  *
+  */
+void st_fsm_engine_init(st_fsm_engine *engine, float_t xl_sens,
+                        float_t gy_sens)
+{
+  (void)memset(engine, 0, sizeof(st_fsm_engine));
+  engine->xl_sens = xl_sens;
+  engine->gy_sens = gy_sens;
+}
+
+/**
+  * @brief  Add a program to the engine, programs are numbered in load
+  *         order (first loaded program -> FSM1).
+  *         The program is rejected if it uses a feature not supported by
+  *         the interpreter, see engine->prg[engine->prg_num].err_offset.
+  *
+  * @param  engine            FSM engine.(ptr)
+  * @param  code              program, as written in the FSM memory.(ptr)
+  * @param  len               length of code.
+  * @param  input             sensor processed by the program.
+  *
+  * @retval st_fsm_status     ST_FSM_OK /  ST_FSM_ERR
+  *
+  */
+st_fsm_status st_fsm_program_load(st_fsm_engine *engine,
+                                  const uint8_t *code, uint16_t len,
+                                  st_fsm_input input)
+{
+  st_fsm_program *p;
+
+  if (engine->prg_num >= ST_FSM_PROGRAM_MAX) {
+    return ST_FSM_ERR;
+  }
+
+  p = &engine->prg[engine->prg_num];
+  (void)memset(p, 0, sizeof(st_fsm_program));
+  p->input = input;
+
+  if ((len < PRG_HEADER_LEN) || (len > ST_FSM_PROGRAM_SIZE_MAX) ||
+      (code[PRG_SIZE] > len)) {
+    p->err_offset = PRG_SIZE;
+    return ST_FSM_ERR;
+  }
+
+  (void)memcpy(p->code, code, len);
+  p->size = code[PRG_SIZE];
+
+  if (program_layout(p) != ST_FSM_OK) {
+    return ST_FSM_ERR;
+  }
+
+  if (program_check(p) != ST_FSM_OK) {
+    return ST_FSM_ERR;
+  }
+
+  program_reset(p);
+  engine->prg_num++;
+
+  return ST_FSM_OK;
+}
+
+/**
+  * @brief  Restart all programs from their first instruction and clear
+  *         outputs and status. Thresholds and parameters changed by
+  *         STHR1 / STHR2 / SETP are not restored.
+  *
+  * @param  engine            FSM engine.(ptr)
+  *
+  */
+void st_fsm_engine_reset(st_fsm_engine *engine)
+{
+  for (uint8_t i = 0; i < engine->prg_num; i++) {
+    program_reset(&engine->prg[i]);
+  }
+
+  engine->status = 0;
+  (void)memset(engine->outs, 0, sizeof(engine->outs));
+}
+
+/**
+  * @brief  Run all programs on one sample.
+  *         engine->status reports the programs that generated an
+  *         interrupt on this sample (bit n -> program n + 1), engine->outs
+  *         holds the FSM_OUTS registers.
+  *
+  * @param  engine            FSM engine.(ptr)
+  * @param  xl                accelerometer raw data.(ptr)
+  * @param  gy                gyroscope raw data, can be NULL if no program
+  *                           uses it.(ptr)
+  * @param  sample            sample index, reported in the events.
+  * @param  event             buffer for the events of this sample, can be
+  *                           NULL.(ptr)
+  * @param  event_max         event buffer size.
+  *
+  * @retval                   number of events (state changes and
+  *                           interrupts), also the ones that did not fit
+  *                           in event.
+  *
+  */
+uint8_t st_fsm_process(st_fsm_engine *engine, const int16_t xl[3],
+                       const int16_t gy[3], uint32_t sample,
+                       st_fsm_event *event, uint8_t event_max)
+{
+  float_t v[2][AXIS_NUM];
+  uint8_t num = 0;
+
+  for (uint8_t a = 0; a < 3U; a++) {
+    v[ST_FSM_INPUT_XL][a] = (float_t)xl[a] * engine->xl_sens;
+    v[ST_FSM_INPUT_GY][a] = (gy != NULL) ?
+                            (float_t)gy[a] * engine->gy_sens : 0.0f;
+  }
+
+  for (uint8_t i = 0; i < 2U; i++) {
+    v[i][3] = sqrtf((v[i][0] * v[i][0]) + (v[i][1] * v[i][1]) +
+                    (v[i][2] * v[i][2]));
+  }
+
+  engine->status = 0;
+
+  for (uint8_t i = 0; i < engine->prg_num; i++) {
+    st_fsm_program *p = &engine->prg[i];
+    uint8_t pp = p->pp;
+    uint8_t irq;
+
+    irq = program_step(p, v[p->input], &engine->outs[i]);
+
+    if (irq != 0U) {
+      engine->status |= (uint16_t)(1U << i);
+    }
+
+    if ((irq != 0U) || (pp != p->pp)) {
+      if ((event != NULL) && (num < event_max)) {
+        event[num].sample = sample;
+        event[num].program = i;
+        event[num].pp_from = pp;
+        event[num].pp_to = p->pp;
+        event[num].outs = engine->outs[i];
+        event[num].irq = irq;
+      }
+
+      num++;
+    }
+  }
+
+  return num;
+}
+
+/**
+  * @brief  Run the programs on a whole recording, starting from the
+  *         state of engine (that is not modified).
+  *
+  * @param  engine            FSM engine with the programs loaded.(ptr)
+  * @param  rec               recording to process.(ptr)
+  *
+  * @retval st_fsm_status     ST_FSM_OK /  ST_FSM_ERR
+  *
+  */
+st_fsm_status st_fsm_run(const st_fsm_engine *engine, st_fsm_recording *rec)
+{
+  st_fsm_event event[ST_FSM_PROGRAM_MAX];
+  st_fsm_engine *state;
+  uint8_t num;
+
+  rec->event_num = 0;
+  rec->event_lost = 0;
+  (void)memset(rec->irq_num, 0, sizeof(rec->irq_num));
+
+  state = malloc(sizeof(st_fsm_engine));
+  if (state == NULL) {
+    rec->status = ST_FSM_ERR;
+    return ST_FSM_ERR;
+  }
+
+  (void)memcpy(state, engine, sizeof(st_fsm_engine));
+
+  for (uint32_t i = 0; i < rec->len; i++) {
+    num = st_fsm_process(state, rec->xl[i],
+                         (rec->gy != NULL) ? rec->gy[i] : NULL, i,
+                         event, (uint8_t)ST_FSM_PROGRAM_MAX);
+
+    for (uint8_t j = 0; j < num; j++) {
+      if (event[j].irq != 0U) {
+        rec->irq_num[event[j].program]++;
+      }
+
+      if ((rec->event != NULL) && (rec->event_num < rec->event_max)) {
+        rec->event[rec->event_num] = event[j];
+        rec->event_num++;
+      } else {
+        rec->event_lost++;
+      }
+    }
+  }
+
+  free(state);
+  rec->status = ST_FSM_OK;
+
+  return ST_FSM_OK;
+}
+
+/**
+  * @brief  Run the programs on a set of recordings using a pool of
+  *         threads. Every recording starts from the state of engine, so
+  *         results are the same of st_fsm_run().
+  *         Running several program variants is done calling this function
+  *         once per engine (a variant per engine).
+  *
+  * @param  engine            FSM engine with the programs loaded.(ptr)
+  * @param  rec               recordings to process.(ptr)
+  * @param  rec_num           number of recordings.
+  * @param  threads           number of worker threads, 0 or 1 to run
+  *                           in the calling thread.
+  *
+  * @retval st_fsm_status     ST_FSM_OK /  ST_FSM_ERR if at least one
+  *                           recording failed (see rec[i].status).
+  *
+  */
+st_fsm_status st_fsm_batch_run(const st_fsm_engine *engine,
+                               st_fsm_recording *rec, uint32_t rec_num,
+                               uint8_t threads)
+{
+  pthread_t tid[255];
+  batch_queue queue;
+  uint8_t started = 0;
+  st_fsm_status ret = ST_FSM_OK;
+
+  queue.engine = engine;
+  queue.rec = rec;
+  queue.rec_num = rec_num;
+  queue.next = 0;
+
+  if (pthread_mutex_init(&queue.lock, NULL) != 0) {
+    return ST_FSM_ERR;
+  }
+
+  if (threads > rec_num) {
+    threads = (uint8_t)rec_num;
+  }
+
+  for (uint8_t i = 1; i < threads; i++) {
+    if (pthread_create(&tid[started], NULL, batch_worker, &queue) == 0) {
+      started++;
+    }
+  }
+
+  /* the calling thread is a worker too */
+  (void)batch_worker(&queue);
+
+  for (uint8_t i = 0; i < started; i++) {
+    (void)pthread_join(tid[i], NULL);
+  }
+
+  (void)pthread_mutex_destroy(&queue.lock);
+
+  for (uint32_t i = 0; i < rec_num; i++) {
+    if (rec[i].status != ST_FSM_OK) {
+      ret = ST_FSM_ERR;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Convert an half precision float (thresholds and hysteresis
+  *         format) to float.
+  *
+  * @param  h                 half precision value.
+  *
+  * @retval                   float value.
+  *
+  */
+float_t st_fsm_half_to_float(uint16_t h)
+{
+  int32_t e = (int32_t)((h >> 10) & 0x1FU);
+  float_t m = (float_t)(h & 0x3FFU);
+  float_t f;
+
+  if (e == 0) {
+    f = ldexpf(m, -24);
+  } else if (e == 31) {
+    f = (m == 0.0f) ? INFINITY : NAN;
+  } else {
+    f = ldexpf(m + 1024.0f, e - 25);
+  }
+
+  return ((h & 0x8000U) != 0U) ? -f : f;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  FSM interpreter private functions
+  * @brief     This section provide a set of private low-level functions
+  *            used by pubblic APIs.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Compute the offsets of the program variable part:
+  *         thresholds (2 bytes each), hysteresis (2 bytes, CONFIG_B_HYST),
+  *         masks (mask + temporary mask), timer counter (2 bytes when long
+  *         timers are used, otherwise 1 byte), long timers (2 bytes each),
+  *         short timers (1 byte each), zero crossing state (2 bytes,
+  *         CONFIG_B_ZC), instructions.
+  *
+  * @param  p                 program.(ptr)
+  *
+  * @retval st_fsm_status     ST_FSM_OK /  ST_FSM_ERR
+  *
+  */
+static st_fsm_status program_layout(st_fsm_program *p)
+{
+  uint8_t cfg_a = p->code[PRG_CONFIG_A];
+  uint8_t cfg_b = p->code[PRG_CONFIG_B];
+  uint8_t nr_ltimer = CONFIG_A_NR_LTIMER(cfg_a);
+  uint8_t nr_timer = CONFIG_A_NR_TIMER(cfg_a);
+  uint16_t off = PRG_HEADER_LEN;
+
+  if ((cfg_b & (uint8_t)~CONFIG_B_SUPPORTED) != 0U) {
+    p->err_offset = PRG_CONFIG_B;
+    return ST_FSM_ERR;
+  }
+
+  /* TIMER3 / TIMER4 are the short ones */
+  if ((nr_ltimer > 2U) || (nr_timer > 2U)) {
+    p->err_offset = PRG_CONFIG_A;
+    return ST_FSM_ERR;
+  }
+
+  p->nr_thresh = CONFIG_A_NR_THRESH(cfg_a);
+  p->nr_mask = CONFIG_A_NR_MASK(cfg_a);
+
+  p->thresh_off = (uint8_t)off;
+  off += 2U * p->nr_thresh;
+
+  if ((cfg_b & CONFIG_B_HYST) != 0U) {
+    p->hyst_off = (uint8_t)off;
+    off += 2U;
+  }
+
+  p->mask_off = (uint8_t)off;
+  off += 2U * p->nr_mask;
+
+  if (nr_ltimer != 0U) {
+    off += 2U;
+  } else if (nr_timer != 0U) {
+    off += 1U;
+  } else {
+    /* no timer counter */
+  }
+
+  for (uint8_t i = 0; i < nr_ltimer; i++) {
+    p->timer_off[i] = (uint8_t)off;
+    off += 2U;
+  }
+
+  for (uint8_t i = 0; i < nr_timer; i++) {
+    p->timer_off[2U + i] = (uint8_t)off;
+    off += 1U;
+  }
+
+  if ((cfg_b & CONFIG_B_ZC) != 0U) {
+    off += 2U;
+  }
+
+  if (off >= p->size) {
+    p->err_offset = PRG_SIZE;
+    return ST_FSM_ERR;
+  }
+
+  p->instr_off = (uint8_t)off;
+
+  return ST_FSM_OK;
+}
+
+/**
+  * @brief  Check that all the instructions are supported and that they
+  *         refer to thresholds, masks and timers defined by the program.
+  *
+  * @param  p                 program.(ptr)
+  *
+  * @retval st_fsm_status     ST_FSM_OK /  ST_FSM_ERR
+  *
+  */
+static st_fsm_status program_check(st_fsm_program *p)
+{
+  uint16_t off = p->instr_off;
+  uint8_t ok;
+  int16_t len;
+
+  while (off < p->size) {
+    uint8_t code = p->code[off];
+
+    len = command_len(code);
+
+    if (len < 0) {
+      ok = 0;
+    } else if (len > 0) {
+      switch (code) {
+        case CMD_SELMB:
+          ok = (uint8_t)(p->nr_mask >= 2U);
+          break;
+
+        case CMD_SELMC:
+          ok = (uint8_t)(p->nr_mask >= 3U);
+          break;
+
+        case CMD_STHR1:
+          ok = (uint8_t)(p->nr_thresh >= 1U);
+          break;
+
+        case CMD_STHR2:
+          ok = (uint8_t)(p->nr_thresh >= 2U);
+          break;
+
+        case CMD_SELTHR3:
+          ok = (uint8_t)(p->nr_thresh >= 3U);
+          break;
+
+        case CMD_SETP:
+          ok = (uint8_t)((off + 1U < p->size) &&
+                         (p->code[off + 1U] < p->size));
+          break;
+
+        default:
+          ok = 1;
+          break;
+      }
+
+      if ((off + (uint16_t)len) > p->size) {
+        ok = 0;
+      }
+    } else {
+      ok = (uint8_t)((condition_check(p, code >> 4) != 0U) &&
+                     (condition_check(p, code & 0x0FU) != 0U));
+      len = 1;
+    }
+
+    if (ok == 0U) {
+      p->err_offset = off;
+      return ST_FSM_ERR;
+    }
+
+    off += (uint16_t)len;
+  }
+
+  return ST_FSM_OK;
+}
+
+/**
+  * @brief  Length of a command.
+  *
+  * @param  code              instruction code.
+  *
+  * @retval                   0 if code is a condition pair, -1 if it is a
+  *                           command not supported, otherwise the command
+  *                           length including parameters.
+  *
+  */
+static int16_t command_len(uint8_t code)
+{
+  int16_t len;
+
+  switch (code) {
+    case CMD_STOP:
+    case CMD_CONT:
+    case CMD_CONTREL:
+    case CMD_SRP:
+    case CMD_CRP:
+    case CMD_SELMA:
+    case CMD_SELMB:
+    case CMD_SELMC:
+    case CMD_OUTC:
+    case CMD_SELTHR1:
+    case CMD_SELTHR3:
+    case CMD_REL:
+      len = 1;
+      break;
+
+    case CMD_SETP:
+    case CMD_STHR1:
+    case CMD_STHR2:
+      len = 3;
+      break;
+
+    /* SISW and the extended commands sharing codes with timer conditions
+     * pairs are not interpreted */
+    case CMD_SISW:
+    case 0x12U:
+    case 0x13U:
+    case 0x14U:
+    case 0x21U:
+    case 0x23U:
+    case 0x24U:
+    case 0x31U:
+    case 0x32U:
+    case 0x34U:
+    case 0x41U:
+    case 0x42U:
+    case 0x43U:
+      len = -1;
+      break;
+
+    default:
+      len = 0;
+      break;
+  }
+
+  return len;
+}
+
+/**
+  * @brief  Check that a condition refers to existing resources.
+  *
+  * @param  p                 program.(ptr)
+  * @param  cond              condition code.
+  *
+  * @retval                   1 if the condition can be evaluated.
+  *
+  */
+static uint8_t condition_check(const st_fsm_program *p, uint8_t cond)
+{
+  uint8_t ok;
+
+  switch (cond) {
+    case COND_NOP:
+      ok = 1;
+      break;
+
+    case COND_TI1:
+    case COND_TI2:
+    case COND_TI3:
+    case COND_TI4:
+      ok = (uint8_t)(p->timer_off[timer_of(cond)] != 0U);
+      break;
+
+    case COND_GNTH2:
+    case COND_LNTH2:
+    case COND_GRTH2:
+    case COND_LRTH2:
+      ok = (uint8_t)((p->nr_thresh >= 2U) && (p->nr_mask >= 1U));
+      break;
+
+    case COND_ZC:
+      ok = (uint8_t)(((p->code[PRG_CONFIG_B] & CONFIG_B_ZC) != 0U) &&
+                     (p->nr_mask >= 1U));
+      break;
+
+    default:
+      ok = (uint8_t)((p->nr_thresh >= 1U) && (p->nr_mask >= 1U));
+      break;
+  }
+
+  return ok;
+}
+
+/**
+  * @brief  Restart the program from the first instruction.
+  *
+  * @param  p                 program.(ptr)
+  *
+  */
+static void program_reset(st_fsm_program *p)
+{
+  p->pp = p->instr_off;
+  p->rp = p->instr_off;
+  p->mask_sel = 0;
+  p->thresh_sel = 1;
+  p->tmask = 0;
+  p->zc_sign = 0;
+  p->tc = 0;
+  p->tc_run = 0;
+  p->halted = 0;
+}
+
+/**
+  * @brief  Execute a program on one sample: one condition is evaluated,
+  *         then the following commands until the next condition.
+  *
+  * @param  p                 program.(ptr)
+  * @param  v                 x, y, z, norm of the program input.(ptr)
+  * @param  outs              FSM_OUTS register of the program.(ptr)
+  *
+  * @retval                   1 if an interrupt is generated.
+  *
+  */
+static uint8_t program_step(st_fsm_program *p, const float_t v[AXIS_NUM],
+                            uint8_t *outs)
+{
+  uint8_t evaluated = 0;
+  uint8_t irq = 0;
+  uint8_t done = 0;
+  uint16_t guard = 0;
+  uint8_t sign = ZC_VALID;
+
+  while ((p->halted == 0U) && (done == 0U) && (guard < p->size)) {
+    uint8_t code = p->code[p->pp];
+    uint8_t *mask = &p->code[p->mask_off + (2U * p->mask_sel)];
+
+    guard++;
+
+    switch (command_len(code)) {
+      case 0:
+        if (evaluated != 0U) {
+          done = 1;
+        } else {
+          uint8_t t = timer_of(code >> 4);
+
+          evaluated = 1;
+
+          if (t == 0xFFU) {
+            t = timer_of(code & 0x0FU);
+          }
+
+          if (t == 0xFFU) {
+            /* no timer used by the instruction */
+          } else if (p->tc_run == 0U) {
+            p->tc = p->code[p->timer_off[t]];
+            if (t < 2U) {
+              p->tc |= (uint16_t)p->code[p->timer_off[t] + 1U] << 8;
+            }
+            p->tc_run = 1;
+          } else if (p->tc > 0U) {
+            p->tc--;
+          } else {
+            /* timer expired */
+          }
+
+          if (condition_eval(p, code >> 4, v) != 0U) {
+            p->pp = p->rp;
+            p->tc_run = 0;
+            done = 1;
+          } else if (condition_eval(p, code & 0x0FU, v) != 0U) {
+            p->pp++;
+            p->tc_run = 0;
+          } else {
+            done = 1;
+          }
+        }
+        break;
+
+      default:
+        switch (code) {
+          case CMD_STOP:
+            p->halted = 1;
+            break;
+
+          case CMD_CONT:
+            irq = 1;
+            p->pp = p->rp;
+            done = 1;
+            break;
+
+          case CMD_CONTREL:
+            irq = 1;
+            mask[1] = 0;
+            p->pp = p->rp;
+            done = 1;
+            break;
+
+          case CMD_SRP:
+            p->pp++;
+            p->rp = p->pp;
+            break;
+
+          case CMD_CRP:
+            p->pp++;
+            p->rp = p->instr_off;
+            break;
+
+          case CMD_SETP:
+            p->code[p->code[p->pp + 1U]] = p->code[p->pp + 2U];
+            p->pp += 3U;
+            break;
+
+          case CMD_SELMA:
+          case CMD_SELMB:
+          case CMD_SELMC:
+            p->mask_sel = (uint8_t)((code - CMD_SELMA) / 0x11U);
+            p->pp++;
+            break;
+
+          case CMD_OUTC:
+            *outs = mask[1];
+            irq = 1;
+            p->pp++;
+            break;
+
+          case CMD_STHR1:
+          case CMD_STHR2:
+            (void)memcpy(&p->code[p->thresh_off +
+                                  (2U * ((code - CMD_STHR1) / 0x11U))],
+                         &p->code[p->pp + 1U], 2);
+            p->pp += 3U;
+            break;
+
+          case CMD_SELTHR1:
+          case CMD_SELTHR3:
+            p->thresh_sel = (code == CMD_SELTHR1) ? 1U : 3U;
+            p->pp++;
+            break;
+
+          case CMD_REL:
+            mask[1] = 0;
+            p->pp++;
+            break;
+
+          default:
+            /* rejected by program_check() */
+            p->halted = 1;
+            break;
+        }
+        break;
+    }
+
+    if (p->pp >= p->size) {
+      p->halted = 1;
+    }
+  }
+
+  /* zero crossing reference is the previous sample */
+  for (uint8_t a = 0; a < AXIS_NUM; a++) {
+    if (v[a] > 0.0f) {
+      sign |= (uint8_t)(1U << a);
+    }
+  }
+  p->zc_sign = sign;
+
+  return irq;
+}
+
+/**
+  * @brief  Evaluate a condition. Threshold conditions compare every axis
+  *         enabled in the temporary mask, or in the selected mask when the
+  *         temporary one has been released (bit 7 .. 0: +X -X +Y -Y +Z -Z
+  *         +V -V, negative bits compare the opposite of the axis value),
+  *         and store the axes satisfying the condition in the temporary
+  *         mask.
+  *
+  * @param  p                 program.(ptr)
+  * @param  cond              condition code.
+  * @param  v                 x, y, z, norm of the program input.(ptr)
+  *
+  * @retval                   1 if the condition is true.
+  *
+  */
+static uint8_t condition_eval(st_fsm_program *p, uint8_t cond,
+                              const float_t v[AXIS_NUM])
+{
+  uint8_t *mask = &p->code[p->mask_off + (2U * p->mask_sel)];
+  uint8_t sel = (mask[1] != 0U) ? mask[1] : mask[0];
+  float_t hyst = 0.0f;
+  float_t th = 0.0f;
+  uint8_t hit = 0;
+  uint8_t all = 1;
+  uint8_t en = 0;
+
+  switch (cond) {
+    case COND_NOP:
+      return 0;
+
+    case COND_TI1:
+    case COND_TI2:
+    case COND_TI3:
+    case COND_TI4:
+      return (uint8_t)((p->tc_run != 0U) && (p->tc == 0U));
+
+    case COND_GNTH2:
+    case COND_LNTH2:
+    case COND_GRTH2:
+    case COND_LRTH2:
+      th = thresh_get(p, 2);
+      break;
+
+    case COND_ZC:
+      break;
+
+    default:
+      th = thresh_get(p, p->thresh_sel);
+      break;
+  }
+
+  if (p->hyst_off != 0U) {
+    hyst = st_fsm_half_to_float((uint16_t)p->code[p->hyst_off] |
+                                ((uint16_t)p->code[p->hyst_off + 1U] << 8));
+  }
+
+  for (uint8_t b = 0; b < 8U; b++) {
+    uint8_t bit = (uint8_t)(0x80U >> b);
+    uint8_t a = b / 2U;
+    float_t s = ((b & 1U) != 0U) ? -v[a] : v[a];
+    uint8_t ok;
+
+    if ((sel & bit) == 0U) {
+      continue;
+    }
+
+    en = 1;
+
+    switch (cond) {
+      case COND_GNTH1:
+      case COND_GNTH2:
+      case COND_GLTH1:
+        ok = (uint8_t)(s > (th + hyst));
+        break;
+
+      case COND_LNTH1:
+      case COND_LNTH2:
+      case COND_LLTH1:
+        ok = (uint8_t)(s <= (th - hyst));
+        break;
+
+      case COND_GRTH1:
+      case COND_GRTH2:
+        ok = (uint8_t)(s > (-th + hyst));
+        break;
+
+      case COND_LRTH1:
+      case COND_LRTH2:
+        ok = (uint8_t)(s <= (-th - hyst));
+        break;
+
+      default:
+        /* COND_ZC: positive bit -> crossing upward, negative -> downward */
+        if ((p->zc_sign & ZC_VALID) == 0U) {
+          ok = 0;
+        } else if ((b & 1U) != 0U) {
+          ok = (uint8_t)((((p->zc_sign >> a) & 1U) != 0U) && (v[a] <= 0.0f));
+        } else {
+          ok = (uint8_t)((((p->zc_sign >> a) & 1U) == 0U) && (v[a] > 0.0f));
+        }
+        break;
+    }
+
+    if (ok != 0U) {
+      hit |= bit;
+    } else {
+      all = 0;
+    }
+  }
+
+  if ((cond == COND_GLTH1) || (cond == COND_LLTH1)) {
+    if ((en == 0U) || (all == 0U)) {
+      return 0;
+    }
+  } else if (hit == 0U) {
+    return 0;
+  } else {
+    /* at least one axis */
+  }
+
+  mask[1] = hit;
+
+  return 1;
+}
+
+/**
+  * @brief  Timer index (0 -> TIMER1) used by a condition.
+  *
+  * @param  cond              condition code.
+  *
+  * @retval                   timer index or 0xFF.
+  *
+  */
+static uint8_t timer_of(uint8_t cond)
+{
+  if ((cond >= COND_TI1) && (cond <= COND_TI4)) {
+    return cond - COND_TI1;
+  }
+
+  return 0xFFU;
+}
+
+/**
+  * @brief  Get a threshold value.
+  *
+  * @param  p                 program.(ptr)
+  * @param  n                 threshold number (1 .. 3).
+  *
+  * @retval                   threshold.
+  *
+  */
+static float_t thresh_get(const st_fsm_program *p, uint8_t n)
+{
+  uint8_t off = p->thresh_off + (2U * (n - 1U));
+
+  return st_fsm_half_to_float((uint16_t)p->code[off] |
+                              ((uint16_t)p->code[off + 1U] << 8));
+}
+
+/**
+  * @brief  Batch worker: process recordings until the queue is empty.
+  *
+  * @param  arg               batch queue.(ptr)
+  *
+  */
+static void *batch_worker(void *arg)
+{
+  batch_queue *queue = (batch_queue *)arg;
+  uint32_t i;
+
+  for (;;) {
+    (void)pthread_mutex_lock(&queue->lock);
+    i = queue->next;
+    if (i < queue->rec_num) {
+      queue->next++;
+    }
+    (void)pthread_mutex_unlock(&queue->lock);
+
+    if (i >= queue->rec_num) {
+      break;
+    }
+
+    (void)st_fsm_run(queue->engine, &queue->rec[i]);
+  }
+
+  return NULL;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
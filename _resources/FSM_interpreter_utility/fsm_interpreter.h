@@ -0,0 +1,179 @@
+/*
+ ******************************************************************************
+ * @file    fsm_interpreter.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          fsm_interpreter.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_FSM_INTERPRETER_H
+#define ST_FSM_INTERPRETER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <math.h>
+
+/** @addtogroup FSM interpreter
+  * @brief    Host side interpreter of the Finite State Machine programs of
+  *           LSM6DSO / LSM6DSOX (i.e. the lsm6so_prg_* arrays written with
+  *           lsm6dsox_ln_pg_write()).
+  *
+  *           Supported program features:
+  *           - CONFIG_A: thresholds, masks, long (16-bit) and short (8-bit)
+  *             timers.
+  *           - CONFIG_B: hysteresis (bit 6).
+  *           - conditions: NOP, TI1..TI4, GNTH1, GNTH2, LNTH1, LNTH2,
+  *             GLTH1, LLTH1, GRTH1, LRTH1, PZC, NZC.
+  *           - commands: STOP, CONT, CONTREL, SRP, CRP, SETP, SELMA, SELMB,
+  *             SELMC, OUTC, STHR1, STHR2, SELTHR1, SELTHR3, REL.
+  *           Programs using other features are rejected by
+  *           st_fsm_program_load() (st_fsm_program.err_offset reports the
+  *           offending byte) instead of being executed differently from the
+  *           device.
+  *
+  *           One condition is evaluated per sample per program, commands
+  *           are executed in the same sample of the condition that precedes
+  *           them.
+  * @{
+  *
+  */
+
+/** @defgroup FSM_interpreter_pubblic_definitions
+  * @{
+  *
+  */
+
+#define ST_FSM_PROGRAM_MAX          16U
+#define ST_FSM_PROGRAM_SIZE_MAX    256U
+
+typedef enum {
+  ST_FSM_OK = 0,
+  ST_FSM_ERR
+} st_fsm_status;
+
+typedef enum {
+  ST_FSM_INPUT_XL = 0,    /* accelerometer, thresholds in g */
+  ST_FSM_INPUT_GY         /* gyroscope, thresholds in dps */
+} st_fsm_input;
+
+typedef struct {
+  uint8_t code[ST_FSM_PROGRAM_SIZE_MAX];
+  uint16_t size;
+  st_fsm_input input;
+  uint16_t err_offset;
+  /* program layout */
+  uint8_t thresh_off;
+  uint8_t hyst_off;
+  uint8_t mask_off;
+  uint8_t timer_off[4];
+  uint8_t instr_off;
+  uint8_t nr_thresh;
+  uint8_t nr_mask;
+  /* execution state */
+  uint8_t pp;
+  uint8_t rp;
+  uint8_t mask_sel;
+  uint8_t thresh_sel;
+  uint8_t tmask;
+  uint8_t zc_sign;
+  uint16_t tc;
+  uint8_t tc_run;
+  uint8_t halted;
+} st_fsm_program;
+
+/**
+  * @brief  FSM engine: the programs and the registers that the device
+  *         exposes through lsm6dsox_fsm_out_get() and the FSM_STATUS_A/B
+  *         (bit n -> program n + 1) registers.
+  */
+typedef struct {
+  st_fsm_program prg[ST_FSM_PROGRAM_MAX];
+  uint8_t prg_num;
+  float_t xl_sens;        /* accelerometer sensitivity in g/LSB */
+  float_t gy_sens;        /* gyroscope sensitivity in dps/LSB */
+  uint16_t status;
+  uint8_t outs[ST_FSM_PROGRAM_MAX];
+} st_fsm_engine;
+
+/**
+  * @brief  Program state transition or interrupt.
+  */
+typedef struct {
+  uint32_t sample;
+  uint8_t program;        /* 0 -> FSM1 */
+  uint8_t pp_from;
+  uint8_t pp_to;
+  uint8_t outs;
+  uint8_t irq;
+} st_fsm_event;
+
+/**
+  * @brief  Recorded stream and its events used by st_fsm_run() and
+  *         st_fsm_batch_run(). gy can be NULL if no program uses it.
+  *         Events exceeding event_max are counted in event_lost.
+  */
+typedef struct {
+  const int16_t (*xl)[3];
+  const int16_t (*gy)[3];
+  uint32_t len;
+  st_fsm_event *event;
+  uint32_t event_max;
+  uint32_t event_num;
+  uint32_t event_lost;
+  uint32_t irq_num[ST_FSM_PROGRAM_MAX];
+  st_fsm_status status;
+} st_fsm_recording;
+
+/**
+  * @}
+  *
+  */
+
+void st_fsm_engine_init(st_fsm_engine *engine, float_t xl_sens,
+                        float_t gy_sens);
+
+st_fsm_status st_fsm_program_load(st_fsm_engine *engine,
+                                  const uint8_t *code, uint16_t len,
+                                  st_fsm_input input);
+
+void st_fsm_engine_reset(st_fsm_engine *engine);
+
+uint8_t st_fsm_process(st_fsm_engine *engine, const int16_t xl[3],
+                       const int16_t gy[3], uint32_t sample,
+                       st_fsm_event *event, uint8_t event_max);
+
+st_fsm_status st_fsm_run(const st_fsm_engine *engine, st_fsm_recording *rec);
+
+st_fsm_status st_fsm_batch_run(const st_fsm_engine *engine,
+                               st_fsm_recording *rec, uint32_t rec_num,
+                               uint8_t threads);
+
+float_t st_fsm_half_to_float(uint16_t h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_FSM_INTERPRETER_H */
+
+/**
+  * @}
+  *
+  */
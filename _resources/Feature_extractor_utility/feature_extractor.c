@@ -0,0 +1,460 @@
+/*
+ ******************************************************************************
+ * @file    feature_extractor.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Streaming window features with Machine Learning Core
+ *          definitions.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "feature_extractor.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+  * @defgroup  Feature extractor
+  * @brief     This file provides a set of functions needed to compute
+  *            window features on sensor streams.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+#define EVENT_ZC_POS             (0x01U)
+#define EVENT_ZC_NEG             (0x02U)
+#define EVENT_PEAK_POS           (0x04U)
+#define EVENT_PEAK_NEG           (0x08U)
+
+/* Private functions ---------------------------------------------------------*/
+/*  Functions declare in this section are defined at the end of this file.    */
+static uint8_t event_detect(st_feat_state *state, uint8_t ch, float_t v);
+static void queue_push(st_feat_state *state, uint8_t ch, float_t v,
+                       uint32_t *idx, uint16_t *head, uint16_t *len,
+                       int8_t dir);
+static uint16_t index_slot(const st_feat_state *state, uint32_t idx);
+
+/**
+  * @defgroup  Feature_extractor_pubblic_functions
+  * @brief     This section provide a set of APIs for computing window
+  *            features.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize the extractor and allocate the ring buffers
+  *         (window * ch_num entries each).
+  *
+  * @param  state             extractor state.(ptr)
+  * @param  cfg               extractor configuration.(ptr)
+  *
+  * @retval st_feat_status    ST_FEAT_OK /  ST_FEAT_ERR
+  *
+  */
+st_feat_status st_feat_init(st_feat_state *state, const st_feat_cfg *cfg)
+{
+  size_t n;
+
+  (void)memset(state, 0, sizeof(st_feat_state));
+
+  if ((cfg->window == 0U) || (cfg->hop == 0U) ||
+      (cfg->hop > cfg->window) || (cfg->ch_num == 0U) ||
+      (cfg->ch_num > ST_FEAT_CHANNEL_MAX)) {
+    return ST_FEAT_ERR;
+  }
+
+  state->cfg = *cfg;
+  n = (size_t)cfg->window * cfg->ch_num;
+
+  state->value = malloc(n * sizeof(float_t));
+  state->event = malloc(n * sizeof(uint8_t));
+  state->min_idx = malloc(n * sizeof(uint32_t));
+  state->max_idx = malloc(n * sizeof(uint32_t));
+
+  if ((state->value == NULL) || (state->event == NULL) ||
+      (state->min_idx == NULL) || (state->max_idx == NULL)) {
+    st_feat_deinit(state);
+    return ST_FEAT_ERR;
+  }
+
+  st_feat_reset(state);
+
+  return ST_FEAT_OK;
+}
+
+/**
+  * @brief  Release the ring buffers.
+  *
+  * @param  state             extractor state.(ptr)
+  *
+  */
+void st_feat_deinit(st_feat_state *state)
+{
+  free(state->value);
+  free(state->event);
+  free(state->min_idx);
+  free(state->max_idx);
+  state->value = NULL;
+  state->event = NULL;
+  state->min_idx = NULL;
+  state->max_idx = NULL;
+}
+
+/**
+  * @brief  Empty the window and reset the detectors.
+  *
+  * @param  state             extractor state.(ptr)
+  *
+  */
+void st_feat_reset(st_feat_state *state)
+{
+  size_t n = (size_t)state->cfg.window * state->cfg.ch_num;
+
+  state->sample = 0;
+  state->pos = 0;
+  state->fill = 0;
+  state->hop_cnt = state->cfg.hop - 1U;
+
+  (void)memset(state->mean, 0, sizeof(state->mean));
+  (void)memset(state->m2, 0, sizeof(state->m2));
+  (void)memset(state->energy, 0, sizeof(state->energy));
+  (void)memset(state->zc_pos, 0, sizeof(state->zc_pos));
+  (void)memset(state->zc_neg, 0, sizeof(state->zc_neg));
+  (void)memset(state->peak_pos, 0, sizeof(state->peak_pos));
+  (void)memset(state->peak_neg, 0, sizeof(state->peak_neg));
+  (void)memset(state->zc_sign, 0, sizeof(state->zc_sign));
+  (void)memset(state->peak_dir, 0, sizeof(state->peak_dir));
+  (void)memset(state->peak_ext, 0, sizeof(state->peak_ext));
+  (void)memset(state->min_len, 0, sizeof(state->min_len));
+  (void)memset(state->max_len, 0, sizeof(state->max_len));
+  (void)memset(state->min_head, 0, sizeof(state->min_head));
+  (void)memset(state->max_head, 0, sizeof(state->max_head));
+  (void)memset(state->event, 0, n);
+}
+
+/**
+  * @brief  Add a sample (one value per channel).
+  *
+  * @param  state             extractor state.(ptr)
+  * @param  x                 ch_num values.(ptr)
+  *
+  * @retval                   1 if a new window is available (see
+  *                           st_feat_get()), 0 otherwise.
+  *
+  */
+uint8_t st_feat_push(st_feat_state *state, const float_t *x)
+{
+  uint16_t w = state->cfg.window;
+  uint16_t pos = state->pos;
+  uint8_t full = (uint8_t)(state->fill == w);
+
+  if (full == 0U) {
+    state->fill++;
+  }
+
+  for (uint8_t ch = 0; ch < state->cfg.ch_num; ch++) {
+    size_t slot = ((size_t)ch * w) + pos;
+    double v = (double)x[ch];
+    double mean = state->mean[ch];
+    uint8_t ev;
+
+    if (full != 0U) {
+      /* sliding Welford update: replace the oldest sample */
+      double old = (double)state->value[slot];
+
+      state->mean[ch] = mean + ((v - old) / (double)w);
+      state->m2[ch] += (v - old) * ((v - state->mean[ch]) + (old - mean));
+      state->energy[ch] += (v * v) - (old * old);
+
+      ev = state->event[slot];
+      state->zc_pos[ch] -= (uint16_t)((ev & EVENT_ZC_POS) != 0U);
+      state->zc_neg[ch] -= (uint16_t)((ev & EVENT_ZC_NEG) != 0U);
+      state->peak_pos[ch] -= (uint16_t)((ev & EVENT_PEAK_POS) != 0U);
+      state->peak_neg[ch] -= (uint16_t)((ev & EVENT_PEAK_NEG) != 0U);
+    } else {
+      state->mean[ch] = mean + ((v - mean) / (double)state->fill);
+      state->m2[ch] += (v - mean) * (v - state->mean[ch]);
+      state->energy[ch] += v * v;
+    }
+
+    if (state->m2[ch] < 0.0) {
+      state->m2[ch] = 0.0;
+    }
+
+    ev = event_detect(state, ch, x[ch]);
+    state->event[slot] = ev;
+    state->zc_pos[ch] += (uint16_t)((ev & EVENT_ZC_POS) != 0U);
+    state->zc_neg[ch] += (uint16_t)((ev & EVENT_ZC_NEG) != 0U);
+    state->peak_pos[ch] += (uint16_t)((ev & EVENT_PEAK_POS) != 0U);
+    state->peak_neg[ch] += (uint16_t)((ev & EVENT_PEAK_NEG) != 0U);
+
+    queue_push(state, ch, x[ch], &state->min_idx[(size_t)ch * w],
+               &state->min_head[ch], &state->min_len[ch], -1);
+    queue_push(state, ch, x[ch], &state->max_idx[(size_t)ch * w],
+               &state->max_head[ch], &state->max_len[ch], 1);
+
+    state->value[slot] = x[ch];
+  }
+
+  state->sample++;
+  state->pos = (uint16_t)((pos + 1U == w) ? 0U : (pos + 1U));
+
+  if (state->fill == w) {
+    state->hop_cnt++;
+
+    if (state->hop_cnt >= state->cfg.hop) {
+      state->hop_cnt = 0;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Add a block of raw 3 axes samples. Channels 0 .. 2 are x, y, z
+  *         multiplied by sens, channel 3 (if ch_num > 3) is the norm and
+  *         channel 4 (if ch_num > 4) the squared norm, as the MLC inputs.
+  *
+  * @param  state             extractor state.(ptr)
+  * @param  xyz               raw samples.(ptr)
+  * @param  len               number of samples.
+  * @param  sens              sensitivity (e.g. g/LSB).
+  * @param  out               features of every window completed in the
+  *                           block, can be NULL.(ptr)
+  *
+  * @retval                   number of windows completed.
+  *
+  */
+uint16_t st_feat_push_raw(st_feat_state *state, const int16_t (*xyz)[3],
+                          uint16_t len, float_t sens, st_feat_out *out)
+{
+  float_t x[5];
+  uint16_t num = 0;
+
+  for (uint16_t i = 0; i < len; i++) {
+    x[0] = (float_t)xyz[i][0] * sens;
+    x[1] = (float_t)xyz[i][1] * sens;
+    x[2] = (float_t)xyz[i][2] * sens;
+    x[4] = (x[0] * x[0]) + (x[1] * x[1]) + (x[2] * x[2]);
+    x[3] = sqrtf(x[4]);
+
+    if (st_feat_push(state, x) != 0U) {
+      if (out != NULL) {
+        st_feat_get(state, &out[num]);
+      }
+
+      num++;
+    }
+  }
+
+  return num;
+}
+
+/**
+  * @brief  Get the features of the current window.
+  *
+  * @param  state             extractor state.(ptr)
+  * @param  out               features.(ptr)
+  *
+  */
+void st_feat_get(const st_feat_state *state, st_feat_out *out)
+{
+  uint16_t w = state->cfg.window;
+  double n = (state->fill != 0U) ? (double)state->fill : 1.0;
+
+  for (uint8_t ch = 0; ch < state->cfg.ch_num; ch++) {
+    const float_t *value = &state->value[(size_t)ch * w];
+    uint32_t min_i = state->min_idx[((size_t)ch * w) + state->min_head[ch]];
+    uint32_t max_i = state->max_idx[((size_t)ch * w) + state->max_head[ch]];
+
+    out->mean[ch] = (float_t)state->mean[ch];
+    out->variance[ch] = (float_t)(state->m2[ch] / n);
+    out->energy[ch] = (float_t)state->energy[ch];
+
+    if (state->fill != 0U) {
+      out->minimum[ch] = value[index_slot(state, min_i)];
+      out->maximum[ch] = value[index_slot(state, max_i)];
+    } else {
+      out->minimum[ch] = INFINITY;
+      out->maximum[ch] = -INFINITY;
+    }
+
+    out->peak_to_peak[ch] = out->maximum[ch] - out->minimum[ch];
+    out->zc_pos[ch] = state->zc_pos[ch];
+    out->zc_neg[ch] = state->zc_neg[ch];
+    out->peak_pos[ch] = state->peak_pos[ch];
+    out->peak_neg[ch] = state->peak_neg[ch];
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  Feature extractor private functions
+  * @brief     This section provide a set of private low-level functions
+  *            used by pubblic APIs.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Update the zero-crossing and peak detectors of a channel, same
+  *         rules of the MLC emulator.
+  *
+  * @param  state             extractor state.(ptr)
+  * @param  ch                channel.
+  * @param  v                 new value.
+  *
+  * @retval                   EVENT_* flags of the sample.
+  *
+  */
+static uint8_t event_detect(st_feat_state *state, uint8_t ch, float_t v)
+{
+  float_t th = state->cfg.threshold[ch];
+  uint8_t ev = 0;
+  int8_t side;
+
+  side = (v > th) ? 1 : ((v < -th) ? -1 : 0);
+  if (side != 0) {
+    if ((state->zc_sign[ch] < 0) && (side > 0)) {
+      ev |= EVENT_ZC_POS;
+    }
+    if ((state->zc_sign[ch] > 0) && (side < 0)) {
+      ev |= EVENT_ZC_NEG;
+    }
+    state->zc_sign[ch] = side;
+  }
+
+  switch (state->peak_dir[ch]) {
+    case 1:
+      if (v > state->peak_ext[ch]) {
+        state->peak_ext[ch] = v;
+      } else if (v < (state->peak_ext[ch] - th)) {
+        ev |= EVENT_PEAK_POS;
+        state->peak_dir[ch] = -1;
+        state->peak_ext[ch] = v;
+      } else {
+        /* still inside hysteresis */
+      }
+      break;
+
+    case -1:
+      if (v < state->peak_ext[ch]) {
+        state->peak_ext[ch] = v;
+      } else if (v > (state->peak_ext[ch] + th)) {
+        ev |= EVENT_PEAK_NEG;
+        state->peak_dir[ch] = 1;
+        state->peak_ext[ch] = v;
+      } else {
+        /* still inside hysteresis */
+      }
+      break;
+
+    default:
+      if (v > (state->peak_ext[ch] + th)) {
+        state->peak_dir[ch] = 1;
+        state->peak_ext[ch] = v;
+      } else if (v < (state->peak_ext[ch] - th)) {
+        state->peak_dir[ch] = -1;
+        state->peak_ext[ch] = v;
+      } else {
+        /* still inside hysteresis */
+      }
+      break;
+  }
+
+  return ev;
+}
+
+/**
+  * @brief  Add the current sample to a monotonic queue (increasing values
+  *         for the minimum, decreasing for the maximum); the head is the
+  *         extreme of the window. Must be called before the sample is
+  *         stored in the value ring.
+  *
+  * @param  state             extractor state.(ptr)
+  * @param  ch                channel.
+  * @param  v                 new value.
+  * @param  idx               queue ring (window entries).(ptr)
+  * @param  head              queue head.(ptr)
+  * @param  len               queue length.(ptr)
+  * @param  dir               -1 minimum queue, 1 maximum queue.
+  *
+  */
+static void queue_push(st_feat_state *state, uint8_t ch, float_t v,
+                       uint32_t *idx, uint16_t *head, uint16_t *len,
+                       int8_t dir)
+{
+  uint16_t w = state->cfg.window;
+  const float_t *value = &state->value[(size_t)ch * w];
+  uint16_t tail;
+
+  /* drop the sample leaving the window */
+  if ((*len != 0U) && ((state->sample - idx[*head]) >= w)) {
+    *head = (uint16_t)((*head + 1U) % w);
+    (*len)--;
+  }
+
+  /* drop the samples that can no more be the extreme */
+  while (*len != 0U) {
+    float_t last;
+
+    tail = (uint16_t)((*head + *len - 1U) % w);
+    last = value[index_slot(state, idx[tail])];
+
+    if (((dir > 0) && (last <= v)) || ((dir < 0) && (last >= v))) {
+      (*len)--;
+    } else {
+      break;
+    }
+  }
+
+  tail = (uint16_t)((*head + *len) % w);
+  idx[tail] = state->sample;
+  (*len)++;
+}
+
+/**
+  * @brief  Ring slot of a sample index of the window. The age is taken
+  *         from the sample counter (modulo 2^32, also across its wrap)
+  *         and counted back from the write position.
+  *
+  * @param  state             extractor state.(ptr)
+  * @param  idx               sample index, at most window samples old.
+  *
+  * @retval                   slot in the channel rings.
+  *
+  */
+static uint16_t index_slot(const st_feat_state *state, uint32_t idx)
+{
+  uint32_t w = state->cfg.window;
+  uint32_t age = state->sample - idx;
+
+  return (uint16_t)((state->pos + w - age) % w);
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,149 @@
+/*
+ ******************************************************************************
+ * @file    feature_extractor.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          feature_extractor.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_FEAT_EXTRACTOR_H
+#define ST_FEAT_EXTRACTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <math.h>
+
+/** @addtogroup Feature extractor
+  * @brief    Incremental computation of window features on sensor streams.
+  *           Features have the same definitions of the Machine Learning
+  *           Core ones (see mlc_emulator.c):
+  *           - mean, variance (population, E[x^2] - mean^2), energy
+  *             (sum of x^2 on the window), minimum, maximum, peak-to-peak;
+  *           - zero-crossings: the signal moves from one side to the other
+  *             of the [-threshold, threshold] band;
+  *           - peaks: the signal reverses by more than threshold from the
+  *             last extreme.
+  *           Detectors state is kept across windows as in the MLC, so with
+  *           hop == window (tumbling windows) results are interchangeable
+  *           with the MLC ones; hop < window gives sliding / hopping
+  *           windows.
+  *
+  *           Every sample costs O(1) per channel: mean and variance use
+  *           the Welford update (adding the new sample and removing the
+  *           one leaving the window), minimum and maximum use monotonic
+  *           queues and zero-crossing / peak counts use the events stored
+  *           in a ring buffer. Channels (e.g. x, y, z, norm) are stored
+  *           as structure of arrays.
+  * @{
+  *
+  */
+
+/** @defgroup Feature_extractor_pubblic_definitions
+  * @{
+  *
+  */
+
+#define ST_FEAT_CHANNEL_MAX        16U
+
+typedef enum {
+  ST_FEAT_OK = 0,
+  ST_FEAT_ERR
+} st_feat_status;
+
+typedef struct {
+  uint16_t window;        /* window length in samples */
+  uint16_t hop;           /* samples between results, 1 .. window */
+  uint8_t ch_num;         /* number of channels */
+  float_t threshold[ST_FEAT_CHANNEL_MAX]; /* zero-crossing / peak
+                                           * hysteresis per channel */
+} st_feat_cfg;
+
+/**
+  * @brief  Features of the last window, one entry per channel.
+  */
+typedef struct {
+  float_t mean[ST_FEAT_CHANNEL_MAX];
+  float_t variance[ST_FEAT_CHANNEL_MAX];
+  float_t energy[ST_FEAT_CHANNEL_MAX];
+  float_t minimum[ST_FEAT_CHANNEL_MAX];
+  float_t maximum[ST_FEAT_CHANNEL_MAX];
+  float_t peak_to_peak[ST_FEAT_CHANNEL_MAX];
+  uint16_t zc_pos[ST_FEAT_CHANNEL_MAX];
+  uint16_t zc_neg[ST_FEAT_CHANNEL_MAX];
+  uint16_t peak_pos[ST_FEAT_CHANNEL_MAX];
+  uint16_t peak_neg[ST_FEAT_CHANNEL_MAX];
+} st_feat_out;
+
+typedef struct {
+  st_feat_cfg cfg;
+  uint32_t sample;        /* samples pushed */
+  uint16_t pos;           /* ring buffers write position */
+  uint16_t fill;          /* samples in the window */
+  uint16_t hop_cnt;
+  /* per channel running values (SoA) */
+  double mean[ST_FEAT_CHANNEL_MAX];
+  double m2[ST_FEAT_CHANNEL_MAX];
+  double energy[ST_FEAT_CHANNEL_MAX];
+  uint16_t zc_pos[ST_FEAT_CHANNEL_MAX];
+  uint16_t zc_neg[ST_FEAT_CHANNEL_MAX];
+  uint16_t peak_pos[ST_FEAT_CHANNEL_MAX];
+  uint16_t peak_neg[ST_FEAT_CHANNEL_MAX];
+  int8_t zc_sign[ST_FEAT_CHANNEL_MAX];
+  int8_t peak_dir[ST_FEAT_CHANNEL_MAX];
+  float_t peak_ext[ST_FEAT_CHANNEL_MAX];
+  /* ring buffers, window entries per channel */
+  float_t *value;         /* samples */
+  uint8_t *event;         /* zero-crossing / peak events */
+  uint32_t *min_idx;      /* monotonic queues of sample indexes */
+  uint32_t *max_idx;
+  uint16_t min_head[ST_FEAT_CHANNEL_MAX];
+  uint16_t min_len[ST_FEAT_CHANNEL_MAX];
+  uint16_t max_head[ST_FEAT_CHANNEL_MAX];
+  uint16_t max_len[ST_FEAT_CHANNEL_MAX];
+} st_feat_state;
+
+/**
+  * @}
+  *
+  */
+
+st_feat_status st_feat_init(st_feat_state *state, const st_feat_cfg *cfg);
+
+void st_feat_deinit(st_feat_state *state);
+
+void st_feat_reset(st_feat_state *state);
+
+uint8_t st_feat_push(st_feat_state *state, const float_t *x);
+
+uint16_t st_feat_push_raw(st_feat_state *state, const int16_t (*xyz)[3],
+                          uint16_t len, float_t sens, st_feat_out *out);
+
+void st_feat_get(const st_feat_state *state, st_feat_out *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_FEAT_EXTRACTOR_H */
+
+/**
+  * @}
+  *
+  */
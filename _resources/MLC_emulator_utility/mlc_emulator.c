@@ -0,0 +1,988 @@
+/*
+ ******************************************************************************
+ * @file    mlc_emulator.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Host side emulator of the Machine Learning Core.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mlc_emulator.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/**
+  * @defgroup  MLC emulator
+  * @brief     This file provides a set of functions needed to evaluate
+  *            Machine Learning Core configurations on recorded data.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+#define FUNC_CFG_ACCESS          (0x01U)
+#define CTRL1_XL                 (0x10U)
+#define CTRL2_G                  (0x11U)
+#define EMB_FUNC_ODR_CFG_C       (0x60U)
+
+#define REG_ACCESS_MASK          (0xC0U)
+#define REG_ACCESS_EMB_FUNC      (0x80U)
+#define FS_XL_MASK               (0x0CU)
+#define FS_XL_SHIFT              (0x02U)
+#define FS_G_MASK                (0x0EU)
+#define FS_G_SHIFT               (0x01U)
+#define MLC_ODR_MASK             (0x30U)
+#define MLC_ODR_SHIFT            (0x04U)
+
+#define TREE_LINE_MAX            (128U)
+#define TREE_DEPTH_MAX           (64U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  const char *text;
+  uint8_t valid;
+  uint8_t depth;
+  uint8_t feature;
+  uint8_t greater;
+  float_t threshold;
+  uint8_t leaf;
+  uint8_t result;
+} tree_line;
+
+typedef struct {
+  const st_mlc_cfg *cfg;
+  const st_mlc_class *class_map;
+  uint16_t class_num;
+  st_mlc_node *node;
+  uint16_t node_num;
+  uint16_t max_node;
+  st_mlc_status status;
+} tree_parser;
+
+typedef struct {
+  const st_mlc_cfg *cfg;
+  st_mlc_recording *rec;
+  uint32_t rec_num;
+  uint32_t next;
+  pthread_mutex_t lock;
+} batch_queue;
+
+/* Private functions ---------------------------------------------------------*/
+/*  Functions declare in this section are defined at the end of this file.    */
+static void window_reset(st_mlc_state *state);
+static float_t filter_apply(const st_mlc_filter_cfg *flt,
+                            st_mlc_feature_state *fs, float_t x);
+static void feature_update(const st_mlc_feature_cfg *cfg,
+                           st_mlc_feature_state *fs, float_t v);
+static float_t feature_value(const st_mlc_feature_cfg *cfg,
+                             st_mlc_feature_state *fs, uint16_t len);
+static uint8_t tree_eval(const st_mlc_tree_cfg *tree, const float_t *value);
+static void meta_classifier(st_mlc_state *state, uint8_t tree,
+                            uint8_t result);
+static void tree_line_read(tree_parser *p, tree_line *line);
+static int16_t tree_node_parse(tree_parser *p, tree_line *line,
+                               uint8_t depth);
+static void *batch_worker(void *arg);
+
+/**
+  * @defgroup  MLC_emulator_pubblic_functions
+  * @brief     This section provide a set of APIs for emulating the
+  *            Machine Learning Core.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Parse the text of an UCF file. Only the "Ac <reg> <val>" lines
+  *         are converted, comments and WAIT commands are skipped.
+  *
+  * @param  text              UCF file content, null terminated.(ptr)
+  * @param  ucf               parsed register writes.(ptr)
+  * @param  len               number of parsed lines.(ptr)
+  * @param  max_len           size of ucf buffer.
+  *
+  * @retval st_mlc_status     ST_MLC_OK /  ST_MLC_ERR
+  *
+  */
+st_mlc_status st_mlc_ucf_parse(const char *text, ucf_line_t *ucf,
+                               uint16_t *len, uint16_t max_len)
+{
+  const char *p = text;
+  char *end;
+  unsigned long reg;
+  unsigned long val;
+
+  *len = 0;
+
+  while (*p != '\0') {
+
+    while ((*p == ' ') || (*p == '\t')) {
+      p++;
+    }
+
+    if ((p[0] == 'A') && (p[1] == 'c') && ((p[2] == ' ') || (p[2] == '\t'))) {
+
+      reg = strtoul(&p[3], &end, 16);
+      if (end == &p[3]) {
+        return ST_MLC_ERR;
+      }
+      p = end;
+      val = strtoul(p, &end, 16);
+      if ((end == p) || (reg > 0xFFU) || (val > 0xFFU)) {
+        return ST_MLC_ERR;
+      }
+      p = end;
+
+      if (*len >= max_len) {
+        return ST_MLC_ERR;
+      }
+      ucf[*len].address = (uint8_t)reg;
+      ucf[*len].data = (uint8_t)val;
+      (*len)++;
+    }
+
+    while ((*p != '\0') && (*p != '\n')) {
+      p++;
+    }
+    if (*p == '\n') {
+      p++;
+    }
+  }
+
+  return ST_MLC_OK;
+}
+
+/**
+  * @brief  Retrieve from an UCF configuration the MLC data rate and the
+  *         accelerometer / gyroscope sensitivities.
+  *         Window length, features and trees are not modified.
+  *
+  * @param  cfg               MLC configuration to update.(ptr)
+  * @param  ucf               UCF register writes.(ptr)
+  * @param  len               number of UCF lines.
+  *
+  * @retval st_mlc_status     ST_MLC_OK /  ST_MLC_ERR
+  *
+  */
+st_mlc_status st_mlc_ucf_cfg_get(st_mlc_cfg *cfg, const ucf_line_t *ucf,
+                                 uint16_t len)
+{
+  const float_t xl_sens[] = { 0.061f, 0.488f, 0.122f, 0.244f };
+  const float_t gy_sens[] = { 8.75f, 4.375f, 17.50f, 0.0f,
+                              35.0f, 0.0f,   70.0f,  0.0f };
+  const float_t mlc_odr[] = { 12.5f, 26.0f, 52.0f, 104.0f };
+  uint8_t bank = 0;
+  uint8_t fs;
+
+  for (uint16_t i = 0; i < len; i++) {
+
+    if (ucf[i].address == FUNC_CFG_ACCESS) {
+      bank = ucf[i].data & REG_ACCESS_MASK;
+    }
+    else if (bank == 0x00U) {
+
+      if (ucf[i].address == CTRL1_XL) {
+        fs = (ucf[i].data & FS_XL_MASK) >> FS_XL_SHIFT;
+        cfg->xl_sens = xl_sens[fs] / 1000.0f;
+      }
+
+      if (ucf[i].address == CTRL2_G) {
+        fs = (ucf[i].data & FS_G_MASK) >> FS_G_SHIFT;
+        if (gy_sens[fs] == 0.0f) {
+          return ST_MLC_ERR;
+        }
+        cfg->gy_sens = gy_sens[fs] / 1000.0f;
+      }
+    }
+    else if (bank == REG_ACCESS_EMB_FUNC) {
+
+      if (ucf[i].address == EMB_FUNC_ODR_CFG_C) {
+        cfg->odr = mlc_odr[(ucf[i].data & MLC_ODR_MASK) >> MLC_ODR_SHIFT];
+      }
+    }
+    else {
+      /* sensor hub bank is not relevant for the MLC */
+    }
+  }
+
+  return ST_MLC_OK;
+}
+
+/**
+  * @brief  Parse a decision tree in Weka J48 text format, i.e.:
+  *
+  *           F1_VAR_on_ACC_V2 <= 0.012
+  *           |   F2_MEAN_on_ACC_Z <= -0.5: face_down (10.0)
+  *           |   F2_MEAN_on_ACC_Z > -0.5: stationary (12.0/1.0)
+  *           F1_VAR_on_ACC_V2 > 0.012: walking (30.0)
+  *
+  *         Feature names must match st_mlc_feature_cfg.name, class labels
+  *         are converted with class_map or, if not found, must be numbers.
+  *         Lines without a condition (headers, statistics) are skipped.
+  *
+  * @param  text              decision tree text, null terminated.(ptr)
+  * @param  cfg               configuration holding the features.(ptr)
+  * @param  class_map         label to result table, can be NULL.(ptr)
+  * @param  class_num         number of entries in class_map.
+  * @param  node              parsed nodes, node[0] is the root.(ptr)
+  * @param  node_num          number of parsed nodes.(ptr)
+  * @param  max_node          size of node buffer.
+  *
+  * @retval st_mlc_status     ST_MLC_OK /  ST_MLC_ERR
+  *
+  */
+st_mlc_status st_mlc_tree_parse(const char *text, const st_mlc_cfg *cfg,
+                                const st_mlc_class *class_map,
+                                uint16_t class_num, st_mlc_node *node,
+                                uint16_t *node_num, uint16_t max_node)
+{
+  tree_parser p;
+  tree_line line;
+
+  p.cfg = cfg;
+  p.class_map = class_map;
+  p.class_num = class_num;
+  p.node = node;
+  p.node_num = 0;
+  p.max_node = max_node;
+  p.status = ST_MLC_OK;
+
+  line.text = text;
+  tree_line_read(&p, &line);
+
+  if ((line.valid == 0U) || (line.depth != 0U)) {
+    p.status = ST_MLC_ERR;
+  }
+  else {
+    (void)tree_node_parse(&p, &line, 0);
+    if (line.valid != 0U) {
+      /* more than one root */
+      p.status = ST_MLC_ERR;
+    }
+  }
+
+  *node_num = p.node_num;
+
+  return p.status;
+}
+
+/**
+  * @brief  Initialize the emulator state.
+  *
+  * @param  state             emulator state.(ptr)
+  * @param  cfg               MLC configuration, must remain valid while
+  *                           the state is used.(ptr)
+  *
+  * @retval st_mlc_status     ST_MLC_OK /  ST_MLC_ERR
+  *
+  */
+st_mlc_status st_mlc_init(st_mlc_state *state, const st_mlc_cfg *cfg)
+{
+  if ((cfg->window == 0U) || (cfg->feature_num > ST_MLC_FEATURE_MAX) ||
+      (cfg->filter_num > ST_MLC_FILTER_MAX) ||
+      (cfg->tree_num > ST_MLC_TREE_MAX)) {
+    return ST_MLC_ERR;
+  }
+
+  for (uint8_t i = 0; i < cfg->feature_num; i++) {
+    if ((cfg->feature[i].input >= ST_MLC_INPUT_NUM) ||
+        (cfg->feature[i].filter >= (int8_t)cfg->filter_num)) {
+      return ST_MLC_ERR;
+    }
+  }
+
+  for (uint8_t i = 0; i < cfg->tree_num; i++) {
+    for (uint16_t j = 0; j < cfg->tree[i].node_num; j++) {
+      const st_mlc_node *n = &cfg->tree[i].node[j];
+      if ((n->feature >= cfg->feature_num) ||
+          (n->left >= (int16_t)cfg->tree[i].node_num) ||
+          (n->right >= (int16_t)cfg->tree[i].node_num)) {
+        return ST_MLC_ERR;
+      }
+    }
+  }
+
+  (void)memset(state, 0, sizeof(st_mlc_state));
+  state->cfg = cfg;
+  window_reset(state);
+
+  return ST_MLC_OK;
+}
+
+/**
+  * @brief  Feed a new sample into the emulator.
+  *
+  * @param  state             emulator state.(ptr)
+  * @param  xl                accelerometer raw data.(ptr)
+  * @param  gy                gyroscope raw data, NULL if not used.(ptr)
+  *
+  * @retval uint8_t           1 when a window has been completed and the
+  *                           decision tree outputs updated, 0 otherwise.
+  *
+  */
+uint8_t st_mlc_process(st_mlc_state *state, const int16_t xl[3],
+                       const int16_t gy[3])
+{
+  const st_mlc_cfg *cfg = state->cfg;
+  float_t in[ST_MLC_INPUT_NUM];
+  float_t v;
+  uint8_t result;
+
+  in[ST_MLC_ACC_X] = (float_t)xl[0] * cfg->xl_sens;
+  in[ST_MLC_ACC_Y] = (float_t)xl[1] * cfg->xl_sens;
+  in[ST_MLC_ACC_Z] = (float_t)xl[2] * cfg->xl_sens;
+  in[ST_MLC_ACC_V2] = (in[ST_MLC_ACC_X] * in[ST_MLC_ACC_X]) +
+                      (in[ST_MLC_ACC_Y] * in[ST_MLC_ACC_Y]) +
+                      (in[ST_MLC_ACC_Z] * in[ST_MLC_ACC_Z]);
+  in[ST_MLC_ACC_V] = sqrtf(in[ST_MLC_ACC_V2]);
+
+  if (gy != NULL) {
+    in[ST_MLC_GY_X] = (float_t)gy[0] * cfg->gy_sens;
+    in[ST_MLC_GY_Y] = (float_t)gy[1] * cfg->gy_sens;
+    in[ST_MLC_GY_Z] = (float_t)gy[2] * cfg->gy_sens;
+  }
+  else {
+    in[ST_MLC_GY_X] = 0.0f;
+    in[ST_MLC_GY_Y] = 0.0f;
+    in[ST_MLC_GY_Z] = 0.0f;
+  }
+  in[ST_MLC_GY_V2] = (in[ST_MLC_GY_X] * in[ST_MLC_GY_X]) +
+                     (in[ST_MLC_GY_Y] * in[ST_MLC_GY_Y]) +
+                     (in[ST_MLC_GY_Z] * in[ST_MLC_GY_Z]);
+  in[ST_MLC_GY_V] = sqrtf(in[ST_MLC_GY_V2]);
+
+  for (uint8_t i = 0; i < cfg->feature_num; i++) {
+    const st_mlc_feature_cfg *f = &cfg->feature[i];
+
+    v = in[f->input];
+    if (f->filter >= 0) {
+      v = filter_apply(&cfg->filter[f->filter], &state->feature[i], v);
+    }
+    feature_update(f, &state->feature[i], v);
+  }
+
+  state->sample++;
+  if (state->sample < cfg->window) {
+    return 0;
+  }
+
+  for (uint8_t i = 0; i < cfg->feature_num; i++) {
+    state->value[i] = feature_value(&cfg->feature[i], &state->feature[i],
+                                    cfg->window);
+  }
+
+  for (uint8_t i = 0; i < cfg->tree_num; i++) {
+    result = tree_eval(&cfg->tree[i], state->value);
+    meta_classifier(state, i, result);
+  }
+
+  window_reset(state);
+
+  return 1;
+}
+
+/**
+  * @brief  Get the decision tree outputs, same layout of the MLC0_SRC ..
+  *         MLC7_SRC registers read by lsm6dsox_mlc_out_get().
+  *
+  * @param  state             emulator state.(ptr)
+  * @param  out               decision tree outputs.(ptr)
+  *
+  */
+void st_mlc_out_get(st_mlc_state *state, uint8_t out[ST_MLC_TREE_MAX])
+{
+  (void)memcpy(out, state->out, ST_MLC_TREE_MAX);
+}
+
+/**
+  * @brief  Evaluate a whole recording, storing the outputs at the end of
+  *         every window in rec->out.
+  *
+  * @param  cfg               MLC configuration.(ptr)
+  * @param  rec               recording to process.(ptr)
+  *
+  * @retval st_mlc_status     ST_MLC_OK /  ST_MLC_ERR
+  *
+  */
+st_mlc_status st_mlc_run(const st_mlc_cfg *cfg, st_mlc_recording *rec)
+{
+  st_mlc_state *state;
+
+  rec->out_num = 0;
+
+  state = malloc(sizeof(st_mlc_state));
+  if (state == NULL) {
+    rec->status = ST_MLC_ERR;
+    return ST_MLC_ERR;
+  }
+
+  rec->status = st_mlc_init(state, cfg);
+
+  if (rec->status == ST_MLC_OK) {
+    for (uint32_t i = 0; i < rec->len; i++) {
+      if (st_mlc_process(state, rec->xl[i],
+                         (rec->gy != NULL) ? rec->gy[i] : NULL) != 0U) {
+        st_mlc_out_get(state, rec->out[rec->out_num]);
+        rec->out_num++;
+      }
+    }
+  }
+
+  free(state);
+
+  return rec->status;
+}
+
+/**
+  * @brief  Evaluate a set of recordings using a pool of threads.
+  *         Every recording is processed from the beginning with its own
+  *         emulator state, so results are the same of st_mlc_run().
+  *
+  * @param  cfg               MLC configuration.(ptr)
+  * @param  rec               recordings to process.(ptr)
+  * @param  rec_num           number of recordings.
+  * @param  threads           number of worker threads, 0 or 1 to run
+  *                           in the calling thread.
+  *
+  * @retval st_mlc_status     ST_MLC_OK /  ST_MLC_ERR if at least one
+  *                           recording failed (see rec[i].status).
+  *
+  */
+st_mlc_status st_mlc_batch_run(const st_mlc_cfg *cfg, st_mlc_recording *rec,
+                               uint32_t rec_num, uint8_t threads)
+{
+  pthread_t tid[255];
+  batch_queue queue;
+  uint8_t started = 0;
+  st_mlc_status ret = ST_MLC_OK;
+
+  queue.cfg = cfg;
+  queue.rec = rec;
+  queue.rec_num = rec_num;
+  queue.next = 0;
+
+  if (pthread_mutex_init(&queue.lock, NULL) != 0) {
+    return ST_MLC_ERR;
+  }
+
+  if (threads > rec_num) {
+    threads = (uint8_t)rec_num;
+  }
+
+  for (uint8_t i = 1; i < threads; i++) {
+    if (pthread_create(&tid[started], NULL, batch_worker, &queue) == 0) {
+      started++;
+    }
+  }
+
+  /* the calling thread is a worker too */
+  (void)batch_worker(&queue);
+
+  for (uint8_t i = 0; i < started; i++) {
+    (void)pthread_join(tid[i], NULL);
+  }
+
+  (void)pthread_mutex_destroy(&queue.lock);
+
+  for (uint32_t i = 0; i < rec_num; i++) {
+    if (rec[i].status != ST_MLC_OK) {
+      ret = ST_MLC_ERR;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  MLC emulator private functions
+  * @brief     This section provide a set of private low-level functions
+  *            used by pubblic APIs.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Clear the window accumulators, filters and detectors states
+  *         are kept across windows.
+  *
+  * @param  state             emulator state.(ptr)
+  *
+  */
+static void window_reset(st_mlc_state *state)
+{
+  for (uint8_t i = 0; i < state->cfg->feature_num; i++) {
+    st_mlc_feature_state *fs = &state->feature[i];
+
+    fs->sum = 0.0f;
+    fs->sum2 = 0.0f;
+    fs->min = INFINITY;
+    fs->max = -INFINITY;
+    fs->zc_pos = 0;
+    fs->zc_neg = 0;
+    fs->peak_pos = 0;
+    fs->peak_neg = 0;
+  }
+
+  state->sample = 0;
+}
+
+/**
+  * @brief  Second order IIR filter (direct form I).
+  *
+  * @param  flt               filter coefficients.(ptr)
+  * @param  fs                feature state holding the filter history.(ptr)
+  * @param  x                 filter input.
+  *
+  * @retval float_t           filter output.
+  *
+  */
+static float_t filter_apply(const st_mlc_filter_cfg *flt,
+                            st_mlc_feature_state *fs, float_t x)
+{
+  float_t y;
+
+  y = flt->gain * ((flt->b1 * x) + (flt->b2 * fs->x[0]) +
+                   (flt->b3 * fs->x[1]));
+  y -= (flt->a2 * fs->y[0]) + (flt->a3 * fs->y[1]);
+
+  fs->x[1] = fs->x[0];
+  fs->x[0] = x;
+  fs->y[1] = fs->y[0];
+  fs->y[0] = y;
+
+  return y;
+}
+
+/**
+  * @brief  Update the accumulators of a feature with a new value.
+  *         Zero-crossings are counted when the signal moves from one side
+  *         to the other of the [-threshold, threshold] band, peaks when
+  *         the signal reverses by more than threshold from the last
+  *         extreme.
+  *
+  * @param  cfg               feature definition.(ptr)
+  * @param  fs                feature state.(ptr)
+  * @param  v                 new value.
+  *
+  */
+static void feature_update(const st_mlc_feature_cfg *cfg,
+                           st_mlc_feature_state *fs, float_t v)
+{
+  int8_t side;
+
+  fs->sum += v;
+  fs->sum2 += v * v;
+  fs->min = (v < fs->min) ? v : fs->min;
+  fs->max = (v > fs->max) ? v : fs->max;
+
+  side = (v > cfg->threshold) ? 1 : ((v < -cfg->threshold) ? -1 : 0);
+  if (side != 0) {
+    if ((fs->zc_sign < 0) && (side > 0)) {
+      fs->zc_pos++;
+    }
+    if ((fs->zc_sign > 0) && (side < 0)) {
+      fs->zc_neg++;
+    }
+    fs->zc_sign = side;
+  }
+
+  switch (fs->peak_dir) {
+    case 1:
+      if (v > fs->peak_ext) {
+        fs->peak_ext = v;
+      }
+      else if (v < (fs->peak_ext - cfg->threshold)) {
+        fs->peak_pos++;
+        fs->peak_dir = -1;
+        fs->peak_ext = v;
+      }
+      else {
+        /* still inside hysteresis */
+      }
+      break;
+    case -1:
+      if (v < fs->peak_ext) {
+        fs->peak_ext = v;
+      }
+      else if (v > (fs->peak_ext + cfg->threshold)) {
+        fs->peak_neg++;
+        fs->peak_dir = 1;
+        fs->peak_ext = v;
+      }
+      else {
+        /* still inside hysteresis */
+      }
+      break;
+    default:
+      if (v > (fs->peak_ext + cfg->threshold)) {
+        fs->peak_dir = 1;
+        fs->peak_ext = v;
+      }
+      else if (v < (fs->peak_ext - cfg->threshold)) {
+        fs->peak_dir = -1;
+        fs->peak_ext = v;
+      }
+      else {
+        /* still inside hysteresis */
+      }
+      break;
+  }
+}
+
+/**
+  * @brief  Compute the value of a feature at the end of the window.
+  *
+  * @param  cfg               feature definition.(ptr)
+  * @param  fs                feature state.(ptr)
+  * @param  len               window length.
+  *
+  * @retval float_t           feature value.
+  *
+  */
+static float_t feature_value(const st_mlc_feature_cfg *cfg,
+                             st_mlc_feature_state *fs, uint16_t len)
+{
+  float_t mean = fs->sum / (float_t)len;
+  float_t ret;
+
+  switch (cfg->type) {
+    case ST_MLC_MEAN:
+      ret = mean;
+      break;
+    case ST_MLC_VARIANCE:
+      ret = (fs->sum2 / (float_t)len) - (mean * mean);
+      break;
+    case ST_MLC_ENERGY:
+      ret = fs->sum2;
+      break;
+    case ST_MLC_PEAK_TO_PEAK:
+      ret = fs->max - fs->min;
+      break;
+    case ST_MLC_ZERO_CROSSING:
+      ret = (float_t)fs->zc_pos + (float_t)fs->zc_neg;
+      break;
+    case ST_MLC_POSITIVE_ZERO_CROSSING:
+      ret = (float_t)fs->zc_pos;
+      break;
+    case ST_MLC_NEGATIVE_ZERO_CROSSING:
+      ret = (float_t)fs->zc_neg;
+      break;
+    case ST_MLC_PEAK_DETECTOR:
+      ret = (float_t)fs->peak_pos + (float_t)fs->peak_neg;
+      break;
+    case ST_MLC_POSITIVE_PEAK_DETECTOR:
+      ret = (float_t)fs->peak_pos;
+      break;
+    case ST_MLC_NEGATIVE_PEAK_DETECTOR:
+      ret = (float_t)fs->peak_neg;
+      break;
+    case ST_MLC_MINIMUM:
+      ret = fs->min;
+      break;
+    case ST_MLC_MAXIMUM:
+      ret = fs->max;
+      break;
+    default:
+      ret = 0.0f;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Evaluate a decision tree.
+  *
+  * @param  tree              decision tree.(ptr)
+  * @param  value             feature values.(ptr)
+  *
+  * @retval uint8_t           tree result.
+  *
+  */
+static uint8_t tree_eval(const st_mlc_tree_cfg *tree, const float_t *value)
+{
+  int16_t n = 0;
+
+  if (tree->node_num == 0U) {
+    return 0;
+  }
+
+  /* node indexes are checked by st_mlc_init, bound the path anyway */
+  for (uint16_t i = 0; i <= tree->node_num; i++) {
+    const st_mlc_node *node = &tree->node[n];
+
+    n = (value[node->feature] <= node->threshold) ? node->left : node->right;
+    if (ST_MLC_IS_LEAF(n)) {
+      return ST_MLC_LEAF_RESULT(n);
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Meta-classifier: the counter of the detected class is
+  *         incremented, the others decremented. The output changes when
+  *         the counter of a class reaches the end counter value.
+  *
+  * @param  state             emulator state.(ptr)
+  * @param  tree              tree index.
+  * @param  result            decision tree result.
+  *
+  */
+static void meta_classifier(st_mlc_state *state, uint8_t tree,
+                            uint8_t result)
+{
+  uint8_t end = state->cfg->tree[tree].end_counter;
+  uint8_t *cnt = state->counter[tree];
+
+  if (end == 0U) {
+    state->out[tree] = result;
+    return;
+  }
+
+  for (uint16_t i = 0; i < ST_MLC_CLASS_MAX; i++) {
+    if (i == result) {
+      cnt[i] = (cnt[i] < end) ? (cnt[i] + 1U) : end;
+    }
+    else if (cnt[i] > 0U) {
+      cnt[i]--;
+    }
+    else {
+      /* already zero */
+    }
+  }
+
+  if (cnt[result] >= end) {
+    state->out[tree] = result;
+  }
+}
+
+/**
+  * @brief  Read the next decision tree line containing a condition.
+  *
+  * @param  p                 parser state.(ptr)
+  * @param  line              line cursor, text points to the line to
+  *                           read and is moved to the following one.(ptr)
+  *
+  */
+static void tree_line_read(tree_parser *p, tree_line *line)
+{
+  char buf[TREE_LINE_MAX];
+  const char *s;
+  char *cond;
+  char *name;
+  char *end;
+  char *label;
+  size_t n;
+  uint16_t i;
+
+  line->valid = 0;
+
+  while ((line->valid == 0U) && (*line->text != '\0')) {
+
+    s = line->text;
+    n = 0;
+    while ((s[n] != '\0') && (s[n] != '\n')) {
+      n++;
+    }
+    line->text = (s[n] == '\n') ? &s[n + 1U] : &s[n];
+
+    if (n >= TREE_LINE_MAX) {
+      p->status = ST_MLC_ERR;
+      return;
+    }
+    (void)memcpy(buf, s, n);
+    buf[n] = '\0';
+
+    line->depth = 0;
+    name = buf;
+    while ((*name == '|') || (*name == ' ') || (*name == '\t')) {
+      if (*name == '|') {
+        line->depth++;
+      }
+      name++;
+    }
+
+    cond = strstr(name, " <= ");
+    line->greater = 0;
+    if (cond == NULL) {
+      cond = strstr(name, " > ");
+      line->greater = 1;
+    }
+    if (cond == NULL) {
+      /* header, statistics or empty line */
+      continue;
+    }
+    *cond = '\0';
+
+    for (i = 0; i < p->cfg->feature_num; i++) {
+      if ((p->cfg->feature[i].name != NULL) &&
+          (strcmp(p->cfg->feature[i].name, name) == 0)) {
+        break;
+      }
+    }
+    if (i == p->cfg->feature_num) {
+      p->status = ST_MLC_ERR;
+      return;
+    }
+    line->feature = (uint8_t)i;
+
+    cond += (line->greater != 0U) ? 3 : 4;
+    line->threshold = strtof(cond, &end);
+    if (end == cond) {
+      p->status = ST_MLC_ERR;
+      return;
+    }
+
+    line->leaf = 0;
+    label = strchr(end, ':');
+    if (label != NULL) {
+      label++;
+      while (*label == ' ') {
+        label++;
+      }
+      n = 0;
+      while ((label[n] != '\0') && (label[n] != ' ') && (label[n] != '(')) {
+        n++;
+      }
+      label[n] = '\0';
+
+      for (i = 0; i < p->class_num; i++) {
+        if (strcmp(p->class_map[i].label, label) == 0) {
+          break;
+        }
+      }
+      if (i < p->class_num) {
+        line->result = p->class_map[i].result;
+      }
+      else {
+        unsigned long val = strtoul(label, &end, 0);
+        if ((end == label) || (*end != '\0') || (val > 0xFFU)) {
+          p->status = ST_MLC_ERR;
+          return;
+        }
+        line->result = (uint8_t)val;
+      }
+      line->leaf = 1;
+    }
+
+    line->valid = 1;
+  }
+}
+
+/**
+  * @brief  Parse a node (the "<=" line and the matching ">" line) and its
+  *         subtrees.
+  *
+  * @param  p                 parser state.(ptr)
+  * @param  line              current line, must be the "<=" one.(ptr)
+  * @param  depth             expected node depth.
+  *
+  * @retval int16_t           node index.
+  *
+  */
+static int16_t tree_node_parse(tree_parser *p, tree_line *line,
+                               uint8_t depth)
+{
+  st_mlc_node *node;
+  int16_t idx;
+  uint8_t feature;
+
+  if ((p->status != ST_MLC_OK) || (line->valid == 0U) ||
+      (line->depth != depth) || (line->greater != 0U) ||
+      (depth >= TREE_DEPTH_MAX) || (p->node_num >= p->max_node)) {
+    p->status = ST_MLC_ERR;
+    return 0;
+  }
+
+  idx = (int16_t)p->node_num;
+  node = &p->node[p->node_num];
+  p->node_num++;
+  node->feature = line->feature;
+  node->threshold = line->threshold;
+  feature = line->feature;
+
+  if (line->leaf != 0U) {
+    node->left = ST_MLC_LEAF(line->result);
+    tree_line_read(p, line);
+  }
+  else {
+    tree_line_read(p, line);
+    node->left = tree_node_parse(p, line, depth + 1U);
+  }
+
+  if ((p->status != ST_MLC_OK) || (line->valid == 0U) ||
+      (line->depth != depth) || (line->greater == 0U) ||
+      (line->feature != feature)) {
+    p->status = ST_MLC_ERR;
+    return 0;
+  }
+
+  if (line->leaf != 0U) {
+    node->right = ST_MLC_LEAF(line->result);
+    tree_line_read(p, line);
+  }
+  else {
+    tree_line_read(p, line);
+    node->right = tree_node_parse(p, line, depth + 1U);
+  }
+
+  return idx;
+}
+
+/**
+  * @brief  Batch worker: process recordings until the queue is empty.
+  *
+  * @param  arg               batch queue.(ptr)
+  *
+  */
+static void *batch_worker(void *arg)
+{
+  batch_queue *queue = (batch_queue *)arg;
+  uint32_t i;
+
+  for (;;) {
+    (void)pthread_mutex_lock(&queue->lock);
+    i = queue->next;
+    if (i < queue->rec_num) {
+      queue->next++;
+    }
+    (void)pthread_mutex_unlock(&queue->lock);
+
+    if (i >= queue->rec_num) {
+      break;
+    }
+
+    (void)st_mlc_run(queue->cfg, &queue->rec[i]);
+  }
+
+  return NULL;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,276 @@
+/*
+ ******************************************************************************
+ * @file    mlc_emulator.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          mlc_emulator.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_MLC_EMULATOR_H
+#define ST_MLC_EMULATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <math.h>
+
+/** @addtogroup MLC emulator
+  * @brief    Host side emulation of the Machine Learning Core (MLC) of
+  *           LSM6DSOX / LSM6DSRX / ISM330DHCX / IIS2ICLX.
+  *           The emulator computes the configured features on windows of
+  *           recorded accelerometer / gyroscope samples, evaluates the
+  *           decision trees and applies the meta-classifier, producing the
+  *           same 8 bytes returned by lsm6dsox_mlc_out_get().
+  *
+  *           The MLC program stored in the device by the UCF file is not
+  *           documented, so the UCF is used only to retrieve the sensor and
+  *           MLC configuration (data rates, full scales) while features and
+  *           decision trees are described by st_mlc_cfg, typically filled
+  *           from the decision tree text file (Weka J48 format) generated
+  *           together with the UCF.
+  *
+  *           Features are computed in single precision float: the device
+  *           uses half precision so results may differ when a feature is
+  *           very close to a node threshold.
+  * @{
+  *
+  */
+
+/** @defgroup MLC_emulator_pubblic_definitions
+  * @{
+  *
+  */
+
+#ifndef MEMS_UCF_SHARED_TYPES
+#define MEMS_UCF_SHARED_TYPES
+
+/** @defgroup    Generic address-data structure definition
+  * @brief       This structure is useful to load a predefined configuration
+  *              of a sensor.
+  *              You can create a sensor configuration by your own or using
+  *              Unico / Unicleo tools available on STMicroelectronics
+  *              web site.
+  *
+  * @{
+  *
+  */
+
+typedef struct {
+  uint8_t address;
+  uint8_t data;
+} ucf_line_t;
+
+/**
+  * @}
+  *
+  */
+
+#endif /* MEMS_UCF_SHARED_TYPES */
+
+#define ST_MLC_TREE_MAX              8U
+#define ST_MLC_FEATURE_MAX          64U
+#define ST_MLC_FILTER_MAX           16U
+#define ST_MLC_CLASS_MAX           256U
+
+/** Leaf encoding in st_mlc_node.left / st_mlc_node.right **/
+#define ST_MLC_LEAF(result)         ((int16_t)(-1 - (int16_t)(result)))
+#define ST_MLC_IS_LEAF(child)       ((child) < 0)
+#define ST_MLC_LEAF_RESULT(child)   ((uint8_t)(-1 - (child)))
+
+typedef enum {
+  ST_MLC_OK = 0,
+  ST_MLC_ERR
+} st_mlc_status;
+
+typedef enum {
+  ST_MLC_ACC_X = 0,
+  ST_MLC_ACC_Y,
+  ST_MLC_ACC_Z,
+  ST_MLC_ACC_V,           /* accelerometer norm */
+  ST_MLC_ACC_V2,          /* accelerometer squared norm */
+  ST_MLC_GY_X,
+  ST_MLC_GY_Y,
+  ST_MLC_GY_Z,
+  ST_MLC_GY_V,            /* gyroscope norm */
+  ST_MLC_GY_V2,           /* gyroscope squared norm */
+  ST_MLC_INPUT_NUM
+} st_mlc_input;
+
+typedef enum {
+  ST_MLC_MEAN = 0,
+  ST_MLC_VARIANCE,
+  ST_MLC_ENERGY,
+  ST_MLC_PEAK_TO_PEAK,
+  ST_MLC_ZERO_CROSSING,
+  ST_MLC_POSITIVE_ZERO_CROSSING,
+  ST_MLC_NEGATIVE_ZERO_CROSSING,
+  ST_MLC_PEAK_DETECTOR,
+  ST_MLC_POSITIVE_PEAK_DETECTOR,
+  ST_MLC_NEGATIVE_PEAK_DETECTOR,
+  ST_MLC_MINIMUM,
+  ST_MLC_MAXIMUM
+} st_mlc_feature_type;
+
+/**
+  * @brief  Second order IIR filter, same coefficients names used by the
+  *         MLC configuration tool:
+  *         y(z)/x(z) = gain * (b1 + b2 z^-1 + b3 z^-2) / (1 + a2 z^-1 + a3 z^-2)
+  *         First order filters (IIR1 / HP) have b3 = a3 = 0.
+  */
+typedef struct {
+  float_t b1;
+  float_t b2;
+  float_t b3;
+  float_t a2;
+  float_t a3;
+  float_t gain;
+} st_mlc_filter_cfg;
+
+/**
+  * @brief  Feature definition.
+  *         threshold is used by zero-crossing and peak detector features
+  *         as hysteresis around zero / around the last detected extreme.
+  *         filter is the index in st_mlc_cfg.filter or -1 if the feature
+  *         is computed on the unfiltered input.
+  */
+typedef struct {
+  const char *name;
+  st_mlc_feature_type type;
+  st_mlc_input input;
+  int8_t filter;
+  float_t threshold;
+} st_mlc_feature_cfg;
+
+/**
+  * @brief  Decision tree node: when feature <= threshold the tree continues
+  *         on left, otherwise on right. Children are node indexes or leaves
+  *         built with ST_MLC_LEAF(result).
+  */
+typedef struct {
+  uint8_t feature;
+  float_t threshold;
+  int16_t left;
+  int16_t right;
+} st_mlc_node;
+
+typedef struct {
+  const st_mlc_node *node;
+  uint16_t node_num;
+  uint8_t end_counter;    /* meta-classifier end counter, 0 = disabled */
+} st_mlc_tree_cfg;
+
+typedef struct {
+  float_t odr;            /* MLC data rate in Hz */
+  uint16_t window;        /* window length in samples */
+  float_t xl_sens;        /* accelerometer sensitivity in g/LSB */
+  float_t gy_sens;        /* gyroscope sensitivity in dps/LSB */
+  st_mlc_filter_cfg filter[ST_MLC_FILTER_MAX];
+  uint8_t filter_num;
+  st_mlc_feature_cfg feature[ST_MLC_FEATURE_MAX];
+  uint8_t feature_num;
+  st_mlc_tree_cfg tree[ST_MLC_TREE_MAX];
+  uint8_t tree_num;
+} st_mlc_cfg;
+
+/**
+  * @brief  Class label to decision tree result mapping used by the
+  *         decision tree parser.
+  */
+typedef struct {
+  const char *label;
+  uint8_t result;
+} st_mlc_class;
+
+typedef struct {
+  float_t sum;
+  float_t sum2;
+  float_t min;
+  float_t max;
+  uint16_t zc_pos;
+  uint16_t zc_neg;
+  uint16_t peak_pos;
+  uint16_t peak_neg;
+  int8_t zc_sign;         /* last side of the hysteresis band (-1, 0, 1) */
+  int8_t peak_dir;        /* current slope direction (-1, 0, 1) */
+  float_t peak_ext;       /* last extreme value */
+  float_t x[2];           /* filter input history */
+  float_t y[2];           /* filter output history */
+} st_mlc_feature_state;
+
+typedef struct {
+  const st_mlc_cfg *cfg;
+  uint16_t sample;
+  st_mlc_feature_state feature[ST_MLC_FEATURE_MAX];
+  float_t value[ST_MLC_FEATURE_MAX];
+  uint8_t counter[ST_MLC_TREE_MAX][ST_MLC_CLASS_MAX];
+  uint8_t out[ST_MLC_TREE_MAX];
+} st_mlc_state;
+
+/**
+  * @brief  Recorded stream and its results used by st_mlc_batch_run().
+  *         gy can be NULL when the MLC uses only the accelerometer.
+  *         out must contain room for (len / window) results.
+  */
+typedef struct {
+  const int16_t (*xl)[3];
+  const int16_t (*gy)[3];
+  uint32_t len;
+  uint8_t (*out)[ST_MLC_TREE_MAX];
+  uint32_t out_num;
+  st_mlc_status status;
+} st_mlc_recording;
+
+/**
+  * @}
+  *
+  */
+
+st_mlc_status st_mlc_ucf_parse(const char *text, ucf_line_t *ucf,
+                               uint16_t *len, uint16_t max_len);
+
+st_mlc_status st_mlc_ucf_cfg_get(st_mlc_cfg *cfg, const ucf_line_t *ucf,
+                                 uint16_t len);
+
+st_mlc_status st_mlc_tree_parse(const char *text, const st_mlc_cfg *cfg,
+                                const st_mlc_class *class_map,
+                                uint16_t class_num, st_mlc_node *node,
+                                uint16_t *node_num, uint16_t max_node);
+
+st_mlc_status st_mlc_init(st_mlc_state *state, const st_mlc_cfg *cfg);
+
+uint8_t st_mlc_process(st_mlc_state *state, const int16_t xl[3],
+                       const int16_t gy[3]);
+
+void st_mlc_out_get(st_mlc_state *state, uint8_t out[ST_MLC_TREE_MAX]);
+
+st_mlc_status st_mlc_run(const st_mlc_cfg *cfg, st_mlc_recording *rec);
+
+st_mlc_status st_mlc_batch_run(const st_mlc_cfg *cfg, st_mlc_recording *rec,
+                               uint32_t rec_num, uint8_t threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_MLC_EMULATOR_H */
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,494 @@
+/*
+ ******************************************************************************
+ * @file    sensor_fusion.c
+ * @author  Sensor Solutions Software Team
+ * @brief   Fixed point orientation fusion on FIFO batches.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sensor_fusion.h"
+#include <string.h>
+
+/**
+  * @defgroup  Sensor fusion
+  * @brief     This file provides a set of functions needed to estimate
+  *            the orientation from accelerometer, gyroscope and
+  *            magnetometer FIFO data.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+#define Q30_SHIFT                (30U)
+#define GY_SHIFT                 (12U)
+#define DEG_TO_RAD               (0.017453292519943295f)
+#define Q30_HALF                 ((int32_t)0x20000000)
+
+/* Private functions ---------------------------------------------------------*/
+/*  Functions declare in this section are defined at the end of this file.    */
+static int32_t q30_mul(int32_t a, int32_t b);
+static int32_t q30_from_float(float_t f);
+static uint32_t isqrt64(uint64_t x);
+static uint16_t isqrt32(uint32_t x);
+static uint8_t vector_normalize(const int16_t in[3], int32_t out[3]);
+static void fusion_step(st_fusion_state *state, const int16_t gy[3]);
+static void quat_normalize(int32_t q[4]);
+
+/**
+  * @defgroup  Sensor_fusion_pubblic_functions
+  * @brief     This section provide a set of APIs for orientation
+  *            estimation.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize the filter state: orientation is set to identity
+  *         and the fixed point gains are computed from cfg.
+  *
+  * @param  state             fusion state.(ptr)
+  * @param  cfg               fusion configuration.(ptr)
+  *
+  * @retval st_fusion_status  ST_FUSION_OK /  ST_FUSION_ERR
+  *
+  */
+st_fusion_status st_fusion_init(st_fusion_state *state,
+                                const st_fusion_cfg *cfg)
+{
+  float_t dt;
+  float_t lsb_1g;
+  float_t k_gy;
+
+  if ((cfg->gy_odr <= 0.0f) || (cfg->gy_sens <= 0.0f) ||
+      (cfg->xl_sens <= 0.0f)) {
+    return ST_FUSION_ERR;
+  }
+
+  dt = 1.0f / cfg->gy_odr;
+  k_gy = ldexpf(cfg->gy_sens * DEG_TO_RAD * dt * 0.5f,
+                (int32_t)(Q30_SHIFT + GY_SHIFT));
+
+  if ((k_gy >= 2147483648.0f) || (cfg->kp * dt * 0.5f >= 1.0f) ||
+      (cfg->ki * dt * dt * 0.5f >= 1.0f)) {
+    return ST_FUSION_ERR;
+  }
+
+  (void)memset(state, 0, sizeof(st_fusion_state));
+  state->q[0] = ST_FUSION_Q30_ONE;
+  state->k_gy = (int32_t)k_gy;
+  state->k_p = q30_from_float(cfg->kp * dt * 0.5f);
+  state->k_i = q30_from_float(cfg->ki * dt * dt * 0.5f);
+  state->mag_en = cfg->mag_en;
+  state->mag_tag = cfg->mag_tag;
+
+  if (cfg->xl_band > 0.0f) {
+    lsb_1g = 1.0f / cfg->xl_sens;
+    state->xl_min2 = (cfg->xl_band < 1.0f) ?
+                     (uint32_t)((lsb_1g * (1.0f - cfg->xl_band)) *
+                                (lsb_1g * (1.0f - cfg->xl_band))) : 0U;
+    state->xl_max2 = (uint32_t)fminf((lsb_1g * (1.0f + cfg->xl_band)) *
+                                     (lsb_1g * (1.0f + cfg->xl_band)),
+                                     4294967295.0f);
+  } else {
+    state->xl_min2 = 0U;
+    state->xl_max2 = 0xFFFFFFFFU;
+  }
+
+  return ST_FUSION_OK;
+}
+
+/**
+  * @brief  Set the orientation from an accelerometer sample (heading is
+  *         left to zero), useful to skip the filter convergence time.
+  *
+  * @param  state             fusion state.(ptr)
+  * @param  xl                accelerometer raw data.(ptr)
+  *
+  */
+void st_fusion_align(st_fusion_state *state, const int16_t xl[3])
+{
+  int32_t a[3];
+
+  if (vector_normalize(xl, a) == 0U) {
+    return;
+  }
+
+  /* half way quaternion between a and the earth z axis (half scale) */
+  if (a[2] > (-ST_FUSION_Q30_ONE + 0x100)) {
+    state->q[0] = (ST_FUSION_Q30_ONE / 2) + (a[2] / 2);
+    state->q[1] = a[1] / 2;
+    state->q[2] = -a[0] / 2;
+    state->q[3] = 0;
+  } else {
+    state->q[0] = 0;
+    state->q[1] = ST_FUSION_Q30_ONE;
+    state->q[2] = 0;
+    state->q[3] = 0;
+  }
+
+  {
+    uint64_t n2 = 0;
+    int64_t n;
+
+    for (uint8_t i = 0; i < 4U; i++) {
+      n2 += (uint64_t)((int64_t)state->q[i] * state->q[i]);
+    }
+
+    n = (int64_t)isqrt64(n2);
+
+    for (uint8_t i = 0; i < 4U; i++) {
+      state->q[i] = (int32_t)(((int64_t)state->q[i] << Q30_SHIFT) / n);
+    }
+  }
+}
+
+/**
+  * @brief  Process a batch of decoded FIFO slots (sorted by timestamp, as
+  *         returned by st_fifo_decompress() / st_fifo_sort()). Slots of
+  *         other sensors are skipped.
+  *
+  * @param  state             fusion state.(ptr)
+  * @param  slot              decoded FIFO slots.(ptr)
+  * @param  slot_num          number of slots.
+  * @param  out               orientation after every gyroscope slot, can be
+  *                           NULL when only the final orientation is
+  *                           needed.(ptr)
+  * @param  out_num           number of orientations stored in out.(ptr)
+  *
+  */
+void st_fusion_update(st_fusion_state *state,
+                      const st_fifo_out_slot *slot, uint16_t slot_num,
+                      st_fusion_quat *out, uint16_t *out_num)
+{
+  uint16_t num = 0;
+  int16_t data[3];
+
+  for (uint16_t i = 0; i < slot_num; i++) {
+    for (uint8_t j = 0; j < 3U; j++) {
+      data[j] = (int16_t)((uint16_t)slot[i].raw_data[2U * j] |
+                          ((uint16_t)slot[i].raw_data[(2U * j) + 1U] << 8));
+    }
+
+    if (slot[i].sensor_tag == ST_FIFO_GYROSCOPE) {
+      fusion_step(state, data);
+
+      if (out != NULL) {
+        out[num].timestamp = slot[i].timestamp;
+        (void)memcpy(out[num].q, state->q, sizeof(state->q));
+        num++;
+      }
+    } else if (slot[i].sensor_tag == ST_FIFO_ACCELEROMETER) {
+      uint32_t n2 = 0;
+
+      for (uint8_t j = 0; j < 3U; j++) {
+        n2 += (uint32_t)((int32_t)data[j] * data[j]);
+      }
+
+      /* samples out of band (linear acceleration) are discarded */
+      state->xl_valid = ((n2 >= state->xl_min2) && (n2 <= state->xl_max2)) ?
+                        vector_normalize(data, state->xl) : 0U;
+    } else if ((state->mag_en != 0U) &&
+               (slot[i].sensor_tag == state->mag_tag)) {
+      state->mag_valid = vector_normalize(data, state->mag);
+    } else {
+      /* not used */
+    }
+  }
+
+  if (out_num != NULL) {
+    *out_num = num;
+  }
+}
+
+/**
+  * @brief  Get the current orientation.
+  *
+  * @param  state             fusion state.(ptr)
+  * @param  q                 quaternion w, x, y, z in Q30.(ptr)
+  *
+  */
+void st_fusion_quat_get(const st_fusion_state *state, int32_t q[4])
+{
+  (void)memcpy(q, state->q, sizeof(state->q));
+}
+
+/**
+  * @brief  Convert a Q30 quaternion to float.
+  *
+  * @param  q                 quaternion in Q30.(ptr)
+  * @param  out               quaternion in float.(ptr)
+  *
+  */
+void st_fusion_to_float(const int32_t q[4], float_t out[4])
+{
+  for (uint8_t i = 0; i < 4U; i++) {
+    out[i] = (float_t)q[i] / (float_t)ST_FUSION_Q30_ONE;
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  Sensor fusion private functions
+  * @brief     This section provide a set of private low-level functions
+  *            used by pubblic APIs.
+  * @{
+  *
+  */
+
+static int32_t q30_mul(int32_t a, int32_t b)
+{
+  return (int32_t)(((int64_t)a * b) >> Q30_SHIFT);
+}
+
+static int32_t q30_from_float(float_t f)
+{
+  return (int32_t)(f * (float_t)ST_FUSION_Q30_ONE);
+}
+
+/**
+  * @brief  Integer square root.
+  *
+  * @param  x                 input value.
+  *
+  * @retval                   floor(sqrt(x)).
+  *
+  */
+static uint32_t isqrt64(uint64_t x)
+{
+  uint64_t res = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+
+  while (bit > x) {
+    bit >>= 2;
+  }
+
+  while (bit != 0U) {
+    if (x >= (res + bit)) {
+      x -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+
+    bit >>= 2;
+  }
+
+  return (uint32_t)res;
+}
+
+/**
+  * @brief  Integer square root, 32 bit version (half the iterations and
+  *         no 64 bit arithmetic).
+  *
+  * @param  x                 input value.
+  *
+  * @retval                   floor(sqrt(x)).
+  *
+  */
+static uint16_t isqrt32(uint32_t x)
+{
+  uint32_t res = 0;
+  uint32_t bit = (uint32_t)1 << 30;
+
+  while (bit > x) {
+    bit >>= 2;
+  }
+
+  while (bit != 0U) {
+    if (x >= (res + bit)) {
+      x -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+
+    bit >>= 2;
+  }
+
+  return (uint16_t)res;
+}
+
+/**
+  * @brief  Normalize a raw vector to Q30.
+  *
+  * @param  in                raw data.(ptr)
+  * @param  out               unit vector in Q30.(ptr)
+  *
+  * @retval                   0 if the vector is null.
+  *
+  */
+static uint8_t vector_normalize(const int16_t in[3], int32_t out[3])
+{
+  uint32_t n2 = 0;
+  int64_t inv;
+  uint32_t n;
+
+  for (uint8_t i = 0; i < 3U; i++) {
+    n2 += (uint32_t)((int32_t)in[i] * in[i]);
+  }
+
+  n = isqrt32(n2);
+
+  if (n == 0U) {
+    return 0;
+  }
+
+  /* one division, then multiplications: Q46 / n * in >> 16 = Q30 */
+  inv = ((int64_t)1 << 46) / (int64_t)n;
+
+  for (uint8_t i = 0; i < 3U; i++) {
+    out[i] = (int32_t)((inv * in[i]) >> 16);
+  }
+
+  return 1;
+}
+
+/**
+  * @brief  Filter update on a gyroscope sample: the error between the
+  *         measured and estimated gravity (and magnetic field) directions
+  *         is fed back to the angular rate, then the quaternion is
+  *         integrated and normalized.
+  *
+  * @param  state             fusion state.(ptr)
+  * @param  gy                gyroscope raw data.(ptr)
+  *
+  */
+static void fusion_step(st_fusion_state *state, const int16_t gy[3])
+{
+  int32_t *q = state->q;
+  const int32_t *a = state->xl;
+  const int32_t *m = state->mag;
+  int32_t e[3] = {0, 0, 0};
+  int32_t w[3];
+  int32_t dq[4];
+  uint8_t corr = 0;
+
+  if (state->xl_valid != 0U) {
+    int32_t q0q0 = q30_mul(q[0], q[0]);
+    int32_t q0q1 = q30_mul(q[0], q[1]);
+    int32_t q0q2 = q30_mul(q[0], q[2]);
+    int32_t q0q3 = q30_mul(q[0], q[3]);
+    int32_t q1q1 = q30_mul(q[1], q[1]);
+    int32_t q1q2 = q30_mul(q[1], q[2]);
+    int32_t q1q3 = q30_mul(q[1], q[3]);
+    int32_t q2q2 = q30_mul(q[2], q[2]);
+    int32_t q2q3 = q30_mul(q[2], q[3]);
+    int32_t q3q3 = q30_mul(q[3], q[3]);
+    int32_t v[3];
+
+    /* estimated gravity direction in body frame */
+    v[0] = 2 * (q1q3 - q0q2);
+    v[1] = 2 * (q0q1 + q2q3);
+    v[2] = q0q0 - q1q1 - q2q2 + q3q3;
+
+    e[0] = q30_mul(a[1], v[2]) - q30_mul(a[2], v[1]);
+    e[1] = q30_mul(a[2], v[0]) - q30_mul(a[0], v[2]);
+    e[2] = q30_mul(a[0], v[1]) - q30_mul(a[1], v[0]);
+    corr = 1;
+
+    if (state->mag_valid != 0U) {
+      int64_t h[3];
+      int32_t b[2];
+      int32_t u[3];
+
+      /* magnetic field in earth frame */
+      h[0] = 2 * ((int64_t)q30_mul(m[0], Q30_HALF - q2q2 - q3q3) +
+                  q30_mul(m[1], q1q2 - q0q3) + q30_mul(m[2], q1q3 + q0q2));
+      h[1] = 2 * ((int64_t)q30_mul(m[0], q1q2 + q0q3) +
+                  q30_mul(m[1], Q30_HALF - q1q1 - q3q3) +
+                  q30_mul(m[2], q2q3 - q0q1));
+      h[2] = 2 * ((int64_t)q30_mul(m[0], q1q3 - q0q2) +
+                  q30_mul(m[1], q2q3 + q0q1) +
+                  q30_mul(m[2], Q30_HALF - q1q1 - q2q2));
+
+      /* reference direction: horizontal component on earth x, computed
+       * on Q15 values */
+      b[0] = (int32_t)isqrt32((uint32_t)(((h[0] >> 15) * (h[0] >> 15)) +
+                                         ((h[1] >> 15) * (h[1] >> 15))))
+             << 15;
+      b[1] = (int32_t)h[2];
+
+      /* estimated magnetic field direction in body frame */
+      u[0] = 2 * (q30_mul(b[0], Q30_HALF - q2q2 - q3q3) +
+                  q30_mul(b[1], q1q3 - q0q2));
+      u[1] = 2 * (q30_mul(b[0], q1q2 - q0q3) + q30_mul(b[1], q0q1 + q2q3));
+      u[2] = 2 * (q30_mul(b[0], q0q2 + q1q3) +
+                  q30_mul(b[1], Q30_HALF - q1q1 - q2q2));
+
+      e[0] += q30_mul(m[1], u[2]) - q30_mul(m[2], u[1]);
+      e[1] += q30_mul(m[2], u[0]) - q30_mul(m[0], u[2]);
+      e[2] += q30_mul(m[0], u[1]) - q30_mul(m[1], u[0]);
+    }
+  }
+
+  for (uint8_t i = 0; i < 3U; i++) {
+    if ((corr != 0U) && (state->k_i != 0)) {
+      state->integral[i] += q30_mul(e[i], state->k_i);
+    }
+
+    /* half angle increment: gyro * dt / 2 + feedback */
+    w[i] = (int32_t)(((int64_t)gy[i] * state->k_gy) >> GY_SHIFT) +
+           q30_mul(e[i], state->k_p) + state->integral[i];
+  }
+
+  dq[0] = -q30_mul(q[1], w[0]) - q30_mul(q[2], w[1]) - q30_mul(q[3], w[2]);
+  dq[1] = q30_mul(q[0], w[0]) + q30_mul(q[2], w[2]) - q30_mul(q[3], w[1]);
+  dq[2] = q30_mul(q[0], w[1]) - q30_mul(q[1], w[2]) + q30_mul(q[3], w[0]);
+  dq[3] = q30_mul(q[0], w[2]) + q30_mul(q[1], w[1]) - q30_mul(q[2], w[0]);
+
+  for (uint8_t i = 0; i < 4U; i++) {
+    q[i] += dq[i];
+  }
+
+  quat_normalize(q);
+}
+
+/**
+  * @brief  Normalize a quaternion close to unit norm with one Newton step
+  *         of the inverse square root (no division / square root).
+  *
+  * @param  q                 quaternion in Q30.(ptr)
+  *
+  */
+static void quat_normalize(int32_t q[4])
+{
+  int64_t n2 = 0;
+  int32_t k;
+
+  for (uint8_t i = 0; i < 4U; i++) {
+    n2 += ((int64_t)q[i] * q[i]) >> Q30_SHIFT;
+  }
+
+  /* 1 / sqrt(n2) ~ (3 - n2) / 2 */
+  k = (int32_t)(((3 * (int64_t)ST_FUSION_Q30_ONE) - n2) >> 1);
+
+  for (uint8_t i = 0; i < 4U; i++) {
+    q[i] = q30_mul(q[i], k);
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
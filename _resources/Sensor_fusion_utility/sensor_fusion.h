@@ -0,0 +1,126 @@
+/*
+ ******************************************************************************
+ * @file    sensor_fusion.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          sensor_fusion.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_FUSION_H
+#define ST_FUSION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <math.h>
+#include "fifo_utility.h"
+
+/** @addtogroup Sensor fusion
+  * @brief    Orientation fusion (Mahony complementary filter) working on
+  *           the slots decoded by st_fifo_decompress(): gyroscope,
+  *           accelerometer and, optionally, a magnetometer read by the
+  *           sensor hub (raw data as 3 x int16, aligned to the
+  *           accelerometer axes).
+  *
+  *           The filter uses only integer math: quaternion and gains are
+  *           Q30 fixed point, scale factors are computed once in
+  *           st_fusion_init() (the only function using float), then a
+  *           whole FIFO batch is processed per st_fusion_update() call.
+  *           The quaternion is updated on every gyroscope slot using the
+  *           last accelerometer / magnetometer slots.
+  * @{
+  *
+  */
+
+/** @defgroup Sensor_fusion_pubblic_definitions
+  * @{
+  *
+  */
+
+#define ST_FUSION_Q30_ONE         ((int32_t)0x40000000)
+
+typedef enum {
+  ST_FUSION_OK = 0,
+  ST_FUSION_ERR
+} st_fusion_status;
+
+typedef struct {
+  float_t gy_odr;         /* gyroscope batch data rate in Hz */
+  float_t gy_sens;        /* gyroscope sensitivity in dps/LSB */
+  float_t xl_sens;        /* accelerometer sensitivity in g/LSB */
+  float_t kp;             /* proportional gain, 0.5 .. 2 typical */
+  float_t ki;             /* integral gain (gyro bias), 0 to disable */
+  float_t xl_band;        /* accelerometer correction used only when
+                           * | |a| - 1g | < xl_band g, 0 to always use */
+  uint8_t mag_en;         /* 1: use mag_tag slots for heading */
+  st_fifo_sensor_type mag_tag;
+} st_fusion_cfg;
+
+typedef struct {
+  /* quaternion w, x, y, z in Q30, body to earth frame */
+  int32_t q[4];
+  /* precomputed scale factors */
+  int32_t k_gy;           /* gyro LSB -> half angle increment, Q42 */
+  int32_t k_p;            /* kp * dt / 2, Q30 */
+  int32_t k_i;            /* ki * dt^2 / 2, Q30 */
+  uint32_t xl_min2;       /* accelerometer band, squared LSB */
+  uint32_t xl_max2;
+  uint8_t mag_en;
+  st_fifo_sensor_type mag_tag;
+  /* last samples (unit vectors in Q30) and integral term */
+  int32_t xl[3];
+  int32_t mag[3];
+  uint8_t xl_valid;
+  uint8_t mag_valid;
+  int32_t integral[3];
+} st_fusion_state;
+
+typedef struct {
+  uint32_t timestamp;
+  int32_t q[4];           /* w, x, y, z in Q30 */
+} st_fusion_quat;
+
+/**
+  * @}
+  *
+  */
+
+st_fusion_status st_fusion_init(st_fusion_state *state,
+                                const st_fusion_cfg *cfg);
+
+void st_fusion_align(st_fusion_state *state, const int16_t xl[3]);
+
+void st_fusion_update(st_fusion_state *state,
+                      const st_fifo_out_slot *slot, uint16_t slot_num,
+                      st_fusion_quat *out, uint16_t *out_num);
+
+void st_fusion_quat_get(const st_fusion_state *state, int32_t q[4]);
+
+void st_fusion_to_float(const int32_t q[4], float_t out[4]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_FUSION_H */
+
+/**
+  * @}
+  *
+  */
@@ -0,0 +1,372 @@
+/*
+ ******************************************************************************
+ * @file    sh_fifo.c
+ * @author  Sensor Solutions Software Team
+ * @brief   LSM6DSL / LSM6DSM FIFO decoding with sensor hub datasets.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sh_fifo.h"
+
+/**
+  * @defgroup  Sensor hub FIFO
+  * @brief     This file provides a set of functions needed to decode the
+  *            LSM6DSL / LSM6DSM FIFO pattern, sensor hub slaves included.
+  * @{
+  *
+  */
+
+/* Private constants  --------------------------------------------------------*/
+#define DS_NUM                   (4U)
+#define DS_GY                    (0U)
+#define DS_XL                    (1U)
+#define DS_3                     (2U)
+#define DS_4                     (3U)
+
+#define SAMPLE_LEN               (6U)
+#define SAMPLE_WORDS             (3U)
+#define SH_LEN                   (12U)   /* SENSORHUB1..12 in the FIFO */
+#define SLV_LEN_MAX              (7U)
+#define DEC_MAX                  (7U)
+#define SLV_DEC_MAX              (3U)
+
+/* Private variables ---------------------------------------------------------*/
+/* FIFO_CTRL3 / 4 decimation field to factor */
+static const uint8_t dec_factor[DEC_MAX + 1U] = { 0, 1, 2, 3, 4, 8, 16, 32 };
+
+/* Private functions ---------------------------------------------------------*/
+static uint16_t gcd(uint16_t a, uint16_t b);
+static uint8_t ds_next(st_sh_fifo_state *state, uint8_t ds);
+static void pattern_start(st_sh_fifo_state *state);
+static void sample_next(st_sh_fifo_state *state);
+static void sample_out(st_sh_fifo_state *state, st_sh_fifo_out_cb cb,
+                       void *arg);
+static void slv_out(st_sh_fifo_state *state, uint8_t slv,
+                    st_sh_fifo_out *out, st_sh_fifo_out_cb cb, void *arg);
+
+/**
+  * @defgroup    Sensor_hub_FIFO_pubblic_functions
+  * @brief       This section provide a set of APIs for decoding the FIFO
+  *              of the LSM6DSL / LSM6DSM.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize the decoder, positioned at the pattern start (FIFO
+  *         empty when the configuration is written).
+  *
+  * @param  state             decoder state.(ptr)
+  * @param  cfg               FIFO and sensor hub configuration.(ptr)
+  * @retval st_sh_fifo_status ST_SH_FIFO_OK / ST_SH_FIFO_ERR (bad
+  *                           configuration)
+  *
+  */
+st_sh_fifo_status st_sh_fifo_init(st_sh_fifo_state *state,
+                                  const st_sh_fifo_cfg *cfg)
+{
+  uint8_t dec[DS_NUM];
+  uint16_t period = 1;
+  uint16_t words = 0;
+  uint8_t off = 0;
+  uint8_t end;
+  uint8_t i;
+
+  if ((state == NULL) || (cfg == NULL) || (cfg->odr_hz <= 0.0f)) {
+    return ST_SH_FIFO_ERR;
+  }
+
+  dec[DS_GY] = cfg->dec_gy;
+  dec[DS_XL] = cfg->dec_xl;
+  dec[DS_3] = cfg->dec_ds3;
+  dec[DS_4] = cfg->dec_ds4;
+
+  for (i = 0; i < DS_NUM; i++) {
+    if (dec[i] > DEC_MAX) {
+      return ST_SH_FIFO_ERR;
+    }
+    state->dec[i] = dec_factor[dec[i]];
+    if (state->dec[i] != 0U) {
+      period = (uint16_t)((period / gcd(period, state->dec[i])) *
+                          state->dec[i]);
+    }
+  }
+
+  for (i = 0; i < DS_NUM; i++) {
+    if (state->dec[i] != 0U) {
+      words += (uint16_t)(SAMPLE_WORDS * (period / state->dec[i]));
+    }
+  }
+
+  if (words == 0U) {
+    return ST_SH_FIFO_ERR;
+  }
+
+  /* slaves fill SENSORHUBx in order, only the first 12 bytes are batched */
+  for (i = 0; i < ST_SH_FIFO_SLV_NUM; i++) {
+    if ((cfg->slv[i].len > SLV_LEN_MAX) ||
+        (cfg->slv[i].dec > ((i == 0U) ? SLV_DEC_MAX : 0U))) {
+      return ST_SH_FIFO_ERR;
+    }
+
+    end = off + cfg->slv[i].len;
+    if ((cfg->slv[i].len != 0U) && (off < SAMPLE_LEN) &&
+        (end > SAMPLE_LEN) && (end <= SH_LEN) &&
+        (state->dec[DS_3] != state->dec[DS_4])) {
+      return ST_SH_FIFO_ERR;
+    }
+
+    state->slv_off[i] = off;
+    state->slv_cnt[i] = 0;
+    off = end;
+  }
+
+  state->cfg = *cfg;
+  state->period = period;
+  state->pattern_len = words;
+  state->period_ns = (uint32_t)(1000000000.0f / cfg->odr_hz);
+  pattern_start(state);
+  state->tick = 0;
+
+  return ST_SH_FIFO_OK;
+}
+
+/**
+  * @brief  Pattern length, e.g. for a FIFO threshold multiple of it.
+  *
+  * @param  state             decoder state.(ptr)
+  * @retval                   pattern length [words]
+  *
+  */
+uint16_t st_sh_fifo_pattern_len_get(const st_sh_fifo_state *state)
+{
+  return state->pattern_len;
+}
+
+/**
+  * @brief  Position the decoder on the next FIFO word, as reported by
+  *         FIFO_STATUS3 / 4 (xxx_fifo_pattern_get()). A sample already
+  *         partially read is discarded, the tick count restarts from the
+  *         pattern start.
+  *
+  * @param  state             decoder state.(ptr)
+  * @param  pattern           word index in the pattern.
+  * @retval st_sh_fifo_status ST_SH_FIFO_OK / ST_SH_FIFO_ERR (index out of
+  *                           the pattern)
+  *
+  */
+st_sh_fifo_status st_sh_fifo_sync(st_sh_fifo_state *state,
+                                  uint16_t pattern)
+{
+  uint16_t i;
+
+  if (pattern >= state->pattern_len) {
+    return ST_SH_FIFO_ERR;
+  }
+
+  pattern_start(state);
+  state->tick = 0;
+  for (i = 0; i < (pattern / SAMPLE_WORDS); i++) {
+    sample_next(state);
+  }
+  state->byte = (uint8_t)((pattern % SAMPLE_WORDS) * 2U);
+  state->drop = (state->byte != 0U) ? 1U : 0U;
+
+  return ST_SH_FIFO_OK;
+}
+
+/**
+  * @brief  Decode FIFO data (FIFO_DATA_OUT_L / H bursts), any number of
+  *         bytes: a sample split between two calls is completed by the
+  *         next one. Every sample is passed to the callback.
+  *
+  * @param  state             decoder state.(ptr)
+  * @param  data              FIFO data.(ptr)
+  * @param  len               data length [bytes].
+  * @param  cb                output callback.(ptr)
+  * @param  arg               callback argument.(ptr)
+  *
+  */
+void st_sh_fifo_decode(st_sh_fifo_state *state, const uint8_t *data,
+                       uint32_t len, st_sh_fifo_out_cb cb, void *arg)
+{
+  uint32_t i;
+
+  for (i = 0; i < len; i++) {
+    state->sample[state->byte] = data[i];
+    state->byte++;
+
+    if (state->byte == SAMPLE_LEN) {
+      if (state->drop == 0U) {
+        sample_out(state, cb, arg);
+      }
+      state->drop = 0;
+      state->byte = 0;
+      sample_next(state);
+    }
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @brief  Greatest common divisor.
+  *
+  */
+static uint16_t gcd(uint16_t a, uint16_t b)
+{
+  uint16_t t;
+
+  while (b != 0U) {
+    t = a % b;
+    a = b;
+    b = t;
+  }
+
+  return a;
+}
+
+/**
+  * @brief  First dataset from ds stored at the current tick, DS_NUM if
+  *         none.
+  *
+  */
+static uint8_t ds_next(st_sh_fifo_state *state, uint8_t ds)
+{
+  while ((ds < DS_NUM) && ((state->dec[ds] == 0U) ||
+                           ((state->pos % state->dec[ds]) != 0U))) {
+    ds++;
+  }
+
+  return ds;
+}
+
+/**
+  * @brief  Position on the first sample of the pattern.
+  *
+  */
+static void pattern_start(st_sh_fifo_state *state)
+{
+  state->pos = 0;
+  state->ds = ds_next(state, 0);
+  state->byte = 0;
+  state->drop = 0;
+  state->ds3_ok = 0;
+}
+
+/**
+  * @brief  Move to the next sample of the pattern.
+  *
+  */
+static void sample_next(st_sh_fifo_state *state)
+{
+  state->ds = ds_next(state, state->ds + 1U);
+
+  while (state->ds == DS_NUM) {
+    state->pos = (uint16_t)((state->pos + 1U) % state->period);
+    state->tick++;
+    state->ds3_ok = 0;
+    state->ds = ds_next(state, 0);
+  }
+}
+
+/**
+  * @brief  Output of the current sample: gyroscope, accelerometer or the
+  *         slaves whose last byte is in the dataset.
+  *
+  */
+static void sample_out(st_sh_fifo_state *state, st_sh_fifo_out_cb cb,
+                       void *arg)
+{
+  st_sh_fifo_out out;
+  float_t sens;
+  int16_t raw;
+  uint8_t first;
+  uint8_t end;
+  uint8_t i;
+
+  out.tick = state->tick;
+  out.timestamp = (uint32_t)(((uint64_t)state->tick * state->period_ns) /
+                             1000U);
+
+  if (state->ds <= DS_XL) {
+    out.sensor = (state->ds == DS_GY) ? ST_SH_FIFO_GY : ST_SH_FIFO_XL;
+    sens = (state->ds == DS_GY) ? state->cfg.gy_sens : state->cfg.xl_sens;
+    out.num = 3;
+    for (i = 0; i < 3U; i++) {
+      raw = (int16_t)((uint16_t)state->sample[2U * i] |
+                      ((uint16_t)state->sample[(2U * i) + 1U] << 8));
+      out.val[i] = (sens != 0.0f) ? ((float_t)raw * sens) : (float_t)raw;
+    }
+    cb(&out, arg);
+    return;
+  }
+
+  first = (state->ds == DS_3) ? 0U : SAMPLE_LEN;
+  for (i = 0; i < SAMPLE_LEN; i++) {
+    state->sh[first + i] = state->sample[i];
+  }
+  if (state->ds == DS_3) {
+    state->ds3_ok = 1;
+  }
+
+  for (i = 0; i < ST_SH_FIFO_SLV_NUM; i++) {
+    end = state->slv_off[i] + state->cfg.slv[i].len;
+    if ((state->cfg.slv[i].len != 0U) && (end > first) &&
+        (end <= (first + SAMPLE_LEN)) &&
+        ((state->slv_off[i] >= first) || (state->ds3_ok != 0U))) {
+      slv_out(state, i, &out, cb, arg);
+    }
+  }
+}
+
+/**
+  * @brief  Slave output, one every 2^dec batched samples for slave 0.
+  *
+  */
+static void slv_out(st_sh_fifo_state *state, uint8_t slv,
+                    st_sh_fifo_out *out, st_sh_fifo_out_cb cb, void *arg)
+{
+  const st_sh_fifo_slv_cfg *cfg = &state->cfg.slv[slv];
+  const uint8_t *raw = &state->sh[state->slv_off[slv]];
+  uint8_t skip = state->slv_cnt[slv];
+  uint8_t i;
+
+  state->slv_cnt[slv] = (uint8_t)((skip + 1U) & ((1U << cfg->dec) - 1U));
+  if (skip != 0U) {
+    return;
+  }
+
+  out->sensor = (st_sh_fifo_sensor)(ST_SH_FIFO_SLV0 + slv);
+  if (cfg->decode != NULL) {
+    out->num = cfg->decode(raw, cfg->len, out->val, cfg->arg);
+  }
+  else {
+    out->num = (cfg->len / 2U > 3U) ? 3U : (uint8_t)(cfg->len / 2U);
+    for (i = 0; i < out->num; i++) {
+      out->val[i] = (float_t)(int16_t)((uint16_t)raw[2U * i] |
+                                       ((uint16_t)raw[(2U * i) + 1U] << 8));
+    }
+  }
+  cb(out, arg);
+}
+
+/**
+  * @}
+  *
+  */
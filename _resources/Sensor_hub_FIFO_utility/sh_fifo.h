@@ -0,0 +1,169 @@
+/*
+ ******************************************************************************
+ * @file    sh_fifo.h
+ * @author  Sensor Solutions Software Team
+ * @brief   This file contains all the functions prototypes for the
+ *          sh_fifo.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST_SH_FIFO_H
+#define ST_SH_FIFO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+/** @addtogroup Sensor hub FIFO
+  * @brief    Decoding of the LSM6DSL / LSM6DSM FIFO (not tagged) with the
+  *           sensor hub slaves batched in datasets 3 and 4.
+  *
+  *           The FIFO stores, at every tick of the base data rate, the
+  *           samples of the datasets whose decimation factor divides the
+  *           tick, always in the order gyroscope (dataset 1),
+  *           accelerometer (dataset 2), dataset 3, dataset 4; every
+  *           sample is 3 words (6 bytes). The decoder walks this pattern,
+  *           so the FIFO can be drained with bursts of any number of
+  *           words and the samples come with the tick they were stored.
+  *
+  *           Datasets 3 and 4 are the SENSORHUB1..6 and SENSORHUB7..12
+  *           registers, filled by the slaves in order (slave 0 first,
+  *           slv_len bytes each): a slave is decoded when the last of
+  *           its bytes is read, by the decoder given in the configuration
+  *           (units of the slave), or as raw 16 bit words. A slave that
+  *           spans datasets 3 and 4 needs the same decimation on both.
+  *           Dataset 4 carries slave data only with the step counter and
+  *           timestamp batching disabled.
+  * @{
+  *
+  */
+
+/** @defgroup Sensor_hub_FIFO_pubblic_definitions
+  * @{
+  *
+  */
+
+#define ST_SH_FIFO_SLV_NUM       (4U)
+
+typedef enum {
+  ST_SH_FIFO_OK = 0,
+  ST_SH_FIFO_ERR
+} st_sh_fifo_status;
+
+typedef enum {
+  ST_SH_FIFO_GY = 0,
+  ST_SH_FIFO_XL,
+  ST_SH_FIFO_SLV0,
+  ST_SH_FIFO_SLV1,
+  ST_SH_FIFO_SLV2,
+  ST_SH_FIFO_SLV3
+} st_sh_fifo_sensor;
+
+/**
+  * @brief  Slave decoder: raw bytes as read by the sensor hub (len =
+  *         slv_len), up to 3 values in the slave units.
+  * @retval number of values
+  */
+typedef uint8_t (*st_sh_fifo_slv_decode_ptr)(const uint8_t *raw, uint8_t len,
+                                             float_t val[3], void *arg);
+
+typedef struct {
+  uint8_t len;                    /* slv_len of SLVx_CONFIG, 0: not read */
+  uint8_t dec;                    /* slave 0 only: slave0_rate (0..3),
+                                   * read every 1, 2, 4, 8 cycles */
+  st_sh_fifo_slv_decode_ptr decode;   /* NULL: raw 16 bit words */
+  void *arg;
+} st_sh_fifo_slv_cfg;
+
+/**
+  * @brief  Configuration, decimations as written in FIFO_CTRL3 / 4
+  *         (xxx_fifo_yy_batch_set() values: 0 not batched, 1 no
+  *         decimation, 2, 3, 4, 8, 16, 32).
+  */
+typedef struct {
+  float_t odr_hz;                 /* rate of the datasets with no
+                                   * decimation: fastest batched sensor,
+                                   * not above the FIFO data rate */
+  uint8_t dec_gy;
+  uint8_t dec_xl;
+  uint8_t dec_ds3;
+  uint8_t dec_ds4;
+  float_t gy_sens;                /* mdps/LSB, 0: raw */
+  float_t xl_sens;                /* mg/LSB, 0: raw */
+  st_sh_fifo_slv_cfg slv[ST_SH_FIFO_SLV_NUM];
+} st_sh_fifo_cfg;
+
+typedef struct {
+  uint32_t timestamp;             /* us from the decoder start */
+  uint32_t tick;                  /* base data rate ticks */
+  st_sh_fifo_sensor sensor;
+  uint8_t num;                    /* values */
+  float_t val[3];
+} st_sh_fifo_out;
+
+typedef void (*st_sh_fifo_out_cb)(const st_sh_fifo_out *out, void *arg);
+
+/**
+  * @brief  Decoder state, fields are private.
+  */
+typedef struct {
+  st_sh_fifo_cfg cfg;
+  uint8_t dec[4];                 /* decimation factor of the datasets */
+  uint8_t slv_off[ST_SH_FIFO_SLV_NUM];
+  uint8_t slv_cnt[ST_SH_FIFO_SLV_NUM];
+  uint16_t period;                /* pattern ticks */
+  uint16_t pattern_len;           /* pattern words */
+  uint16_t pos;                   /* tick in the pattern */
+  uint8_t ds;                     /* current dataset */
+  uint8_t byte;                   /* bytes of the current sample */
+  uint8_t drop;                   /* sample partially read before sync */
+  uint8_t ds3_ok;                 /* dataset 3 read at the current tick */
+  uint32_t tick;
+  uint32_t period_ns;
+  uint8_t sample[6];
+  uint8_t sh[12];                 /* SENSORHUB1..12 */
+} st_sh_fifo_state;
+
+/**
+  * @}
+  *
+  */
+
+st_sh_fifo_status st_sh_fifo_init(st_sh_fifo_state *state,
+                                  const st_sh_fifo_cfg *cfg);
+
+uint16_t st_sh_fifo_pattern_len_get(const st_sh_fifo_state *state);
+
+st_sh_fifo_status st_sh_fifo_sync(st_sh_fifo_state *state,
+                                  uint16_t pattern);
+
+void st_sh_fifo_decode(st_sh_fifo_state *state, const uint8_t *data,
+                       uint32_t len, st_sh_fifo_out_cb cb, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST_SH_FIFO_H */
+
+/**
+  * @}
+  *
+  */
@@ -86,7 +86,7 @@ int32_t h3lis100dl_write_reg(stmdev_ctx_t* ctx, uint8_t reg, uint8_t* data,
 
 float_t h3lis100dl_from_fs100g_to_mg(int8_t lsb)
 {
-  return ( (float_t)lsb / 256.0f ) * 780.0f;
+  return ( (float_t)lsb ) * 780.0f;
 }
 
 /**
@@ -408,6 +408,49 @@ int32_t h3lis100dl_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff)
   return ret;
 }
 
+/**
+  * @brief  Linear acceleration output register, 8 bit data only.[get]
+  *         One burst OUT_X .. OUT_Z (5 bytes), the registers between the
+  *         outputs are dropped: x, y, z packed in 3 bytes.
+  *
+  * @param  ctx         read / write interface definitions(ptr)
+  * @param  buff        buffer that stores data read, x, y, z (3 bytes)
+  *
+  */
+int32_t h3lis100dl_acceleration_8bit_raw_get(stmdev_ctx_t *ctx, int8_t *buff)
+{
+  uint8_t reg[5];
+  int32_t ret;
+
+  ret = h3lis100dl_read_reg(ctx, H3LIS100DL_OUT_X, reg, 5);
+  buff[0] = (int8_t)reg[0];
+  buff[1] = (int8_t)reg[2];
+  buff[2] = (int8_t)reg[4];
+
+  return ret;
+}
+
+/**
+  * @brief  Convert 8 bit samples to mg, integer only: one multiply by
+  *         780 mg / LSB per value, no branch in the loop: vectorized by
+  *         the compiler on targets with SIMD (Cortex-M4 / M7 DSP, Neon,
+  *         SSE). The output is 32 bit: +-100 g in mg exceeds int16_t.
+  *
+  * @param  lsb         8 bit values, e.g. 3 * num packed samples
+  * @param  mg          converted values
+  * @param  len         number of values
+  *
+  */
+void h3lis100dl_from_lsb8_to_mg(const int8_t *lsb, int32_t *mg,
+                                uint16_t len)
+{
+  uint16_t i;
+
+  for (i = 0U; i < len; i++) {
+    mg[i] = (int32_t)lsb[i] * 780;
+  }
+}
+
 /**
   * @}
   *
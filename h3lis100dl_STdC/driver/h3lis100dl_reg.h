@@ -345,6 +345,11 @@ int32_t h3lis100dl_flag_data_ready_get(stmdev_ctx_t *ctx,
 
 int32_t h3lis100dl_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
+int32_t h3lis100dl_acceleration_8bit_raw_get(stmdev_ctx_t *ctx, int8_t *buff);
+
+void h3lis100dl_from_lsb8_to_mg(const int8_t *lsb, int32_t *mg,
+                                uint16_t len);
+
 int32_t h3lis100dl_device_id_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t h3lis100dl_boot_set(stmdev_ctx_t *ctx, uint8_t val);
@@ -77,16 +77,11 @@
 #include "usart.h"
 #endif
 
-typedef union{
-  int16_t i16bit[3];
-  uint8_t u8bit[6];
-} axis3bit16_t;
-
 /* Private macro -------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
-static axis3bit16_t data_raw_acceleration;
-static float acceleration_mg[3];
+static int8_t data_raw_acceleration[3];
+static int32_t acceleration_mg[3];
 static uint8_t whoamI;
 static uint8_t tx_buffer[1000];
 
@@ -144,19 +139,13 @@ void example_main_h3lis100dl(void)
 
     if (reg.status_reg.zyxda)
     {
-      /* Read acceleration data */
-      memset(data_raw_acceleration.u8bit, 0x00, 3*sizeof(int16_t));
-      h3lis100dl_acceleration_raw_get(&dev_ctx, data_raw_acceleration.u8bit);
+      /* Read acceleration data, x, y, z packed in 3 bytes */
+      h3lis100dl_acceleration_8bit_raw_get(&dev_ctx, data_raw_acceleration);
+      h3lis100dl_from_lsb8_to_mg(data_raw_acceleration, acceleration_mg, 3);
 
-      acceleration_mg[0] =
-        h3lis100dl_from_fs100g_to_mg(data_raw_acceleration.u8bit[0]);
-      acceleration_mg[1] =
-        h3lis100dl_from_fs100g_to_mg(data_raw_acceleration.u8bit[1]);
-      acceleration_mg[2] =
-        h3lis100dl_from_fs100g_to_mg(data_raw_acceleration.u8bit[2]);
-     
-      sprintf((char*)tx_buffer, "Acceleration [mg]:%4.2f\t%4.2f\t%4.2f\r\n",
-              acceleration_mg[0], acceleration_mg[1], acceleration_mg[2]);
+      sprintf((char*)tx_buffer, "Acceleration [mg]:%ld\t%ld\t%ld\r\n",
+              (long)acceleration_mg[0], (long)acceleration_mg[1],
+              (long)acceleration_mg[2]);
       tx_com(tx_buffer, strlen((char const*)tx_buffer));
     }
   }
@@ -0,0 +1,574 @@
+/*
+ ******************************************************************************
+ * @file    iis2iclx_inclination.c
+ * @author  Sensors Software Solution Team
+ * @brief   Dual axis inclination with low duty cycle: the accelerometer
+ *          is turned on for every measurement, an oversampled batch of
+ *          samples (with the temperature) is collected in FIFO and read
+ *          in one burst, then averaged and converted to angles with
+ *          integer arithmetic only.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/*
+ * This example was developed using the following STMicroelectronics
+ * evaluation boards:
+ *
+ * - STEVAL_MKI109V3 + STEVAL-MKI209V1K
+ * - NUCLEO_F411RE + STEVAL-MKI209V1K
+ *
+ * and STM32CubeMX tool with STM32CubeF4 MCU Package
+ *
+ * Used interfaces:
+ *
+ * STEVAL_MKI109V3    - Host side:   USB (Virtual COM)
+ *                    - Sensor side: SPI(Default) / I2C(supported)
+ *
+ * NUCLEO_STM32F411RE - Host side: UART(COM) to USB bridge
+ *                    - I2C(Default) / SPI(supported)
+ *
+ * If you need to run this example on a different hardware platform a
+ * modification of the functions: `platform_write`, `platform_read`,
+ * `tx_com` and 'platform_init' is required.
+ *
+ */
+
+/* STMicroelectronics evaluation boards definition
+ *
+ * Please uncomment ONLY the evaluation boards in use.
+ * If a different hardware is used please comment all
+ * following target board and redefine yours.
+ */
+//#define STEVAL_MKI109V3
+#define NUCLEO_F411RE
+
+#if defined(STEVAL_MKI109V3)
+/* MKI109V3: Define communication interface */
+#define SENSOR_BUS hspi2
+
+/* MKI109V3: Vdd and Vddio power supply values */
+#define PWM_3V3 915
+
+#elif defined(NUCLEO_F411RE)
+/* NUCLEO_F411RE: Define communication interface */
+#define SENSOR_BUS hi2c1
+
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <stdio.h>
+#include "stm32f4xx_hal.h"
+#include <iis2iclx_reg.h>
+#include "gpio.h"
+#include "i2c.h"
+#if defined(STEVAL_MKI109V3)
+#include "usbd_cdc_if.h"
+#include "spi.h"
+#elif defined(NUCLEO_F411RE)
+#include "usart.h"
+#endif
+
+/* Private macro -------------------------------------------------------------*/
+#define    BOOT_TIME            20 //ms
+
+/* Time between two measurements, the accelerometer is off meanwhile */
+#define    MEAS_PERIOD       10000 //ms
+
+/* Low pass filter settling after the accelerometer turn on */
+#define    SETTLING_TIME       200 //ms
+
+/* Accelerometer samples averaged for every angle (up to 2048, the
+ * accumulators are 32 bit), batched at 104 Hz: about 1.2 s of data
+ */
+#define    OVERSAMPLING        128
+
+/* FIFO words of one measurement: accelerometer words plus the
+ * temperature words batched at 12.5 Hz (1 every 8 accelerometer words)
+ */
+#define    FIFO_WORDS          (OVERSAMPLING + (OVERSAMPLING / 8) + 2)
+#define    FIFO_WORD_LEN         7
+
+/* 1 g at full scale 1 g (0.031 mg/LSB) */
+#define    ONE_G_LSB         32258
+
+/* Mean values are in 1/16 LSB (Q4) */
+#define    MEAN_SHIFT            4
+
+/* Temperature offset drift of the node, 1/16 LSB per degC, and the
+ * temperature of the offset calibration (0 LSB: 25 degC, 1/256 degC/LSB).
+ * To be set from the calibration of every node, 0: no compensation.
+ */
+#define    TCO_X                 0
+#define    TCO_Y                 0
+#define    TCO_T0                0
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+  int32_t x;            /* mean acceleration, 1/16 LSB */
+  int32_t y;
+  int32_t temp;         /* mean temperature, LSB (1/256 degC) */
+  uint16_t xl_num;      /* accelerometer samples averaged */
+  uint16_t temp_num;    /* temperature samples averaged */
+} incl_batch_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* atan(2^-i) in micro degrees */
+static const int32_t cordic_atan_udeg[] = {
+  45000000, 26565051, 14036243, 7125016, 3576334, 1789911, 895174, 447614,
+  223811, 111906, 55953, 27976, 13988, 6994, 3497, 1749, 874, 437, 219,
+  109, 55, 27, 14, 7,
+};
+static uint8_t fifo_buf[FIFO_WORDS * FIFO_WORD_LEN];
+static uint8_t whoamI, rst;
+static uint8_t tx_buffer[1000];
+
+/* Extern variables ----------------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/*
+ *   WARNING:
+ *   Functions declare in this section are defined at the end of this file
+ *   and are strictly related to the hardware platform used.
+ *
+ */
+static int32_t platform_write(void *handle, uint8_t reg, uint8_t *bufp,
+                              uint16_t len);
+static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
+                             uint16_t len);
+static void tx_com( uint8_t *tx_buffer, uint16_t len );
+static void platform_delay(uint32_t ms);
+static void platform_init(void);
+
+static int32_t incl_batch_get(stmdev_ctx_t *ctx, incl_batch_t *batch);
+static void incl_batch_average(const uint8_t *buf, uint16_t num,
+                               incl_batch_t *batch);
+static int32_t incl_axis_udeg(int32_t a);
+static int32_t atan2_udeg(int32_t y, int32_t x);
+static uint32_t isqrt64(uint64_t val);
+static int32_t div_round(int32_t num, int32_t den);
+
+/* Main Example --------------------------------------------------------------*/
+void example_main_inclination_iis2iclx(void)
+{
+  stmdev_ctx_t dev_ctx;
+  incl_batch_t batch;
+  int32_t incl_x;
+  int32_t incl_y;
+  int32_t dt;
+
+  /* Initialize mems driver interface */
+  dev_ctx.write_reg = platform_write;
+  dev_ctx.read_reg = platform_read;
+  dev_ctx.handle = &SENSOR_BUS;
+
+  /* Init test platform */
+  platform_init();
+
+  /* Wait sensor boot time */
+  platform_delay(BOOT_TIME);
+
+  /* Set Bus mode */
+  iis2iclx_bus_mode_set(&dev_ctx, IIS2ICLX_SEL_BY_HW);
+
+  /* Check device ID */
+  iis2iclx_device_id_get(&dev_ctx, &whoamI);
+  if (whoamI != IIS2ICLX_ID)
+    while(1);
+
+  /* Restore default configuration */
+  iis2iclx_reset_set(&dev_ctx, PROPERTY_ENABLE);
+  do {
+    iis2iclx_reset_get(&dev_ctx, &rst);
+  } while (rst);
+
+  /* Enable Block Data Update */
+  iis2iclx_block_data_update_set(&dev_ctx, PROPERTY_ENABLE);
+
+  /* Set full scale: 1 g covers +/- 90 deg with the best resolution */
+  iis2iclx_xl_full_scale_set(&dev_ctx, IIS2ICLX_1g);
+
+  /* Configure filtering chain - LPF1 + LPF2 path, ODR / 10 */
+  iis2iclx_xl_hp_path_on_out_set(&dev_ctx, IIS2ICLX_LP_ODR_DIV_10);
+  iis2iclx_xl_filter_lp2_set(&dev_ctx, PROPERTY_ENABLE);
+
+  /* FIFO: accelerometer and temperature batched, stop at the watermark
+   * so the burst read length is known in advance
+   */
+  iis2iclx_fifo_watermark_set(&dev_ctx, FIFO_WORDS);
+  iis2iclx_fifo_stop_on_wtm_set(&dev_ctx, PROPERTY_ENABLE);
+  iis2iclx_fifo_xl_batch_set(&dev_ctx, IIS2ICLX_XL_BATCHED_AT_104Hz);
+  iis2iclx_fifo_temp_batch_set(&dev_ctx, IIS2ICLX_TEMP_BATCHED_AT_12Hz5);
+
+  while(1)
+  {
+    if (incl_batch_get(&dev_ctx, &batch) == 0)
+    {
+      /* Offset drift compensation */
+      if (batch.temp_num > 0U)
+      {
+        dt = batch.temp - TCO_T0;
+        batch.x -= div_round(TCO_X * dt, 256);
+        batch.y -= div_round(TCO_Y * dt, 256);
+      }
+
+      incl_x = incl_axis_udeg(batch.x);
+      incl_y = incl_axis_udeg(batch.y);
+
+      sprintf((char*)tx_buffer,
+              "Inclination [deg]:%9.4f\t%9.4f\tT [degC]:%6.2f\t(%u)\r\n",
+              (float)incl_x / 1e6f, (float)incl_y / 1e6f,
+              (float)batch.temp / 256.0f + 25.0f, batch.xl_num);
+      tx_com(tx_buffer, strlen((char const*)tx_buffer));
+    }
+
+    platform_delay(MEAS_PERIOD);
+  }
+}
+
+/*
+ * @brief  Turn on the accelerometer, collect one batch in FIFO, read
+ *         it in one burst and turn off the accelerometer.
+ *
+ * @param  ctx       driver context
+ * @param  batch     averaged batch
+ *
+ */
+static int32_t incl_batch_get(stmdev_ctx_t *ctx, incl_batch_t *batch)
+{
+  uint16_t num = 0;
+  uint8_t wtm = 0;
+  int32_t ret;
+
+  ret = iis2iclx_xl_data_rate_set(ctx, IIS2ICLX_XL_ODR_104Hz);
+
+  /* Samples of the filter settling are not stored (FIFO in bypass) */
+  platform_delay(SETTLING_TIME);
+
+  if (ret == 0)
+  {
+    ret = iis2iclx_fifo_mode_set(ctx, IIS2ICLX_FIFO_MODE);
+  }
+
+  while ((ret == 0) && (wtm == 0U))
+  {
+    platform_delay(100);
+    ret = iis2iclx_fifo_wtm_flag_get(ctx, &wtm);
+  }
+
+  if (ret == 0)
+  {
+    ret = iis2iclx_fifo_data_level_get(ctx, &num);
+  }
+
+  if (num > FIFO_WORDS)
+  {
+    num = FIFO_WORDS;
+  }
+
+  /* One transaction, the address rolls back to FIFO_DATA_OUT_TAG
+   * every word
+   */
+  if ((ret == 0) && (num > 0U))
+  {
+    ret = iis2iclx_read_reg(ctx, IIS2ICLX_FIFO_DATA_OUT_TAG, fifo_buf,
+                            num * FIFO_WORD_LEN);
+  }
+
+  /* Power down until the next measurement, bypass empties the FIFO */
+  iis2iclx_xl_data_rate_set(ctx, IIS2ICLX_XL_ODR_OFF);
+  iis2iclx_fifo_mode_set(ctx, IIS2ICLX_BYPASS_MODE);
+
+  if (ret == 0)
+  {
+    incl_batch_average(fifo_buf, num, batch);
+
+    if (batch->xl_num == 0U)
+    {
+      ret = -1;
+    }
+  }
+
+  return ret;
+}
+
+/*
+ * @brief  Average the accelerometer (1/16 LSB) and temperature words of
+ *         a FIFO batch.
+ *
+ */
+static void incl_batch_average(const uint8_t *buf, uint16_t num,
+                               incl_batch_t *batch)
+{
+  const uint8_t *word;
+  int32_t sum_x = 0;
+  int32_t sum_y = 0;
+  int32_t sum_t = 0;
+  uint16_t i;
+  uint8_t tag;
+
+  batch->xl_num = 0;
+  batch->temp_num = 0;
+
+  for (i = 0; i < num; i++)
+  {
+    word = &buf[i * FIFO_WORD_LEN];
+    tag = word[0] >> 3;
+
+    if (tag == IIS2ICLX_XL_NC_TAG)
+    {
+      sum_x += (int16_t)((uint16_t)word[2] << 8 | word[1]);
+      sum_y += (int16_t)((uint16_t)word[4] << 8 | word[3]);
+      batch->xl_num++;
+    }
+    else if (tag == IIS2ICLX_TEMPERATURE_TAG)
+    {
+      sum_t += (int16_t)((uint16_t)word[2] << 8 | word[1]);
+      batch->temp_num++;
+    }
+  }
+
+  if (batch->xl_num > 0U)
+  {
+    batch->x = div_round(sum_x * (1 << MEAN_SHIFT), batch->xl_num);
+    batch->y = div_round(sum_y * (1 << MEAN_SHIFT), batch->xl_num);
+  }
+
+  if (batch->temp_num > 0U)
+  {
+    batch->temp = div_round(sum_t, batch->temp_num);
+  }
+}
+
+/*
+ * @brief  Inclination of one axis from the horizontal plane, micro
+ *         degrees: atan2(a, sqrt(1g^2 - a^2)).
+ *
+ * @param  a         mean acceleration of the axis, 1/16 LSB
+ *
+ */
+static int32_t incl_axis_udeg(int32_t a)
+{
+  const int64_t g = (int64_t)ONE_G_LSB << MEAN_SHIFT;
+  int64_t h2;
+
+  h2 = (g * g) - ((int64_t)a * a);
+  if (h2 < 0)
+  {
+    h2 = 0;
+  }
+
+  return atan2_udeg(a, (int32_t)isqrt64((uint64_t)h2));
+}
+
+/*
+ * @brief  atan2(y, x) in micro degrees, CORDIC in vectoring mode.
+ *         The inputs are normalized to 29 bit (|x|, |y| < 2^29 is
+ *         required), 24 iterations: the error is below 0.0001 deg.
+ *
+ */
+static int32_t atan2_udeg(int32_t y, int32_t x)
+{
+  int32_t angle = 0;
+  int32_t xt;
+  uint8_t i;
+
+  if ((x == 0) && (y == 0))
+  {
+    return 0;
+  }
+
+  while ((x < (1 << 28)) && (x > -(1 << 28)) &&
+         (y < (1 << 28)) && (y > -(1 << 28)))
+  {
+    x *= 2;
+    y *= 2;
+  }
+
+  /* Left half plane: rotate by -/+ 90 deg */
+  if (x < 0)
+  {
+    xt = x;
+    if (y >= 0)
+    {
+      x = y;
+      y = -xt;
+      angle = 90000000;
+    }
+    else
+    {
+      x = -y;
+      y = xt;
+      angle = -90000000;
+    }
+  }
+
+  for (i = 0; i < sizeof(cordic_atan_udeg) / sizeof(int32_t); i++)
+  {
+    xt = x;
+    if (y > 0)
+    {
+      x += y >> i;
+      y -= xt >> i;
+      angle += cordic_atan_udeg[i];
+    }
+    else
+    {
+      x -= y >> i;
+      y += xt >> i;
+      angle -= cordic_atan_udeg[i];
+    }
+  }
+
+  return angle;
+}
+
+static uint32_t isqrt64(uint64_t val)
+{
+  uint64_t res = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+
+  while (bit > val)
+  {
+    bit >>= 2;
+  }
+
+  while (bit != 0U)
+  {
+    if (val >= res + bit)
+    {
+      val -= res + bit;
+      res = (res >> 1) + bit;
+    }
+    else
+    {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return (uint32_t)res;
+}
+
+static int32_t div_round(int32_t num, int32_t den)
+{
+  return (num >= 0) ? ((num + (den / 2)) / den) :
+         ((num - (den / 2)) / den);
+}
+
+/*
+ * @brief  Write generic device register (platform dependent)
+ *
+ * @param  handle    customizable argument. In this examples is used in
+ *                   order to select the correct sensor bus handler.
+ * @param  reg       register to write
+ * @param  bufp      pointer to data to write in register reg
+ * @param  len       number of consecutive register to write
+ *
+ */
+static int32_t platform_write(void *handle, uint8_t reg, uint8_t *bufp,
+                              uint16_t len)
+{
+  if (handle == &hi2c1)
+  {
+    HAL_I2C_Mem_Write(handle, IIS2ICLX_I2C_ADD_L, reg,
+                      I2C_MEMADD_SIZE_8BIT, bufp, len, 1000);
+  }
+#ifdef STEVAL_MKI109V3
+  else if (handle == &hspi2)
+  {
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_RESET);
+    HAL_SPI_Transmit(handle, &reg, 1, 1000);
+    HAL_SPI_Transmit(handle, bufp, len, 1000);
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_SET);
+  }
+#endif
+  return 0;
+}
+
+/*
+ * @brief  Read generic device register (platform dependent)
+ *
+ * @param  handle    customizable argument. In this examples is used in
+ *                   order to select the correct sensor bus handler.
+ * @param  reg       register to read
+ * @param  bufp      pointer to buffer that store the data read
+ * @param  len       number of consecutive register to read
+ *
+ */
+static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
+                             uint16_t len)
+{
+  if (handle == &hi2c1)
+  {
+    HAL_I2C_Mem_Read(handle, IIS2ICLX_I2C_ADD_L, reg,
+                     I2C_MEMADD_SIZE_8BIT, bufp, len, 1000);
+  }
+#ifdef STEVAL_MKI109V3
+  else if (handle == &hspi2)
+  {
+    /* Read command */
+    reg |= 0x80;
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_RESET);
+    HAL_SPI_Transmit(handle, &reg, 1, 1000);
+    HAL_SPI_Receive(handle, bufp, len, 1000);
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_SET);
+  }
+#endif
+  return 0;
+}
+
+/*
+ * @brief  Write generic device register (platform dependent)
+ *
+ * @param  tx_buffer     buffer to trasmit
+ * @param  len           number of byte to send
+ *
+ */
+static void tx_com(uint8_t *tx_buffer, uint16_t len)
+{
+  #ifdef NUCLEO_F411RE
+  HAL_UART_Transmit(&huart2, tx_buffer, len, 1000);
+  #endif
+  #ifdef STEVAL_MKI109V3
+  CDC_Transmit_FS(tx_buffer, len);
+  #endif
+}
+
+/*
+ * @brief  platform specific delay (platform dependent)
+ *
+ * @param  ms        delay in ms
+ *
+ */
+static void platform_delay(uint32_t ms)
+{
+  HAL_Delay(ms);
+}
+
+/*
+ * @brief  platform specific initialization (platform dependent)
+ */
+static void platform_init(void)
+{
+#if defined(STEVAL_MKI109V3)
+  TIM3->CCR1 = PWM_3V3;
+  TIM3->CCR2 = PWM_3V3;
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);
+  HAL_Delay(1000);
+#endif
+}
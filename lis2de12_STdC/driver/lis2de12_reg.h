@@ -514,6 +514,11 @@ int32_t lis2de12_xl_data_ovr_get(stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis2de12_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
+int32_t lis2de12_acceleration_8bit_raw_get(stmdev_ctx_t *ctx, int8_t *buff);
+
+void lis2de12_from_lsb8_to_mg(lis2de12_fs_t fs, const int8_t *lsb, int16_t *mg,
+                              uint16_t len);
+
 int32_t lis2de12_device_id_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 typedef enum {
@@ -641,6 +646,9 @@ int32_t lis2de12_fifo_ovr_flag_get(stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis2de12_fifo_fth_flag_get(stmdev_ctx_t *ctx, uint8_t *val);
 
+int32_t lis2de12_fifo_8bit_raw_get(stmdev_ctx_t *ctx, int8_t *buff,
+                                   uint8_t num);
+
 int32_t lis2de12_tap_conf_set(stmdev_ctx_t *ctx, lis2de12_click_cfg_t *val);
 int32_t lis2de12_tap_conf_get(stmdev_ctx_t *ctx, lis2de12_click_cfg_t *val);
 
@@ -650,6 +650,154 @@ int32_t lis2dw12_offset_weight_get(stmdev_ctx_t *ctx,
   return ret;
 }
 
+/**
+  * @brief  Accelerometer bias calibration in the user offset
+  *         registers.[set]
+  *         The bias is estimated from raw samples collected with the
+  *         device not moving and one axis along gravity (e.g. a FIFO
+  *         batch at the current full scale and offset configuration):
+  *         the axis with the largest mean is the gravity one and 1 g is
+  *         removed from it, the offset already applied (if enabled) is
+  *         added back. The finest weight able to represent the bias is
+  *         selected (2^-10 g/LSB up to 124 mg, 2^-6 g/LSB up to 1.98 g),
+  *         then X/Y/Z_OFS_USR, usr_off_w and usr_off_on_out are written:
+  *         the bias is removed in hardware from output registers, FIFO
+  *         and wake-up / 6D functions (with usr_off_on_wu).
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  raw      raw samples, x, y, z interleaved.(ptr)
+  * @param  num      number of samples (x, y, z triplets).
+  * @param  val      noise_mg input (maximum standard deviation per axis
+  *                  for a still device, 0 to skip the check) and
+  *                  calibration results; registers are written only
+  *                  when val->done is set.(ptr)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis2dw12_offset_calibrate(stmdev_ctx_t *ctx, const int16_t *raw,
+                                  uint16_t num,
+                                  lis2dw12_offset_cal_t *val)
+{
+  lis2dw12_ctrl_reg7_t ctrl_reg7;
+  lis2dw12_fs_t fs;
+  float_t mean[3];
+  float_t var[3];
+  float_t sens;
+  float_t wgt;
+  float_t max;
+  float_t d;
+  uint8_t ofs[3];
+  uint16_t i;
+  uint8_t k;
+  int32_t ret;
+
+  val->done = PROPERTY_DISABLE;
+
+  ret = lis2dw12_full_scale_get(ctx, &fs);
+  if (ret == 0) {
+    ret = lis2dw12_read_reg(ctx, LIS2DW12_CTRL_REG7,
+                            (uint8_t*)&ctrl_reg7, 1);
+  }
+  if (ret == 0) {
+    ret = lis2dw12_read_reg(ctx, LIS2DW12_X_OFS_USR, ofs, 3);
+  }
+  if ( (ret != 0) || (num == 0U) ) {
+    return ret;
+  }
+
+  switch (fs) {
+    case LIS2DW12_4g:
+      sens = lis2dw12_from_fs4_to_mg(1);
+      break;
+    case LIS2DW12_8g:
+      sens = lis2dw12_from_fs8_to_mg(1);
+      break;
+    case LIS2DW12_16g:
+      sens = lis2dw12_from_fs16_to_mg(1);
+      break;
+    default:
+      sens = lis2dw12_from_fs2_to_mg(1);
+      break;
+  }
+
+  for (k = 0U; k < 3U; k++) {
+    mean[k] = 0.0f;
+    var[k] = 0.0f;
+    for (i = 0U; i < num; i++) {
+      mean[k] += (float_t)raw[(3U * i) + k];
+    }
+    mean[k] /= (float_t)num;
+    for (i = 0U; i < num; i++) {
+      d = (float_t)raw[(3U * i) + k] - mean[k];
+      var[k] += d * d;
+    }
+    var[k] = (var[k] / (float_t)num) * sens * sens;
+    mean[k] *= sens;
+  }
+
+  /* gravity axis */
+  val->gravity_axis = 0U;
+  for (k = 1U; k < 3U; k++) {
+    d = (mean[k] < 0.0f) ? -mean[k] : mean[k];
+    max = (mean[val->gravity_axis] < 0.0f) ?
+          -mean[val->gravity_axis] : mean[val->gravity_axis];
+    if (d > max) {
+      val->gravity_axis = k;
+    }
+  }
+
+  /* offset already removed by the device */
+  wgt = (ctrl_reg7.usr_off_w == PROPERTY_ENABLE) ? 15.625f : 0.9765625f;
+  max = 0.0f;
+  for (k = 0U; k < 3U; k++) {
+    val->bias_mg[k] = mean[k];
+    if (k == val->gravity_axis) {
+      val->bias_mg[k] -= (mean[k] < 0.0f) ? -1000.0f : 1000.0f;
+    }
+    if (ctrl_reg7.usr_off_on_out == PROPERTY_ENABLE) {
+      val->bias_mg[k] += (float_t)((int8_t)ofs[k]) * wgt;
+    }
+    d = (val->bias_mg[k] < 0.0f) ? -val->bias_mg[k] : val->bias_mg[k];
+    if (d > max) {
+      max = d;
+    }
+    if ( (val->noise_mg > 0.0f) &&
+         (var[k] > (val->noise_mg * val->noise_mg)) ) {
+      return ret;
+    }
+  }
+
+  if (max <= (127.0f * 0.9765625f)) {
+    val->weight = LIS2DW12_LSb_977ug;
+    wgt = 0.9765625f;
+  }
+  else if (max <= (127.0f * 15.625f)) {
+    val->weight = LIS2DW12_LSb_15mg6;
+    wgt = 15.625f;
+  }
+  else {
+    return ret;
+  }
+
+  for (k = 0U; k < 3U; k++) {
+    d = val->bias_mg[k] / wgt;
+    d += (d < 0.0f) ? -0.5f : 0.5f;
+    val->offset[k] = (uint8_t)((int8_t)d);
+  }
+
+  ret = lis2dw12_write_reg(ctx, LIS2DW12_X_OFS_USR, val->offset, 3);
+  if (ret == 0) {
+    ctrl_reg7.usr_off_w = (uint8_t)val->weight;
+    ctrl_reg7.usr_off_on_out = PROPERTY_ENABLE;
+    ret = lis2dw12_write_reg(ctx, LIS2DW12_CTRL_REG7,
+                             (uint8_t*)&ctrl_reg7, 1);
+  }
+  if (ret == 0) {
+    val->done = PROPERTY_ENABLE;
+  }
+  return ret;
+}
+
 /**
   * @}
   *
@@ -694,6 +842,39 @@ int32_t lis2dw12_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff)
   return ret;
 }
 
+/**
+  * @brief  Data-ready flag and linear acceleration read in one burst
+  *         (STATUS .. OUT_Z_H): the polling loop needs one transaction
+  *         per sample instead of two. buff is written only when new
+  *         data is available.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  drdy     change the values of drdy in reg STATUS
+  * @param  buff     buffer that stores data read (6 bytes)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis2dw12_acceleration_drdy_raw_get(stmdev_ctx_t *ctx, uint8_t *drdy,
+                                           uint8_t *buff)
+{
+  lis2dw12_status_t status;
+  uint8_t reg[7];
+  uint8_t i;
+  int32_t ret;
+
+  ret = lis2dw12_read_reg(ctx, LIS2DW12_STATUS, reg, 7);
+  *((uint8_t*)&status) = reg[0];
+  *drdy = status.drdy;
+
+  if ( (ret == 0) && (*drdy == PROPERTY_ENABLE) ) {
+    for (i = 0U; i < 6U; i++) {
+      buff[i] = reg[i + 1U];
+    }
+  }
+
+  return ret;
+}
+
 /**
   * @}
   *
@@ -493,10 +493,25 @@ int32_t lis2dw12_offset_weight_set(stmdev_ctx_t *ctx,
 int32_t lis2dw12_offset_weight_get(stmdev_ctx_t *ctx,
                                       lis2dw12_usr_off_w_t *val);
 
+typedef struct {
+  float_t noise_mg;         /* input: max std deviation, 0 = no check */
+  float_t bias_mg[3];       /* estimated bias (with previous offset) */
+  uint8_t offset[3];        /* X/Y/Z_OFS_USR, two's complement */
+  lis2dw12_usr_off_w_t weight;
+  uint8_t gravity_axis;     /* 0: x, 1: y, 2: z */
+  uint8_t done;             /* 1: registers written */
+} lis2dw12_offset_cal_t;
+int32_t lis2dw12_offset_calibrate(stmdev_ctx_t *ctx, const int16_t *raw,
+                                  uint16_t num,
+                                  lis2dw12_offset_cal_t *val);
+
 int32_t lis2dw12_temperature_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t lis2dw12_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
+int32_t lis2dw12_acceleration_drdy_raw_get(stmdev_ctx_t *ctx, uint8_t *drdy,
+                                           uint8_t *buff);
+
 int32_t lis2dw12_device_id_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t lis2dw12_auto_increment_set(stmdev_ctx_t *ctx, uint8_t val);
@@ -162,13 +162,13 @@ void lis2dw12_read_data_polling(void)
   {
     uint8_t reg;
 
-    /* Read output only if new value is available */
-    lis2dw12_flag_data_ready_get(&dev_ctx, &reg);
+    /* Read data ready flag and acceleration data in one burst,
+     * data are updated only if new value is available
+     */
+    lis2dw12_acceleration_drdy_raw_get(&dev_ctx, &reg,
+                                       data_raw_acceleration.u8bit);
     if (reg)
     {
-      /* Read acceleration data */
-      memset(data_raw_acceleration.u8bit, 0x00, 3 * sizeof(int16_t));
-      lis2dw12_acceleration_raw_get(&dev_ctx, data_raw_acceleration.u8bit);
       //acceleration_mg[0] = lis2dw12_from_fs8_lp1_to_mg(data_raw_acceleration.i16bit[0]);
       //acceleration_mg[1] = lis2dw12_from_fs8_lp1_to_mg(data_raw_acceleration.i16bit[1]);
       //acceleration_mg[2] = lis2dw12_from_fs8_lp1_to_mg(data_raw_acceleration.i16bit[2]);
@@ -313,6 +313,9 @@ int32_t lis2mdl_mag_data_ovr_get(stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis2mdl_magnetic_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
+int32_t lis2mdl_magnetic_drdy_raw_get(stmdev_ctx_t *ctx, uint8_t *drdy,
+                                      uint8_t *buff);
+
 int32_t lis2mdl_temperature_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t lis2mdl_device_id_get(stmdev_ctx_t *ctx, uint8_t *buff);
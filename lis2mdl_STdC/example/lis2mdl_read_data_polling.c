@@ -170,13 +170,12 @@ void lis2mdl_read_data_simple(void)
   {
     uint8_t reg;
 
-    /* Read output only if new value is available */
-    lis2mdl_mag_data_ready_get(&dev_ctx, &reg);
+    /* Read data ready flag and magnetic field data in one burst,
+     * data are updated only if new value is available
+     */
+    lis2mdl_magnetic_drdy_raw_get(&dev_ctx, &reg, data_raw_magnetic.u8bit);
     if (reg)
     {
-      /* Read magnetic field data */
-      memset(data_raw_magnetic.u8bit, 0x00, 3 * sizeof(int16_t));
-      lis2mdl_magnetic_raw_get(&dev_ctx, data_raw_magnetic.u8bit);
       magnetic_mG[0] = lis2mdl_from_lsb_to_mgauss(data_raw_magnetic.i16bit[0]);
       magnetic_mG[1] = lis2mdl_from_lsb_to_mgauss(data_raw_magnetic.i16bit[1]);
       magnetic_mG[2] = lis2mdl_from_lsb_to_mgauss(data_raw_magnetic.i16bit[2]);
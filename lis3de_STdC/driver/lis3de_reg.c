@@ -743,6 +743,54 @@ int32_t lis3de_acceleration_raw_get(stmdev_ctx_t *ctx, int16_t *buff)
   return ret;
 }
 
+/**
+  * @brief  Acceleration output value, 8 bit data only[get]
+  *         One burst OUT_X .. OUT_Z (5 bytes), the registers between
+  *         the outputs are dropped: x, y, z packed in 3 bytes.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  buff     buffer that stores data read, x, y, z (3 bytes)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_acceleration_8bit_raw_get(stmdev_ctx_t *ctx, int8_t *buff)
+{
+  uint8_t reg[5];
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_OUT_X, reg, 5);
+  buff[0] = (int8_t)reg[0];
+  buff[1] = (int8_t)reg[2];
+  buff[2] = (int8_t)reg[4];
+
+  return ret;
+}
+
+/**
+  * @brief  Convert 8 bit samples to mg, integer only: one multiply by
+  *         the Q8 sensitivity of the full scale and a division by 256
+  *         (a shift) per value, no branch in the loop: vectorized by the
+  *         compiler on targets with SIMD (Cortex-M4 / M7 DSP, Neon, SSE).
+  *
+  * @param  fs       full scale
+  * @param  lsb      8 bit values, e.g. 3 * num packed samples
+  * @param  mg       converted values
+  * @param  len      number of values
+  *
+  */
+void lis3de_from_lsb8_to_mg(lis3de_fs_t fs, const int8_t *lsb, int16_t *mg,
+                            uint16_t len)
+{
+  /* 15.6, 31.2, 62.5, 187.5 mg / LSB in Q8 */
+  static const int32_t sens_q8[4] = { 3994, 7987, 16000, 48000 };
+  int32_t sens = sens_q8[(uint8_t)fs & 0x03U];
+  uint16_t i;
+
+  for (i = 0U; i < len; i++) {
+    mg[i] = (int16_t)(((int32_t)lsb[i] * sens) / 256);
+  }
+}
+
 /**
   * @}
   *
@@ -1787,6 +1835,41 @@ int32_t lis3de_fifo_fth_flag_get(stmdev_ctx_t *ctx, uint8_t *val)
 
   return ret;
 }
+
+/**
+  * @brief  FIFO samples, 8 bit data only, in one burst[get]
+  *         With FIFO enabled the read address rolls back from OUT_Z to
+  *         0x28: the burst from OUT_X of num * 6 - 1 bytes pops num
+  *         samples, the bytes between the outputs are dropped in place.
+  *         Read the number of samples with lis3de_fifo_data_level_get().
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  buff     buffer of num * 6 bytes, on return x, y, z of the
+  *                  num samples packed in the first num * 3 bytes
+  * @param  num      number of samples to read (max 32)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_8bit_raw_get(stmdev_ctx_t *ctx, int8_t *buff,
+                                 uint8_t num)
+{
+  uint8_t *reg = (uint8_t*)buff;
+  uint16_t len;
+  uint16_t i;
+  int32_t ret = 0;
+
+  if (num > 0U) {
+    len = ((uint16_t)num * 6U) - 1U;
+    ret = lis3de_read_reg(ctx, LIS3DE_OUT_X, reg, len);
+  }
+
+  /* forward copy: destination index never past the source one */
+  for (i = 0U; i < ((uint16_t)num * 3U); i++) {
+    buff[i] = (int8_t)reg[i * 2U];
+  }
+
+  return ret;
+}
 /**
   * @}
   *
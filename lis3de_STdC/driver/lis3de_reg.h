@@ -522,6 +522,11 @@ int32_t lis3de_xl_data_ovr_get(stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis3de_acceleration_raw_get(stmdev_ctx_t *ctx, int16_t *buff);
 
+int32_t lis3de_acceleration_8bit_raw_get(stmdev_ctx_t *ctx, int8_t *buff);
+
+void lis3de_from_lsb8_to_mg(lis3de_fs_t fs, const int8_t *lsb, int16_t *mg,
+                            uint16_t len);
+
 int32_t lis3de_device_id_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 typedef enum {
@@ -649,6 +654,9 @@ int32_t lis3de_fifo_ovr_flag_get(stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis3de_fifo_fth_flag_get(stmdev_ctx_t *ctx, uint8_t *val);
 
+int32_t lis3de_fifo_8bit_raw_get(stmdev_ctx_t *ctx, int8_t *buff,
+                                 uint8_t num);
+
 int32_t lis3de_tap_conf_set(stmdev_ctx_t *ctx, lis3de_click_cfg_t *val);
 int32_t lis3de_tap_conf_get(stmdev_ctx_t *ctx, lis3de_click_cfg_t *val);
 
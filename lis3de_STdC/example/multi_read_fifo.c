@@ -40,11 +40,6 @@
 #include "gpio.h"
 #endif
 
-typedef union{
-  int16_t i16bit[3];
-  uint8_t u8bit[6];
-} axis3bit16_t;
-
 /* Private macro -------------------------------------------------------------*/
 #ifdef MKI109V2
 #define CS_SPI2_GPIO_Port   CS_DEV_GPIO_Port
@@ -70,12 +65,15 @@ typedef union{
 /* Define FIFO watermark to 10 samples */
 #define FIFO_WATERMARK		10
 
+/* Define FIFO depth in samples */
+#define FIFO_DEPTH		32
+
 /* Private variables ---------------------------------------------------------*/
 
 static uint8_t tx_buffer[TX_BUF_DIM];
 
-static float acceleration_mg[3];
-static axis3bit16_t data_raw_acceleration;
+static int16_t acceleration_mg[FIFO_DEPTH * 3];
+static int8_t data_raw_acceleration[FIFO_DEPTH * OUT_XYZ_SIZE];
 static stmdev_ctx_t dev_ctx;
 
 /* Extern variables ----------------------------------------------------------*/
@@ -218,6 +216,7 @@ void example_lis3de_fifo(void)
   {
 	uint8_t flags;
 	uint8_t num = 0;
+	uint8_t i;
 
 	/* Check if FIFO level over threshold. */
 	lis3de_fifo_fth_flag_get(&dev_ctx, &flags);
@@ -226,16 +225,16 @@ void example_lis3de_fifo(void)
 		/* Read number of sample in FIFO. */
 		lis3de_fifo_data_level_get(&dev_ctx, &num);
 
-		while (num-- > 0)
+		/* Read all the XL samples in one burst, 3 bytes each. */
+		lis3de_fifo_8bit_raw_get(&dev_ctx, data_raw_acceleration, num);
+		lis3de_from_lsb8_to_mg(LIS3DE_2g, data_raw_acceleration,
+		                       acceleration_mg, num * 3);
+
+		for (i = 0; i < num; i++)
 		{
-			/* Read XL samples. */
-			lis3de_acceleration_raw_get(&dev_ctx, data_raw_acceleration.i16bit);
-			acceleration_mg[0] = lis3de_from_fs2_to_mg(data_raw_acceleration.i16bit[0]);
-			acceleration_mg[1] = lis3de_from_fs2_to_mg(data_raw_acceleration.i16bit[1]);
-			acceleration_mg[2] = lis3de_from_fs2_to_mg(data_raw_acceleration.i16bit[2]);
-
-			sprintf((char*)tx_buffer, "Acceleration [mg]:%4.2f\t%4.2f\t%4.2f\r\n",
-			   		acceleration_mg[0], acceleration_mg[1], acceleration_mg[2]);
+			sprintf((char*)tx_buffer, "Acceleration [mg]:%d\t%d\t%d\r\n",
+				acceleration_mg[i * 3], acceleration_mg[(i * 3) + 1],
+				acceleration_mg[(i * 3) + 2]);
 			tx_com( tx_buffer, strlen( (char const*)tx_buffer ) );
 		}
 	}
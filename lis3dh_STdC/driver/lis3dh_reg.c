@@ -809,6 +809,38 @@ int32_t lis3dh_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff)
   ret = lis3dh_read_reg(ctx, LIS3DH_OUT_X_L, buff, 6);
   return ret;
 }
+/**
+  * @brief  Acceleration data available flag and output value read in
+  *         one burst (STATUS_REG .. OUT_Z_H): the polling loop needs one
+  *         transaction per sample instead of two. buff is written only
+  *         when new data is available.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  drdy     change the values of zyxda in reg STATUS_REG
+  * @param  buff     buffer that stores data read (6 bytes)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_acceleration_drdy_raw_get(stmdev_ctx_t *ctx, uint8_t *drdy,
+                                         uint8_t *buff)
+{
+  lis3dh_status_reg_t status_reg;
+  uint8_t reg[7];
+  uint8_t i;
+  int32_t ret;
+
+  ret = lis3dh_read_reg(ctx, LIS3DH_STATUS_REG, reg, 7);
+  *((uint8_t*)&status_reg) = reg[0];
+  *drdy = status_reg.zyxda;
+
+  if ( (ret == 0) && (*drdy == PROPERTY_ENABLE) ) {
+    for (i = 0U; i < 6U; i++) {
+      buff[i] = reg[i + 1U];
+    }
+  }
+
+  return ret;
+}
 /**
   * @}
   *
@@ -547,6 +547,9 @@ int32_t lis3dh_xl_data_ovr_get(stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis3dh_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
+int32_t lis3dh_acceleration_drdy_raw_get(stmdev_ctx_t *ctx, uint8_t *drdy,
+                                         uint8_t *buff);
+
 int32_t lis3dh_device_id_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 typedef enum {
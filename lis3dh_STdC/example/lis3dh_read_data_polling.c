@@ -153,12 +153,12 @@ void lis3dh_read_data_polling(void)
   while(1) {
     lis3dh_reg_t reg;
 
-    /* Read output only if new value available */
-    lis3dh_xl_data_ready_get(&dev_ctx, &reg.byte);
+    /* Read data ready flag and accelerometer data in one burst,
+     * data are updated only if new value is available
+     */
+    lis3dh_acceleration_drdy_raw_get(&dev_ctx, &reg.byte,
+                                     data_raw_acceleration.u8bit);
     if (reg.byte) {
-      /* Read accelerometer data */
-      memset(data_raw_acceleration.u8bit, 0x00, 3*sizeof(int16_t));
-      lis3dh_acceleration_raw_get(&dev_ctx, data_raw_acceleration.u8bit);
       acceleration_mg[0] =
         lis3dh_from_fs2_hr_to_mg(data_raw_acceleration.i16bit[0]);
       acceleration_mg[1] =
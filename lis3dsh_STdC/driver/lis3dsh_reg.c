@@ -91,6 +91,45 @@ static void bytecpy(uint8_t *target, uint8_t *source)
   }
 }
 
+static void data_conv(lis3dsh_md_t *md, uint8_t *temp, uint8_t *xl,
+                      lis3dsh_data_t *data)
+{
+  uint8_t i;
+  uint8_t j;
+
+  /* temperature conversion */
+  data->heat.raw = (int8_t)*temp;
+  data->heat.deg_c = lis3dsh_from_lsb_to_celsius(data->heat.raw);
+
+  /* acceleration conversion */
+  j = 0U;
+  for (i = 0U; i < 3U; i++) {
+    data->xl.raw[i] = (int16_t)xl[j+1U];
+    data->xl.raw[i] = (data->xl.raw[i] * 256) + (int16_t) xl[j];
+    j+=2U;
+    switch ( md->fs ) {
+      case LIS3DSH_2g:
+        data->xl.mg[i] =lis3dsh_from_fs2_to_mg(data->xl.raw[i]);
+        break;
+      case LIS3DSH_4g:
+        data->xl.mg[i] =lis3dsh_from_fs4_to_mg(data->xl.raw[i]);
+        break;
+      case LIS3DSH_6g:
+        data->xl.mg[i] =lis3dsh_from_fs6_to_mg(data->xl.raw[i]);
+        break;
+      case LIS3DSH_8g:
+        data->xl.mg[i] =lis3dsh_from_fs8_to_mg(data->xl.raw[i]);
+        break;
+      case LIS3DSH_16g:
+        data->xl.mg[i] =lis3dsh_from_fs16_to_mg(data->xl.raw[i]);
+        break;
+      default:
+        data->xl.mg[i] = 0.0f;
+        break;
+    }
+  }
+}
+
 /**
   * @}
   *
@@ -666,50 +705,48 @@ int32_t lis3dsh_data_get(stmdev_ctx_t *ctx, lis3dsh_md_t *md,
                          lis3dsh_data_t *data)
 {
   uint8_t buff[6];
+  uint8_t temp;
   int32_t ret;
-  uint8_t i;
-  uint8_t j;
-  
-  ret = lis3dsh_read_reg(ctx, LIS3DSH_OUT_T, (uint8_t*)&data->heat.raw, 1);
+
+  ret = lis3dsh_read_reg(ctx, LIS3DSH_OUT_T, &temp, 1);
   if (ret == 0) {
     ret = lis3dsh_read_reg(ctx, LIS3DSH_OUT_X_L, (uint8_t*)&buff, 6);
   }
-  
 
-  /* temperature conversion */
-  data->heat.deg_c = lis3dsh_from_lsb_to_celsius(data->heat.raw);
-
-  /* acceleration conversion */
-  j = 0U;
-  for (i = 0U; i < 3U; i++) {
-    data->xl.raw[i] = (int16_t)buff[j+1U];
-    data->xl.raw[i] = (data->xl.raw[i] * 256) + (int16_t) buff[j];
-    j+=2U;
-    switch ( md->fs ) {
-      case LIS3DSH_2g:
-        data->xl.mg[i] =lis3dsh_from_fs2_to_mg(data->xl.raw[i]);
-        break;
-      case LIS3DSH_4g:
-        data->xl.mg[i] =lis3dsh_from_fs4_to_mg(data->xl.raw[i]);
-        break;
-      case LIS3DSH_6g:
-        data->xl.mg[i] =lis3dsh_from_fs6_to_mg(data->xl.raw[i]);
-        break;
-      case LIS3DSH_8g:
-        data->xl.mg[i] =lis3dsh_from_fs8_to_mg(data->xl.raw[i]);
-        break;
-      case LIS3DSH_16g:
-        data->xl.mg[i] =lis3dsh_from_fs16_to_mg(data->xl.raw[i]);
-        break;
-      default:
-        data->xl.mg[i] = 0.0f;
-        break;
-    }
-  }
+  data_conv(md, &temp, buff, data);
 
   return ret;
 }
 
+/**
+  * @brief  Read data in engineering unit with a single bus
+  *         transaction.[get]
+  *         Registers from OUT_T to OUT_Z_H are read in one burst
+  *         (34 bytes), so temperature and acceleration come from the
+  *         same access: one transaction instead of two, useful when
+  *         the transaction setup dominates (e.g. SPI with driver
+  *         calls per transaction); on I2C lis3dsh_data_get() moves
+  *         fewer bytes.
+  *         Register address auto increment must be enabled
+  *         (lis3dsh_init_set(LIS3DSH_DRV_RDY)).
+  *
+  * @param  ctx     communication interface handler.(ptr)
+  * @param  md      the sensor conversion parameters.(ptr)
+  * @param  data    data read.(ptr)
+  *
+  */
+int32_t lis3dsh_data_burst_get(stmdev_ctx_t *ctx, lis3dsh_md_t *md,
+                               lis3dsh_data_t *data)
+{
+  uint8_t buff[LIS3DSH_OUT_Z_H - LIS3DSH_OUT_T + 1U];
+  int32_t ret;
+
+  ret = lis3dsh_read_reg(ctx, LIS3DSH_OUT_T, buff, (uint16_t)sizeof(buff));
+
+  data_conv(md, &buff[0], &buff[LIS3DSH_OUT_X_L - LIS3DSH_OUT_T], data);
+
+  return ret;
+}
 
 /**
   * @}
@@ -769,6 +806,465 @@ int32_t lis3dsh_self_test_get(stmdev_ctx_t *ctx, lis3dsh_st_t *val)
   return ret;
 }
 
+/**
+  * @defgroup  FIFO
+  * @brief     This section groups all the functions concerning the
+  *            FIFO usage.
+  * @{
+  *
+  */
+
+/**
+  * @brief  FIFO mode and threshold selection.[set]
+  *         The FIFO is enabled for every mode but bypass, the threshold
+  *         (watermark) flag is enabled when watermark is not 0.
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  val          FIFO mode and threshold.(ptr)
+  *
+  */
+int32_t lis3dsh_fifo_mode_set(stmdev_ctx_t *ctx, lis3dsh_fifo_md_t *val)
+{
+  lis3dsh_fifo_ctrl_t fifo_ctrl;
+  lis3dsh_ctrl_reg6_t ctrl_reg6;
+  int32_t ret;
+
+  ret = lis3dsh_read_reg(ctx, LIS3DSH_CTRL_REG6, (uint8_t*)&ctrl_reg6, 1);
+  if (ret == 0) {
+    ret = lis3dsh_read_reg(ctx, LIS3DSH_FIFO_CTRL, (uint8_t*)&fifo_ctrl, 1);
+  }
+
+  if (ret == 0) {
+    fifo_ctrl.fmode = (uint8_t)val->mode;
+    fifo_ctrl.wtmp = val->watermark;
+    ret = lis3dsh_write_reg(ctx, LIS3DSH_FIFO_CTRL, (uint8_t*)&fifo_ctrl, 1);
+  }
+  if (ret == 0) {
+    if (val->mode != LIS3DSH_BYPASS_MODE) {
+      ctrl_reg6.fifo_en = PROPERTY_ENABLE;
+    }
+    else {
+      ctrl_reg6.fifo_en = PROPERTY_DISABLE;
+    }
+    if (val->watermark != 0U) {
+      ctrl_reg6.wtm_en = PROPERTY_ENABLE;
+    }
+    else {
+      ctrl_reg6.wtm_en = PROPERTY_DISABLE;
+    }
+    ret = lis3dsh_write_reg(ctx, LIS3DSH_CTRL_REG6, (uint8_t*)&ctrl_reg6, 1);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO mode and threshold selection.[get]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  val          FIFO mode and threshold.(ptr)
+  *
+  */
+int32_t lis3dsh_fifo_mode_get(stmdev_ctx_t *ctx, lis3dsh_fifo_md_t *val)
+{
+  lis3dsh_fifo_ctrl_t fifo_ctrl;
+  lis3dsh_ctrl_reg6_t ctrl_reg6;
+  int32_t ret;
+
+  ret = lis3dsh_read_reg(ctx, LIS3DSH_CTRL_REG6, (uint8_t*)&ctrl_reg6, 1);
+  if (ret == 0) {
+    ret = lis3dsh_read_reg(ctx, LIS3DSH_FIFO_CTRL, (uint8_t*)&fifo_ctrl, 1);
+  }
+
+  if (ctrl_reg6.fifo_en == PROPERTY_DISABLE) {
+    val->mode = LIS3DSH_BYPASS_MODE;
+  }
+  else {
+    switch (fifo_ctrl.fmode) {
+      case LIS3DSH_FIFO_MODE:
+        val->mode = LIS3DSH_FIFO_MODE;
+        break;
+      case LIS3DSH_STREAM_MODE:
+        val->mode = LIS3DSH_STREAM_MODE;
+        break;
+      case LIS3DSH_STREAM_TO_FIFO_MODE:
+        val->mode = LIS3DSH_STREAM_TO_FIFO_MODE;
+        break;
+      case LIS3DSH_BYPASS_TO_STREAM_MODE:
+        val->mode = LIS3DSH_BYPASS_TO_STREAM_MODE;
+        break;
+      case LIS3DSH_BYPASS_TO_FIFO_MODE:
+        val->mode = LIS3DSH_BYPASS_TO_FIFO_MODE;
+        break;
+      default:
+        val->mode = LIS3DSH_BYPASS_MODE;
+        break;
+    }
+  }
+
+  if (ctrl_reg6.wtm_en == PROPERTY_ENABLE) {
+    val->watermark = fifo_ctrl.wtmp;
+  }
+  else {
+    val->watermark = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO level and flags.[get]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  val          FIFO level and flags.(ptr)
+  *
+  */
+int32_t lis3dsh_fifo_status_get(stmdev_ctx_t *ctx,
+                                lis3dsh_fifo_status_t *val)
+{
+  lis3dsh_fifo_src_t fifo_src;
+  int32_t ret;
+
+  ret = lis3dsh_read_reg(ctx, LIS3DSH_FIFO_SRC, (uint8_t*)&fifo_src, 1);
+
+  val->level = fifo_src.fss;
+  val->empty = fifo_src.empty;
+  val->ovr   = fifo_src.ovrn_fifo;
+  val->wtm   = fifo_src.wtm;
+
+  return ret;
+}
+
+/**
+  * @brief  Drain the FIFO: read the unread samples (up to max) in one
+  *         bus transaction.[get]
+  *         With the FIFO enabled the register address rolls back from
+  *         OUT_Z_H to OUT_X_L, so the samples are read as a single
+  *         burst starting at OUT_X_L. Register address auto increment
+  *         must be enabled (lis3dsh_init_set(LIS3DSH_DRV_RDY)).
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  raw          buffer of max samples, raw X, Y, Z.(ptr)
+  * @param  max          number of samples the buffer can hold.
+  * @param  num          number of samples read.(ptr)
+  *
+  */
+int32_t lis3dsh_fifo_data_get(stmdev_ctx_t *ctx, int16_t *raw, uint8_t max,
+                              uint8_t *num)
+{
+  lis3dsh_fifo_src_t fifo_src;
+  uint8_t *buff = (uint8_t*)raw;
+  uint16_t i;
+  int32_t ret;
+
+  *num = 0U;
+
+  ret = lis3dsh_read_reg(ctx, LIS3DSH_FIFO_SRC, (uint8_t*)&fifo_src, 1);
+  if ( (ret == 0) && (fifo_src.empty == PROPERTY_DISABLE) ) {
+    *num = (fifo_src.fss < max) ? fifo_src.fss : max;
+  }
+
+  if ( (ret == 0) && (*num > 0U) ) {
+    ret = lis3dsh_read_reg(ctx, LIS3DSH_OUT_X_L, buff, (uint16_t)*num * 6U);
+  }
+
+  /* little endian bytes to int16_t, in place */
+  for (i = 0U; i < ((uint16_t)*num * 3U); i++) {
+    raw[i] = (int16_t)(((uint16_t)buff[(2U * i) + 1U] << 8) |
+                       (uint16_t)buff[2U * i]);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  State_machines
+  * @brief     This section groups all the functions concerning the
+  *            programmable state machines SM1 and SM2.
+  *            Program and parameters are loaded with burst writes
+  *            (register address auto increment must be enabled, see
+  *            lis3dsh_init_set(LIS3DSH_DRV_RDY)), with the state machine
+  *            disabled.
+  * @{
+  *
+  */
+
+/**
+  * @brief  State machine enable.[set]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  sm           state machine.
+  * @param  val          change the values of smx_en in CTRL_REGx.
+  *
+  */
+int32_t lis3dsh_sm_enable_set(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                              uint8_t val)
+{
+  lis3dsh_ctrl_reg1_t ctrl_reg1;
+  uint8_t reg;
+  int32_t ret;
+
+  /* CTRL_REG1 and CTRL_REG2 share the same layout */
+  reg = (sm == LIS3DSH_SM1) ? LIS3DSH_CTRL_REG1 : LIS3DSH_CTRL_REG2;
+
+  ret = lis3dsh_read_reg(ctx, reg, (uint8_t*)&ctrl_reg1, 1);
+  if (ret == 0) {
+    ctrl_reg1.sm1_en = val;
+    ret = lis3dsh_write_reg(ctx, reg, (uint8_t*)&ctrl_reg1, 1);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  State machine enable.[get]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  sm           state machine.
+  * @param  val          get the values of smx_en in CTRL_REGx.(ptr)
+  *
+  */
+int32_t lis3dsh_sm_enable_get(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                              uint8_t *val)
+{
+  lis3dsh_ctrl_reg1_t ctrl_reg1;
+  uint8_t reg;
+  int32_t ret;
+
+  reg = (sm == LIS3DSH_SM1) ? LIS3DSH_CTRL_REG1 : LIS3DSH_CTRL_REG2;
+
+  ret = lis3dsh_read_reg(ctx, reg, (uint8_t*)&ctrl_reg1, 1);
+  *val = ctrl_reg1.sm1_en;
+
+  return ret;
+}
+
+/**
+  * @brief  State machine program (ST0_x .. ST15_x), one burst
+  *         write.[set]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  sm           state machine.
+  * @param  prg          program steps.(ptr)
+  * @param  len          number of steps (up to LIS3DSH_SM_PRG_MAX).
+  *
+  */
+int32_t lis3dsh_sm_program_set(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                               uint8_t *prg, uint8_t len)
+{
+  uint8_t reg;
+  int32_t ret;
+
+  if (len > LIS3DSH_SM_PRG_MAX) {
+    len = LIS3DSH_SM_PRG_MAX;
+  }
+
+  reg = (sm == LIS3DSH_SM1) ? LIS3DSH_ST0_1 : LIS3DSH_ST0_2;
+  ret = lis3dsh_write_reg(ctx, reg, prg, len);
+
+  return ret;
+}
+
+/**
+  * @brief  State machine program (ST0_x .. ST15_x), one burst
+  *         read.[get]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  sm           state machine.
+  * @param  prg          program steps.(ptr)
+  * @param  len          number of steps (up to LIS3DSH_SM_PRG_MAX).
+  *
+  */
+int32_t lis3dsh_sm_program_get(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                               uint8_t *prg, uint8_t len)
+{
+  uint8_t reg;
+  int32_t ret;
+
+  if (len > LIS3DSH_SM_PRG_MAX) {
+    len = LIS3DSH_SM_PRG_MAX;
+  }
+
+  reg = (sm == LIS3DSH_SM1) ? LIS3DSH_ST0_1 : LIS3DSH_ST0_2;
+  ret = lis3dsh_read_reg(ctx, reg, prg, len);
+
+  return ret;
+}
+
+/**
+  * @brief  State machine parameters: timers, thresholds, decimation
+  *         (SM2 only), masks and settings.[set]
+  *         SM2 registers TIM4_2 .. SETT2 are written in one burst, SM1
+  *         in two (the address of DES is reserved for SM1).
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  sm           state machine.
+  * @param  val          state machine parameters.(ptr)
+  *
+  */
+int32_t lis3dsh_sm_param_set(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                             lis3dsh_sm_param_t *val)
+{
+  uint8_t buff[12];
+  int32_t ret;
+
+  buff[0]  = val->tim4;
+  buff[1]  = val->tim3;
+  buff[2]  = (uint8_t)(val->tim2 & 0xFFU);
+  buff[3]  = (uint8_t)(val->tim2 >> 8);
+  buff[4]  = (uint8_t)(val->tim1 & 0xFFU);
+  buff[5]  = (uint8_t)(val->tim1 >> 8);
+  buff[6]  = val->thrs2;
+  buff[7]  = val->thrs1;
+  buff[8]  = val->des;
+  buff[9]  = val->mask_b;
+  buff[10] = val->mask_a;
+  buff[11] = val->sett;
+
+  if (sm == LIS3DSH_SM1) {
+    ret = lis3dsh_write_reg(ctx, LIS3DSH_TIM4_1, &buff[0], 8);
+    if (ret == 0) {
+      ret = lis3dsh_write_reg(ctx, LIS3DSH_MASK1_B, &buff[9], 3);
+    }
+  }
+  else {
+    ret = lis3dsh_write_reg(ctx, LIS3DSH_TIM4_2, &buff[0], 12);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  State machine parameters: timers, thresholds, decimation
+  *         (SM2 only), masks and settings.[get]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  sm           state machine.
+  * @param  val          state machine parameters.(ptr)
+  *
+  */
+int32_t lis3dsh_sm_param_get(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                             lis3dsh_sm_param_t *val)
+{
+  uint8_t buff[12];
+  int32_t ret;
+
+  if (sm == LIS3DSH_SM1) {
+    buff[8] = 0U;
+    ret = lis3dsh_read_reg(ctx, LIS3DSH_TIM4_1, &buff[0], 8);
+    if (ret == 0) {
+      ret = lis3dsh_read_reg(ctx, LIS3DSH_MASK1_B, &buff[9], 3);
+    }
+  }
+  else {
+    ret = lis3dsh_read_reg(ctx, LIS3DSH_TIM4_2, &buff[0], 12);
+  }
+
+  val->tim4   = buff[0];
+  val->tim3   = buff[1];
+  val->tim2   = ((uint16_t)buff[3] << 8) | buff[2];
+  val->tim1   = ((uint16_t)buff[5] << 8) | buff[4];
+  val->thrs2  = buff[6];
+  val->thrs1  = buff[7];
+  val->des    = buff[8];
+  val->mask_b = buff[9];
+  val->mask_a = buff[10];
+  val->sett   = buff[11];
+
+  return ret;
+}
+
+/**
+  * @brief  Parameters shared by the state machines: vector filter
+  *         coefficients, threshold 3 and long counter.[set]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  val          shared parameters.(ptr)
+  *
+  */
+int32_t lis3dsh_sm_shared_param_set(stmdev_ctx_t *ctx,
+                                    lis3dsh_sm_shared_param_t *val)
+{
+  uint8_t buff[5];
+  int32_t ret;
+
+  buff[0] = val->vfc[0];
+  buff[1] = val->vfc[1];
+  buff[2] = val->vfc[2];
+  buff[3] = val->vfc[3];
+  buff[4] = val->thrs3;
+  ret = lis3dsh_write_reg(ctx, LIS3DSH_VFC_1, buff, 5);
+
+  if (ret == 0) {
+    buff[0] = (uint8_t)(val->lc & 0xFFU);
+    buff[1] = (uint8_t)(val->lc >> 8);
+    ret = lis3dsh_write_reg(ctx, LIS3DSH_LC_L, buff, 2);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Parameters shared by the state machines: vector filter
+  *         coefficients, threshold 3 and long counter.[get]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  val          shared parameters.(ptr)
+  *
+  */
+int32_t lis3dsh_sm_shared_param_get(stmdev_ctx_t *ctx,
+                                    lis3dsh_sm_shared_param_t *val)
+{
+  uint8_t buff[5];
+  int32_t ret;
+
+  ret = lis3dsh_read_reg(ctx, LIS3DSH_VFC_1, buff, 5);
+  val->vfc[0] = buff[0];
+  val->vfc[1] = buff[1];
+  val->vfc[2] = buff[2];
+  val->vfc[3] = buff[3];
+  val->thrs3  = buff[4];
+
+  if (ret == 0) {
+    ret = lis3dsh_read_reg(ctx, LIS3DSH_LC_L, buff, 2);
+    val->lc = ((uint16_t)buff[1] << 8) | buff[0];
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  State machine output: axis and sign that triggered the
+  *         interrupt. Reading it resets the state machine interrupt
+  *         signal.[get]
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  sm           state machine.
+  * @param  val          OUTSx register.(ptr)
+  *
+  */
+int32_t lis3dsh_sm_out_get(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                           lis3dsh_sm_out_t *val)
+{
+  uint8_t reg;
+  int32_t ret;
+
+  reg = (sm == LIS3DSH_SM1) ? LIS3DSH_OUTS1 : LIS3DSH_OUTS2;
+  ret = lis3dsh_read_reg(ctx, reg, (uint8_t*)val, 1);
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
 /**
   * @}
   *
@@ -592,6 +592,8 @@ typedef struct {
 } lis3dsh_data_t;
 int32_t lis3dsh_data_get(stmdev_ctx_t *ctx, lis3dsh_md_t *md,
                          lis3dsh_data_t *data);
+int32_t lis3dsh_data_burst_get(stmdev_ctx_t *ctx, lis3dsh_md_t *md,
+                               lis3dsh_data_t *data);
 
 typedef enum {
   LIS3DSH_ST_DISABLE   = 0,
@@ -601,6 +603,87 @@ typedef enum {
 int32_t lis3dsh_self_test_set(stmdev_ctx_t *ctx, lis3dsh_st_t val);
 int32_t lis3dsh_self_test_get(stmdev_ctx_t *ctx, lis3dsh_st_t *val);
 
+typedef struct {
+  enum {
+    LIS3DSH_BYPASS_MODE           = 0x00,
+    LIS3DSH_FIFO_MODE             = 0x01,
+    LIS3DSH_STREAM_MODE           = 0x02,
+    LIS3DSH_STREAM_TO_FIFO_MODE   = 0x03,
+    LIS3DSH_BYPASS_TO_STREAM_MODE = 0x04,
+    LIS3DSH_BYPASS_TO_FIFO_MODE   = 0x07,
+  } mode;
+  uint8_t watermark; /* FIFO threshold level (0..31), 0 = disabled */
+} lis3dsh_fifo_md_t;
+int32_t lis3dsh_fifo_mode_set(stmdev_ctx_t *ctx, lis3dsh_fifo_md_t *val);
+int32_t lis3dsh_fifo_mode_get(stmdev_ctx_t *ctx, lis3dsh_fifo_md_t *val);
+
+typedef struct {
+  uint8_t level            : 5; /* unread samples (31 also when full) */
+  uint8_t empty            : 1; /* FIFO empty */
+  uint8_t ovr              : 1; /* FIFO full, samples overwritten */
+  uint8_t wtm              : 1; /* FIFO threshold reached */
+} lis3dsh_fifo_status_t;
+int32_t lis3dsh_fifo_status_get(stmdev_ctx_t *ctx,
+                                lis3dsh_fifo_status_t *val);
+
+int32_t lis3dsh_fifo_data_get(stmdev_ctx_t *ctx, int16_t *raw, uint8_t max,
+                              uint8_t *num);
+
+typedef enum {
+  LIS3DSH_SM1 = 0,
+  LIS3DSH_SM2 = 1,
+} lis3dsh_sm_t;
+int32_t lis3dsh_sm_enable_set(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                              uint8_t val);
+int32_t lis3dsh_sm_enable_get(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                              uint8_t *val);
+
+#define LIS3DSH_SM_PRG_MAX   16U /* program steps ST0_x .. ST15_x */
+int32_t lis3dsh_sm_program_set(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                               uint8_t *prg, uint8_t len);
+int32_t lis3dsh_sm_program_get(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                               uint8_t *prg, uint8_t len);
+
+typedef struct {
+  uint8_t tim4;     /* timer 4, 8 bit */
+  uint8_t tim3;     /* timer 3, 8 bit */
+  uint16_t tim2;    /* timer 2, 16 bit */
+  uint16_t tim1;    /* timer 1, 16 bit */
+  uint8_t thrs2;    /* threshold 2 */
+  uint8_t thrs1;    /* threshold 1 */
+  uint8_t des;      /* decimation counter, SM2 only */
+  uint8_t mask_b;   /* axis and sign mask B (MASKx_B) */
+  uint8_t mask_a;   /* axis and sign mask A (MASKx_A) */
+  uint8_t sett;     /* settings (SETTx) */
+} lis3dsh_sm_param_t;
+int32_t lis3dsh_sm_param_set(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                             lis3dsh_sm_param_t *val);
+int32_t lis3dsh_sm_param_get(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                             lis3dsh_sm_param_t *val);
+
+typedef struct {
+  uint8_t vfc[4];   /* vector filter coefficients */
+  uint8_t thrs3;    /* threshold 3 */
+  uint16_t lc;      /* long counter */
+} lis3dsh_sm_shared_param_t;
+int32_t lis3dsh_sm_shared_param_set(stmdev_ctx_t *ctx,
+                                    lis3dsh_sm_shared_param_t *val);
+int32_t lis3dsh_sm_shared_param_get(stmdev_ctx_t *ctx,
+                                    lis3dsh_sm_shared_param_t *val);
+
+typedef struct {
+  uint8_t n_v              : 1;
+  uint8_t p_v              : 1;
+  uint8_t n_z              : 1;
+  uint8_t p_z              : 1;
+  uint8_t n_y              : 1;
+  uint8_t p_y              : 1;
+  uint8_t n_x              : 1;
+  uint8_t p_x              : 1;
+} lis3dsh_sm_out_t;
+int32_t lis3dsh_sm_out_get(stmdev_ctx_t *ctx, lis3dsh_sm_t sm,
+                           lis3dsh_sm_out_t *val);
+
 /**
   * @}
   *
@@ -80,8 +80,7 @@
 
 
 /* Private typedef -----------------------------------------------------------*/
-typedef union {
-  uint8_t u8[6];
+typedef struct {
   int16_t i16[3];
 } fifo_data_t;
 
@@ -119,9 +118,10 @@ void lis3dsh_fifo_stream(void)
   lis3dsh_status_var_t status;
   lis3dsh_int_mode_t int_mode;
   stmdev_ctx_t dev_ctx;
-  lis3dsh_reg_t reg;
+  lis3dsh_fifo_md_t fifo_md;
   lis3dsh_id_t id;
   lis3dsh_md_t md;
+  uint8_t num;
   uint8_t i;
 
   /* Initialize mems driver interface */
@@ -154,12 +154,9 @@ void lis3dsh_fifo_stream(void)
   lis3dsh_bus_mode_set(&dev_ctx, &bus_mode);
 
   /* FIFO configuration */
-  lis3dsh_read_reg(&dev_ctx, LIS3DSH_FIFO_CTRL, &reg.byte,1);
-  reg.fifo_ctrl.fmode = 0x02; /* FIFO stream mode */
-  lis3dsh_write_reg(&dev_ctx, LIS3DSH_FIFO_CTRL, &reg.byte,1);
-  lis3dsh_read_reg(&dev_ctx, LIS3DSH_CTRL_REG6, &reg.byte,1);
-  reg.ctrl_reg6.fifo_en = PROPERTY_ENABLE;
-  lis3dsh_write_reg(&dev_ctx, LIS3DSH_CTRL_REG6, &reg.byte,1);
+  fifo_md.mode = LIS3DSH_STREAM_MODE;
+  fifo_md.watermark = 0;
+  lis3dsh_fifo_mode_set(&dev_ctx, &fifo_md);
 
   /* Configure interrupt pins */
   lis3dsh_interrupt_mode_get(&dev_ctx, &int_mode);
@@ -182,12 +179,11 @@ void lis3dsh_fifo_stream(void)
     lis3dsh_all_sources_get(&dev_ctx, &all_sources);
     if ( all_sources.fifo_full ) {
 
-      lis3dsh_read_reg(&dev_ctx, LIS3DSH_FIFO_SRC, &reg.byte,1);
-      lis3dsh_read_reg(&dev_ctx, LIS3DSH_OUT_X_L, &fifo_data[0].u8[0],
-                       reg.fifo_src.fss*6);
-      
+      /* Drain the FIFO in one burst */
+      lis3dsh_fifo_data_get(&dev_ctx, &fifo_data[0].i16[0], 32, &num);
+
       /* print sensor data  */
-      for (i = 0; i < reg.fifo_src.fss; i++) {
+      for (i = 0; i < num; i++) {
         sprintf((char*)tx_buffer, "Acceleration [mg]:%4.2f\t%4.2f\t%4.2f\r\n",
                 lis3dsh_from_fs4_to_mg(fifo_data[i].i16[0]),
                 lis3dsh_from_fs4_to_mg(fifo_data[i].i16[1]),
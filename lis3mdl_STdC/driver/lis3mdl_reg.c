@@ -614,6 +614,92 @@ int32_t lis3mdl_magnetic_raw_get(stmdev_ctx_t *ctx, uint8_t *buff)
   ret = lis3mdl_read_reg(ctx, LIS3MDL_OUT_X_L, (uint8_t*) buff, 6);
   return ret;
 }
+
+/**
+  * @brief  Magnetic output value, high part only[get]
+  *         With fast_read enabled the burst read from OUT_X_H returns
+  *         OUT_X_H, OUT_Y_H, OUT_Z_H: 3 bytes per sample instead of 6.
+  *         Each byte is signed: cast it to int8_t and multiply by
+  *         lis3mdl_fast_read_scale_get() to get gauss.
+  *
+  * @param  ctx      read / write interface definitions(ptr)
+  * @param  buff     buffer that stores data read, x, y, z (3 bytes)(ptr)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3mdl_magnetic_msb_raw_get(stmdev_ctx_t *ctx, uint8_t *buff)
+{
+  int32_t ret;
+  ret = lis3mdl_read_reg(ctx, LIS3MDL_OUT_X_H, buff, 3);
+  return ret;
+}
+
+/**
+  * @brief  Configure the 8 bit streaming: fast_read enabled, block data
+  *         update disabled (the low part is never read, the outputs
+  *         would not be updated), output data rate (e.g. the fast
+  *         rates LIS3MDL_LP_1kHz .. LIS3MDL_UHP_155Hz) and continuous
+  *         mode.[set]
+  *
+  * @param  ctx      read / write interface definitions(ptr)
+  * @param  val      change the values of om in reg CTRL_REG1
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3mdl_fast_read_stream_set(stmdev_ctx_t *ctx, lis3mdl_om_t val)
+{
+  lis3mdl_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  ret = lis3mdl_read_reg(ctx, LIS3MDL_CTRL_REG5, (uint8_t*)&ctrl_reg5, 1);
+  if(ret == 0)
+  {
+    ctrl_reg5.bdu = PROPERTY_DISABLE;
+    ctrl_reg5.fast_read = PROPERTY_ENABLE;
+    ret = lis3mdl_write_reg(ctx, LIS3MDL_CTRL_REG5, (uint8_t*)&ctrl_reg5, 1);
+  }
+  if(ret == 0)
+  {
+    ret = lis3mdl_data_rate_set(ctx, val);
+  }
+  if(ret == 0)
+  {
+    ret = lis3mdl_operating_mode_set(ctx, LIS3MDL_CONTINUOUS_MODE);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Gauss per LSB of the high part of the output (256 LSB of the
+  *         full output), to be computed once out of the read loop.
+  *
+  * @param  val      full scale
+  * @retval          sensitivity in gauss / LSB
+  *
+  */
+float lis3mdl_fast_read_scale_get(lis3mdl_fs_t val)
+{
+  float scale;
+
+  switch (val)
+  {
+    case LIS3MDL_8_GAUSS:
+      scale = 256.0f / 3421.0f;
+      break;
+    case LIS3MDL_12_GAUSS:
+      scale = 256.0f / 2281.0f;
+      break;
+    case LIS3MDL_16_GAUSS:
+      scale = 256.0f / 1711.0f;
+      break;
+    default:
+      scale = 256.0f / 6842.0f;
+      break;
+  }
+
+  return scale;
+}
 /**
   * @brief  Temperature output value[get]
   *
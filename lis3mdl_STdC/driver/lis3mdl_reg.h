@@ -368,6 +368,11 @@ int32_t lis3mdl_mag_data_ovr_get(stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis3mdl_magnetic_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
+int32_t lis3mdl_magnetic_msb_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
+
+int32_t lis3mdl_fast_read_stream_set(stmdev_ctx_t *ctx, lis3mdl_om_t val);
+float lis3mdl_fast_read_scale_get(lis3mdl_fs_t val);
+
 int32_t lis3mdl_temperature_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t lis3mdl_device_id_get(stmdev_ctx_t *ctx, uint8_t *buff);
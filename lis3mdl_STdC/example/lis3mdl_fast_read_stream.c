@@ -0,0 +1,329 @@
+/*
+ ******************************************************************************
+ * @file    lis3mdl_fast_read_stream.c
+ * @author  Sensors Software Solution Team
+ * @brief   This file shows how to stream the magnetic field at 1 kHz
+ *          reading only the high part of the outputs (FAST_READ).
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/*
+ * This example was developed using the following STMicroelectronics
+ * evaluation boards:
+ *
+ * - STEVAL_MKI109V3 + STEVAL-MKI137V1
+ * - NUCLEO_F411RE + X-NUCLEO-IKS01A1
+ *
+ * and STM32CubeMX tool with STM32CubeF4 MCU Package
+ *
+ * Used interfaces:
+ *
+ * STEVAL_MKI109V3    - Host side:   USB (Virtual COM)
+ *                    - Sensor side: SPI(Default) / I2C(supported)
+ *
+ * NUCLEO_STM32F411RE - Host side: UART(COM) to USB bridge
+ *                    - I2C(Default) / SPI(supported)
+ *
+ * If you need to run this example on a different hardware platform a
+ * modification of the functions: `platform_write`, `platform_read`,
+ * `platform_read_drdy_pin`, `tx_com` and 'platform_init' is required.
+ *
+ */
+
+/*
+ * The sensor runs at the fast data rate of 1 kHz with FAST_READ: a
+ * sample is one 3 byte burst of the high part of the outputs, started by
+ * the DRDY pin, with no status register read. On I2C at 400 kHz:
+ *
+ * - lis3mdl_mag_data_ready_get() + lis3mdl_magnetic_raw_get():
+ *   2 transactions, 13 bytes on the bus, about 300 us per sample;
+ * - lis3mdl_magnetic_msb_raw_get(): 1 transaction, 6 bytes on the bus,
+ *   about 140 us per sample.
+ *
+ * The resolution is 256 LSB of the full output (37 mG at 4 gauss full
+ * scale), enough to detect steps of the field: each sample is compared
+ * with a slow moving average and the anomalies over THRESHOLD_MG are
+ * reported.
+ */
+
+/* STMicroelectronics evaluation boards definition
+ *
+ * Please uncomment ONLY the evaluation boards in use.
+ * If a different hardware is used please comment all
+ * following target board and redefine yours.
+ */
+//#define STEVAL_MKI109V3
+#define NUCLEO_F411RE
+
+#if defined(STEVAL_MKI109V3)
+/* MKI109V3: Define communication interface */
+#define SENSOR_BUS hspi2
+
+/* MKI109V3: Vdd and Vddio power supply values */
+#define PWM_3V3 915
+
+#elif defined(NUCLEO_F411RE)
+/* NUCLEO_F411RE: Define communication interface */
+#define SENSOR_BUS hi2c1
+
+/* NUCLEO_F411RE: LIS3MDL DRDY pin, adapt to the board wiring */
+#define LIS3MDL_DRDY_PIN GPIO_PIN_0
+#define LIS3MDL_DRDY_GPIO_PORT GPIOC
+
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <stdio.h>
+#include "stm32f4xx_hal.h"
+#include "lis3mdl_reg.h"
+#include "gpio.h"
+#include "i2c.h"
+#if defined(STEVAL_MKI109V3)
+#include "usbd_cdc_if.h"
+#include "spi.h"
+#elif defined(NUCLEO_F411RE)
+#include "usart.h"
+#endif
+
+/* Private macro -------------------------------------------------------------*/
+#define BOOT_TIME        20        /* ms */
+#define THRESHOLD_MG     300.0f
+#define AVERAGE_WEIGHT   0.01f     /* moving average weight */
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t data_raw_magnetic[3];
+static float magnetic_mG[3];
+static float average_mG[3];
+static uint8_t whoamI, rst;
+static uint8_t tx_buffer[1000];
+
+/* Extern variables ----------------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+/*
+ *   WARNING:
+ *   Functions declare in this section are defined at the end of this file
+ *   and are strictly related to the hardware platform used.
+ *
+ */
+static int32_t platform_write(void *handle, uint8_t reg, uint8_t *bufp,
+                              uint16_t len);
+static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
+                             uint16_t len);
+static int32_t platform_read_drdy_pin(void);
+static void tx_com(uint8_t *tx_buffer, uint16_t len);
+static void platform_delay(uint32_t ms);
+static void platform_init(void);
+
+/* Main Example --------------------------------------------------------------*/
+void lis3mdl_fast_read_stream(void)
+{
+  /* Initialize mems driver interface */
+  stmdev_ctx_t dev_ctx;
+  float scale_mG;
+  uint32_t sample = 0;
+  uint8_t anomaly;
+  uint8_t i;
+
+  dev_ctx.write_reg = platform_write;
+  dev_ctx.read_reg = platform_read;
+  dev_ctx.handle = &SENSOR_BUS;
+
+  /* Initialize platform specific hardware */
+  platform_init();
+
+  /* Wait sensor boot time */
+  platform_delay(BOOT_TIME);
+
+  /* Check device ID */
+  lis3mdl_device_id_get(&dev_ctx, &whoamI);
+  if (whoamI != LIS3MDL_ID)
+    while(1); /*manage here device not found */
+
+  /* Restore default configuration */
+  lis3mdl_reset_set(&dev_ctx, PROPERTY_ENABLE);
+  do {
+    lis3mdl_reset_get(&dev_ctx, &rst);
+  } while (rst);
+
+  /* Set full scale and compute the high part sensitivity once */
+  lis3mdl_full_scale_set(&dev_ctx, LIS3MDL_4_GAUSS);
+  scale_mG = 1000.0f * lis3mdl_fast_read_scale_get(LIS3MDL_4_GAUSS);
+
+  /* FAST_READ, no block data update, 1 kHz, continuous mode */
+  lis3mdl_fast_read_stream_set(&dev_ctx, LIS3MDL_LP_1kHz);
+
+  /* Read samples on the DRDY pin */
+  while(1)
+  {
+    if (platform_read_drdy_pin() == 0)
+    {
+      continue;
+    }
+
+    /* One burst: OUT_X_H, OUT_Y_H, OUT_Z_H */
+    lis3mdl_magnetic_msb_raw_get(&dev_ctx, data_raw_magnetic);
+
+    anomaly = 0;
+    for (i = 0; i < 3U; i++)
+    {
+      magnetic_mG[i] = (float)(int8_t)data_raw_magnetic[i] * scale_mG;
+
+      if (sample == 0U)
+      {
+        average_mG[i] = magnetic_mG[i];
+      }
+      if ((magnetic_mG[i] - average_mG[i] > THRESHOLD_MG) ||
+          (average_mG[i] - magnetic_mG[i] > THRESHOLD_MG))
+      {
+        anomaly = 1;
+      }
+      average_mG[i] += (magnetic_mG[i] - average_mG[i]) * AVERAGE_WEIGHT;
+    }
+    sample++;
+
+    if (anomaly)
+    {
+      sprintf((char*)tx_buffer, "%lu anomaly [mG]:%4.0f\t%4.0f\t%4.0f\r\n",
+              (unsigned long)sample,
+              magnetic_mG[0], magnetic_mG[1], magnetic_mG[2]);
+      tx_com(tx_buffer, strlen((char const*)tx_buffer));
+    }
+  }
+}
+
+/*
+ * @brief  Write generic device register (platform dependent)
+ *
+ * @param  handle    customizable argument. In this examples is used in
+ *                   order to select the correct sensor bus handler.
+ * @param  reg       register to write
+ * @param  bufp      pointer to data to write in register reg
+ * @param  len       number of consecutive register to write
+ *
+ */
+static int32_t platform_write(void *handle, uint8_t reg, uint8_t *bufp,
+                              uint16_t len)
+{
+  if (handle == &hi2c1)
+  {
+    /* Write multiple command */
+    reg |= 0x80;
+    HAL_I2C_Mem_Write(handle, LIS3MDL_I2C_ADD_L, reg,
+                      I2C_MEMADD_SIZE_8BIT, bufp, len, 1000);
+  }
+#ifdef STEVAL_MKI109V3
+  else if (handle == &hspi2)
+  {
+    /* Write multiple command */
+    reg |= 0x40;
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_RESET);
+    HAL_SPI_Transmit(handle, &reg, 1, 1000);
+    HAL_SPI_Transmit(handle, bufp, len, 1000);
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_SET);
+  }
+#endif
+  return 0;
+}
+
+/*
+ * @brief  Read generic device register (platform dependent)
+ *
+ * @param  handle    customizable argument. In this examples is used in
+ *                   order to select the correct sensor bus handler.
+ * @param  reg       register to read
+ * @param  bufp      pointer to buffer that store the data read
+ * @param  len       number of consecutive register to read
+ *
+ */
+static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
+                             uint16_t len)
+{
+  if (handle == &hi2c1)
+  {
+    /* Read multiple command */
+    reg |= 0x80;
+    HAL_I2C_Mem_Read(handle, LIS3MDL_I2C_ADD_L, reg,
+                     I2C_MEMADD_SIZE_8BIT, bufp, len, 1000);
+  }
+#ifdef STEVAL_MKI109V3
+  else if (handle == &hspi2)
+  {
+    /* Read multiple command */
+    reg |= 0xC0;
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_RESET);
+    HAL_SPI_Transmit(handle, &reg, 1, 1000);
+    HAL_SPI_Receive(handle, bufp, len, 1000);
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_SET);
+  }
+#endif
+  return 0;
+}
+
+/*
+ * @brief  Read DRDY pin (platform dependent)
+ *
+ */
+static int32_t platform_read_drdy_pin(void)
+{
+#if defined(NUCLEO_F411RE)
+  return HAL_GPIO_ReadPin(LIS3MDL_DRDY_GPIO_PORT, LIS3MDL_DRDY_PIN);
+#else
+  return 1;
+#endif
+}
+
+/*
+ * @brief  Send buffer to console (platform dependent)
+ *
+ * @param  tx_buffer     buffer to trasmit
+ * @param  len           number of byte to send
+ *
+ */
+static void tx_com(uint8_t *tx_buffer, uint16_t len)
+{
+  #ifdef NUCLEO_F411RE
+  HAL_UART_Transmit(&huart2, tx_buffer, len, 1000);
+  #endif
+  #ifdef STEVAL_MKI109V3
+  CDC_Transmit_FS(tx_buffer, len);
+  #endif
+}
+
+/*
+ * @brief  platform specific delay (platform dependent)
+ *
+ * @param  ms        delay in ms
+ *
+ */
+static void platform_delay(uint32_t ms)
+{
+  HAL_Delay(ms);
+}
+
+/*
+ * @brief  platform specific initialization (platform dependent)
+ */
+static void platform_init(void)
+{
+#if defined(STEVAL_MKI109V3)
+  TIM3->CCR1 = PWM_3V3;
+  TIM3->CCR2 = PWM_3V3;
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);
+  HAL_Delay(1000);
+#endif
+}
@@ -606,6 +606,44 @@ int32_t lps22hh_temperature_raw_get(stmdev_ctx_t *ctx, int16_t *buff)
   return ret;
 }
 
+/**
+  * @brief  Data available flags, pressure and temperature output values
+  *         read in one burst (STATUS .. TEMP_OUT_H): the polling loop
+  *         needs one transaction per sample instead of three. press is
+  *         written only when p_da is set, temp only when t_da is
+  *         set.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  status   register STATUS
+  * @param  press    pressure, same format of lps22hh_pressure_raw_get()
+  * @param  temp     temperature, same format of
+  *                  lps22hh_temperature_raw_get()
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps22hh_data_drdy_raw_get(stmdev_ctx_t *ctx, lps22hh_status_t *status,
+                                  uint32_t *press, int16_t *temp)
+{
+  int32_t ret;
+  uint8_t reg[6];
+
+  ret = lps22hh_read_reg(ctx, LPS22HH_STATUS, reg, 6);
+  *((uint8_t*)status) = reg[0];
+
+  if ( (ret == 0) && (status->p_da == PROPERTY_ENABLE) ) {
+    *press = reg[3];
+    *press = (*press * 256) + reg[2];
+    *press = (*press * 256) + reg[1];
+    *press *= 256;
+  }
+  if ( (ret == 0) && (status->t_da == PROPERTY_ENABLE) ) {
+    *temp = reg[5];
+    *temp = (*temp * 256) + reg[4];
+  }
+
+  return ret;
+}
+
 /**
   * @brief  Pressure output from FIFO value.[get]
   *
@@ -350,6 +350,9 @@ int32_t lps22hh_pressure_raw_get(stmdev_ctx_t *ctx, uint32_t *buff);
 
 int32_t lps22hh_temperature_raw_get(stmdev_ctx_t *ctx, int16_t *buff);
 
+int32_t lps22hh_data_drdy_raw_get(stmdev_ctx_t *ctx, lps22hh_status_t *status,
+                                  uint32_t *press, int16_t *temp);
+
 int32_t lps22hh_fifo_pressure_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t lps22hh_fifo_temperature_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
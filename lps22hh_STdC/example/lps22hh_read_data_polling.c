@@ -148,13 +148,14 @@ void lps22hh_read_data_polling(void)
   /* Read samples in polling mode (no int) */
   while(1)
   {
-    /* Read output only if new value is available */
-    lps22hh_read_reg(&dev_ctx, LPS22HH_STATUS, (uint8_t *)&reg, 1);
+    /* Read data available flags, pressure and temperature in one
+     * burst, every output is updated only if a new value is available
+     */
+    lps22hh_data_drdy_raw_get(&dev_ctx, &reg.status, &data_raw_pressure,
+                              &data_raw_temperature);
 
     if (reg.status.p_da)
     {
-      memset(&data_raw_pressure, 0x00, sizeof(uint32_t));
-      lps22hh_pressure_raw_get(&dev_ctx, &data_raw_pressure);
       pressure_hPa = lps22hh_from_lsb_to_hpa( data_raw_pressure);
      
       sprintf((char*)tx_buffer, "pressure [hPa]:%6.2f\r\n", pressure_hPa);
@@ -163,8 +164,6 @@ void lps22hh_read_data_polling(void)
 
     if (reg.status.t_da)
     {
-      memset(&data_raw_temperature, 0x00, sizeof(int16_t));
-      lps22hh_temperature_raw_get(&dev_ctx, &data_raw_temperature);
       temperature_degC = lps22hh_from_lsb_to_celsius( data_raw_temperature );
      
       sprintf((char*)tx_buffer, "temperature [degC]:%6.2f\r\n", temperature_degC );
@@ -1015,6 +1015,158 @@ int32_t lsm6dso_xl_usr_offset_get(stmdev_ctx_t *ctx, uint8_t *val)
   return ret;
 }
 
+/**
+  * @brief  Accelerometer bias calibration in the user offset
+  *         registers.[set]
+  *         The bias is estimated from raw samples collected with the
+  *         device not moving and one axis along gravity (e.g. a FIFO
+  *         batch at the current full scale and offset configuration):
+  *         the axis with the largest mean is the gravity one and 1 g is
+  *         removed from it, the offset already applied (if enabled) is
+  *         added back. The finest weight able to represent the bias is
+  *         selected (2^-10 g/LSB up to 124 mg, 2^-6 g/LSB up to 1.98 g),
+  *         then X/Y/Z_OFS_USR, usr_off_w and usr_off_on_out are written:
+  *         the bias is removed in hardware from output registers, FIFO
+  *         and embedded functions.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  raw      raw samples, x, y, z interleaved.(ptr)
+  * @param  num      number of samples (x, y, z triplets).
+  * @param  val      noise_mg input (maximum standard deviation per axis
+  *                  for a still device, 0 to skip the check) and
+  *                  calibration results; registers are written only
+  *                  when val->done is set.(ptr)
+  *
+  */
+int32_t lsm6dso_xl_offset_calibrate(stmdev_ctx_t *ctx, const int16_t *raw,
+                                    uint16_t num,
+                                    lsm6dso_xl_offset_cal_t *val)
+{
+  lsm6dso_ctrl6_c_t ctrl6_c;
+  lsm6dso_ctrl7_g_t ctrl7_g;
+  lsm6dso_fs_xl_t fs;
+  float_t mean[3];
+  float_t var[3];
+  float_t sens;
+  float_t wgt;
+  float_t max;
+  float_t d;
+  uint8_t ofs[3];
+  uint8_t reg[2];
+  uint16_t i;
+  uint8_t k;
+  int32_t ret;
+
+  val->done = PROPERTY_DISABLE;
+
+  ret = lsm6dso_xl_full_scale_get(ctx, &fs);
+  if (ret == 0) {
+    ret = lsm6dso_read_reg(ctx, LSM6DSO_CTRL6_C, reg, 2);
+  }
+  if (ret == 0) {
+    ret = lsm6dso_read_reg(ctx, LSM6DSO_X_OFS_USR, ofs, 3);
+  }
+  if ( (ret != 0) || (num == 0U) ) {
+    return ret;
+  }
+
+  bytecpy((uint8_t*)&ctrl6_c, &reg[0]);
+  bytecpy((uint8_t*)&ctrl7_g, &reg[1]);
+
+  switch (fs) {
+    case LSM6DSO_4g:
+      sens = lsm6dso_from_fs4_to_mg(1);
+      break;
+    case LSM6DSO_8g:
+      sens = lsm6dso_from_fs8_to_mg(1);
+      break;
+    case LSM6DSO_16g:
+      sens = lsm6dso_from_fs16_to_mg(1);
+      break;
+    default:
+      sens = lsm6dso_from_fs2_to_mg(1);
+      break;
+  }
+
+  for (k = 0U; k < 3U; k++) {
+    mean[k] = 0.0f;
+    var[k] = 0.0f;
+    for (i = 0U; i < num; i++) {
+      mean[k] += (float_t)raw[(3U * i) + k];
+    }
+    mean[k] /= (float_t)num;
+    for (i = 0U; i < num; i++) {
+      d = (float_t)raw[(3U * i) + k] - mean[k];
+      var[k] += d * d;
+    }
+    var[k] = (var[k] / (float_t)num) * sens * sens;
+    mean[k] *= sens;
+  }
+
+  /* gravity axis */
+  val->gravity_axis = 0U;
+  for (k = 1U; k < 3U; k++) {
+    d = (mean[k] < 0.0f) ? -mean[k] : mean[k];
+    max = (mean[val->gravity_axis] < 0.0f) ?
+          -mean[val->gravity_axis] : mean[val->gravity_axis];
+    if (d > max) {
+      val->gravity_axis = k;
+    }
+  }
+
+  /* offset already removed by the device */
+  wgt = (ctrl6_c.usr_off_w == PROPERTY_ENABLE) ? 15.625f : 0.9765625f;
+  max = 0.0f;
+  for (k = 0U; k < 3U; k++) {
+    val->bias_mg[k] = mean[k];
+    if (k == val->gravity_axis) {
+      val->bias_mg[k] -= (mean[k] < 0.0f) ? -1000.0f : 1000.0f;
+    }
+    if (ctrl7_g.usr_off_on_out == PROPERTY_ENABLE) {
+      val->bias_mg[k] += (float_t)((int8_t)ofs[k]) * wgt;
+    }
+    d = (val->bias_mg[k] < 0.0f) ? -val->bias_mg[k] : val->bias_mg[k];
+    if (d > max) {
+      max = d;
+    }
+    if ( (val->noise_mg > 0.0f) &&
+         (var[k] > (val->noise_mg * val->noise_mg)) ) {
+      return ret;
+    }
+  }
+
+  if (max <= (127.0f * 0.9765625f)) {
+    val->weight = LSM6DSO_LSb_1mg;
+    wgt = 0.9765625f;
+  }
+  else if (max <= (127.0f * 15.625f)) {
+    val->weight = LSM6DSO_LSb_16mg;
+    wgt = 15.625f;
+  }
+  else {
+    return ret;
+  }
+
+  for (k = 0U; k < 3U; k++) {
+    d = val->bias_mg[k] / wgt;
+    d += (d < 0.0f) ? -0.5f : 0.5f;
+    val->offset[k] = (uint8_t)((int8_t)d);
+  }
+
+  ret = lsm6dso_write_reg(ctx, LSM6DSO_X_OFS_USR, val->offset, 3);
+  if (ret == 0) {
+    ctrl6_c.usr_off_w = (uint8_t)val->weight;
+    ctrl7_g.usr_off_on_out = PROPERTY_ENABLE;
+    bytecpy(&reg[0], (uint8_t*)&ctrl6_c);
+    bytecpy(&reg[1], (uint8_t*)&ctrl7_g);
+    ret = lsm6dso_write_reg(ctx, LSM6DSO_CTRL6_C, reg, 2);
+  }
+  if (ret == 0) {
+    val->done = PROPERTY_ENABLE;
+  }
+  return ret;
+}
+
 /**
   * @}
   *
@@ -1381,6 +1533,134 @@ int32_t lsm6dso_mem_bank_get(stmdev_ctx_t *ctx, lsm6dso_reg_access_t *val)
   return ret;
 }
 
+/**
+  * @brief  Write FUNC_CFG_ACCESS in the device if the value requested in
+  *         the session is different.
+  *
+  * @param  session  bank session.(ptr)
+  *
+  */
+static int32_t lsm6dso_bank_session_flush(lsm6dso_bank_session_t *session)
+{
+  int32_t ret = 0;
+
+  if (session->shadow != session->func_cfg_access) {
+    ret = lsm6dso_write_reg(session->bus, LSM6DSO_FUNC_CFG_ACCESS,
+                            &session->shadow, 1);
+    if (ret == 0) {
+      session->func_cfg_access = session->shadow;
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Bank session write interface: FUNC_CFG_ACCESS writes are
+  *         kept in the shadow register.
+  *
+  * @param  handle   bank session.(ptr)
+  * @param  reg      first register address to write.
+  * @param  data     the buffer contains data to be written.(ptr)
+  * @param  len      number of consecutive register to write.
+  *
+  */
+static int32_t lsm6dso_bank_session_write(void *handle, uint8_t reg,
+                                          uint8_t *data, uint16_t len)
+{
+  lsm6dso_bank_session_t *session = (lsm6dso_bank_session_t*)handle;
+  int32_t ret = 0;
+
+  if ((reg == LSM6DSO_FUNC_CFG_ACCESS) && (len == 1U)) {
+    session->shadow = *data;
+  }
+  else {
+    ret = lsm6dso_bank_session_flush(session);
+    if (ret == 0) {
+      ret = lsm6dso_write_reg(session->bus, reg, data, len);
+    }
+    if ((ret == 0) && (reg == LSM6DSO_FUNC_CFG_ACCESS)) {
+      session->shadow = *data;
+      session->func_cfg_access = *data;
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Bank session read interface: FUNC_CFG_ACCESS is read from
+  *         the shadow register.
+  *
+  * @param  handle   bank session.(ptr)
+  * @param  reg      first register address to read.
+  * @param  data     buffer for data read.(ptr)
+  * @param  len      number of consecutive register to read.
+  *
+  */
+static int32_t lsm6dso_bank_session_read(void *handle, uint8_t reg,
+                                         uint8_t *data, uint16_t len)
+{
+  lsm6dso_bank_session_t *session = (lsm6dso_bank_session_t*)handle;
+  int32_t ret = 0;
+
+  if ((reg == LSM6DSO_FUNC_CFG_ACCESS) && (len == 1U)) {
+    *data = session->shadow;
+  }
+  else {
+    ret = lsm6dso_bank_session_flush(session);
+    if (ret == 0) {
+      ret = lsm6dso_read_reg(session->bus, reg, data, len);
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Start a bank session: the APIs called with session->ctx
+  *         switch the register bank only when needed, e.g.
+  *
+  *           lsm6dso_bank_session_start(&dev_ctx, &session);
+  *           lsm6dso_fsm_enable_set(&session.ctx, ...);
+  *           lsm6dso_fsm_data_rate_set(&session.ctx, ...);
+  *           lsm6dso_long_cnt_int_value_set(&session.ctx, ...);
+  *           lsm6dso_bank_session_stop(&session);
+  *
+  *         FUNC_CFG_ACCESS is read once here; it must not be changed
+  *         using ctx until the session is stopped.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  session  bank session.(ptr)
+  *
+  */
+int32_t lsm6dso_bank_session_start(stmdev_ctx_t *ctx,
+                                   lsm6dso_bank_session_t *session)
+{
+  int32_t ret;
+
+  session->bus = ctx;
+  session->ctx.write_reg = lsm6dso_bank_session_write;
+  session->ctx.read_reg = lsm6dso_bank_session_read;
+  session->ctx.handle = session;
+
+  ret = lsm6dso_read_reg(ctx, LSM6DSO_FUNC_CFG_ACCESS,
+                         &session->func_cfg_access, 1);
+  session->shadow = session->func_cfg_access;
+
+  return ret;
+}
+
+/**
+  * @brief  Stop a bank session: FUNC_CFG_ACCESS is written in the device
+  *         if the last value requested was not applied yet (usually the
+  *         return to the user bank).
+  *
+  * @param  session  bank session.(ptr)
+  *
+  */
+int32_t lsm6dso_bank_session_stop(lsm6dso_bank_session_t *session)
+{
+  return lsm6dso_bank_session_flush(session);
+}
+
 /**
   * @brief  Write a line(byte) in a page.[set]
   *
@@ -1643,6 +1643,18 @@ int32_t lsm6dso_xl_usr_offset_z_get(stmdev_ctx_t *ctx, uint8_t *buff);
 int32_t lsm6dso_xl_usr_offset_set(stmdev_ctx_t *ctx, uint8_t val);
 int32_t lsm6dso_xl_usr_offset_get(stmdev_ctx_t *ctx, uint8_t *val);
 
+typedef struct {
+  float_t noise_mg;         /* input: max std deviation, 0 = no check */
+  float_t bias_mg[3];       /* estimated bias (with previous offset) */
+  uint8_t offset[3];        /* X/Y/Z_OFS_USR, two's complement */
+  lsm6dso_usr_off_w_t weight;
+  uint8_t gravity_axis;     /* 0: x, 1: y, 2: z */
+  uint8_t done;             /* 1: registers written */
+} lsm6dso_xl_offset_cal_t;
+int32_t lsm6dso_xl_offset_calibrate(stmdev_ctx_t *ctx, const int16_t *raw,
+                                    uint16_t num,
+                                    lsm6dso_xl_offset_cal_t *val);
+
 int32_t lsm6dso_timestamp_rst(stmdev_ctx_t *ctx);
 
 int32_t lsm6dso_timestamp_set(stmdev_ctx_t *ctx, uint8_t val);
@@ -1684,6 +1696,24 @@ typedef enum {
 int32_t lsm6dso_mem_bank_set(stmdev_ctx_t *ctx, lsm6dso_reg_access_t val);
 int32_t lsm6dso_mem_bank_get(stmdev_ctx_t *ctx, lsm6dso_reg_access_t *val);
 
+/**
+  * @brief  Embedded functions / sensor hub bank session: the driver APIs
+  *         called with session.ctx keep FUNC_CFG_ACCESS in a shadow
+  *         register and write it to the device only when a register of a
+  *         different bank is accessed, so consecutive embedded functions
+  *         settings do a single bank switch.
+  *         The session must not be moved between start and stop.
+  */
+typedef struct {
+  stmdev_ctx_t ctx;              /* context to be used in the session */
+  stmdev_ctx_t *bus;             /* device context */
+  uint8_t func_cfg_access;       /* FUNC_CFG_ACCESS value in the device */
+  uint8_t shadow;                /* FUNC_CFG_ACCESS value requested */
+} lsm6dso_bank_session_t;
+int32_t lsm6dso_bank_session_start(stmdev_ctx_t *ctx,
+                                   lsm6dso_bank_session_t *session);
+int32_t lsm6dso_bank_session_stop(lsm6dso_bank_session_t *session);
+
 int32_t lsm6dso_ln_pg_write_byte(stmdev_ctx_t *ctx, uint16_t address,
                                  uint8_t *val);
 int32_t lsm6dso_ln_pg_read_byte(stmdev_ctx_t *ctx, uint16_t address,
@@ -86,16 +86,14 @@
  * in FIFO are stored acc, gyro and timestamp samples
  */
 #define FIFO_WATERMARK    10
-#define FIFO_COMPRESSION  3
-#define SLOT_NUMBER      (FIFO_WATERMARK * FIFO_COMPRESSION)
+/* FIFO words read in one burst (the FIFO is drained in bursts) */
+#define SLOT_NUMBER       FIFO_WATERMARK
 
 /* Private variables ---------------------------------------------------------*/
 static uint8_t whoamI, rst;
 static uint8_t tx_buffer[1000];
 static st_fifo_raw_slot raw_slot[SLOT_NUMBER];
-static st_fifo_out_slot out_slot[SLOT_NUMBER];
-static st_fifo_out_slot acc_slot[SLOT_NUMBER];
-static st_fifo_out_slot gyr_slot[SLOT_NUMBER];
+static st_fifo_state fifo_state;
 
 /* Extern variables ----------------------------------------------------------*/
 
@@ -114,6 +112,7 @@ static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
 static void tx_com( uint8_t *tx_buffer, uint16_t len );
 static void platform_delay(uint32_t ms);
 static void platform_init(void);
+static void fifo_sample_print(const st_fifo_view *view, void *arg);
 
 sensor_data_t sensor_data;
 
@@ -121,7 +120,6 @@ sensor_data_t sensor_data;
 void example_compressed_fifo_simple_lsm6dso(void)
 {
   stmdev_ctx_t dev_ctx;
-  uint16_t out_slot_size;
 
   /* Uncomment to configure INT 1 */
   //lsm6dso_pin_int1_route_t int1_route;
@@ -140,7 +138,7 @@ void example_compressed_fifo_simple_lsm6dso(void)
   platform_delay(10);
 
   /* Init utility for FIFO decompression */
-  st_fifo_init(0, 0, 0);
+  st_fifo_state_init(&fifo_state, 0, 0, 0);
 
   /* Check device ID */
   lsm6dso_device_id_get(&dev_ctx, &whoamI);
@@ -206,9 +204,7 @@ void example_compressed_fifo_simple_lsm6dso(void)
   {
     uint16_t num = 0;
     uint8_t wmflag = 0;
-    uint16_t slots = 0;
-    uint16_t acc_samples;
-    uint16_t gyr_samples;
+    uint16_t slots;
 
   /* Read watermark flag */
     lsm6dso_fifo_wtm_flag_get(&dev_ctx, &wmflag);
@@ -216,65 +212,70 @@ void example_compressed_fifo_simple_lsm6dso(void)
     {
       /* Read number of samples in FIFO */
       lsm6dso_fifo_data_level_get(&dev_ctx, &num);
-      while(num--)
+      while(num > 0)
       {
+        slots = (num > SLOT_NUMBER) ? SLOT_NUMBER : num;
+
         /*
-         * Read FIFO sensor tag
+         * Read FIFO words (sensor tag + sensor value) in one burst, the
+         * register address rolls back from FIFO_DATA_OUT_Z_H to
+         * FIFO_DATA_OUT_TAG: this is the transfer to be done by DMA.
          *
          * To reorder data samples in FIFO is needed the register
          * LSM6DSO_FIFO_DATA_OUT_TAG, including tag counter and parity.
          */
         lsm6dso_read_reg(&dev_ctx, LSM6DSO_FIFO_DATA_OUT_TAG,
-                         (uint8_t *)&raw_slot[slots].fifo_data_out[0], 1);
+                         (uint8_t *)raw_slot,
+                         slots * sizeof(st_fifo_raw_slot));
 
-        /* Read FIFO sensor value */
-        lsm6dso_fifo_out_raw_get(&dev_ctx, &raw_slot[slots].fifo_data_out[1]);
-        slots++;
+        /*
+         * Uncompress FIFO samples: not compressed samples are decoded
+         * in raw_slot, without the copy to an output slot array
+         */
+        st_fifo_state_decode_view(&fifo_state, raw_slot, slots,
+                                  fifo_sample_print, NULL);
+        num -= slots;
       }
+    }
+  }
+}
 
-      /* Uncompress FIFO samples and filter based on sensor type */
-      st_fifo_decompress(out_slot, raw_slot, &out_slot_size, slots);
-      st_fifo_sort(out_slot, out_slot_size);
-      acc_samples = st_fifo_get_sensor_occurrence(out_slot,
-                                                  out_slot_size,
-                                                  ST_FIFO_ACCELEROMETER);
-      gyr_samples = st_fifo_get_sensor_occurrence(out_slot,
-                                                  out_slot_size,
-                                                  ST_FIFO_GYROSCOPE);
-      /* Count how many acc and gyro samples */
-      st_fifo_extract_sensor(acc_slot, out_slot,out_slot_size,
-                             ST_FIFO_ACCELEROMETER);
-      st_fifo_extract_sensor(gyr_slot, out_slot, out_slot_size,
-                             ST_FIFO_GYROSCOPE);
-
-      for (int i = 0; i < acc_samples; i++)
-      {
-        memcpy( sensor_data.raw_data, acc_slot[i].raw_data, sizeof(sensor_data) );
-
-        sprintf((char*)tx_buffer, "ACC:\t%u\t%d\t%4.2f\t%4.2f\t%4.2f\r\n",
-                (unsigned int)acc_slot[i].timestamp,
-                 acc_slot[i].sensor_tag,
-                 lsm6dso_from_fs2_to_mg(sensor_data.data[0]),
-                 lsm6dso_from_fs2_to_mg(sensor_data.data[1]),
-                 lsm6dso_from_fs2_to_mg(sensor_data.data[2]));
-        tx_com(tx_buffer, strlen((char const*)tx_buffer));
-      }
+/*
+ * @brief  Print a decoded FIFO sample (acc and gyro only)
+ *
+ * @param  view      decoded sample
+ * @param  arg       not used
+ *
+ */
+static void fifo_sample_print(const st_fifo_view *view, void *arg)
+{
+  (void)arg;
 
-      for (int i = 0; i < gyr_samples; i++)
-      {
-        memcpy( sensor_data.raw_data, gyr_slot[i].raw_data, sizeof(sensor_data) );
-
-        sprintf((char*)tx_buffer, "GYR:\t%u\t%d\t%4.2f\t%4.2f\t%4.2f\r\n",
-                (unsigned int)gyr_slot[i].timestamp,
-                gyr_slot[i].sensor_tag,
-                lsm6dso_from_fs2000_to_mdps(sensor_data.data[0]),
-                lsm6dso_from_fs2000_to_mdps(sensor_data.data[1]),
-                lsm6dso_from_fs2000_to_mdps(sensor_data.data[2]));
-        tx_com(tx_buffer, strlen((char const*)tx_buffer));
-      }
+  /*
+   * 6 bytes copy: the data of a 7 bytes slot are not aligned for
+   * int16_t access
+   */
+  memcpy( sensor_data.raw_data, view->raw_data, sizeof(sensor_data) );
 
-      slots = 0;
-    }
+  if (view->sensor_tag == ST_FIFO_ACCELEROMETER)
+  {
+    sprintf((char*)tx_buffer, "ACC:\t%u\t%d\t%4.2f\t%4.2f\t%4.2f\r\n",
+            (unsigned int)view->timestamp,
+            view->sensor_tag,
+            lsm6dso_from_fs2_to_mg(sensor_data.data[0]),
+            lsm6dso_from_fs2_to_mg(sensor_data.data[1]),
+            lsm6dso_from_fs2_to_mg(sensor_data.data[2]));
+    tx_com(tx_buffer, strlen((char const*)tx_buffer));
+  }
+  else if (view->sensor_tag == ST_FIFO_GYROSCOPE)
+  {
+    sprintf((char*)tx_buffer, "GYR:\t%u\t%d\t%4.2f\t%4.2f\t%4.2f\r\n",
+            (unsigned int)view->timestamp,
+            view->sensor_tag,
+            lsm6dso_from_fs2000_to_mdps(sensor_data.data[0]),
+            lsm6dso_from_fs2000_to_mdps(sensor_data.data[1]),
+            lsm6dso_from_fs2000_to_mdps(sensor_data.data[2]));
+    tx_com(tx_buffer, strlen((char const*)tx_buffer));
   }
 }
 
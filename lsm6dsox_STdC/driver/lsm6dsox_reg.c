@@ -234,13 +234,18 @@ int32_t lsm6dsox_xl_full_scale_get(stmdev_ctx_t *ctx, lsm6dsox_fs_xl_t *val)
 int32_t lsm6dsox_xl_data_rate_set(stmdev_ctx_t *ctx, lsm6dsox_odr_xl_t val)
 {
   lsm6dsox_odr_xl_t odr_xl =  val;
+#ifndef LSM6DSOX_NO_FSM
   lsm6dsox_emb_fsm_enable_t fsm_enable;
   lsm6dsox_fsm_odr_t fsm_odr;
+#endif /* LSM6DSOX_NO_FSM */
+#ifndef LSM6DSOX_NO_MLC
   uint8_t mlc_enable;
   lsm6dsox_mlc_odr_t mlc_odr;
+#endif /* LSM6DSOX_NO_MLC */
   lsm6dsox_ctrl1_xl_t reg;
-  int32_t ret;
+  int32_t ret = 0;
 
+#ifndef LSM6DSOX_NO_FSM
   /* Check the Finite State Machine data rate constraints */
   ret =  lsm6dsox_fsm_enable_get(ctx, &fsm_enable);
   if (ret == 0) {
@@ -325,7 +330,9 @@ int32_t lsm6dsox_xl_data_rate_set(stmdev_ctx_t *ctx, lsm6dsox_odr_xl_t val)
       }
     }
   }
+#endif /* LSM6DSOX_NO_FSM */
 
+#ifndef LSM6DSOX_NO_MLC
   /* Check the Machine Learning Core data rate constraints */
   mlc_enable = PROPERTY_DISABLE;
   if (ret == 0) {
@@ -394,6 +401,8 @@ int32_t lsm6dsox_xl_data_rate_set(stmdev_ctx_t *ctx, lsm6dsox_odr_xl_t val)
       }
     }
   }
+#endif /* LSM6DSOX_NO_MLC */
+
   if (ret == 0) {
     ret = lsm6dsox_read_reg(ctx, LSM6DSOX_CTRL1_XL, (uint8_t*)&reg, 1);
   }
@@ -530,13 +539,18 @@ int32_t lsm6dsox_gy_full_scale_get(stmdev_ctx_t *ctx, lsm6dsox_fs_g_t *val)
 int32_t lsm6dsox_gy_data_rate_set(stmdev_ctx_t *ctx, lsm6dsox_odr_g_t val)
 {
   lsm6dsox_odr_g_t odr_gy =  val;
+#ifndef LSM6DSOX_NO_FSM
   lsm6dsox_emb_fsm_enable_t fsm_enable;
   lsm6dsox_fsm_odr_t fsm_odr;
+#endif /* LSM6DSOX_NO_FSM */
+#ifndef LSM6DSOX_NO_MLC
   uint8_t mlc_enable;
   lsm6dsox_mlc_odr_t mlc_odr;
+#endif /* LSM6DSOX_NO_MLC */
   lsm6dsox_ctrl2_g_t reg;
-  int32_t ret;
+  int32_t ret = 0;
 
+#ifndef LSM6DSOX_NO_FSM
   /* Check the Finite State Machine data rate constraints */
   ret =  lsm6dsox_fsm_enable_get(ctx, &fsm_enable);
   if (ret == 0) {
@@ -621,7 +635,9 @@ int32_t lsm6dsox_gy_data_rate_set(stmdev_ctx_t *ctx, lsm6dsox_odr_g_t val)
       }
     }
   }
+#endif /* LSM6DSOX_NO_FSM */
 
+#ifndef LSM6DSOX_NO_MLC
   /* Check the Machine Learning Core data rate constraints */
   mlc_enable = PROPERTY_DISABLE;
   if (ret == 0) {
@@ -692,6 +708,8 @@ int32_t lsm6dsox_gy_data_rate_set(stmdev_ctx_t *ctx, lsm6dsox_odr_g_t val)
       }
     }
   }
+#endif /* LSM6DSOX_NO_MLC */
+
   if (ret == 0) {
     ret = lsm6dsox_read_reg(ctx, LSM6DSOX_CTRL2_G, (uint8_t*)&reg, 1);
   }
@@ -1163,6 +1181,158 @@ int32_t lsm6dsox_xl_usr_offset_get(stmdev_ctx_t *ctx, uint8_t *val)
   return ret;
 }
 
+/**
+  * @brief  Accelerometer bias calibration in the user offset
+  *         registers.[set]
+  *         The bias is estimated from raw samples collected with the
+  *         device not moving and one axis along gravity (e.g. a FIFO
+  *         batch at the current full scale and offset configuration):
+  *         the axis with the largest mean is the gravity one and 1 g is
+  *         removed from it, the offset already applied (if enabled) is
+  *         added back. The finest weight able to represent the bias is
+  *         selected (2^-10 g/LSB up to 124 mg, 2^-6 g/LSB up to 1.98 g),
+  *         then X/Y/Z_OFS_USR, usr_off_w and usr_off_on_out are written:
+  *         the bias is removed in hardware from output registers, FIFO
+  *         and embedded functions.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  raw      raw samples, x, y, z interleaved.(ptr)
+  * @param  num      number of samples (x, y, z triplets).
+  * @param  val      noise_mg input (maximum standard deviation per axis
+  *                  for a still device, 0 to skip the check) and
+  *                  calibration results; registers are written only
+  *                  when val->done is set.(ptr)
+  *
+  */
+int32_t lsm6dsox_xl_offset_calibrate(stmdev_ctx_t *ctx, const int16_t *raw,
+                                     uint16_t num,
+                                     lsm6dsox_xl_offset_cal_t *val)
+{
+  lsm6dsox_ctrl6_c_t ctrl6_c;
+  lsm6dsox_ctrl7_g_t ctrl7_g;
+  lsm6dsox_fs_xl_t fs;
+  float_t mean[3];
+  float_t var[3];
+  float_t sens;
+  float_t wgt;
+  float_t max;
+  float_t d;
+  uint8_t ofs[3];
+  uint8_t reg[2];
+  uint16_t i;
+  uint8_t k;
+  int32_t ret;
+
+  val->done = PROPERTY_DISABLE;
+
+  ret = lsm6dsox_xl_full_scale_get(ctx, &fs);
+  if (ret == 0) {
+    ret = lsm6dsox_read_reg(ctx, LSM6DSOX_CTRL6_C, reg, 2);
+  }
+  if (ret == 0) {
+    ret = lsm6dsox_read_reg(ctx, LSM6DSOX_X_OFS_USR, ofs, 3);
+  }
+  if ( (ret != 0) || (num == 0U) ) {
+    return ret;
+  }
+
+  bytecpy((uint8_t*)&ctrl6_c, &reg[0]);
+  bytecpy((uint8_t*)&ctrl7_g, &reg[1]);
+
+  switch (fs) {
+    case LSM6DSOX_4g:
+      sens = lsm6dsox_from_fs4_to_mg(1);
+      break;
+    case LSM6DSOX_8g:
+      sens = lsm6dsox_from_fs8_to_mg(1);
+      break;
+    case LSM6DSOX_16g:
+      sens = lsm6dsox_from_fs16_to_mg(1);
+      break;
+    default:
+      sens = lsm6dsox_from_fs2_to_mg(1);
+      break;
+  }
+
+  for (k = 0U; k < 3U; k++) {
+    mean[k] = 0.0f;
+    var[k] = 0.0f;
+    for (i = 0U; i < num; i++) {
+      mean[k] += (float_t)raw[(3U * i) + k];
+    }
+    mean[k] /= (float_t)num;
+    for (i = 0U; i < num; i++) {
+      d = (float_t)raw[(3U * i) + k] - mean[k];
+      var[k] += d * d;
+    }
+    var[k] = (var[k] / (float_t)num) * sens * sens;
+    mean[k] *= sens;
+  }
+
+  /* gravity axis */
+  val->gravity_axis = 0U;
+  for (k = 1U; k < 3U; k++) {
+    d = (mean[k] < 0.0f) ? -mean[k] : mean[k];
+    max = (mean[val->gravity_axis] < 0.0f) ?
+          -mean[val->gravity_axis] : mean[val->gravity_axis];
+    if (d > max) {
+      val->gravity_axis = k;
+    }
+  }
+
+  /* offset already removed by the device */
+  wgt = (ctrl6_c.usr_off_w == PROPERTY_ENABLE) ? 15.625f : 0.9765625f;
+  max = 0.0f;
+  for (k = 0U; k < 3U; k++) {
+    val->bias_mg[k] = mean[k];
+    if (k == val->gravity_axis) {
+      val->bias_mg[k] -= (mean[k] < 0.0f) ? -1000.0f : 1000.0f;
+    }
+    if (ctrl7_g.usr_off_on_out == PROPERTY_ENABLE) {
+      val->bias_mg[k] += (float_t)((int8_t)ofs[k]) * wgt;
+    }
+    d = (val->bias_mg[k] < 0.0f) ? -val->bias_mg[k] : val->bias_mg[k];
+    if (d > max) {
+      max = d;
+    }
+    if ( (val->noise_mg > 0.0f) &&
+         (var[k] > (val->noise_mg * val->noise_mg)) ) {
+      return ret;
+    }
+  }
+
+  if (max <= (127.0f * 0.9765625f)) {
+    val->weight = LSM6DSOX_LSb_1mg;
+    wgt = 0.9765625f;
+  }
+  else if (max <= (127.0f * 15.625f)) {
+    val->weight = LSM6DSOX_LSb_16mg;
+    wgt = 15.625f;
+  }
+  else {
+    return ret;
+  }
+
+  for (k = 0U; k < 3U; k++) {
+    d = val->bias_mg[k] / wgt;
+    d += (d < 0.0f) ? -0.5f : 0.5f;
+    val->offset[k] = (uint8_t)((int8_t)d);
+  }
+
+  ret = lsm6dsox_write_reg(ctx, LSM6DSOX_X_OFS_USR, val->offset, 3);
+  if (ret == 0) {
+    ctrl6_c.usr_off_w = (uint8_t)val->weight;
+    ctrl7_g.usr_off_on_out = PROPERTY_ENABLE;
+    bytecpy(&reg[0], (uint8_t*)&ctrl6_c);
+    bytecpy(&reg[1], (uint8_t*)&ctrl7_g);
+    ret = lsm6dsox_write_reg(ctx, LSM6DSOX_CTRL6_C, reg, 2);
+  }
+  if (ret == 0) {
+    val->done = PROPERTY_ENABLE;
+  }
+  return ret;
+}
+
 /**
   * @}
   *
@@ -1428,6 +1598,50 @@ int32_t lsm6dsox_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff)
   return ret;
 }
 
+/**
+  * @brief  Data available flags, temperature, angular rate and linear
+  *         acceleration read in one burst (STATUS_REG .. OUTZ_H_A): the
+  *         polling loop needs one transaction per sample instead of up
+  *         to six. Every buffer is written only when the matching flag
+  *         is set.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  status   register STATUS_REG
+  * @param  temp     temperature buffer (2 bytes)
+  * @param  gy       angular rate buffer (6 bytes)
+  * @param  xl       linear acceleration buffer (6 bytes)
+  *
+  */
+int32_t lsm6dsox_data_drdy_raw_get(stmdev_ctx_t *ctx,
+                                   lsm6dsox_status_reg_t *status,
+                                   uint8_t *temp, uint8_t *gy, uint8_t *xl)
+{
+  uint8_t reg[16];
+  uint8_t i;
+  int32_t ret;
+
+  /* STATUS_REG, reserved, OUT_TEMP_L .. OUTZ_H_A */
+  ret = lsm6dsox_read_reg(ctx, LSM6DSOX_STATUS_REG, reg, 16);
+  bytecpy((uint8_t*)status, &reg[0]);
+
+  if (ret == 0) {
+    if (status->tda == PROPERTY_ENABLE) {
+      temp[0] = reg[2];
+      temp[1] = reg[3];
+    }
+    for (i = 0U; i < 6U; i++) {
+      if (status->gda == PROPERTY_ENABLE) {
+        gy[i] = reg[4U + i];
+      }
+      if (status->xlda == PROPERTY_ENABLE) {
+        xl[i] = reg[10U + i];
+      }
+    }
+  }
+
+  return ret;
+}
+
 /**
   * @brief  FIFO data output [get]
   *
@@ -1442,6 +1656,7 @@ int32_t lsm6dsox_fifo_out_raw_get(stmdev_ctx_t *ctx, uint8_t *buff)
   return ret;
 }
 
+#ifndef LSM6DSOX_NO_OIS
 /**
   * @brief  ois_angular_rate_raw: [get]  OIS angular rate sensor.
   *                                      The value is expressed as a
@@ -1514,7 +1729,9 @@ int32_t lsm6dsox_aux_ois_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff)
 {
   return lsm6dsox_read_reg(ctx, LSM6DSOX_SPI2_OUTX_L_A_OIS, buff, 6);
 }
+#endif /* LSM6DSOX_NO_OIS */
 
+#ifndef LSM6DSOX_NO_PEDOMETER
 /**
   * @brief  Step counter output register.[get]
   *
@@ -1560,7 +1777,9 @@ int32_t lsm6dsox_steps_reset(stmdev_ctx_t *ctx)
   }
   return ret;
 }
+#endif /* LSM6DSOX_NO_PEDOMETER */
 
+#ifndef LSM6DSOX_NO_MLC
 /**
   * @brief  prgsens_out: [get] Output value of all MLCx decision trees.
   *
@@ -1580,6 +1799,7 @@ int32_t lsm6dsox_mlc_out_get(stmdev_ctx_t *ctx, uint8_t *buff)
   }
   return ret;
 }
+#endif /* LSM6DSOX_NO_MLC */
 
 /**
   * @}
@@ -1692,6 +1912,134 @@ int32_t lsm6dsox_mem_bank_get(stmdev_ctx_t *ctx, lsm6dsox_reg_access_t *val)
   return ret;
 }
 
+/**
+  * @brief  Write FUNC_CFG_ACCESS in the device if the value requested in
+  *         the session is different.
+  *
+  * @param  session  bank session.(ptr)
+  *
+  */
+static int32_t lsm6dsox_bank_session_flush(lsm6dsox_bank_session_t *session)
+{
+  int32_t ret = 0;
+
+  if (session->shadow != session->func_cfg_access) {
+    ret = lsm6dsox_write_reg(session->bus, LSM6DSOX_FUNC_CFG_ACCESS,
+                             &session->shadow, 1);
+    if (ret == 0) {
+      session->func_cfg_access = session->shadow;
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Bank session write interface: FUNC_CFG_ACCESS writes are
+  *         kept in the shadow register.
+  *
+  * @param  handle   bank session.(ptr)
+  * @param  reg      first register address to write.
+  * @param  data     the buffer contains data to be written.(ptr)
+  * @param  len      number of consecutive register to write.
+  *
+  */
+static int32_t lsm6dsox_bank_session_write(void *handle, uint8_t reg,
+                                           uint8_t *data, uint16_t len)
+{
+  lsm6dsox_bank_session_t *session = (lsm6dsox_bank_session_t*)handle;
+  int32_t ret = 0;
+
+  if ((reg == LSM6DSOX_FUNC_CFG_ACCESS) && (len == 1U)) {
+    session->shadow = *data;
+  }
+  else {
+    ret = lsm6dsox_bank_session_flush(session);
+    if (ret == 0) {
+      ret = lsm6dsox_write_reg(session->bus, reg, data, len);
+    }
+    if ((ret == 0) && (reg == LSM6DSOX_FUNC_CFG_ACCESS)) {
+      session->shadow = *data;
+      session->func_cfg_access = *data;
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Bank session read interface: FUNC_CFG_ACCESS is read from
+  *         the shadow register.
+  *
+  * @param  handle   bank session.(ptr)
+  * @param  reg      first register address to read.
+  * @param  data     buffer for data read.(ptr)
+  * @param  len      number of consecutive register to read.
+  *
+  */
+static int32_t lsm6dsox_bank_session_read(void *handle, uint8_t reg,
+                                          uint8_t *data, uint16_t len)
+{
+  lsm6dsox_bank_session_t *session = (lsm6dsox_bank_session_t*)handle;
+  int32_t ret = 0;
+
+  if ((reg == LSM6DSOX_FUNC_CFG_ACCESS) && (len == 1U)) {
+    *data = session->shadow;
+  }
+  else {
+    ret = lsm6dsox_bank_session_flush(session);
+    if (ret == 0) {
+      ret = lsm6dsox_read_reg(session->bus, reg, data, len);
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Start a bank session: the APIs called with session->ctx
+  *         switch the register bank only when needed, e.g.
+  *
+  *           lsm6dsox_bank_session_start(&dev_ctx, &session);
+  *           lsm6dsox_fsm_enable_set(&session.ctx, ...);
+  *           lsm6dsox_fsm_data_rate_set(&session.ctx, ...);
+  *           lsm6dsox_long_cnt_int_value_set(&session.ctx, ...);
+  *           lsm6dsox_bank_session_stop(&session);
+  *
+  *         FUNC_CFG_ACCESS is read once here; it must not be changed
+  *         using ctx until the session is stopped.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  session  bank session.(ptr)
+  *
+  */
+int32_t lsm6dsox_bank_session_start(stmdev_ctx_t *ctx,
+                                    lsm6dsox_bank_session_t *session)
+{
+  int32_t ret;
+
+  session->bus = ctx;
+  session->ctx.write_reg = lsm6dsox_bank_session_write;
+  session->ctx.read_reg = lsm6dsox_bank_session_read;
+  session->ctx.handle = session;
+
+  ret = lsm6dsox_read_reg(ctx, LSM6DSOX_FUNC_CFG_ACCESS,
+                          &session->func_cfg_access, 1);
+  session->shadow = session->func_cfg_access;
+
+  return ret;
+}
+
+/**
+  * @brief  Stop a bank session: FUNC_CFG_ACCESS is written in the device
+  *         if the last value requested was not applied yet (usually the
+  *         return to the user bank).
+  *
+  * @param  session  bank session.(ptr)
+  *
+  */
+int32_t lsm6dsox_bank_session_stop(lsm6dsox_bank_session_t *session)
+{
+  return lsm6dsox_bank_session_flush(session);
+}
+
 /**
   * @brief  Write a line(byte) in a page.[set]
   *
@@ -2700,6 +3048,7 @@ int32_t lsm6dsox_gy_hp_path_internal_get(stmdev_ctx_t *ctx,
   *
   */
 
+#ifndef LSM6DSOX_NO_OIS
 /**
   * @brief   OIS data reading from Auxiliary / Main SPI.[set]
   *
@@ -3621,6 +3970,7 @@ int32_t lsm6dsox_aux_xl_full_scale_get(stmdev_ctx_t *ctx,
   }
   return ret;
 }
+#endif /* LSM6DSOX_NO_OIS */
 
 /**
   * @}
@@ -4519,6 +4869,7 @@ int32_t lsm6dsox_act_sleep_dur_get(stmdev_ctx_t *ctx, uint8_t *val)
   *
   */
 
+#ifndef LSM6DSOX_NO_TAP
 /**
   * @brief  Enable Z direction in tap recognition.[set]
   *
@@ -5010,6 +5361,7 @@ int32_t lsm6dsox_tap_mode_get(stmdev_ctx_t *ctx,
 
   return ret;
 }
+#endif /* LSM6DSOX_NO_TAP */
 
 /**
   * @}
@@ -6223,6 +6575,7 @@ int32_t lsm6dsox_fifo_sensor_tag_get(stmdev_ctx_t *ctx,
   return ret;
 }
 
+#ifndef LSM6DSOX_NO_PEDOMETER
 /**
   * @brief  :  Enable FIFO batching of pedometer embedded
   *            function values.[set]
@@ -6275,7 +6628,9 @@ int32_t lsm6dsox_fifo_pedo_batch_get(stmdev_ctx_t *ctx, uint8_t *val)
   }
   return ret;
 }
+#endif /* LSM6DSOX_NO_PEDOMETER */
 
+#ifndef LSM6DSOX_NO_SENSOR_HUB
 /**
   * @brief   Enable FIFO batching data of first slave.[set]
   *
@@ -6484,6 +6839,7 @@ int32_t lsm6dsox_sh_batch_slave_3_get(stmdev_ctx_t *ctx, uint8_t *val)
 
   return ret;
 }
+#endif /* LSM6DSOX_NO_SENSOR_HUB */
 
 /**
   * @}
@@ -6786,6 +7142,7 @@ int32_t lsm6dsox_den_mark_axis_z_get(stmdev_ctx_t *ctx, uint8_t *val)
   *
 */
 
+#ifndef LSM6DSOX_NO_PEDOMETER
 /**
   * @brief  Enable pedometer algorithm.[set]
   *
@@ -7034,6 +7391,7 @@ int32_t lsm6dsox_pedo_int_mode_get(stmdev_ctx_t *ctx,
   }
   return ret;
 }
+#endif /* LSM6DSOX_NO_PEDOMETER */
 
 /**
   * @}
@@ -7758,6 +8116,7 @@ int32_t lsm6dsox_mag_x_orient_get(stmdev_ctx_t *ctx,
   *
   */
 
+#ifndef LSM6DSOX_NO_FSM
 /**
   * @brief   Interrupt status bit for FSM long counter
   *          timeout interrupt event.[get]
@@ -8310,6 +8669,7 @@ int32_t lsm6dsox_fsm_start_address_get(stmdev_ctx_t *ctx, uint16_t *val)
   }
   return ret;
 }
+#endif /* LSM6DSOX_NO_FSM */
 
 /**
   * @}
@@ -8324,6 +8684,7 @@ int32_t lsm6dsox_fsm_start_address_get(stmdev_ctx_t *ctx, uint16_t *val)
   *
   */
 
+#ifndef LSM6DSOX_NO_MLC
 /**
   * @brief  Enable Machine Learning Core.[set]
   *
@@ -8470,6 +8831,7 @@ int32_t lsm6dsox_mlc_data_rate_get(stmdev_ctx_t *ctx,
   }
   return ret;
 }
+#endif /* LSM6DSOX_NO_MLC */
 
 /**
   * @}
@@ -8484,6 +8846,7 @@ int32_t lsm6dsox_mlc_data_rate_get(stmdev_ctx_t *ctx,
   *
   */
 
+#ifndef LSM6DSOX_NO_SENSOR_HUB
 /**
 * @brief  Sensor hub output registers.[get]
 *
@@ -9216,6 +9579,7 @@ int32_t lsm6dsox_sh_status_get(stmdev_ctx_t *ctx,
 
   return ret;
 }
+#endif /* LSM6DSOX_NO_SENSOR_HUB */
 
 /**
   * @}
@@ -10631,6 +10995,530 @@ int32_t lsm6dsox_pin_int2_route_get(stmdev_ctx_t *ctx, stmdev_ctx_t *aux_ctx,
   return ret;
 }
 
+/**
+  * @brief  Read the interrupt routing registers image, burst reads:
+  *         EMB_FUNC_INT1 .. MLC_INT2, INT1_CTRL .. INT2_CTRL,
+  *         MD1_CFG .. MD2_CFG, CTRL4_C and TAP_CFG2.
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  regs         registers image.(ptr)
+  *
+  */
+static int32_t lsm6dsox_pin_int_regs_read(stmdev_ctx_t *ctx,
+                                          lsm6dsox_pin_int_regs_t *regs)
+{
+  lsm6dsox_tap_cfg2_t tap_cfg2;
+  lsm6dsox_ctrl4_c_t  ctrl4_c;
+  int32_t             ret;
+
+  regs->valid = PROPERTY_DISABLE;
+
+  ret = lsm6dsox_mem_bank_set(ctx, LSM6DSOX_EMBEDDED_FUNC_BANK);
+  if (ret == 0) {
+    ret = lsm6dsox_read_reg(ctx, LSM6DSOX_EMB_FUNC_INT1,
+                            regs->emb_func_int, 8);
+  }
+  if (ret == 0) {
+    ret = lsm6dsox_mem_bank_set(ctx, LSM6DSOX_USER_BANK);
+  }
+  if (ret == 0) {
+    ret = lsm6dsox_read_reg(ctx, LSM6DSOX_INT1_CTRL, regs->int_ctrl, 2);
+  }
+  if (ret == 0) {
+    ret = lsm6dsox_read_reg(ctx, LSM6DSOX_MD1_CFG, regs->md_cfg, 2);
+  }
+  if (ret == 0) {
+    ret = lsm6dsox_read_reg(ctx, LSM6DSOX_CTRL4_C, (uint8_t*)&ctrl4_c, 1);
+  }
+  if (ret == 0) {
+    ret = lsm6dsox_read_reg(ctx, LSM6DSOX_TAP_CFG2, (uint8_t*)&tap_cfg2, 1);
+  }
+  if (ret == 0) {
+    regs->int2_on_int1 = ctrl4_c.int2_on_int1;
+    regs->interrupts_enable = tap_cfg2.interrupts_enable;
+    regs->valid = PROPERTY_ENABLE;
+  }
+  return ret;
+}
+
+/**
+  * @brief  Write the registers of a contiguous block that differ from
+  *         the image, in a single burst from the first to the last
+  *         changed register (a few unchanged bytes cost less than an
+  *         extra transaction).
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  reg          address of the first register of the block.
+  * @param  cur          registers image, updated on success.(ptr)
+  * @param  next         values to write.(ptr)
+  * @param  len          number of registers in the block.
+  *
+  */
+static int32_t lsm6dsox_pin_int_regs_write(stmdev_ctx_t *ctx, uint8_t reg,
+                                           uint8_t *cur, uint8_t *next,
+                                           uint8_t len)
+{
+  uint8_t first;
+  uint8_t last;
+  uint8_t i;
+  int32_t ret;
+
+  first = len;
+  last = 0U;
+  for (i = 0U; i < len; i++) {
+    if (cur[i] != next[i]) {
+      if (first == len) {
+        first = i;
+      }
+      last = i;
+    }
+  }
+
+  ret = 0;
+  if (first < len) {
+    ret = lsm6dsox_write_reg(ctx, reg + first, &next[first],
+                             (uint16_t)(last - first) + 1U);
+    for (i = first; (ret == 0) && (i <= last); i++) {
+      cur[i] = next[i];
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Route interrupt signals on int1 and int2 pins in a single
+  *         pass.[set]
+  *         All the routing registers are computed in memory from val
+  *         (including MD1_CFG.int1_emb_func, MD2_CFG.int2_emb_func,
+  *         CTRL4_C.int2_on_int1 and TAP_CFG2.interrupts_enable), then
+  *         only the changed registers are written: one burst in the
+  *         embedded functions bank (the bank is switched only if needed)
+  *         and one burst per contiguous block in the user bank.
+  *         Passing the same regs image across calls no registers are
+  *         read, so re-routing (e.g. moving the FIFO and the event
+  *         signals between pins when changing power state) costs only
+  *         the writes. Set regs->valid to 0 (or pass NULL) when the
+  *         routing registers may have been changed by other functions.
+  *         OIS data ready on int2 is configured by the auxiliary
+  *         interface, see lsm6dsox_pin_int2_route_set().
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  val          the signals to route on int1 and int2 pins.
+  *                      drdy_temp and timestamp on int1 set int2_on_int1
+  *                      (all int2 signals are routed also on int1).
+  * @param  regs         registers image, read from the device if NULL
+  *                      or not valid and kept updated.(ptr)
+  *
+  */
+int32_t lsm6dsox_pin_int_route_set(stmdev_ctx_t *ctx,
+                                   lsm6dsox_pin_int_route_t val,
+                                   lsm6dsox_pin_int_regs_t *regs)
+{
+  lsm6dsox_emb_func_int1_t emb_func_int1;
+  lsm6dsox_emb_func_int2_t emb_func_int2;
+  lsm6dsox_pin_int_regs_t  image;
+  lsm6dsox_pin_int_regs_t  *cur;
+  lsm6dsox_fsm_int1_a_t    fsm_int1_a;
+  lsm6dsox_fsm_int1_b_t    fsm_int1_b;
+  lsm6dsox_fsm_int2_a_t    fsm_int2_a;
+  lsm6dsox_fsm_int2_b_t    fsm_int2_b;
+  lsm6dsox_int1_ctrl_t     int1_ctrl;
+  lsm6dsox_int2_ctrl_t     int2_ctrl;
+  lsm6dsox_mlc_int1_t      mlc_int1;
+  lsm6dsox_mlc_int2_t      mlc_int2;
+  lsm6dsox_tap_cfg2_t      tap_cfg2;
+  lsm6dsox_md1_cfg_t       md1_cfg;
+  lsm6dsox_md2_cfg_t       md2_cfg;
+  lsm6dsox_ctrl4_c_t       ctrl4_c;
+  uint8_t                  emb_func_int[8];
+  uint8_t                  interrupts_enable;
+  uint8_t                  int2_on_int1;
+  uint8_t                  int_ctrl[2];
+  uint8_t                  md_cfg[2];
+  uint8_t                  diff;
+  uint8_t                  i;
+  int32_t                  ret;
+
+  int1_ctrl.int1_drdy_xl   = val.int1.drdy_xl;
+  int1_ctrl.int1_drdy_g    = val.int1.drdy_g;
+  int1_ctrl.int1_boot      = val.int1.boot;
+  int1_ctrl.int1_fifo_th   = val.int1.fifo_th;
+  int1_ctrl.int1_fifo_ovr  = val.int1.fifo_ovr;
+  int1_ctrl.int1_fifo_full = val.int1.fifo_full;
+  int1_ctrl.int1_cnt_bdr   = val.int1.fifo_bdr;
+  int1_ctrl.den_drdy_flag  = val.int1.den_flag;
+
+  int2_ctrl.int2_drdy_xl   = val.int2.drdy_xl;
+  int2_ctrl.int2_drdy_g    = val.int2.drdy_g;
+  int2_ctrl.int2_drdy_temp = val.int2.drdy_temp | val.int1.drdy_temp;
+  int2_ctrl.int2_fifo_th   = val.int2.fifo_th;
+  int2_ctrl.int2_fifo_ovr  = val.int2.fifo_ovr;
+  int2_ctrl.int2_fifo_full = val.int2.fifo_full;
+  int2_ctrl.int2_cnt_bdr   = val.int2.fifo_bdr;
+  int2_ctrl.not_used_01    = 0;
+
+  md1_cfg.int1_shub         = val.int1.sh_endop;
+  md1_cfg.int1_6d           = val.int1.six_d;
+  md1_cfg.int1_double_tap   = val.int1.double_tap;
+  md1_cfg.int1_ff           = val.int1.free_fall;
+  md1_cfg.int1_wu           = val.int1.wake_up;
+  md1_cfg.int1_single_tap   = val.int1.single_tap;
+  md1_cfg.int1_sleep_change = val.int1.sleep_change;
+
+  md2_cfg.int2_timestamp    = val.int2.timestamp | val.int1.timestamp;
+  md2_cfg.int2_6d           = val.int2.six_d;
+  md2_cfg.int2_double_tap   = val.int2.double_tap;
+  md2_cfg.int2_ff           = val.int2.free_fall;
+  md2_cfg.int2_wu           = val.int2.wake_up;
+  md2_cfg.int2_single_tap   = val.int2.single_tap;
+  md2_cfg.int2_sleep_change = val.int2.sleep_change;
+
+  emb_func_int1.not_used_01        = 0;
+  emb_func_int1.int1_step_detector = val.int1.step_detector;
+  emb_func_int1.int1_tilt          = val.int1.tilt;
+  emb_func_int1.int1_sig_mot       = val.int1.sig_mot;
+  emb_func_int1.not_used_02        = 0;
+  emb_func_int1.int1_fsm_lc        = val.int1.fsm_lc;
+
+  emb_func_int2.not_used_01        = 0;
+  emb_func_int2.int2_step_detector = val.int2.step_detector;
+  emb_func_int2.int2_tilt          = val.int2.tilt;
+  emb_func_int2.int2_sig_mot       = val.int2.sig_mot;
+  emb_func_int2.not_used_02        = 0;
+  emb_func_int2.int2_fsm_lc        = val.int2.fsm_lc;
+
+  fsm_int1_a.int1_fsm1 = val.int1.fsm1;
+  fsm_int1_a.int1_fsm2 = val.int1.fsm2;
+  fsm_int1_a.int1_fsm3 = val.int1.fsm3;
+  fsm_int1_a.int1_fsm4 = val.int1.fsm4;
+  fsm_int1_a.int1_fsm5 = val.int1.fsm5;
+  fsm_int1_a.int1_fsm6 = val.int1.fsm6;
+  fsm_int1_a.int1_fsm7 = val.int1.fsm7;
+  fsm_int1_a.int1_fsm8 = val.int1.fsm8;
+
+  fsm_int1_b.int1_fsm9  = val.int1.fsm9;
+  fsm_int1_b.int1_fsm10 = val.int1.fsm10;
+  fsm_int1_b.int1_fsm11 = val.int1.fsm11;
+  fsm_int1_b.int1_fsm12 = val.int1.fsm12;
+  fsm_int1_b.int1_fsm13 = val.int1.fsm13;
+  fsm_int1_b.int1_fsm14 = val.int1.fsm14;
+  fsm_int1_b.int1_fsm15 = val.int1.fsm15;
+  fsm_int1_b.int1_fsm16 = val.int1.fsm16;
+
+  fsm_int2_a.int2_fsm1 = val.int2.fsm1;
+  fsm_int2_a.int2_fsm2 = val.int2.fsm2;
+  fsm_int2_a.int2_fsm3 = val.int2.fsm3;
+  fsm_int2_a.int2_fsm4 = val.int2.fsm4;
+  fsm_int2_a.int2_fsm5 = val.int2.fsm5;
+  fsm_int2_a.int2_fsm6 = val.int2.fsm6;
+  fsm_int2_a.int2_fsm7 = val.int2.fsm7;
+  fsm_int2_a.int2_fsm8 = val.int2.fsm8;
+
+  fsm_int2_b.int2_fsm9  = val.int2.fsm9;
+  fsm_int2_b.int2_fsm10 = val.int2.fsm10;
+  fsm_int2_b.int2_fsm11 = val.int2.fsm11;
+  fsm_int2_b.int2_fsm12 = val.int2.fsm12;
+  fsm_int2_b.int2_fsm13 = val.int2.fsm13;
+  fsm_int2_b.int2_fsm14 = val.int2.fsm14;
+  fsm_int2_b.int2_fsm15 = val.int2.fsm15;
+  fsm_int2_b.int2_fsm16 = val.int2.fsm16;
+
+  mlc_int1.int1_mlc1 = val.int1.mlc1;
+  mlc_int1.int1_mlc2 = val.int1.mlc2;
+  mlc_int1.int1_mlc3 = val.int1.mlc3;
+  mlc_int1.int1_mlc4 = val.int1.mlc4;
+  mlc_int1.int1_mlc5 = val.int1.mlc5;
+  mlc_int1.int1_mlc6 = val.int1.mlc6;
+  mlc_int1.int1_mlc7 = val.int1.mlc7;
+  mlc_int1.int1_mlc8 = val.int1.mlc8;
+
+  mlc_int2.int2_mlc1 = val.int2.mlc1;
+  mlc_int2.int2_mlc2 = val.int2.mlc2;
+  mlc_int2.int2_mlc3 = val.int2.mlc3;
+  mlc_int2.int2_mlc4 = val.int2.mlc4;
+  mlc_int2.int2_mlc5 = val.int2.mlc5;
+  mlc_int2.int2_mlc6 = val.int2.mlc6;
+  mlc_int2.int2_mlc7 = val.int2.mlc7;
+  mlc_int2.int2_mlc8 = val.int2.mlc8;
+
+  bytecpy(&emb_func_int[0], (uint8_t*)&emb_func_int1);
+  bytecpy(&emb_func_int[1], (uint8_t*)&fsm_int1_a);
+  bytecpy(&emb_func_int[2], (uint8_t*)&fsm_int1_b);
+  bytecpy(&emb_func_int[3], (uint8_t*)&mlc_int1);
+  bytecpy(&emb_func_int[4], (uint8_t*)&emb_func_int2);
+  bytecpy(&emb_func_int[5], (uint8_t*)&fsm_int2_a);
+  bytecpy(&emb_func_int[6], (uint8_t*)&fsm_int2_b);
+  bytecpy(&emb_func_int[7], (uint8_t*)&mlc_int2);
+
+  if ( ( emb_func_int[0] | emb_func_int[1]
+       | emb_func_int[2] | emb_func_int[3] ) != PROPERTY_DISABLE ) {
+    md1_cfg.int1_emb_func = PROPERTY_ENABLE;
+  }
+  else {
+    md1_cfg.int1_emb_func = PROPERTY_DISABLE;
+  }
+  if ( ( emb_func_int[4] | emb_func_int[5]
+       | emb_func_int[6] | emb_func_int[7] ) != PROPERTY_DISABLE ) {
+    md2_cfg.int2_emb_func = PROPERTY_ENABLE;
+  }
+  else {
+    md2_cfg.int2_emb_func = PROPERTY_DISABLE;
+  }
+
+  bytecpy(&int_ctrl[0], (uint8_t*)&int1_ctrl);
+  bytecpy(&int_ctrl[1], (uint8_t*)&int2_ctrl);
+  bytecpy(&md_cfg[0], (uint8_t*)&md1_cfg);
+  bytecpy(&md_cfg[1], (uint8_t*)&md2_cfg);
+
+  if ( ( val.int1.drdy_temp | val.int1.timestamp ) != PROPERTY_DISABLE ) {
+    int2_on_int1 = PROPERTY_ENABLE;
+  }
+  else {
+    int2_on_int1 = PROPERTY_DISABLE;
+  }
+
+  if ( ( int_ctrl[0]
+       | int_ctrl[1]
+       | md1_cfg.int1_shub
+       | md1_cfg.int1_6d
+       | md1_cfg.int1_double_tap
+       | md1_cfg.int1_ff
+       | md1_cfg.int1_wu
+       | md1_cfg.int1_single_tap
+       | md1_cfg.int1_sleep_change
+       | md2_cfg.int2_6d
+       | md2_cfg.int2_double_tap
+       | md2_cfg.int2_ff
+       | md2_cfg.int2_wu
+       | md2_cfg.int2_single_tap
+       | md2_cfg.int2_sleep_change ) != PROPERTY_DISABLE ) {
+    interrupts_enable = PROPERTY_ENABLE;
+  }
+  else {
+    interrupts_enable = PROPERTY_DISABLE;
+  }
+
+  ret = 0;
+  cur = regs;
+  if (cur == NULL) {
+    cur = &image;
+    cur->valid = PROPERTY_DISABLE;
+  }
+  if (cur->valid == PROPERTY_DISABLE) {
+    ret = lsm6dsox_pin_int_regs_read(ctx, cur);
+  }
+
+  diff = 0U;
+  for (i = 0U; i < 8U; i++) {
+    diff |= cur->emb_func_int[i] ^ emb_func_int[i];
+  }
+  if ( (ret == 0) && (diff != 0U) ) {
+    ret = lsm6dsox_mem_bank_set(ctx, LSM6DSOX_EMBEDDED_FUNC_BANK);
+    if (ret == 0) {
+      ret = lsm6dsox_pin_int_regs_write(ctx, LSM6DSOX_EMB_FUNC_INT1,
+                                        cur->emb_func_int, emb_func_int, 8);
+    }
+    if (ret == 0) {
+      ret = lsm6dsox_mem_bank_set(ctx, LSM6DSOX_USER_BANK);
+    }
+  }
+  if (ret == 0) {
+    ret = lsm6dsox_pin_int_regs_write(ctx, LSM6DSOX_INT1_CTRL,
+                                      cur->int_ctrl, int_ctrl, 2);
+  }
+  if (ret == 0) {
+    ret = lsm6dsox_pin_int_regs_write(ctx, LSM6DSOX_MD1_CFG,
+                                      cur->md_cfg, md_cfg, 2);
+  }
+  if ( (ret == 0) && (cur->int2_on_int1 != int2_on_int1) ) {
+    ret = lsm6dsox_read_reg(ctx, LSM6DSOX_CTRL4_C, (uint8_t*)&ctrl4_c, 1);
+    if (ret == 0) {
+      ctrl4_c.int2_on_int1 = int2_on_int1;
+      ret = lsm6dsox_write_reg(ctx, LSM6DSOX_CTRL4_C, (uint8_t*)&ctrl4_c, 1);
+    }
+    if (ret == 0) {
+      cur->int2_on_int1 = int2_on_int1;
+    }
+  }
+  if ( (ret == 0) && (cur->interrupts_enable != interrupts_enable) ) {
+    ret = lsm6dsox_read_reg(ctx, LSM6DSOX_TAP_CFG2, (uint8_t*)&tap_cfg2, 1);
+    if (ret == 0) {
+      tap_cfg2.interrupts_enable = interrupts_enable;
+      ret = lsm6dsox_write_reg(ctx, LSM6DSOX_TAP_CFG2,
+                               (uint8_t*)&tap_cfg2, 1);
+    }
+    if (ret == 0) {
+      cur->interrupts_enable = interrupts_enable;
+    }
+  }
+
+  if (ret != 0) {
+    cur->valid = PROPERTY_DISABLE;
+  }
+  return ret;
+}
+
+/**
+  * @brief  Route interrupt signals on int1 and int2 pins.[get]
+  *         Registers are read in bursts (see lsm6dsox_pin_int_route_set).
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  val          the signals routed on int1 and int2 pins.(ptr)
+  * @param  regs         registers image read from the device, can be
+  *                      passed to lsm6dsox_pin_int_route_set().
+  *                      Use NULL to ignore.(ptr)
+  *
+  */
+int32_t lsm6dsox_pin_int_route_get(stmdev_ctx_t *ctx,
+                                   lsm6dsox_pin_int_route_t *val,
+                                   lsm6dsox_pin_int_regs_t *regs)
+{
+  lsm6dsox_emb_func_int1_t emb_func_int1;
+  lsm6dsox_emb_func_int2_t emb_func_int2;
+  lsm6dsox_pin_int_regs_t  image;
+  lsm6dsox_fsm_int1_a_t    fsm_int1_a;
+  lsm6dsox_fsm_int1_b_t    fsm_int1_b;
+  lsm6dsox_fsm_int2_a_t    fsm_int2_a;
+  lsm6dsox_fsm_int2_b_t    fsm_int2_b;
+  lsm6dsox_int1_ctrl_t     int1_ctrl;
+  lsm6dsox_int2_ctrl_t     int2_ctrl;
+  lsm6dsox_mlc_int1_t      mlc_int1;
+  lsm6dsox_mlc_int2_t      mlc_int2;
+  lsm6dsox_md1_cfg_t       md1_cfg;
+  lsm6dsox_md2_cfg_t       md2_cfg;
+  int32_t                  ret;
+
+  if (regs == NULL) {
+    regs = &image;
+  }
+  ret = lsm6dsox_pin_int_regs_read(ctx, regs);
+
+  if (ret == 0) {
+    bytecpy((uint8_t*)&emb_func_int1, &regs->emb_func_int[0]);
+    bytecpy((uint8_t*)&fsm_int1_a, &regs->emb_func_int[1]);
+    bytecpy((uint8_t*)&fsm_int1_b, &regs->emb_func_int[2]);
+    bytecpy((uint8_t*)&mlc_int1, &regs->emb_func_int[3]);
+    bytecpy((uint8_t*)&emb_func_int2, &regs->emb_func_int[4]);
+    bytecpy((uint8_t*)&fsm_int2_a, &regs->emb_func_int[5]);
+    bytecpy((uint8_t*)&fsm_int2_b, &regs->emb_func_int[6]);
+    bytecpy((uint8_t*)&mlc_int2, &regs->emb_func_int[7]);
+    bytecpy((uint8_t*)&int1_ctrl, &regs->int_ctrl[0]);
+    bytecpy((uint8_t*)&int2_ctrl, &regs->int_ctrl[1]);
+    bytecpy((uint8_t*)&md1_cfg, &regs->md_cfg[0]);
+    bytecpy((uint8_t*)&md2_cfg, &regs->md_cfg[1]);
+
+    val->int1.drdy_xl   = int1_ctrl.int1_drdy_xl;
+    val->int1.drdy_g    = int1_ctrl.int1_drdy_g;
+    val->int1.boot      = int1_ctrl.int1_boot;
+    val->int1.fifo_th   = int1_ctrl.int1_fifo_th;
+    val->int1.fifo_ovr  = int1_ctrl.int1_fifo_ovr;
+    val->int1.fifo_full = int1_ctrl.int1_fifo_full;
+    val->int1.fifo_bdr  = int1_ctrl.int1_cnt_bdr;
+    val->int1.den_flag  = int1_ctrl.den_drdy_flag;
+
+    val->int2.drdy_ois  = PROPERTY_DISABLE;
+    val->int2.drdy_xl   = int2_ctrl.int2_drdy_xl;
+    val->int2.drdy_g    = int2_ctrl.int2_drdy_g;
+    val->int2.fifo_th   = int2_ctrl.int2_fifo_th;
+    val->int2.fifo_ovr  = int2_ctrl.int2_fifo_ovr;
+    val->int2.fifo_full = int2_ctrl.int2_fifo_full;
+    val->int2.fifo_bdr  = int2_ctrl.int2_cnt_bdr;
+
+    if (regs->int2_on_int1 == PROPERTY_ENABLE) {
+      val->int1.drdy_temp = int2_ctrl.int2_drdy_temp;
+      val->int1.timestamp = md2_cfg.int2_timestamp;
+      val->int2.drdy_temp = PROPERTY_DISABLE;
+      val->int2.timestamp = PROPERTY_DISABLE;
+    }
+    else {
+      val->int1.drdy_temp = PROPERTY_DISABLE;
+      val->int1.timestamp = PROPERTY_DISABLE;
+      val->int2.drdy_temp = int2_ctrl.int2_drdy_temp;
+      val->int2.timestamp = md2_cfg.int2_timestamp;
+    }
+
+    val->int1.sh_endop     = md1_cfg.int1_shub;
+    val->int1.six_d        = md1_cfg.int1_6d;
+    val->int1.double_tap   = md1_cfg.int1_double_tap;
+    val->int1.free_fall    = md1_cfg.int1_ff;
+    val->int1.wake_up      = md1_cfg.int1_wu;
+    val->int1.single_tap   = md1_cfg.int1_single_tap;
+    val->int1.sleep_change = md1_cfg.int1_sleep_change;
+
+    val->int2.six_d        = md2_cfg.int2_6d;
+    val->int2.double_tap   = md2_cfg.int2_double_tap;
+    val->int2.free_fall    = md2_cfg.int2_ff;
+    val->int2.wake_up      = md2_cfg.int2_wu;
+    val->int2.single_tap   = md2_cfg.int2_single_tap;
+    val->int2.sleep_change = md2_cfg.int2_sleep_change;
+
+    val->int1.step_detector = emb_func_int1.int1_step_detector;
+    val->int1.tilt          = emb_func_int1.int1_tilt;
+    val->int1.sig_mot       = emb_func_int1.int1_sig_mot;
+    val->int1.fsm_lc        = emb_func_int1.int1_fsm_lc;
+
+    val->int2.step_detector = emb_func_int2.int2_step_detector;
+    val->int2.tilt          = emb_func_int2.int2_tilt;
+    val->int2.sig_mot       = emb_func_int2.int2_sig_mot;
+    val->int2.fsm_lc        = emb_func_int2.int2_fsm_lc;
+
+    val->int1.fsm1  = fsm_int1_a.int1_fsm1;
+    val->int1.fsm2  = fsm_int1_a.int1_fsm2;
+    val->int1.fsm3  = fsm_int1_a.int1_fsm3;
+    val->int1.fsm4  = fsm_int1_a.int1_fsm4;
+    val->int1.fsm5  = fsm_int1_a.int1_fsm5;
+    val->int1.fsm6  = fsm_int1_a.int1_fsm6;
+    val->int1.fsm7  = fsm_int1_a.int1_fsm7;
+    val->int1.fsm8  = fsm_int1_a.int1_fsm8;
+    val->int1.fsm9  = fsm_int1_b.int1_fsm9;
+    val->int1.fsm10 = fsm_int1_b.int1_fsm10;
+    val->int1.fsm11 = fsm_int1_b.int1_fsm11;
+    val->int1.fsm12 = fsm_int1_b.int1_fsm12;
+    val->int1.fsm13 = fsm_int1_b.int1_fsm13;
+    val->int1.fsm14 = fsm_int1_b.int1_fsm14;
+    val->int1.fsm15 = fsm_int1_b.int1_fsm15;
+    val->int1.fsm16 = fsm_int1_b.int1_fsm16;
+
+    val->int2.fsm1  = fsm_int2_a.int2_fsm1;
+    val->int2.fsm2  = fsm_int2_a.int2_fsm2;
+    val->int2.fsm3  = fsm_int2_a.int2_fsm3;
+    val->int2.fsm4  = fsm_int2_a.int2_fsm4;
+    val->int2.fsm5  = fsm_int2_a.int2_fsm5;
+    val->int2.fsm6  = fsm_int2_a.int2_fsm6;
+    val->int2.fsm7  = fsm_int2_a.int2_fsm7;
+    val->int2.fsm8  = fsm_int2_a.int2_fsm8;
+    val->int2.fsm9  = fsm_int2_b.int2_fsm9;
+    val->int2.fsm10 = fsm_int2_b.int2_fsm10;
+    val->int2.fsm11 = fsm_int2_b.int2_fsm11;
+    val->int2.fsm12 = fsm_int2_b.int2_fsm12;
+    val->int2.fsm13 = fsm_int2_b.int2_fsm13;
+    val->int2.fsm14 = fsm_int2_b.int2_fsm14;
+    val->int2.fsm15 = fsm_int2_b.int2_fsm15;
+    val->int2.fsm16 = fsm_int2_b.int2_fsm16;
+
+    val->int1.mlc1 = mlc_int1.int1_mlc1;
+    val->int1.mlc2 = mlc_int1.int1_mlc2;
+    val->int1.mlc3 = mlc_int1.int1_mlc3;
+    val->int1.mlc4 = mlc_int1.int1_mlc4;
+    val->int1.mlc5 = mlc_int1.int1_mlc5;
+    val->int1.mlc6 = mlc_int1.int1_mlc6;
+    val->int1.mlc7 = mlc_int1.int1_mlc7;
+    val->int1.mlc8 = mlc_int1.int1_mlc8;
+
+    val->int2.mlc1 = mlc_int2.int2_mlc1;
+    val->int2.mlc2 = mlc_int2.int2_mlc2;
+    val->int2.mlc3 = mlc_int2.int2_mlc3;
+    val->int2.mlc4 = mlc_int2.int2_mlc4;
+    val->int2.mlc5 = mlc_int2.int2_mlc5;
+    val->int2.mlc6 = mlc_int2.int2_mlc6;
+    val->int2.mlc7 = mlc_int2.int2_mlc7;
+    val->int2.mlc8 = mlc_int2.int2_mlc8;
+  }
+
+  return ret;
+}
+
+#ifndef LSM6DSOX_NO_ALL_SOURCES
 /**
   * @brief  Get the status of all the interrupt sources.[get]
   *
@@ -10764,7 +11652,9 @@ int32_t lsm6dsox_all_sources_get(stmdev_ctx_t *ctx,
 
   return ret;
 }
+#endif /* LSM6DSOX_NO_ALL_SOURCES */
 
+#ifndef LSM6DSOX_NO_MODE
 /**
   * @brief  Sensor conversion parameters selection.[set]
   *
@@ -11870,6 +12760,7 @@ int32_t lsm6dsox_data_get(stmdev_ctx_t *ctx, stmdev_ctx_t *aux_ctx,
 
   return ret;
 }
+#endif /* LSM6DSOX_NO_MODE */
 
 
 /**
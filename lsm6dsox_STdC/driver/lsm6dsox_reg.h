@@ -127,6 +127,37 @@ typedef struct {
 /** Device Identification (Who am I) **/
 #define LSM6DSOX_ID                           0x6CU
 
+/**
+  * @}
+  *
+  */
+
+/** @defgroup LSM6DSOX_Features_selection
+  * @brief    Define one or more of the following macros (i.e. in the
+  *           compiler command line) to remove the corresponding set of
+  *           functions from lsm6dsox_reg.c when it is not used by the
+  *           application. Registers definitions are never removed.
+  *
+  *           LSM6DSOX_NO_OIS         : lsm6dsox_ois_* and lsm6dsox_aux_*
+  *           LSM6DSOX_NO_SENSOR_HUB  : lsm6dsox_sh_* (master and batching)
+  *           LSM6DSOX_NO_FSM         : lsm6dsox_fsm_*, lsm6dsox_long_cnt_*
+  *                                     and lsm6dsox_emb_fsm_*
+  *           LSM6DSOX_NO_MLC         : lsm6dsox_mlc_* (except the
+  *                                     magnetometer sensitivity)
+  *           LSM6DSOX_NO_PEDOMETER   : lsm6dsox_pedo_*, step counter and
+  *                                     step counter batching
+  *           LSM6DSOX_NO_TAP         : lsm6dsox_tap_*
+  *           LSM6DSOX_NO_MODE        : lsm6dsox_mode_set / mode_get and
+  *                                     lsm6dsox_data_get
+  *           LSM6DSOX_NO_ALL_SOURCES : lsm6dsox_all_sources_get
+  *
+  *           When LSM6DSOX_NO_FSM or LSM6DSOX_NO_MLC are defined the
+  *           accelerometer and gyroscope data rate setters don't check
+  *           anymore the FSM / MLC data rate constraints.
+  * @{
+  *
+  */
+
 /**
   * @}
   *
@@ -1824,6 +1855,18 @@ int32_t lsm6dsox_xl_usr_offset_z_get(stmdev_ctx_t *ctx, uint8_t *buff);
 int32_t lsm6dsox_xl_usr_offset_set(stmdev_ctx_t *ctx, uint8_t val);
 int32_t lsm6dsox_xl_usr_offset_get(stmdev_ctx_t *ctx, uint8_t *val);
 
+typedef struct {
+  float_t noise_mg;         /* input: max std deviation, 0 = no check */
+  float_t bias_mg[3];       /* estimated bias (with previous offset) */
+  uint8_t offset[3];        /* X/Y/Z_OFS_USR, two's complement */
+  lsm6dsox_usr_off_w_t weight;
+  uint8_t gravity_axis;     /* 0: x, 1: y, 2: z */
+  uint8_t done;             /* 1: registers written */
+} lsm6dsox_xl_offset_cal_t;
+int32_t lsm6dsox_xl_offset_calibrate(stmdev_ctx_t *ctx, const int16_t *raw,
+                                     uint16_t num,
+                                     lsm6dsox_xl_offset_cal_t *val);
+
 int32_t lsm6dsox_timestamp_rst(stmdev_ctx_t *ctx);
 
 int32_t lsm6dsox_timestamp_set(stmdev_ctx_t *ctx, uint8_t val);
@@ -1857,6 +1900,10 @@ int32_t lsm6dsox_angular_rate_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t lsm6dsox_acceleration_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
+int32_t lsm6dsox_data_drdy_raw_get(stmdev_ctx_t *ctx,
+                                   lsm6dsox_status_reg_t *status,
+                                   uint8_t *temp, uint8_t *gy, uint8_t *xl);
+
 int32_t lsm6dsox_fifo_out_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t lsm6dsox_ois_angular_rate_raw_get(stmdev_ctx_t *ctx, uint8_t *buff);
@@ -1886,6 +1933,24 @@ typedef enum {
 int32_t lsm6dsox_mem_bank_set(stmdev_ctx_t *ctx, lsm6dsox_reg_access_t val);
 int32_t lsm6dsox_mem_bank_get(stmdev_ctx_t *ctx, lsm6dsox_reg_access_t *val);
 
+/**
+  * @brief  Embedded functions / sensor hub bank session: the driver APIs
+  *         called with session.ctx keep FUNC_CFG_ACCESS in a shadow
+  *         register and write it to the device only when a register of a
+  *         different bank is accessed, so consecutive embedded functions
+  *         settings do a single bank switch.
+  *         The session must not be moved between start and stop.
+  */
+typedef struct {
+  stmdev_ctx_t ctx;              /* context to be used in the session */
+  stmdev_ctx_t *bus;             /* device context */
+  uint8_t func_cfg_access;       /* FUNC_CFG_ACCESS value in the device */
+  uint8_t shadow;                /* FUNC_CFG_ACCESS value requested */
+} lsm6dsox_bank_session_t;
+int32_t lsm6dsox_bank_session_start(stmdev_ctx_t *ctx,
+                                    lsm6dsox_bank_session_t *session);
+int32_t lsm6dsox_bank_session_stop(lsm6dsox_bank_session_t *session);
+
 int32_t lsm6dsox_ln_pg_write_byte(stmdev_ctx_t *ctx, uint16_t address,
                                   uint8_t *val);
 int32_t lsm6dsox_ln_pg_read_byte(stmdev_ctx_t *ctx, uint16_t address,
@@ -3052,6 +3117,27 @@ int32_t lsm6dsox_pin_int2_route_set(stmdev_ctx_t *ctx, stmdev_ctx_t *aux_ctx,
 int32_t lsm6dsox_pin_int2_route_get(stmdev_ctx_t *ctx, stmdev_ctx_t *aux_ctx,
                                     lsm6dsox_pin_int2_route_t *val);
 
+typedef struct {
+  lsm6dsox_pin_int1_route_t int1;
+  lsm6dsox_pin_int2_route_t int2; /* drdy_ois not handled, see aux_ctx */
+} lsm6dsox_pin_int_route_t;
+
+typedef struct {
+  uint8_t emb_func_int[8];    /* EMB_FUNC_INT1 .. MLC_INT2 */
+  uint8_t int_ctrl[2];        /* INT1_CTRL, INT2_CTRL */
+  uint8_t md_cfg[2];          /* MD1_CFG, MD2_CFG */
+  uint8_t int2_on_int1;       /* CTRL4_C */
+  uint8_t interrupts_enable;  /* TAP_CFG2 */
+  uint8_t valid;              /* 0: read the registers from device */
+} lsm6dsox_pin_int_regs_t;
+
+int32_t lsm6dsox_pin_int_route_set(stmdev_ctx_t *ctx,
+                                   lsm6dsox_pin_int_route_t val,
+                                   lsm6dsox_pin_int_regs_t *regs);
+int32_t lsm6dsox_pin_int_route_get(stmdev_ctx_t *ctx,
+                                   lsm6dsox_pin_int_route_t *val,
+                                   lsm6dsox_pin_int_regs_t *regs);
+
 typedef struct {
   uint8_t drdy_xl          :  1; /* Accelerometer data ready */
   uint8_t drdy_g           :  1; /* Gyroscope data ready */
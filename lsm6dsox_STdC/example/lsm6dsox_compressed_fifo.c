@@ -86,16 +86,11 @@
  * in FIFO are stored acc, gyro and timestamp samples
  */
 #define FIFO_WATERMARK    10
-#define FIFO_COMPRESSION  3
-#define SLOT_NUMBER      (FIFO_WATERMARK * FIFO_COMPRESSION)
 
 /* Private variables ---------------------------------------------------------*/
 static uint8_t whoamI, rst;
 static uint8_t tx_buffer[1000];
-static st_fifo_raw_slot raw_slot[SLOT_NUMBER];
-static st_fifo_out_slot out_slot[SLOT_NUMBER];
-static st_fifo_out_slot acc_slot[SLOT_NUMBER];
-static st_fifo_out_slot gyr_slot[SLOT_NUMBER];
+static st_fifo_stream fifo_stream;
 
 /* Extern variables ----------------------------------------------------------*/
 
@@ -114,6 +109,7 @@ static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
 static void tx_com( uint8_t *tx_buffer, uint16_t len );
 static void platform_delay(uint32_t ms);
 static void platform_init(void);
+static void fifo_slot_print(const st_fifo_out_slot *slot, void *arg);
 
 sensor_data_t sensor_data;
 
@@ -121,7 +117,6 @@ sensor_data_t sensor_data;
 void lsm6dsox_compressed_fifo(void)
 {
   stmdev_ctx_t dev_ctx;
-  uint16_t out_slot_size;
 
   /* Uncomment to configure INT 1 */
   //lsm6dsox_pin_int1_route_t int1_route;
@@ -140,8 +135,11 @@ void lsm6dsox_compressed_fifo(void)
   /* Wait sensor boot time */
   platform_delay(10);
 
-  /* Init utility for FIFO decompression */
-  st_fifo_init(0, 0, 0);
+  /*
+   * Init utility for FIFO decompression: FIFO words are decoded while
+   * they are read, the decoded samples are printed by fifo_slot_print()
+   */
+  st_fifo_stream_init(&fifo_stream, 0, 0, 0, fifo_slot_print, NULL, NULL);
 
   /* Check device ID */
   lsm6dsox_device_id_get(&dev_ctx, &whoamI);
@@ -207,9 +205,8 @@ void lsm6dsox_compressed_fifo(void)
   {
     uint16_t num = 0;
     uint8_t wmflag = 0;
-    uint16_t slots = 0;
-    uint16_t acc_samples;
-    uint16_t gyr_samples;
+    uint8_t fifo_word[7];
+    uint32_t used;
 
   /* Read watermark flag */
     lsm6dsox_fifo_wtm_flag_get(&dev_ctx, &wmflag);
@@ -226,56 +223,50 @@ void lsm6dsox_compressed_fifo(void)
          * LSM6DSOX_FIFO_DATA_OUT_TAG, including tag counter and parity.
          */
         lsm6dsox_read_reg(&dev_ctx, LSM6DSOX_FIFO_DATA_OUT_TAG,
-                         (uint8_t *)&raw_slot[slots].fifo_data_out[0], 1);
+                          &fifo_word[0], 1);
 
         /* Read FIFO sensor value */
-        lsm6dsox_fifo_out_raw_get(&dev_ctx, &raw_slot[slots].fifo_data_out[1]);
-        slots++;
-      }
+        lsm6dsox_fifo_out_raw_get(&dev_ctx, &fifo_word[1]);
 
-      /* Uncompress FIFO samples and filter based on sensor type */
-      st_fifo_decompress(out_slot, raw_slot, &out_slot_size, slots);
-      st_fifo_sort(out_slot, out_slot_size);
-      acc_samples = st_fifo_get_sensor_occurrence(out_slot,
-                                                  out_slot_size,
-                                                  ST_FIFO_ACCELEROMETER);
-      gyr_samples = st_fifo_get_sensor_occurrence(out_slot,
-                                                  out_slot_size,
-                                                  ST_FIFO_GYROSCOPE);
-      /* Count how many acc and gyro samples */
-      st_fifo_extract_sensor(acc_slot, out_slot,out_slot_size,
-                             ST_FIFO_ACCELEROMETER);
-      st_fifo_extract_sensor(gyr_slot, out_slot, out_slot_size,
-                             ST_FIFO_GYROSCOPE);
-
-      for (int i = 0; i < acc_samples; i++)
-      {
-        memcpy( sensor_data.raw_data, acc_slot[i].raw_data, sizeof(sensor_data) );
-
-        sprintf((char*)tx_buffer, "ACC:\t%u\t%d\t%4.2f\t%4.2f\t%4.2f\r\n",
-                (unsigned int)acc_slot[i].timestamp,
-                 acc_slot[i].sensor_tag,
-                 lsm6dsox_from_fs2_to_mg(sensor_data.data[0]),
-                 lsm6dsox_from_fs2_to_mg(sensor_data.data[1]),
-                 lsm6dsox_from_fs2_to_mg(sensor_data.data[2]));
-        tx_com(tx_buffer, strlen((char const*)tx_buffer));
+        /* Uncompress FIFO word, up to 3 samples */
+        st_fifo_stream_feed(&fifo_stream, fifo_word, 7, &used);
       }
+    }
+  }
+}
 
-      for (int i = 0; i < gyr_samples; i++)
-      {
-        memcpy( sensor_data.raw_data, gyr_slot[i].raw_data, sizeof(sensor_data) );
-
-        sprintf((char*)tx_buffer, "GYR:\t%u\t%d\t%4.2f\t%4.2f\t%4.2f\r\n",
-                (unsigned int)gyr_slot[i].timestamp,
-                gyr_slot[i].sensor_tag,
-                lsm6dsox_from_fs2000_to_mdps(sensor_data.data[0]),
-                lsm6dsox_from_fs2000_to_mdps(sensor_data.data[1]),
-                lsm6dsox_from_fs2000_to_mdps(sensor_data.data[2]));
-        tx_com(tx_buffer, strlen((char const*)tx_buffer));
-      }
+/*
+ * @brief  Print a decoded FIFO sample (acc and gyro only)
+ *
+ * @param  slot      decoded sample
+ * @param  arg       not used
+ *
+ */
+static void fifo_slot_print(const st_fifo_out_slot *slot, void *arg)
+{
+  (void)arg;
 
-      slots = 0;
-    }
+  memcpy( sensor_data.raw_data, slot->raw_data, sizeof(sensor_data) );
+
+  if (slot->sensor_tag == ST_FIFO_ACCELEROMETER)
+  {
+    sprintf((char*)tx_buffer, "ACC:\t%u\t%d\t%4.2f\t%4.2f\t%4.2f\r\n",
+            (unsigned int)slot->timestamp,
+            slot->sensor_tag,
+            lsm6dsox_from_fs2_to_mg(sensor_data.data[0]),
+            lsm6dsox_from_fs2_to_mg(sensor_data.data[1]),
+            lsm6dsox_from_fs2_to_mg(sensor_data.data[2]));
+    tx_com(tx_buffer, strlen((char const*)tx_buffer));
+  }
+  else if (slot->sensor_tag == ST_FIFO_GYROSCOPE)
+  {
+    sprintf((char*)tx_buffer, "GYR:\t%u\t%d\t%4.2f\t%4.2f\t%4.2f\r\n",
+            (unsigned int)slot->timestamp,
+            slot->sensor_tag,
+            lsm6dsox_from_fs2000_to_mdps(sensor_data.data[0]),
+            lsm6dsox_from_fs2000_to_mdps(sensor_data.data[1]),
+            lsm6dsox_from_fs2000_to_mdps(sensor_data.data[2]));
+    tx_com(tx_buffer, strlen((char const*)tx_buffer));
   }
 }
 
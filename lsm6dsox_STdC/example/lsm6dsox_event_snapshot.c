@@ -0,0 +1,439 @@
+/*
+ ******************************************************************************
+ * @file    lsm6dsox_event_snapshot.c
+ * @author  Sensors Software Solution Team
+ * @brief   This file shows how to get the accelerometer samples
+ *          preceding tap, free-fall and 6D events from sensor FIFO.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/*
+ * This example was developed using the following STMicroelectronics
+ * evaluation boards:
+ *
+ * - STEVAL_MKI109V3 + STEVAL-MKI197V1
+ * - NUCLEO_F411RE + STEVAL-MKI197V1
+ *
+ * and STM32CubeMX tool with STM32CubeF4 MCU Package
+ *
+ * Used interfaces:
+ *
+ * STEVAL_MKI109V3    - Host side:   USB (Virtual COM)
+ *                    - Sensor side: SPI(Default) / I2C(supported)
+ *
+ * NUCLEO_STM32F411RE - Host side: UART(COM) to USB bridge
+ *                    - I2C(Default) / SPI(supported)
+ *
+ * If you need to run this example on a different hardware platform a
+ * modification of the functions: `platform_write`, `platform_read`,
+ * `tx_com` and 'platform_init' is required.
+ *
+ */
+
+/* STMicroelectronics evaluation boards definition
+ *
+ * Please uncomment ONLY the evaluation boards in use.
+ * If a different hardware is used please comment all
+ * following target board and redefine yours.
+ */
+//#define STEVAL_MKI109V3
+#define NUCLEO_F411RE_X_NUCLEO_IKS01A2
+
+#if defined(STEVAL_MKI109V3)
+/* MKI109V3: Define communication interface */
+#define SENSOR_BUS hspi2
+
+/* MKI109V3: Vdd and Vddio power supply values */
+#define PWM_3V3 915
+
+#elif defined(NUCLEO_F411RE_X_NUCLEO_IKS01A2)
+/* NUCLEO_F411RE_X_NUCLEO_IKS01A2: Define communication interface */
+#define SENSOR_BUS hi2c1
+
+/* Platform STM32F411RE + IKS01A2 Interrupt PIN */
+#define LSM6DSOX_INT1_PIN GPIO_PIN_0
+#define LSM6DSOX_INT1_GPIO_PORT GPIOC
+
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <stdio.h>
+
+#include "stm32f4xx_hal.h"
+#include <lsm6dsox_reg.h>
+#include "gpio.h"
+#include "i2c.h"
+#if defined(STEVAL_MKI109V3)
+#include "usbd_cdc_if.h"
+#include "spi.h"
+#elif defined(NUCLEO_F411RE_X_NUCLEO_IKS01A2)
+#include "usart.h"
+#endif
+
+typedef union{
+  int16_t i16bit[3];
+  uint8_t u8bit[6];
+} axis3bit16_t;
+
+/* Private macro -------------------------------------------------------------*/
+/* Accelerometer samples kept before the event (at 417 Hz, ~77 ms) */
+#define SNAPSHOT_SAMPLES     32
+#define FIFO_WORD_LEN        7
+
+/* Event record flags */
+#define EVENT_SINGLE_TAP     0x01U
+#define EVENT_DOUBLE_TAP     0x02U
+#define EVENT_FREE_FALL      0x04U
+#define EVENT_SIX_D          0x08U
+
+typedef struct {
+  uint32_t timestamp;         /* device timestamp, 1 LSb = 25 us */
+  uint8_t event;              /* EVENT_xxx flags */
+  uint8_t tap_axis;           /* 'X', 'Y' or 'Z' */
+  uint8_t tap_sign;           /* 0: positive, 1: negative */
+  uint8_t six_d;              /* ZH ZL YH YL XH XL bits (D6D_SRC) */
+  uint16_t num;               /* samples in snapshot */
+  int16_t xl[SNAPSHOT_SAMPLES][3];  /* oldest first */
+} event_record_t;
+
+/* Private variables ---------------------------------------------------------*/
+static float acceleration_mg[3];
+static uint8_t whoamI, rst;
+static uint8_t tx_buffer[1000];
+static uint8_t fifo_buffer[SNAPSHOT_SAMPLES * FIFO_WORD_LEN];
+static event_record_t record;
+
+/* Extern variables ----------------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/*
+ *   WARNING:
+ *   Functions declare in this section are defined at the end of this file
+ *   and are strictly related to the hardware platform used.
+ *
+ */
+static int32_t platform_write(void *handle, uint8_t reg, uint8_t *bufp,
+                              uint16_t len);
+static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
+                             uint16_t len);
+static void tx_com( uint8_t *tx_buffer, uint16_t len );
+static void platform_delay(uint32_t ms);
+static void platform_init(void);
+static int32_t platform_read_int_pin(void);
+
+static void snapshot_get(stmdev_ctx_t *ctx, event_record_t *rec);
+
+/* Main Example --------------------------------------------------------------*/
+void example_main_event_snapshot_lsm6dsox(void)
+{
+  stmdev_ctx_t dev_ctx;
+  lsm6dsox_pin_int_route_t int_route;
+  lsm6dsox_pin_int_regs_t int_regs;
+  uint16_t i;
+
+  /* Initialize mems driver interface */
+  dev_ctx.write_reg = platform_write;
+  dev_ctx.read_reg = platform_read;
+  dev_ctx.handle = &SENSOR_BUS;
+
+  /* Init test platform */
+  platform_init();
+
+  /* Wait sensor boot time */
+  platform_delay(10);
+
+  /* Check device ID */
+  lsm6dsox_device_id_get(&dev_ctx, &whoamI);
+  if (whoamI != LSM6DSOX_ID)
+    while(1);
+
+  /* Restore default configuration */
+  lsm6dsox_reset_set(&dev_ctx, PROPERTY_ENABLE);
+  do {
+    lsm6dsox_reset_get(&dev_ctx, &rst);
+  } while (rst);
+
+  /* Disable I3C interface */
+  lsm6dsox_i3c_disable_set(&dev_ctx, LSM6DSOX_I3C_DISABLE);
+
+  /* Enable Block Data Update */
+  lsm6dsox_block_data_update_set(&dev_ctx, PROPERTY_ENABLE);
+
+  /* Set 2g full XL scale */
+  lsm6dsox_xl_full_scale_set(&dev_ctx, LSM6DSOX_2g);
+
+  /* Enable timestamp, used to date the event records */
+  lsm6dsox_timestamp_set(&dev_ctx, PROPERTY_ENABLE);
+
+  /* Latched interrupts: event sources are read after the pin rises */
+  lsm6dsox_int_notification_set(&dev_ctx, LSM6DSOX_ALL_INT_LATCHED);
+
+  /* Single and double tap on X, Y, Z, threshold 500 mg */
+  lsm6dsox_tap_detection_on_z_set(&dev_ctx, PROPERTY_ENABLE);
+  lsm6dsox_tap_detection_on_y_set(&dev_ctx, PROPERTY_ENABLE);
+  lsm6dsox_tap_detection_on_x_set(&dev_ctx, PROPERTY_ENABLE);
+  lsm6dsox_tap_threshold_x_set(&dev_ctx, 0x08);
+  lsm6dsox_tap_threshold_y_set(&dev_ctx, 0x08);
+  lsm6dsox_tap_threshold_z_set(&dev_ctx, 0x08);
+  lsm6dsox_tap_dur_set(&dev_ctx, 0x07);
+  lsm6dsox_tap_quiet_set(&dev_ctx, 0x03);
+  lsm6dsox_tap_shock_set(&dev_ctx, 0x03);
+  lsm6dsox_tap_mode_set(&dev_ctx, LSM6DSOX_BOTH_SINGLE_DOUBLE);
+
+  /* Free fall: 312 mg threshold, 6 samples duration */
+  lsm6dsox_ff_dur_set(&dev_ctx, 0x06);
+  lsm6dsox_ff_threshold_set(&dev_ctx, LSM6DSOX_FF_TSH_312mg);
+
+  /* 6D orientation: 60 degrees threshold on LPF2 output */
+  lsm6dsox_6d_threshold_set(&dev_ctx, LSM6DSOX_DEG_60);
+  lsm6dsox_xl_lp2_on_6d_set(&dev_ctx, PROPERTY_ENABLE);
+
+  /*
+   * FIFO in continuous mode with depth limited to the watermark (stop
+   * on watermark): the FIFO always holds the last SNAPSHOT_SAMPLES
+   * accelerometer samples, oldest ones are overwritten and no host
+   * access is needed until an event occurs.
+   */
+  lsm6dsox_fifo_watermark_set(&dev_ctx, SNAPSHOT_SAMPLES);
+  lsm6dsox_fifo_stop_on_wtm_set(&dev_ctx, PROPERTY_ENABLE);
+  lsm6dsox_fifo_xl_batch_set(&dev_ctx, LSM6DSOX_XL_BATCHED_AT_417Hz);
+  lsm6dsox_fifo_mode_set(&dev_ctx, LSM6DSOX_STREAM_MODE);
+
+  /* All the events on INT1 pin */
+  int_regs.valid = 0;
+  lsm6dsox_pin_int_route_get(&dev_ctx, &int_route, &int_regs);
+  int_route.int1.single_tap = PROPERTY_ENABLE;
+  int_route.int1.double_tap = PROPERTY_ENABLE;
+  int_route.int1.free_fall = PROPERTY_ENABLE;
+  int_route.int1.six_d = PROPERTY_ENABLE;
+  lsm6dsox_pin_int_route_set(&dev_ctx, int_route, &int_regs);
+
+  /* Set XL Output Data Rate to 417 Hz */
+  lsm6dsox_xl_data_rate_set(&dev_ctx, LSM6DSOX_XL_ODR_417Hz);
+
+  /* Wait Events */
+  while(1)
+  {
+    /* No bus access while waiting */
+    if (platform_read_int_pin() == 0)
+      continue;
+
+    snapshot_get(&dev_ctx, &record);
+    if (record.event == 0U)
+      continue;
+
+    sprintf((char*)tx_buffer, "Event %s%s%s%s at %lu us, %d samples\r\n",
+            (record.event & EVENT_SINGLE_TAP) ? "single-tap " : "",
+            (record.event & EVENT_DOUBLE_TAP) ? "double-tap " : "",
+            (record.event & EVENT_FREE_FALL) ? "free-fall " : "",
+            (record.event & EVENT_SIX_D) ? "6D " : "",
+            (unsigned long)record.timestamp * 25UL, record.num);
+    tx_com(tx_buffer, strlen((char const*)tx_buffer));
+
+    for (i = 0; i < record.num; i++)
+    {
+      acceleration_mg[0] = lsm6dsox_from_fs2_to_mg(record.xl[i][0]);
+      acceleration_mg[1] = lsm6dsox_from_fs2_to_mg(record.xl[i][1]);
+      acceleration_mg[2] = lsm6dsox_from_fs2_to_mg(record.xl[i][2]);
+
+      sprintf((char*)tx_buffer, "Acceleration [mg]:%4.2f\t%4.2f\t%4.2f\r\n",
+              acceleration_mg[0], acceleration_mg[1], acceleration_mg[2]);
+      tx_com(tx_buffer, strlen((char const*)tx_buffer));
+    }
+  }
+}
+
+/*
+ * @brief  Build the event record: read (and clear) the latched event
+ *         sources, the timestamp and then the FIFO content with a
+ *         single burst (the address rolls back from FIFO_DATA_OUT_Z_H
+ *         to FIFO_DATA_OUT_TAG on multiple reads).
+ *
+ * @param  ctx       read / write interface definitions
+ * @param  rec       event record
+ *
+ */
+static void snapshot_get(stmdev_ctx_t *ctx, event_record_t *rec)
+{
+  lsm6dsox_all_sources_t all_source;
+  uint8_t buff[4];
+  uint16_t num;
+  uint16_t i;
+
+  lsm6dsox_all_sources_get(ctx, &all_source);
+  lsm6dsox_timestamp_raw_get(ctx, buff);
+  lsm6dsox_fifo_data_level_get(ctx, &num);
+
+  rec->timestamp = (uint32_t)buff[3];
+  rec->timestamp = (rec->timestamp * 256U) + (uint32_t)buff[2];
+  rec->timestamp = (rec->timestamp * 256U) + (uint32_t)buff[1];
+  rec->timestamp = (rec->timestamp * 256U) + (uint32_t)buff[0];
+
+  rec->event = 0;
+  if (all_source.single_tap)
+    rec->event |= EVENT_SINGLE_TAP;
+  if (all_source.double_tap)
+    rec->event |= EVENT_DOUBLE_TAP;
+  if (all_source.free_fall)
+    rec->event |= EVENT_FREE_FALL;
+  if (all_source.six_d)
+    rec->event |= EVENT_SIX_D;
+
+  rec->tap_axis = all_source.tap_x ? 'X' : (all_source.tap_y ? 'Y' : 'Z');
+  rec->tap_sign = all_source.tap_sign;
+  rec->six_d = (uint8_t)((all_source.six_d_zh << 5) |
+                         (all_source.six_d_zl << 4) |
+                         (all_source.six_d_yh << 3) |
+                         (all_source.six_d_yl << 2) |
+                         (all_source.six_d_xh << 1) |
+                         all_source.six_d_xl);
+
+  if (num > SNAPSHOT_SAMPLES)
+    num = SNAPSHOT_SAMPLES;
+
+  lsm6dsox_read_reg(ctx, LSM6DSOX_FIFO_DATA_OUT_TAG, fifo_buffer,
+                    num * FIFO_WORD_LEN);
+
+  rec->num = 0;
+  for (i = 0; i < num; i++)
+  {
+    uint8_t *word = &fifo_buffer[i * FIFO_WORD_LEN];
+
+    if ((word[0] >> 3) == LSM6DSOX_XL_NC_TAG)
+    {
+      memcpy(rec->xl[rec->num], &word[1], 3 * sizeof(int16_t));
+      rec->num++;
+    }
+  }
+}
+
+/*
+ * @brief  Write generic device register (platform dependent)
+ *
+ * @param  handle    customizable argument. In this examples is used in
+ *                   order to select the correct sensor bus handler.
+ * @param  reg       register to write
+ * @param  bufp      pointer to data to write in register reg
+ * @param  len       number of consecutive register to write
+ *
+ */
+static int32_t platform_write(void *handle, uint8_t reg, uint8_t *bufp,
+                              uint16_t len)
+{
+  if (handle == &hi2c1)
+  {
+    HAL_I2C_Mem_Write(handle, LSM6DSOX_I2C_ADD_L, reg,
+                      I2C_MEMADD_SIZE_8BIT, bufp, len, 1000);
+  }
+#ifdef STEVAL_MKI109V3
+  else if (handle == &hspi2)
+  {
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_RESET);
+    HAL_SPI_Transmit(handle, &reg, 1, 1000);
+    HAL_SPI_Transmit(handle, bufp, len, 1000);
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_SET);
+  }
+#endif
+  return 0;
+}
+
+/*
+ * @brief  Read generic device register (platform dependent)
+ *
+ * @param  handle    customizable argument. In this examples is used in
+ *                   order to select the correct sensor bus handler.
+ * @param  reg       register to read
+ * @param  bufp      pointer to buffer that store the data read
+ * @param  len       number of consecutive register to read
+ *
+ */
+static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
+                             uint16_t len)
+{
+  if (handle == &hi2c1)
+  {
+    HAL_I2C_Mem_Read(handle, LSM6DSOX_I2C_ADD_L, reg,
+                     I2C_MEMADD_SIZE_8BIT, bufp, len, 1000);
+  }
+#ifdef STEVAL_MKI109V3
+  else if (handle == &hspi2)
+  {
+    /* Read command */
+    reg |= 0x80;
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_RESET);
+    HAL_SPI_Transmit(handle, &reg, 1, 1000);
+    HAL_SPI_Receive(handle, bufp, len, 1000);
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_SET);
+  }
+#endif
+  return 0;
+}
+
+/*
+ * @brief  Write generic device register (platform dependent)
+ *
+ * @param  tx_buffer     buffer to trasmit
+ * @param  len           number of byte to send
+ *
+ */
+static void tx_com(uint8_t *tx_buffer, uint16_t len)
+{
+  #ifdef NUCLEO_F411RE_X_NUCLEO_IKS01A2
+  HAL_UART_Transmit(&huart2, tx_buffer, len, 1000);
+  #endif
+  #ifdef STEVAL_MKI109V3
+  CDC_Transmit_FS(tx_buffer, len);
+  #endif
+}
+
+/*
+ * @brief  platform specific delay (platform dependent)
+ *
+ * @param  ms        delay in ms
+ *
+ */
+static void platform_delay(uint32_t ms)
+{
+  HAL_Delay(ms);
+}
+
+/*
+ * @brief  platform specific initialization (platform dependent)
+ */
+static void platform_init(void)
+{
+#ifdef STEVAL_MKI109V3
+  TIM3->CCR1 = PWM_3V3;
+  TIM3->CCR2 = PWM_3V3;
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);
+  HAL_Delay(1000);
+#endif
+}
+
+/*
+ * @brief  Read interrupt pin INT1 (platform dependent)
+ *
+ */
+static int32_t platform_read_int_pin(void)
+{
+#ifdef NUCLEO_F411RE_X_NUCLEO_IKS01A2
+  return HAL_GPIO_ReadPin(LSM6DSOX_INT1_GPIO_PORT, LSM6DSOX_INT1_PIN);
+#else
+  return 1;
+#endif
+}
@@ -89,6 +89,7 @@ typedef union{
 } axis1bit16_t;
 
 /* Private macro -------------------------------------------------------------*/
+#define CAL_SAMPLES    64
 
 /* Private variables ---------------------------------------------------------*/
 static axis3bit16_t data_raw_acceleration;
@@ -99,6 +100,7 @@ static float angular_rate_mdps[3];
 static float temperature_degC;
 static uint8_t whoamI, rst;
 static uint8_t tx_buffer[1000];
+static int16_t cal_raw[CAL_SAMPLES][3];
 
 /* Extern variables ----------------------------------------------------------*/
 
@@ -123,8 +125,9 @@ void example_main_simple_offset_lsm6dsox(void)
 {
   stmdev_ctx_t dev_ctx;
 
-  /* Example of XL offset to apply to acc. output */
-  uint8_t offset[3] = { 0x30, 0x40, 0x7E };
+  lsm6dsox_xl_offset_cal_t cal;
+  uint16_t num;
+  uint8_t wtm;
 
   /* Initialize mems driver interface */
   dev_ctx.write_reg = platform_write;
@@ -154,26 +157,61 @@ void example_main_simple_offset_lsm6dsox(void)
   /* Enable Block Data Update */
   lsm6dsox_block_data_update_set(&dev_ctx, PROPERTY_ENABLE);
 
-  /* Weight of XL user offset to 2^(-10) g/LSB */
-  lsm6dsox_xl_offset_weight_set(&dev_ctx, LSM6DSOX_LSb_1mg);
+  /* Set full scale */
+  lsm6dsox_xl_full_scale_set(&dev_ctx, LSM6DSOX_2g);
+  lsm6dsox_gy_full_scale_set(&dev_ctx, LSM6DSOX_2000dps);
 
   /*
-   * Accelerometer X,Y,Z axis user offset correction expressed
-   * in two’s complement. Set X to 48mg, Y tp 64 mg, Z to -127 mg
+   * Accelerometer offset calibration: device must be kept still.
+   * Collect CAL_SAMPLES accelerometer samples through the FIFO and
+   * write the measured bias (gravity removed from the axis closest
+   * to the vertical) into X/Y/Z_OFS_USR with one call.
    */
-  lsm6dsox_xl_usr_offset_x_set(&dev_ctx, &offset[0]);
-  lsm6dsox_xl_usr_offset_y_set(&dev_ctx, &offset[1]);
-  lsm6dsox_xl_usr_offset_z_set(&dev_ctx, &offset[2]);
-  lsm6dsox_xl_usr_offset_set(&dev_ctx, PROPERTY_ENABLE);
+  lsm6dsox_fifo_watermark_set(&dev_ctx, CAL_SAMPLES);
+  lsm6dsox_fifo_xl_batch_set(&dev_ctx, LSM6DSOX_XL_BATCHED_AT_104Hz);
+  lsm6dsox_fifo_mode_set(&dev_ctx, LSM6DSOX_FIFO_MODE);
+  lsm6dsox_xl_data_rate_set(&dev_ctx, LSM6DSOX_XL_ODR_104Hz);
+
+  /* Discard samples of the filter settling time */
+  platform_delay(100);
+  lsm6dsox_fifo_mode_set(&dev_ctx, LSM6DSOX_BYPASS_MODE);
+  lsm6dsox_fifo_mode_set(&dev_ctx, LSM6DSOX_FIFO_MODE);
+
+  do {
+    lsm6dsox_fifo_wtm_flag_get(&dev_ctx, &wtm);
+  } while (wtm == 0U);
+
+  num = 0;
+  while (num < CAL_SAMPLES)
+  {
+    lsm6dsox_fifo_tag_t reg_tag;
+
+    lsm6dsox_fifo_sensor_tag_get(&dev_ctx, &reg_tag);
+    lsm6dsox_fifo_out_raw_get(&dev_ctx, data_raw_acceleration.u8bit);
+    if (reg_tag == LSM6DSOX_XL_NC_TAG)
+    {
+      memcpy(cal_raw[num], data_raw_acceleration.i16bit, sizeof(cal_raw[0]));
+      num++;
+    }
+  }
+
+  lsm6dsox_fifo_mode_set(&dev_ctx, LSM6DSOX_BYPASS_MODE);
+  lsm6dsox_fifo_xl_batch_set(&dev_ctx, LSM6DSOX_XL_NOT_BATCHED);
+
+  /* Reject the calibration if the device moved (std deviation > 5 mg) */
+  cal.noise_mg = 5.0f;
+  lsm6dsox_xl_offset_calibrate(&dev_ctx, &cal_raw[0][0], CAL_SAMPLES, &cal);
+  if (cal.done == 0U)
+    while(1);
+
+  sprintf((char*)tx_buffer, "Bias [mg]:%4.2f\t%4.2f\t%4.2f\r\n",
+          cal.bias_mg[0], cal.bias_mg[1], cal.bias_mg[2]);
+  tx_com(tx_buffer, strlen((char const*)tx_buffer));
 
   /* Set Output Data Rate */
   lsm6dsox_xl_data_rate_set(&dev_ctx, LSM6DSOX_XL_ODR_12Hz5);
   lsm6dsox_gy_data_rate_set(&dev_ctx, LSM6DSOX_GY_ODR_12Hz5);
 
-  /* Set full scale */
-  lsm6dsox_xl_full_scale_set(&dev_ctx, LSM6DSOX_2g);
-  lsm6dsox_gy_full_scale_set(&dev_ctx, LSM6DSOX_2000dps);
-
   /* Configure filtering chain(No aux interface). */
   /* Accelerometer - LPF1 + LPF2 path */
   lsm6dsox_xl_hp_path_on_out_set(&dev_ctx, LSM6DSOX_LP_ODR_DIV_100);
@@ -170,15 +170,17 @@ void lsm6dsox_read_data_simple(void)
   /* Read samples in polling mode (no int) */
   while(1)
   {
-    uint8_t reg;
-
-    /* Read output only if new xl value is available */
-    lsm6dsox_xl_flag_data_ready_get(&dev_ctx, &reg);
-    if (reg)
+    lsm6dsox_status_reg_t status;
+
+    /* Read data ready flags and all the outputs in one burst, every
+     * output is updated only if a new value is available
+     */
+    lsm6dsox_data_drdy_raw_get(&dev_ctx, &status,
+                               data_raw_temperature.u8bit,
+                               data_raw_angular_rate.u8bit,
+                               data_raw_acceleration.u8bit);
+    if (status.xlda)
     {
-      /* Read acceleration field data */
-      memset(data_raw_acceleration.u8bit, 0x00, 3 * sizeof(int16_t));
-      lsm6dsox_acceleration_raw_get(&dev_ctx, data_raw_acceleration.u8bit);
       acceleration_mg[0] =
           lsm6dsox_from_fs2_to_mg(data_raw_acceleration.i16bit[0]);
       acceleration_mg[1] =
@@ -191,12 +193,8 @@ void lsm6dsox_read_data_simple(void)
       tx_com(tx_buffer, strlen((char const*)tx_buffer));
     }
 
-    lsm6dsox_gy_flag_data_ready_get(&dev_ctx, &reg);
-    if (reg)
+    if (status.gda)
     {
-      /* Read angular rate field data */
-      memset(data_raw_angular_rate.u8bit, 0x00, 3 * sizeof(int16_t));
-      lsm6dsox_angular_rate_raw_get(&dev_ctx, data_raw_angular_rate.u8bit);
       angular_rate_mdps[0] =
           lsm6dsox_from_fs2000_to_mdps(data_raw_angular_rate.i16bit[0]);
       angular_rate_mdps[1] =
@@ -209,12 +207,8 @@ void lsm6dsox_read_data_simple(void)
       tx_com(tx_buffer, strlen((char const*)tx_buffer));
     }
 
-    lsm6dsox_temp_flag_data_ready_get(&dev_ctx, &reg);
-    if (reg)
+    if (status.tda)
     {
-      /* Read temperature data */
-      memset(data_raw_temperature.u8bit, 0x00, sizeof(int16_t));
-      lsm6dsox_temperature_raw_get(&dev_ctx, data_raw_temperature.u8bit);
       temperature_degC = lsm6dsox_from_lsb_to_celsius(data_raw_temperature.i16bit);
 
       sprintf((char*)tx_buffer,
@@ -0,0 +1,479 @@
+/*
+ ******************************************************************************
+ * @file    lsm6dsox_wake_up_fifo.c
+ * @author  Sensors Software Solution Team
+ * @brief   This file shows how to stream data from sensor FIFO only
+ *          while the device is moving (wake-up / inactivity gated).
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2020 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/*
+ * This example was developed using the following STMicroelectronics
+ * evaluation boards:
+ *
+ * - STEVAL_MKI109V3 + STEVAL-MKI197V1
+ * - NUCLEO_F411RE + STEVAL-MKI197V1
+ *
+ * and STM32CubeMX tool with STM32CubeF4 MCU Package
+ *
+ * Used interfaces:
+ *
+ * STEVAL_MKI109V3    - Host side:   USB (Virtual COM)
+ *                    - Sensor side: SPI(Default) / I2C(supported)
+ *
+ * NUCLEO_STM32F411RE - Host side: UART(COM) to USB bridge
+ *                    - I2C(Default) / SPI(supported)
+ *
+ * If you need to run this example on a different hardware platform a
+ * modification of the functions: `platform_write`, `platform_read`,
+ * `tx_com` and 'platform_init' is required.
+ *
+ */
+
+/* STMicroelectronics evaluation boards definition
+ *
+ * Please uncomment ONLY the evaluation boards in use.
+ * If a different hardware is used please comment all
+ * following target board and redefine yours.
+ */
+//#define STEVAL_MKI109V3
+#define NUCLEO_F411RE_X_NUCLEO_IKS01A2
+
+#if defined(STEVAL_MKI109V3)
+/* MKI109V3: Define communication interface */
+#define SENSOR_BUS hspi2
+
+/* MKI109V3: Vdd and Vddio power supply values */
+#define PWM_3V3 915
+
+#elif defined(NUCLEO_F411RE_X_NUCLEO_IKS01A2)
+/* NUCLEO_F411RE_X_NUCLEO_IKS01A2: Define communication interface */
+#define SENSOR_BUS hi2c1
+
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <stdio.h>
+
+#include "stm32f4xx_hal.h"
+#include <lsm6dsox_reg.h>
+#include "gpio.h"
+#include "i2c.h"
+#if defined(STEVAL_MKI109V3)
+#include "usbd_cdc_if.h"
+#include "spi.h"
+#elif defined(NUCLEO_F411RE_X_NUCLEO_IKS01A2)
+#include "usart.h"
+#endif
+
+typedef union{
+  int16_t i16bit[3];
+  uint8_t u8bit[6];
+} axis3bit16_t;
+
+/* Private macro -------------------------------------------------------------*/
+/* Uncomment to keep the samples preceding the wake-up event */
+#define PRE_TRIGGER
+
+/* Samples kept before the wake-up event (at 26 Hz, ~1 s) */
+#define PRE_TRIGGER_SAMPLES  26
+/* FIFO words read with a single bus transaction */
+#define BURST_WORDS          32
+#define FIFO_WORD_LEN        7
+
+typedef enum {
+  PIPELINE_SLEEP = 0,
+  PIPELINE_STREAM,
+} pipeline_state_t;
+
+/* Private variables ---------------------------------------------------------*/
+static axis3bit16_t data_raw_acceleration;
+static axis3bit16_t data_raw_angular_rate;
+static float acceleration_mg[3];
+static float angular_rate_mdps[3];
+static uint8_t whoamI, rst;
+static uint8_t tx_buffer[1000];
+static uint8_t fifo_buffer[BURST_WORDS * FIFO_WORD_LEN];
+static uint16_t pre_trigger_num;
+
+/* Extern variables ----------------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/*
+ *   WARNING:
+ *   Functions declare in this section are defined at the end of this file
+ *   and are strictly related to the hardware platform used.
+ *
+ */
+static int32_t platform_write(void *handle, uint8_t reg, uint8_t *bufp,
+                              uint16_t len);
+static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
+                             uint16_t len);
+static void tx_com( uint8_t *tx_buffer, uint16_t len );
+static void platform_delay(uint32_t ms);
+static void platform_init(void);
+
+static void pipeline_sleep(stmdev_ctx_t *ctx);
+static void pipeline_stream(stmdev_ctx_t *ctx);
+static void pipeline_drain(stmdev_ctx_t *ctx, uint16_t num);
+
+/* Main Example --------------------------------------------------------------*/
+void example_main_wake_up_fifo_lsm6dsox(void)
+{
+  stmdev_ctx_t dev_ctx;
+  pipeline_state_t state;
+
+  /* Initialize mems driver interface */
+  dev_ctx.write_reg = platform_write;
+  dev_ctx.read_reg = platform_read;
+  dev_ctx.handle = &SENSOR_BUS;
+
+  /* Init test platform */
+  platform_init();
+
+  /* Wait sensor boot time */
+  platform_delay(10);
+
+  /* Check device ID */
+  lsm6dsox_device_id_get(&dev_ctx, &whoamI);
+  if (whoamI != LSM6DSOX_ID)
+    while(1);
+
+  /* Restore default configuration */
+  lsm6dsox_reset_set(&dev_ctx, PROPERTY_ENABLE);
+  do {
+    lsm6dsox_reset_get(&dev_ctx, &rst);
+  } while (rst);
+
+  /* Disable I3C interface */
+  lsm6dsox_i3c_disable_set(&dev_ctx, LSM6DSOX_I3C_DISABLE);
+
+  /* Enable Block Data Update */
+  lsm6dsox_block_data_update_set(&dev_ctx, PROPERTY_ENABLE);
+
+  /* Set full scale */
+  lsm6dsox_xl_full_scale_set(&dev_ctx, LSM6DSOX_2g);
+  lsm6dsox_gy_full_scale_set(&dev_ctx, LSM6DSOX_2000dps);
+
+  /* Apply high-pass digital filter on Wake-Up function */
+  lsm6dsox_xl_hp_path_internal_set(&dev_ctx, LSM6DSOX_USE_SLOPE);
+
+  /*
+   * Set Wake-Up threshold: 1 LSb corresponds to FS_XL/2^6 (31.25 mg at
+   * 2 g), 2 LSb = 62.5 mg
+   */
+  lsm6dsox_wkup_threshold_set(&dev_ctx, 2);
+
+  /* Set Wake-Up duration: 1 LSb corresponds to 1 / ODR_XL */
+  lsm6dsox_wkup_dur_set(&dev_ctx, 0);
+
+  /*
+   * Set inactivity time before going back to sleep: 1 LSb corresponds
+   * to 512 / ODR_XL (4.9 s at 417 Hz)
+   */
+  lsm6dsox_act_sleep_dur_set(&dev_ctx, 4);
+
+  /*
+   * Activity / inactivity detection without automatic ODR change:
+   * data rates are managed below, so the FIFO batching rate always
+   * matches the sensor data rate.
+   */
+  lsm6dsox_act_mode_set(&dev_ctx, LSM6DSOX_XL_AND_GY_NOT_AFFECTED);
+
+  /*
+   * The events are polled here. To sleep the MCU route them to an
+   * interrupt pin, e.g. sleep_change on INT1 with
+   * lsm6dsox_pin_int_route_set() and wait the pin in place of polling.
+   */
+  pipeline_sleep(&dev_ctx);
+  state = PIPELINE_SLEEP;
+
+  while(1)
+  {
+    lsm6dsox_all_sources_t all_source;
+    uint16_t num;
+
+    lsm6dsox_all_sources_get(&dev_ctx, &all_source);
+
+    if (state == PIPELINE_SLEEP)
+    {
+      /*
+       * Wake on the motion events only: sleep_state also reads 0 until
+       * the end of the first inactivity period after start.
+       */
+      if (all_source.wake_up ||
+          (all_source.sleep_change && (all_source.sleep_state == 0U)))
+      {
+        pipeline_stream(&dev_ctx);
+        state = PIPELINE_STREAM;
+
+        sprintf((char*)tx_buffer, "Wake-Up: %d pre-trigger samples\r\n",
+                pre_trigger_num);
+        tx_com(tx_buffer, strlen((char const*)tx_buffer));
+      }
+    }
+    else
+    {
+      /* Drain the FIFO in bursts on watermark */
+      if (all_source.fifo_th)
+      {
+        lsm6dsox_fifo_data_level_get(&dev_ctx, &num);
+        pipeline_drain(&dev_ctx, num);
+      }
+
+      /* Back to sleep after the inactivity time */
+      if (all_source.sleep_state)
+      {
+        lsm6dsox_fifo_data_level_get(&dev_ctx, &num);
+        pipeline_drain(&dev_ctx, num);
+        pipeline_sleep(&dev_ctx);
+        state = PIPELINE_SLEEP;
+
+        sprintf((char*)tx_buffer, "Inactivity: back to sleep\r\n");
+        tx_com(tx_buffer, strlen((char const*)tx_buffer));
+      }
+    }
+  }
+}
+
+/*
+ * @brief  Low power state: accelerometer only at 26 Hz in low power
+ *         mode waiting for the wake-up event.
+ *         With PRE_TRIGGER the accelerometer is batched in continuous
+ *         mode with the FIFO depth limited to the watermark (stop on
+ *         watermark), so the FIFO always holds the last
+ *         PRE_TRIGGER_SAMPLES samples without any bus activity.
+ *         Otherwise the FIFO is in bypass mode.
+ *
+ * @param  ctx       read / write interface definitions
+ *
+ */
+static void pipeline_sleep(stmdev_ctx_t *ctx)
+{
+  lsm6dsox_fifo_mode_set(ctx, LSM6DSOX_BYPASS_MODE);
+  lsm6dsox_fifo_gy_batch_set(ctx, LSM6DSOX_GY_NOT_BATCHED);
+  lsm6dsox_gy_data_rate_set(ctx, LSM6DSOX_GY_ODR_OFF);
+  lsm6dsox_xl_power_mode_set(ctx, LSM6DSOX_LOW_NORMAL_POWER_MD);
+  lsm6dsox_xl_data_rate_set(ctx, LSM6DSOX_XL_ODR_26Hz);
+
+#ifdef PRE_TRIGGER
+  lsm6dsox_fifo_watermark_set(ctx, PRE_TRIGGER_SAMPLES);
+  lsm6dsox_fifo_stop_on_wtm_set(ctx, PROPERTY_ENABLE);
+  lsm6dsox_fifo_xl_batch_set(ctx, LSM6DSOX_XL_BATCHED_AT_26Hz);
+  lsm6dsox_fifo_mode_set(ctx, LSM6DSOX_STREAM_MODE);
+#else
+  lsm6dsox_fifo_xl_batch_set(ctx, LSM6DSOX_XL_NOT_BATCHED);
+#endif /* PRE_TRIGGER */
+}
+
+/*
+ * @brief  Streaming state: accelerometer and gyroscope at 417 Hz in
+ *         high performance mode batched in continuous mode.
+ *         The pre-trigger samples already in FIFO are kept (the FIFO
+ *         mode is not changed) and read before the new ones.
+ *
+ * @param  ctx       read / write interface definitions
+ *
+ */
+static void pipeline_stream(stmdev_ctx_t *ctx)
+{
+  pre_trigger_num = 0;
+
+#ifdef PRE_TRIGGER
+  lsm6dsox_fifo_data_level_get(ctx, &pre_trigger_num);
+  lsm6dsox_fifo_stop_on_wtm_set(ctx, PROPERTY_DISABLE);
+#endif /* PRE_TRIGGER */
+
+  lsm6dsox_fifo_watermark_set(ctx, BURST_WORDS);
+  lsm6dsox_xl_power_mode_set(ctx, LSM6DSOX_HIGH_PERFORMANCE_MD);
+  lsm6dsox_xl_data_rate_set(ctx, LSM6DSOX_XL_ODR_417Hz);
+  lsm6dsox_gy_data_rate_set(ctx, LSM6DSOX_GY_ODR_417Hz);
+  lsm6dsox_fifo_xl_batch_set(ctx, LSM6DSOX_XL_BATCHED_AT_417Hz);
+  lsm6dsox_fifo_gy_batch_set(ctx, LSM6DSOX_GY_BATCHED_AT_417Hz);
+  lsm6dsox_fifo_mode_set(ctx, LSM6DSOX_STREAM_MODE);
+}
+
+/*
+ * @brief  Read num FIFO words, BURST_WORDS words (tag + data) for every
+ *         bus transaction: the address rolls back from
+ *         FIFO_DATA_OUT_Z_H to FIFO_DATA_OUT_TAG on multiple reads.
+ *         The first pre_trigger_num accelerometer samples were
+ *         batched at 26 Hz before the wake-up event.
+ *
+ * @param  ctx       read / write interface definitions
+ * @param  num       number of FIFO words to read
+ *
+ */
+static void pipeline_drain(stmdev_ctx_t *ctx, uint16_t num)
+{
+  uint16_t len;
+  uint16_t i;
+
+  while (num > 0U)
+  {
+    len = (num > BURST_WORDS) ? BURST_WORDS : num;
+    lsm6dsox_read_reg(ctx, LSM6DSOX_FIFO_DATA_OUT_TAG, fifo_buffer,
+                      len * FIFO_WORD_LEN);
+    num -= len;
+
+    for (i = 0; i < len; i++)
+    {
+      uint8_t *word = &fifo_buffer[i * FIFO_WORD_LEN];
+
+      switch (word[0] >> 3)
+      {
+        case LSM6DSOX_XL_NC_TAG:
+          memcpy(data_raw_acceleration.u8bit, &word[1], 6);
+          acceleration_mg[0] =
+            lsm6dsox_from_fs2_to_mg(data_raw_acceleration.i16bit[0]);
+          acceleration_mg[1] =
+            lsm6dsox_from_fs2_to_mg(data_raw_acceleration.i16bit[1]);
+          acceleration_mg[2] =
+            lsm6dsox_from_fs2_to_mg(data_raw_acceleration.i16bit[2]);
+
+          sprintf((char*)tx_buffer, "%sAcceleration [mg]:%4.2f\t%4.2f\t%4.2f\r\n",
+                  (pre_trigger_num > 0U) ? "Pre-trigger " : "",
+                  acceleration_mg[0], acceleration_mg[1], acceleration_mg[2]);
+          tx_com(tx_buffer, strlen((char const*)tx_buffer));
+
+          if (pre_trigger_num > 0U)
+            pre_trigger_num--;
+          break;
+        case LSM6DSOX_GYRO_NC_TAG:
+          memcpy(data_raw_angular_rate.u8bit, &word[1], 6);
+          angular_rate_mdps[0] =
+            lsm6dsox_from_fs2000_to_mdps(data_raw_angular_rate.i16bit[0]);
+          angular_rate_mdps[1] =
+            lsm6dsox_from_fs2000_to_mdps(data_raw_angular_rate.i16bit[1]);
+          angular_rate_mdps[2] =
+            lsm6dsox_from_fs2000_to_mdps(data_raw_angular_rate.i16bit[2]);
+
+          sprintf((char*)tx_buffer, "Angular rate [mdps]:%4.2f\t%4.2f\t%4.2f\r\n",
+                  angular_rate_mdps[0], angular_rate_mdps[1], angular_rate_mdps[2]);
+          tx_com(tx_buffer, strlen((char const*)tx_buffer));
+          break;
+        default:
+          /* Unused samples */
+          break;
+      }
+    }
+  }
+}
+
+/*
+ * @brief  Write generic device register (platform dependent)
+ *
+ * @param  handle    customizable argument. In this examples is used in
+ *                   order to select the correct sensor bus handler.
+ * @param  reg       register to write
+ * @param  bufp      pointer to data to write in register reg
+ * @param  len       number of consecutive register to write
+ *
+ */
+static int32_t platform_write(void *handle, uint8_t reg, uint8_t *bufp,
+                              uint16_t len)
+{
+  if (handle == &hi2c1)
+  {
+    HAL_I2C_Mem_Write(handle, LSM6DSOX_I2C_ADD_L, reg,
+                      I2C_MEMADD_SIZE_8BIT, bufp, len, 1000);
+  }
+#ifdef STEVAL_MKI109V3
+  else if (handle == &hspi2)
+  {
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_RESET);
+    HAL_SPI_Transmit(handle, &reg, 1, 1000);
+    HAL_SPI_Transmit(handle, bufp, len, 1000);
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_SET);
+  }
+#endif
+  return 0;
+}
+
+/*
+ * @brief  Read generic device register (platform dependent)
+ *
+ * @param  handle    customizable argument. In this examples is used in
+ *                   order to select the correct sensor bus handler.
+ * @param  reg       register to read
+ * @param  bufp      pointer to buffer that store the data read
+ * @param  len       number of consecutive register to read
+ *
+ */
+static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp,
+                             uint16_t len)
+{
+  if (handle == &hi2c1)
+  {
+    HAL_I2C_Mem_Read(handle, LSM6DSOX_I2C_ADD_L, reg,
+                     I2C_MEMADD_SIZE_8BIT, bufp, len, 1000);
+  }
+#ifdef STEVAL_MKI109V3
+  else if (handle == &hspi2)
+  {
+    /* Read command */
+    reg |= 0x80;
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_RESET);
+    HAL_SPI_Transmit(handle, &reg, 1, 1000);
+    HAL_SPI_Receive(handle, bufp, len, 1000);
+    HAL_GPIO_WritePin(CS_up_GPIO_Port, CS_up_Pin, GPIO_PIN_SET);
+  }
+#endif
+  return 0;
+}
+
+/*
+ * @brief  Write generic device register (platform dependent)
+ *
+ * @param  tx_buffer     buffer to trasmit
+ * @param  len           number of byte to send
+ *
+ */
+static void tx_com(uint8_t *tx_buffer, uint16_t len)
+{
+  #ifdef NUCLEO_F411RE_X_NUCLEO_IKS01A2
+  HAL_UART_Transmit(&huart2, tx_buffer, len, 1000);
+  #endif
+  #ifdef STEVAL_MKI109V3
+  CDC_Transmit_FS(tx_buffer, len);
+  #endif
+}
+
+/*
+ * @brief  platform specific delay (platform dependent)
+ *
+ * @param  ms        delay in ms
+ *
+ */
+static void platform_delay(uint32_t ms)
+{
+  HAL_Delay(ms);
+}
+
+/*
+ * @brief  platform specific initialization (platform dependent)
+ */
+static void platform_init(void)
+{
+#ifdef STEVAL_MKI109V3
+  TIM3->CCR1 = PWM_3V3;
+  TIM3->CCR2 = PWM_3V3;
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+  HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);
+  HAL_Delay(1000);
+#endif
+}
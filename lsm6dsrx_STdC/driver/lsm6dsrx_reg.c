@@ -1622,6 +1622,134 @@ int32_t lsm6dsrx_mem_bank_get(stmdev_ctx_t *ctx,
   return ret;
 }
 
+/**
+  * @brief  Write FUNC_CFG_ACCESS in the device if the value requested in
+  *         the session is different.
+  *
+  * @param  session  bank session.(ptr)
+  *
+  */
+static int32_t lsm6dsrx_bank_session_flush(lsm6dsrx_bank_session_t *session)
+{
+  int32_t ret = 0;
+
+  if (session->shadow != session->func_cfg_access) {
+    ret = lsm6dsrx_write_reg(session->bus, LSM6DSRX_FUNC_CFG_ACCESS,
+                             &session->shadow, 1);
+    if (ret == 0) {
+      session->func_cfg_access = session->shadow;
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Bank session write interface: FUNC_CFG_ACCESS writes are
+  *         kept in the shadow register.
+  *
+  * @param  handle   bank session.(ptr)
+  * @param  reg      first register address to write.
+  * @param  data     the buffer contains data to be written.(ptr)
+  * @param  len      number of consecutive register to write.
+  *
+  */
+static int32_t lsm6dsrx_bank_session_write(void *handle, uint8_t reg,
+                                           uint8_t *data, uint16_t len)
+{
+  lsm6dsrx_bank_session_t *session = (lsm6dsrx_bank_session_t*)handle;
+  int32_t ret = 0;
+
+  if ((reg == LSM6DSRX_FUNC_CFG_ACCESS) && (len == 1U)) {
+    session->shadow = *data;
+  }
+  else {
+    ret = lsm6dsrx_bank_session_flush(session);
+    if (ret == 0) {
+      ret = lsm6dsrx_write_reg(session->bus, reg, data, len);
+    }
+    if ((ret == 0) && (reg == LSM6DSRX_FUNC_CFG_ACCESS)) {
+      session->shadow = *data;
+      session->func_cfg_access = *data;
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Bank session read interface: FUNC_CFG_ACCESS is read from
+  *         the shadow register.
+  *
+  * @param  handle   bank session.(ptr)
+  * @param  reg      first register address to read.
+  * @param  data     buffer for data read.(ptr)
+  * @param  len      number of consecutive register to read.
+  *
+  */
+static int32_t lsm6dsrx_bank_session_read(void *handle, uint8_t reg,
+                                          uint8_t *data, uint16_t len)
+{
+  lsm6dsrx_bank_session_t *session = (lsm6dsrx_bank_session_t*)handle;
+  int32_t ret = 0;
+
+  if ((reg == LSM6DSRX_FUNC_CFG_ACCESS) && (len == 1U)) {
+    *data = session->shadow;
+  }
+  else {
+    ret = lsm6dsrx_bank_session_flush(session);
+    if (ret == 0) {
+      ret = lsm6dsrx_read_reg(session->bus, reg, data, len);
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Start a bank session: the APIs called with session->ctx
+  *         switch the register bank only when needed, e.g.
+  *
+  *           lsm6dsrx_bank_session_start(&dev_ctx, &session);
+  *           lsm6dsrx_fsm_enable_set(&session.ctx, ...);
+  *           lsm6dsrx_fsm_data_rate_set(&session.ctx, ...);
+  *           lsm6dsrx_long_cnt_int_value_set(&session.ctx, ...);
+  *           lsm6dsrx_bank_session_stop(&session);
+  *
+  *         FUNC_CFG_ACCESS is read once here; it must not be changed
+  *         using ctx until the session is stopped.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  session  bank session.(ptr)
+  *
+  */
+int32_t lsm6dsrx_bank_session_start(stmdev_ctx_t *ctx,
+                                    lsm6dsrx_bank_session_t *session)
+{
+  int32_t ret;
+
+  session->bus = ctx;
+  session->ctx.write_reg = lsm6dsrx_bank_session_write;
+  session->ctx.read_reg = lsm6dsrx_bank_session_read;
+  session->ctx.handle = session;
+
+  ret = lsm6dsrx_read_reg(ctx, LSM6DSRX_FUNC_CFG_ACCESS,
+                          &session->func_cfg_access, 1);
+  session->shadow = session->func_cfg_access;
+
+  return ret;
+}
+
+/**
+  * @brief  Stop a bank session: FUNC_CFG_ACCESS is written in the device
+  *         if the last value requested was not applied yet (usually the
+  *         return to the user bank).
+  *
+  * @param  session  bank session.(ptr)
+  *
+  */
+int32_t lsm6dsrx_bank_session_stop(lsm6dsrx_bank_session_t *session)
+{
+  return lsm6dsrx_bank_session_flush(session);
+}
+
 /**
   * @brief  Write a line(byte) in a page.[set]
   *
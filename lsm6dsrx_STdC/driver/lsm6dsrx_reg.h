@@ -1800,6 +1800,24 @@ typedef enum {
 int32_t lsm6dsrx_mem_bank_set(stmdev_ctx_t *ctx, lsm6dsrx_reg_access_t val);
 int32_t lsm6dsrx_mem_bank_get(stmdev_ctx_t *ctx, lsm6dsrx_reg_access_t *val);
 
+/**
+  * @brief  Embedded functions / sensor hub bank session: the driver APIs
+  *         called with session.ctx keep FUNC_CFG_ACCESS in a shadow
+  *         register and write it to the device only when a register of a
+  *         different bank is accessed, so consecutive embedded functions
+  *         settings do a single bank switch.
+  *         The session must not be moved between start and stop.
+  */
+typedef struct {
+  stmdev_ctx_t ctx;              /* context to be used in the session */
+  stmdev_ctx_t *bus;             /* device context */
+  uint8_t func_cfg_access;       /* FUNC_CFG_ACCESS value in the device */
+  uint8_t shadow;                /* FUNC_CFG_ACCESS value requested */
+} lsm6dsrx_bank_session_t;
+int32_t lsm6dsrx_bank_session_start(stmdev_ctx_t *ctx,
+                                    lsm6dsrx_bank_session_t *session);
+int32_t lsm6dsrx_bank_session_stop(lsm6dsrx_bank_session_t *session);
+
 int32_t lsm6dsrx_ln_pg_write_byte(stmdev_ctx_t *ctx, uint16_t address,
                                  uint8_t *val);
 int32_t lsm6dsrx_ln_pg_write(stmdev_ctx_t *ctx, uint16_t address,